@@ -102,6 +102,28 @@ void Application::UpdateSpeed(const float inSpeedFactor)
 	speedFactor = std::min(SPEED_MAX_THRESHOLD, speedFactor);
 }
 
+void Application::SetSpeedFactors(const float inSpeedFactor, const float inPausedSpeedFactor)
+{
+	speedFactor = inSpeedFactor;
+	cachedSpeedFactor = inPausedSpeedFactor;
+}
+
+SnapshotRequest Application::TakeSnapshotRequest()
+{
+	const SnapshotRequest pendingSnapshotRequest = snapshotRequest;
+	snapshotRequest = SnapshotRequest::NONE;
+
+	return pendingSnapshotRequest;
+}
+
+double Application::TakeScrubRequest()
+{
+	const double pendingScrubDays = scrubDays;
+	scrubDays = 0.0;
+
+	return pendingScrubDays;
+}
+
 void Application::SetScene(std::unique_ptr<Scene> scene)
 {
 	CoreEngine::GetInstance().SetScene(std::move(scene));
@@ -10,6 +10,14 @@ class Window;
 
 
 
+// Action on the whole simulation state asked by the user, handled by the Scene at its next update
+enum class SnapshotRequest
+{
+	NONE = 0,
+	SAVE,
+	RESTORE,
+};
+
 // Singleton class allowing a global access point for a unique Application instance
 class Application
 {
@@ -31,6 +39,14 @@ public:
 	bool IsLegendDisplayed() const { return isLegendDisplayed; }
 	void DisplayLegend(const bool inIsLegendDisplayed) { isLegendDisplayed = inIsLegendDisplayed; }
 
+	// Integrate massive celestial bodies under their mutual gravity instead of following their Keplerian orbits
+	bool IsNBodyModeEnabled() const { return isNBodyModeEnabled; }
+	void EnableNBodyMode(const bool inIsNBodyModeEnabled) { isNBodyModeEnabled = inIsNBodyModeEnabled; }
+
+	// Record integrated states while running in N-Body mode, so the run can be scrubbed backwards
+	bool IsTimelineRecordingEnabled() const { return isTimelineRecordingEnabled; }
+	void EnableTimelineRecording(const bool inIsTimelineRecordingEnabled) { isTimelineRecordingEnabled = inIsTimelineRecordingEnabled; }
+
 	float GetSpeedFactor() const { return speedFactor; }
 	bool IsPaused() const { return speedFactor == 0.0f; }
 	bool IsMinSpeed() const { return speedFactor <= SPEED_MIN_THRESHOLD; }
@@ -39,6 +55,23 @@ public:
 	// See what the simulation run by the Application looks like when celestial bodies move slower/faster (won't be of any effect when paused)
 	void UpdateSpeed(const float inSpeedFactor);
 
+	// Speed factor to go back to when unpausing (0 if not paused)
+	float GetPausedSpeedFactor() const { return cachedSpeedFactor; }
+
+	// Overwrite both speed factors at once (e.g. restored from a snapshot)
+	void SetSpeedFactors(const float inSpeedFactor, const float inPausedSpeedFactor);
+
+	void RequestSnapshot(const SnapshotRequest inSnapshotRequest) { snapshotRequest = inSnapshotRequest; }
+
+	// Return the pending snapshot request, which is cleared
+	SnapshotRequest TakeSnapshotRequest();
+
+	// Move the simulated date backward/forward by the provided amount of days, requests being summed up until the Scene handles them
+	void RequestScrub(const double inScrubDays) { scrubDays += inScrubDays; }
+
+	// Return the pending amount of days to scrub by, which is cleared
+	double TakeScrubRequest();
+
 	const std::filesystem::path& GetExecutablePath() const { return executablePath; }
 
 	void SetScene(std::unique_ptr<Scene> scene);
@@ -56,9 +89,15 @@ private:
 	float speedFactor{ 1.0f };
 	float cachedSpeedFactor{ 0.0f };
 	constexpr static float SPEED_MIN_THRESHOLD = 0.125f;
-	constexpr static float SPEED_MAX_THRESHOLD = 512.0f;
+	// 2^20 times faster than real time (i.e. about 2900 Earth years per second), the fixed-step simulation keeping frame cost bounded
+	constexpr static float SPEED_MAX_THRESHOLD = 1048576.0f;
 
 	bool isLegendDisplayed{ false };
+	bool isNBodyModeEnabled{ false };
+	bool isTimelineRecordingEnabled{ false };
+
+	SnapshotRequest snapshotRequest{ SnapshotRequest::NONE };
+	double scrubDays{ 0.0 };
 };
 
 
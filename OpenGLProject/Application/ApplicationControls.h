@@ -10,6 +10,9 @@ namespace ApplicationControls
 	// Keyboard key release action will not be registered if press action has happened at a delta time equal/lower to this value
 	constexpr float KEY_RELEASE_SENSITIVITY = 1.0f;
 
+	// Simulated time moved through per arrow key press (or repeat) when scrubbing [in Main Planet days]
+	constexpr double SCRUB_STEP_DAYS = 10.0;
+
 	// Detect input where keyboard key press only triggers a single state
 	void ProcessUserInput();
 };
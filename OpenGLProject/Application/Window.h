@@ -32,6 +32,9 @@ public:
 
 	float GetAspectRatio() const { return aspectRatio; }
 
+	// Framebuffer height [in pixels]
+	uint32_t GetHeight() const { return height; }
+
 	glm::vec2 ComputeCursorOffset(const double xPosition, const double yPosition);
 
 	// Show/Hide the cursor and lock its motion to the window if hidden
@@ -14,8 +14,21 @@ DataBuffer::DataBuffer(const void* data, const std::size_t sizeInBytes, const ui
 	glBufferData(target, sizeInBytes, data, usage);
 }
 
+DataBuffer::DataBuffer(DataBuffer&& inDataBuffer) noexcept :
+	rendererID(inDataBuffer.rendererID),
+	target(inDataBuffer.target)
+{
+	inDataBuffer.rendererID = 0;
+}
+
 DataBuffer::~DataBuffer()
 {
+	// Nothing to delete once moved from
+	if (rendererID == 0)
+	{
+		return;
+	}
+
 	Unbind();
 
 	// Delete the BO and free up the ID that was being used by it
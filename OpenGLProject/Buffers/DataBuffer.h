@@ -24,6 +24,15 @@ public:
 	// Constructor of BO includes a binding and a data setter, so no need to call these methods separately just after instantiation of children
 	DataBuffer() = default;
 	DataBuffer(const void* data, const std::size_t sizeInBytes, const uint32_t inTarget, const uint32_t usage = GL_STATIC_DRAW);
+
+	// Copy constructor (not needed, as the BO ID would be deleted twice)
+	DataBuffer(const DataBuffer& inDataBuffer) = delete;
+	DataBuffer& operator = (const DataBuffer& inDataBuffer) = delete;
+
+	// Move constructor (needed when the owning mesh is moved, e.g. when stored by value in a vector). The moved-from BO is left without ID
+	DataBuffer(DataBuffer&& inDataBuffer) noexcept;
+	DataBuffer& operator = (DataBuffer&& inDataBuffer) = delete;
+
 	~DataBuffer();
 
 	// Select an OpenGL Target listed in the Context so we make the State associated with the BO current
@@ -0,0 +1,118 @@
+#include "StreamingVertexBuffer.h"
+
+#include <cassert>
+#include <iostream>
+
+
+
+StreamingVertexBuffer::StreamingVertexBuffer(const std::size_t inRegionSizeInBytes) :
+	regionSizeInBytes(inRegionSizeInBytes)
+{
+	target = GL_ARRAY_BUFFER;
+
+	// Reserve an ID available to be used by the BO as a binding point
+	glGenBuffers(1, &rendererID);
+
+	Bind();
+
+	const std::size_t storageSizeInBytes = regionSizeInBytes * REGION_COUNT;
+	if (GLAD_GL_VERSION_4_4)
+	{
+		// Immutable storage, mapped once: coherent mapping makes writes visible to the GPU without any explicit flush
+		const GLbitfield storageFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		glBufferStorage(target, storageSizeInBytes, nullptr, storageFlags);
+		persistentData = glMapBufferRange(target, 0, storageSizeInBytes, storageFlags);
+	}
+	else
+	{
+		glBufferData(target, storageSizeInBytes, nullptr, GL_STREAM_DRAW);
+	}
+
+	Unbind();
+}
+
+StreamingVertexBuffer::~StreamingVertexBuffer()
+{
+	for (GLsync& fence : regionFences)
+	{
+		if (fence != nullptr)
+		{
+			glDeleteSync(fence);
+			fence = nullptr;
+		}
+	}
+
+	if (persistentData != nullptr)
+	{
+		Bind();
+		glUnmapBuffer(target);
+		persistentData = nullptr;
+	}
+
+	// The BO itself is deleted by the DataBuffer destructor
+}
+
+void* StreamingVertexBuffer::BeginWrite()
+{
+	currentRegion = (currentRegion + 1) % REGION_COUNT;
+	WaitForRegion(currentRegion);
+
+	if (persistentData != nullptr)
+	{
+		return static_cast<char*>(persistentData) + GetCurrentRegionOffset();
+	}
+
+	// Regions still read by the GPU have been waited for, so the driver does not need to synchronise the mapping with them
+	Bind();
+	void* const regionData = glMapBufferRange(target, GetCurrentRegionOffset(), regionSizeInBytes, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+	if (regionData == nullptr)
+	{
+		std::cout << "ERROR::STREAMING_VERTEX_BUFFER - Region " << currentRegion << " could not be mapped!" << std::endl;
+		assert(false);
+	}
+
+	return regionData;
+}
+
+void StreamingVertexBuffer::EndWrite()
+{
+	if (persistentData != nullptr)
+	{
+		return;
+	}
+
+	Bind();
+	glUnmapBuffer(target);
+	Unbind();
+}
+
+void StreamingVertexBuffer::FenceCurrentRegion()
+{
+	GLsync& fence = regionFences[currentRegion];
+	if (fence != nullptr)
+	{
+		glDeleteSync(fence);
+	}
+
+	fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+void StreamingVertexBuffer::WaitForRegion(const uint32_t region)
+{
+	GLsync& fence = regionFences[region];
+	if (fence == nullptr)
+	{
+		return;
+	}
+
+	// Commands are flushed on the first wait only, so the fence is guaranteed to be signaled eventually
+	GLbitfield waitFlags = GL_SYNC_FLUSH_COMMANDS_BIT;
+	constexpr GLuint64 waitTimeoutInNs = 1000000;
+	while (glClientWaitSync(fence, waitFlags, waitTimeoutInNs) == GL_TIMEOUT_EXPIRED)
+	{
+		waitFlags = 0;
+	}
+
+	glDeleteSync(fence);
+	fence = nullptr;
+}
@@ -0,0 +1,62 @@
+#ifndef STREAMING_VERTEX_BUFFER_H
+#define STREAMING_VERTEX_BUFFER_H
+
+#include <glad/glad.h>
+
+#include <array>
+#include <cstdint>
+#include <cstddef> // std::size_t
+
+#include "DataBuffer.h"
+
+
+
+// VBO whose content is rewritten by the CPU every frame. Storage is split into several regions written in turn (multi-buffering), each region being fenced
+// once draw calls reading it are submitted, so the CPU only waits for the GPU if it comes back to a region still in use (i.e. when it is several frames ahead).
+// Storage is mapped once for the lifetime of the buffer when the context allows it (OpenGL 4.4), and mapped without synchronisation at each write otherwise
+class StreamingVertexBuffer : public DataBuffer
+{
+public:
+	// Amount of regions, i.e. frames the CPU can write ahead of the GPU
+	static constexpr uint32_t REGION_COUNT = 3;
+
+	StreamingVertexBuffer(const std::size_t inRegionSizeInBytes);
+
+	// Copy constructor (not needed, as the buffer is mapped and deleted by its owner only)
+	StreamingVertexBuffer(const StreamingVertexBuffer& inStreamingVertexBuffer) = delete;
+	StreamingVertexBuffer& operator = (const StreamingVertexBuffer& inStreamingVertexBuffer) = delete;
+
+	// Move constructor (not needed, for the same reason)
+	StreamingVertexBuffer(StreamingVertexBuffer&& inStreamingVertexBuffer) = delete;
+	StreamingVertexBuffer& operator = (StreamingVertexBuffer&& inStreamingVertexBuffer) = delete;
+
+	~StreamingVertexBuffer();
+
+	// Move to the next region, wait for the GPU to be done with it if needed, and return where to write its new content (region size bytes at most)
+	void* BeginWrite();
+
+	// Make the content written since the last BeginWrite() call available to draw calls
+	void EndWrite();
+
+	// Byte offset of the region written last, i.e. the one draw calls should read from
+	std::size_t GetCurrentRegionOffset() const { return static_cast<std::size_t>(currentRegion) * regionSizeInBytes; }
+
+	// Protect the region written last from being overwritten until draw calls submitted so far are done reading it
+	void FenceCurrentRegion();
+
+private:
+	std::size_t regionSizeInBytes{ 0 };
+	uint32_t currentRegion{ REGION_COUNT - 1 };
+
+	// Fence of each region, set after the draw calls reading it (nullptr when the region is free)
+	std::array<GLsync, REGION_COUNT> regionFences{};
+
+	// Start of the whole storage when persistently mapped, nullptr otherwise
+	void* persistentData{ nullptr };
+
+	void WaitForRegion(const uint32_t region);
+};
+
+
+
+#endif // STREAMING_VERTEX_BUFFER_H
@@ -13,6 +13,7 @@ std::unordered_map<GLSLUniform::Enum, std::vector<ShaderLookUpID::Enum>> Uniform
 		GLSLUniform::PROJECTION_VIEW,
 		{
 			ShaderLookUpID::Enum::DEFAULT,
+			ShaderLookUpID::Enum::BODY,
 			ShaderLookUpID::Enum::STAR,
 			ShaderLookUpID::Enum::BILLBOARD,
 			ShaderLookUpID::Enum::BELT,
@@ -23,6 +24,7 @@ std::unordered_map<GLSLUniform::Enum, std::vector<ShaderLookUpID::Enum>> Uniform
 		GLSLUniform::LINE_OF_SIGHT,
 		{
 			ShaderLookUpID::Enum::DEFAULT,
+			ShaderLookUpID::Enum::BODY,
 			ShaderLookUpID::Enum::BELT,
 		}
 	}
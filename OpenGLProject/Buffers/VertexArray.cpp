@@ -1,12 +1,9 @@
 #include "VertexArray.h"
 
 #include <glad/glad.h>
-#include <glm/mat4x4.hpp>
-#include <glm/vec4.hpp>
 
 #include <cstddef> // std::size_t
 
-#include "Scene/Transform.h"
 #include "VertexBufferLayout.h"
 
 
@@ -19,8 +16,20 @@ VertexArray::VertexArray()
 	Bind();
 }
 
+VertexArray::VertexArray(VertexArray&& inVertexArray) noexcept :
+	rendererID(inVertexArray.rendererID)
+{
+	inVertexArray.rendererID = 0;
+}
+
 VertexArray::~VertexArray()
 {
+	// Nothing to delete once moved from
+	if (rendererID == 0)
+	{
+		return;
+	}
+
 	Unbind();
 
 	// Delete the VAO and free up the ID that was being used by it
@@ -55,28 +64,25 @@ void VertexArray::RegisterVertexBufferLayout(const VertexBufferLayout& layout)
 	}
 }
 
-void VertexArray::RegisterInstancingVertexBufferLayout(const VertexBufferLayout& layout) const
+void VertexArray::RegisterInstancingVertexBufferLayout(const VertexBufferLayout& layout, const std::size_t dataStart) const
 {
 	Bind();
 
-	const std::size_t mat4SizeInBytes = Transform::GetMatrixSizeInBytes();
-	const std::size_t mat4ColSizeInBytes = Transform::GetColumnSizeInBytes();
-
-	std::size_t offset = 0;
+	std::size_t offset = dataStart;
 
-	// Iterate through the matrix containing Vertex Attribute layout for instancing
+	// Iterate through the Vertex Attribute layouts of the instance data (e.g. each column of a matrix)
 	for (const VertexAttributeLayout& attributeLayout : layout.GetAttributeLayouts())
 	{
 		// Enable the attribute index at location i in the vertex shader to be used
 		glEnableVertexAttribArray(attributeLayout.location);
 
-		// Store in the currently bound VBO how we want OpenGL to interpret the data corresponding to the 4x4 matrix
-		glVertexAttribPointer(attributeLayout.location, attributeLayout.count, attributeLayout.type, attributeLayout.normalised, mat4SizeInBytes, reinterpret_cast<const void*>(offset));
+		// Store in the currently bound VBO how we want OpenGL to interpret the instance data
+		glVertexAttribPointer(attributeLayout.location, attributeLayout.count, attributeLayout.type, attributeLayout.normalised, layout.GetStride(), reinterpret_cast<const void*>(offset));
 
 		// Set the rate at which the attribute index advance when rendering multiple instances of primitives in a single draw call
 		glVertexAttribDivisor(attributeLayout.location, 1);
 
-		offset += mat4ColSizeInBytes;
+		offset += static_cast<std::size_t>(attributeLayout.count) * sizeof(attributeLayout.type);
 	}
 
 	Unbind();
@@ -1,6 +1,8 @@
 #ifndef VERTEX_ARRAY_H
 #define VERTEX_ARRAY_H
 
+#include <cstddef> // std::size_t
+
 class VertexBuffer;
 class VertexBufferLayout;
 
@@ -14,6 +16,15 @@ class VertexArray
 public:
 	// Constructor of VAO includes a binding, so no need to call the method separately just after instantiation
 	VertexArray();
+
+	// Copy constructor (not needed, as the VAO ID would be deleted twice)
+	VertexArray(const VertexArray& inVertexArray) = delete;
+	VertexArray& operator = (const VertexArray& inVertexArray) = delete;
+
+	// Move constructor (needed when the owning mesh is moved, e.g. when stored by value in a vector). The moved-from VAO is left without ID
+	VertexArray(VertexArray&& inVertexArray) noexcept;
+	VertexArray& operator = (VertexArray&& inVertexArray) = delete;
+
 	~VertexArray();
 
 	// Select the VAO we want to activate in the array
@@ -25,8 +36,9 @@ public:
 	// Parameterise VAO so the VBO is interpreted correctly for GLSL Shader attributes. Warning: require VAO/VBO to be bound beforehand 
 	void RegisterVertexBufferLayout(const VertexBufferLayout& layout);
 
-	// Parameterise VAO so the VBO is interpreted correctly for GLSL Shader attributes in an instancing context. Warning: require VAO/VBO to be bound beforehand 
-	void RegisterInstancingVertexBufferLayout(const VertexBufferLayout& layout) const;
+	// Parameterise VAO so the VBO is interpreted correctly for GLSL Shader attributes in an instancing context, data of the first instance starting at the provided byte offset.
+	// Warning: require VBO to be bound beforehand 
+	void RegisterInstancingVertexBufferLayout(const VertexBufferLayout& layout, const std::size_t dataStart = 0) const;
 
 private:
 	unsigned int rendererID{ 0 };
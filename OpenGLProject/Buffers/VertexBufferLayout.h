@@ -20,6 +20,9 @@ enum VertexAttributeLocation: unsigned int
 	InstancedMatrixCol2 = 6,
 	InstancedMatrixCol3 = 7,
 	InstancedMatrixCol4 = 8,
+
+	// Layer of the texture array sampled by an instance
+	InstancedTextureLayer = 9,
 };
 
 // Group of parameters so the VAO interprets VBO data correctly, enabling a correct initialisation of user-defined input values of GLSL Vertex Shaders 
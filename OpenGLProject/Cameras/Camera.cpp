@@ -9,8 +9,8 @@
 
 
 Camera::Camera(const glm::vec3& inPosition, const EulerAngles& inRotation, const float inFovY, const float inFarPlane) :
-	transformAtStart(inPosition, inRotation),
-	transform(inPosition, inRotation),
+	positionAtStart(inPosition),
+	rotationAtStart(inRotation),
 	fovY(inFovY),
 	farPlane(inFarPlane),
 	vuboProjectionView("vubo_ProjectionView", GLSLUniform::PROJECTION_VIEW),
@@ -23,26 +23,34 @@ Camera::Camera(const glm::vec3& inPosition, const EulerAngles& inRotation, const
 
 	// Not stored in a GLSL struct in Fragment Shader
 	fuboCameraPosition.SetData(static_cast<const void*>(glm::value_ptr(glm::vec4(0.0f))), GLSLConstants::vec4SizeInBytes);
+
+	SetTransform(inPosition, inRotation);
 }
 
 void Camera::SetInitialTransform(const glm::vec3& inPosition, const EulerAngles& inRotation)
 {
 	SetTransform(inPosition, inRotation);
 
-	transformAtStart.SetPosition(inPosition);
-	transformAtStart.SetRotation(inRotation);
+	positionAtStart = inPosition;
+	rotationAtStart = inRotation;
 }
 
 void Camera::SetTransform(const glm::vec3& inPosition, const EulerAngles& inRotation)
 {
 	transform.SetPosition(inPosition);
-	transform.SetRotation(inRotation);
+	orientation.SetRotation(inRotation);
+	ApplyOrientation();
 }
 
 void Camera::SetTransformToStart()
 {
 	transform.Reset();
-	SetTransform(transformAtStart.GetPosition(), transformAtStart.GetRotation());
+	SetTransform(positionAtStart, rotationAtStart);
+}
+
+void Camera::ApplyOrientation()
+{
+	transform.SetRotation(orientation.GetRotationMatrix());
 }
 
 glm::mat4 Camera::ComputeInfiniteView() const
@@ -50,7 +58,7 @@ glm::mat4 Camera::ComputeInfiniteView() const
 	return glm::mat4(glm::mat3(ComputeView()));
 }
 
-void Camera::SetProjectionViewVUniform(const ViewMode viewMode, const float windowAspectRatio) const
+glm::mat4 Camera::ComputeProjectionView(const ViewMode viewMode, const float windowAspectRatio) const
 {
 	glm::mat4 projectionView = ComputeProjection(windowAspectRatio);
 	switch (viewMode)
@@ -72,6 +80,12 @@ void Camera::SetProjectionViewVUniform(const ViewMode viewMode, const float wind
 	}
 	}
 
+	return projectionView;
+}
+
+void Camera::SetProjectionViewVUniform(const ViewMode viewMode, const float windowAspectRatio) const
+{
+	const glm::mat4 projectionView = ComputeProjectionView(viewMode, windowAspectRatio);
 	vuboProjectionView.SetSubData(static_cast<const void*>(glm::value_ptr(projectionView)), GLSLConstants::mat4v4SizeInBytes, 0);
 }
 
@@ -25,6 +25,7 @@ public:
 	glm::vec3 GetPosition() const { return transform.GetPosition(); }
 
 	const Transform& GetTransform() const { return transform; }
+	const Orientation& GetOrientation() const { return orientation; }
 	void SetInitialTransform(const glm::vec3& inPosition, const EulerAngles& inRotation);
 	void SetTransform(const glm::vec3& inPosition, const EulerAngles& inRotation);
 	void SetTransformToStart();
@@ -37,19 +38,32 @@ public:
 	// (no rotation by roll around Forward camera vector, as we do not want rotation around normal to screen)
 	virtual void Rotate(const EulerAngles& deltaRotation) = 0;
 
+	float GetFovY() const { return fovY; }
 	void SetFovY(const float zoomLeft) { fovY = zoomLeft; }
 
 	virtual glm::mat4 ComputeProjection(const float windowAspectRatio) const = 0;
 	virtual glm::mat4 ComputeView() const = 0;
 	virtual glm::mat4 ComputeInfiniteView() const;
 
+	// Projection-View matrix uploaded for the provided view mode (e.g. also read by frustum culling)
+	glm::mat4 ComputeProjectionView(const ViewMode viewMode, const float windowAspectRatio) const;
+
 	void SetProjectionViewVUniform(const ViewMode viewMode, const float windowAspectRatio) const;
 	void SetPositionFUniform() const;
 
 protected:
-	Transform transformAtStart;
+	// Hot data, read every frame to compute the View matrix
 	Transform transform;
 
+	// Cold data, only updated on user input (LookAt vectors being copied into the Transform rotation each time)
+	Orientation orientation;
+
+	glm::vec3 positionAtStart{ 0.0f };
+	EulerAngles rotationAtStart;
+
+	// Store LookAt vectors of the orientation in the Transform rotation
+	void ApplyOrientation();
+
 	// Field of view along the y-axis [in degrees]
 	float fovY{ 0.0f };
 	float farPlane{ 0.0f };
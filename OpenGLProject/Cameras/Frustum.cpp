@@ -0,0 +1,77 @@
+#include "Frustum.h"
+
+#include <glm/geometric.hpp>
+#include <glm/gtc/matrix_access.hpp>	// glm::row()
+
+#include "Utils/SIMDHelpers.h"
+
+
+
+Frustum::Frustum(const glm::mat4& projectionView)
+{
+	// Clip space bounds -w <= x, y, z <= w give a plane per bound, out of the 4th row added to or subtracted from another row
+	const glm::vec4 rowX = glm::row(projectionView, 0);
+	const glm::vec4 rowY = glm::row(projectionView, 1);
+	const glm::vec4 rowZ = glm::row(projectionView, 2);
+	const glm::vec4 rowW = glm::row(projectionView, 3);
+
+	planes = { rowW + rowX, rowW - rowX, rowW + rowY, rowW - rowY, rowW + rowZ, rowW - rowZ };
+
+	for (glm::vec4& plane : planes)
+	{
+		plane /= glm::length(glm::vec3(plane));
+	}
+}
+
+bool Frustum::IntersectsSphere(const glm::vec3& center, const float radius) const
+{
+	for (const glm::vec4& plane : planes)
+	{
+		if (glm::dot(glm::vec3(plane), center) + plane.w < -radius)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void Frustum::IntersectSpheres(const float* centersX, const float* centersY, const float* centersZ, const float* radii, const std::size_t count, uint8_t* outVisibilityFlags) const
+{
+	std::size_t i = 0;
+
+#if SIMD_SSE2_ENABLED
+	constexpr std::size_t laneCount = SIMDHelpers::FLOAT_LANE_COUNT;
+
+	// A sphere is kept if it is not entirely behind any plane, i.e. its signed distance to every plane is at least -radius
+	for (; i + laneCount <= count; i += laneCount)
+	{
+		const __m128 x = _mm_loadu_ps(centersX + i);
+		const __m128 y = _mm_loadu_ps(centersY + i);
+		const __m128 z = _mm_loadu_ps(centersZ + i);
+		const __m128 negatedRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(radii + i));
+
+		__m128 isInside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+		for (const glm::vec4& plane : planes)
+		{
+			__m128 distance = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.x), x), _mm_set1_ps(plane.w));
+			distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.y), y));
+			distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.z), z));
+
+			isInside = _mm_and_ps(isInside, _mm_cmpge_ps(distance, negatedRadius));
+		}
+
+		const int32_t insideMask = _mm_movemask_ps(isInside);
+		for (std::size_t lane = 0; lane < laneCount; ++lane)
+		{
+			outVisibilityFlags[i + lane] = static_cast<uint8_t>((insideMask >> lane) & 1);
+		}
+	}
+#endif
+
+	// Remaining spheres (or all of them without SIMD)
+	for (; i < count; ++i)
+	{
+		outVisibilityFlags[i] = IntersectsSphere(glm::vec3(centersX[i], centersY[i], centersZ[i]), radii[i]) ? 1 : 0;
+	}
+}
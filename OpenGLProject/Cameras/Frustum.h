@@ -0,0 +1,36 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include <array>
+#include <cstddef> // std::size_t
+#include <cstdint>
+
+
+
+// Volume seen by a camera, bounded by 6 planes extracted out of its Projection-View matrix (Gribb-Hartmann method),
+// so culling tests the same volume the GPU clips against. Plane normals point inwards and are normalized, so distances are in World space units
+class Frustum
+{
+public:
+	static constexpr std::size_t PLANE_COUNT = 6;
+
+	explicit Frustum(const glm::mat4& projectionView);
+
+	// Return whether a sphere is at least partly inside the frustum (conservative: spheres close to a frustum corner may be kept)
+	bool IntersectsSphere(const glm::vec3& center, const float radius) const;
+
+	// Test spheres stored as Structure-of-Arrays in batch, writing 1 in the flag of each sphere intersecting the frustum, 0 otherwise
+	void IntersectSpheres(const float* centersX, const float* centersY, const float* centersZ, const float* radii, const std::size_t count, uint8_t* outVisibilityFlags) const;
+
+private:
+	// Left, right, bottom, top, near and far planes (normal.x, normal.y, normal.z, distance to the origin)
+	std::array<glm::vec4, PLANE_COUNT> planes;
+};
+
+
+
+#endif // FRUSTUM_H
@@ -20,7 +20,7 @@ glm::mat4 PerspectiveCamera::ComputeProjection(const float windowAspectRatio) co
 glm::mat4 PerspectiveCamera::ComputeView() const
 {
 	const glm::vec3& cameraPosition = transform.GetPosition();
-	return glm::lookAt(cameraPosition, cameraPosition + transform.GetForwardVector(), transform.GetUpVector());
+	return glm::lookAt(cameraPosition, cameraPosition + orientation.GetForwardVector(), orientation.GetUpVector());
 }
 
 void PerspectiveCamera::Translate(const float deltaPosition, const glm::vec3& direction)
@@ -30,5 +30,6 @@ void PerspectiveCamera::Translate(const float deltaPosition, const glm::vec3& di
 
 void PerspectiveCamera::Rotate(const EulerAngles& deltaRotation)
 {
-	transform.UpdateRotation(deltaRotation);
+	orientation.UpdateRotation(deltaRotation);
+	ApplyOrientation();
 }
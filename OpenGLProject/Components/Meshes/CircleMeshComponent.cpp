@@ -1,18 +1,19 @@
 #include "CircleMeshComponent.h"
 
 #include <glad/glad.h>
-#include <glm/trigonometric.hpp>
 #include <glm/vec3.hpp>
 
+#include <cassert>
+#include <cstddef> // std::size_t
+#include <iostream>
 #include <utility>
 
 #include "Rendering/Renderer.h"
-#include "Utils/Constants.h"
+#include "Utils/TrigTable.h"
 
 
 
-CircleMeshComponent::CircleMeshComponent(const float inRadius, const uint32_t inMeridianStripCount) :
-	radius(inRadius),
+CircleMeshComponent::CircleMeshComponent(const uint32_t inMeridianStripCount) :
 	meridianStripCount(inMeridianStripCount)
 {
 	ComputeVertices();
@@ -21,17 +22,25 @@ CircleMeshComponent::CircleMeshComponent(const float inRadius, const uint32_t in
 
 void CircleMeshComponent::ComputeVertices()
 {
-	const float thetaAngle = GLMConstants::doublePi * 1.0f / meridianStripCount;
+	if (TrigTable::IsSampled(meridianStripCount) == false)
+	{
+		std::cout << "ERROR::CIRCLE - Segment count should fall on steps of the trigonometric table!" << std::endl;
+		assert(false);
+		return;
+	}
+
+	// Table steps between two consecutive vertices
+	const int64_t thetaSteps = TrigTable::TURN_STEP_COUNT / meridianStripCount;
 
 	const glm::vec3 zeroVector(0.0f);
 
-	vertices.reserve(static_cast<size_t>(meridianStripCount + 1));
-	for (int32_t i = 0; i <= meridianStripCount; ++i)
+	vertices.reserve(static_cast<std::size_t>(meridianStripCount) + 1);
+	for (uint32_t i = 0; i <= meridianStripCount; ++i)
 	{
-		const float theta = i * thetaAngle;
+		const int64_t thetaStep = i * thetaSteps;
 
 		Vertex vertex;
-		vertex.position = glm::vec3(radius * glm::sin(theta), 0.0f, radius * glm::cos(theta));
+		vertex.position = glm::vec3(TrigTable::Sin(thetaStep), 0.0f, TrigTable::Cos(thetaStep));
 		vertex.normal = zeroVector;
 		vertex.texCoords = zeroVector;
 		vertex.tangent = zeroVector;
@@ -7,16 +7,17 @@
 
 
 
+// Circle of radius 1 in the XZ plane, turned into any ellipse by the Model matrix (so a single mesh is shared by all orbits)
 class CircleMeshComponent : public MeshComponent
 {
 public:
-	CircleMeshComponent(const float inRadius, const uint32_t inMeridianStripCount = 500);
+	// Segment count should divide the turn steps of the trigonometric table
+	CircleMeshComponent(const uint32_t inMeridianStripCount = 480);
 
 	void Render(const unsigned int mode = 0) const override;
 
 private:
-	float radius{ 0.0f };
-	int32_t meridianStripCount{ 500 };
+	uint32_t meridianStripCount{ 480 };
 
 	void ComputeVertices();
 };
@@ -1,6 +1,10 @@
 #include "MeshComponent.h"
 
+#include <glm/geometric.hpp>
+
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <iostream>
 #include <utility>
 
@@ -27,11 +31,11 @@ void MeshComponent::StoreVertices()
 		assert(false);
 	}
 
-	vao = std::make_shared<VertexArray>();
+	vao.emplace();
 	VertexBuffer vbo(static_cast<const void*>(vertices.data()), vertices.size() * sizeof(Vertex));
 	if (IsIndicesBuffer())
 	{
-		ibo = std::make_shared<IndexBuffer>(static_cast<const void*>(indices.data()), static_cast<uint32_t>(indices.size()));
+		ibo.emplace(static_cast<const void*>(indices.data()), static_cast<uint32_t>(indices.size()));
 	}
 
 	VertexBufferLayout vbl;
@@ -51,14 +55,42 @@ void MeshComponent::StoreVertices()
 	}
 }
 
-void MeshComponent::StoreInstanceTransforms() const
+float MeshComponent::ComputeBoundingRadius() const
+{
+	float squaredBoundingRadius = 0.0f;
+	for (const Vertex& vertex : vertices)
+	{
+		squaredBoundingRadius = std::max(squaredBoundingRadius, glm::dot(vertex.position, vertex.position));
+	}
+
+	return std::sqrt(squaredBoundingRadius);
+}
+
+void MeshComponent::StoreInstanceRotationScales(const std::size_t dataStart) const
+{
+	VertexBufferLayout vbl;
+	vbl.AddAttributeLayout(VertexAttributeLocation::InstancedMatrixCol1, GL_FLOAT, Vertex::INSTANCE_MATRIX_COL_TYPE_DIMENSION);
+	vbl.AddAttributeLayout(VertexAttributeLocation::InstancedMatrixCol2, GL_FLOAT, Vertex::INSTANCE_MATRIX_COL_TYPE_DIMENSION);
+	vbl.AddAttributeLayout(VertexAttributeLocation::InstancedMatrixCol3, GL_FLOAT, Vertex::INSTANCE_MATRIX_COL_TYPE_DIMENSION);
+	vao->RegisterInstancingVertexBufferLayout(std::move(vbl), dataStart);
+}
+
+void MeshComponent::StoreInstancePositions(const std::size_t dataStart) const
+{
+	VertexBufferLayout vbl;
+	vbl.AddAttributeLayout(VertexAttributeLocation::InstancedMatrixCol4, GL_FLOAT, Vertex::INSTANCE_POSITION_TYPE_DIMENSION);
+	vao->RegisterInstancingVertexBufferLayout(std::move(vbl), dataStart);
+}
+
+void MeshComponent::StoreInstanceModels(const std::size_t dataStart) const
 {
 	VertexBufferLayout vbl;
 	vbl.AddAttributeLayout(VertexAttributeLocation::InstancedMatrixCol1, GL_FLOAT, Vertex::INSTANCE_MATRIX_COL_TYPE_DIMENSION);
 	vbl.AddAttributeLayout(VertexAttributeLocation::InstancedMatrixCol2, GL_FLOAT, Vertex::INSTANCE_MATRIX_COL_TYPE_DIMENSION);
 	vbl.AddAttributeLayout(VertexAttributeLocation::InstancedMatrixCol3, GL_FLOAT, Vertex::INSTANCE_MATRIX_COL_TYPE_DIMENSION);
 	vbl.AddAttributeLayout(VertexAttributeLocation::InstancedMatrixCol4, GL_FLOAT, Vertex::INSTANCE_MATRIX_COL_TYPE_DIMENSION);
-	vao->RegisterInstancingVertexBufferLayout(std::move(vbl));
+	vbl.AddAttributeLayout(VertexAttributeLocation::InstancedTextureLayer, GL_FLOAT, Vertex::INSTANCE_TEXTURE_LAYER_TYPE_DIMENSION);
+	vao->RegisterInstancingVertexBufferLayout(std::move(vbl), dataStart);
 }
 
 void MeshComponent::Render(const unsigned int mode) const
@@ -69,7 +101,7 @@ void MeshComponent::Render(const unsigned int mode) const
 	if (IsIndicesBuffer())
 	{
 		// Expected to be called for any Mesh defining indices
-		if (ibo == nullptr || ibo->GetCount() == 0)
+		if (ibo.has_value() == false || ibo->GetCount() == 0)
 		{
 			std::cout << "ERROR::MESH - Any call to this method should have a non-null IBO!" << std::endl;
 		}
@@ -88,7 +120,15 @@ void MeshComponent::RenderInstances(const uint32_t instanceCount) const
 {
 	vao->Bind();
 
-	Renderer::DrawInstances(GL_TRIANGLES, 0, ibo->GetCount(), instanceCount);
+	// Same choice of OpenGL wrapper function as for a single draw
+	if (IsIndicesBuffer())
+	{
+		Renderer::DrawInstances(GL_TRIANGLES, static_cast<int32_t>(indices.size()), nullptr, static_cast<int32_t>(instanceCount));
+	}
+	else
+	{
+		Renderer::DrawInstances(GL_TRIANGLES, 0, static_cast<int32_t>(vertices.size()), static_cast<int32_t>(instanceCount));
+	}
 
 	vao->Unbind();
 }
@@ -5,13 +5,13 @@
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 
+#include <cstddef> // std::size_t
 #include <cstdint>
-#include <memory>
+#include <optional>
 #include <vector>
 
-class IndexBuffer;
-class VertexArray;
-class VertexBuffer;
+#include "Buffers/IndexBuffer.h"
+#include "Buffers/VertexArray.h"
 
 
 
@@ -30,6 +30,8 @@ struct Vertex
 	static constexpr uint32_t BITANGENT_TYPE_DIMENSION = 3;
 
 	static constexpr uint32_t INSTANCE_MATRIX_COL_TYPE_DIMENSION = 4;
+	static constexpr uint32_t INSTANCE_POSITION_TYPE_DIMENSION = 3;
+	static constexpr uint32_t INSTANCE_TEXTURE_LAYER_TYPE_DIMENSION = 1;
 };
 
 // 3D Geometry and its associated buffer objects
@@ -42,8 +44,8 @@ public:
 	// User-defined constructor (used when parsing a pre-made 3D model, i.e. a mesh with textures applied on it, and transferring Mesh info to this class) 
 	MeshComponent(const std::vector<Vertex>& inVertices, const std::vector<uint32_t>& inIndices = {});
 
-	// Copy constructor (needed when defining a Sphere in CelestialBody when object passed as const ref to instantiate Orbit/Billboard)
-	MeshComponent(const MeshComponent& inMesh) = default;
+	// Copy constructor (not needed, as buffer objects are owned by a single mesh)
+	MeshComponent(const MeshComponent& inMesh) = delete;
 	const MeshComponent& operator = (const MeshComponent& inMesh) = delete;
 
 	// Move constructor (used when reading data from model file)
@@ -53,18 +55,29 @@ public:
 	// Virtual destructor (needed, as class is not final)
 	virtual ~MeshComponent() = default;
 
-	void StoreInstanceTransforms() const;
+	// Register instance attributes out of the currently bound VBO, starting at the provided byte offset: the rotation/scale part of instance
+	// Model matrices (their first 3 columns), and instance positions (their 4th column, 1 being implied as last component)
+	void StoreInstanceRotationScales(const std::size_t dataStart = 0) const;
+	void StoreInstancePositions(const std::size_t dataStart) const;
+
+	// Register instance attributes out of the currently bound VBO, starting at the provided byte offset: whole instance Model matrices,
+	// each one followed by the layer of the texture array the instance samples (e.g. shared unit spheres drawn for every celestial body)
+	void StoreInstanceModels(const std::size_t dataStart) const;
 
 	// Call the appropriate OpenGL draw function according to the emptiness of the indices vector
 	virtual void Render(const unsigned int mode = GL_TRIANGLES) const;
 	virtual void RenderInstances(const uint32_t instanceCount) const;
 
+	// Return the radius of the sphere centered on the Model space origin enclosing every vertex (e.g. for frustum culling)
+	float ComputeBoundingRadius() const;
+
 protected:
 	std::vector<Vertex> vertices;
 	std::vector<uint32_t> indices;
 
-	std::shared_ptr<VertexArray> vao;
-	std::shared_ptr<IndexBuffer> ibo;
+	// Stored inline (empty until vertices are stored), so the mesh and its buffer objects live in the storage of their owner (e.g. a pooled entity)
+	std::optional<VertexArray> vao;
+	std::optional<IndexBuffer> ibo;
 
 	// Set vertex buffers and its attribute pointers once we have all required data
 	void StoreVertices();
@@ -0,0 +1,18 @@
+#include "MeshLibrary.h"
+
+std::vector<SphereMeshComponent> MeshLibrary::unitSpheres;
+
+std::unique_ptr<CircleMeshComponent> MeshLibrary::unitCircle;
+
+
+
+void MeshLibrary::BuildUnitMeshes()
+{
+	unitSpheres.reserve(SphereMeshComponent::LOD_COUNT);
+	for (const uint32_t stripCount : SphereMeshComponent::LOD_STRIP_COUNTS)
+	{
+		unitSpheres.emplace_back(stripCount, stripCount);
+	}
+
+	unitCircle = std::make_unique<CircleMeshComponent>();
+}
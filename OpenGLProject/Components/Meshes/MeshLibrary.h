@@ -0,0 +1,33 @@
+#ifndef MESH_LIBRARY_H
+#define MESH_LIBRARY_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "CircleMeshComponent.h"
+#include "SphereMeshComponent.h"
+
+
+
+// Global access point to the unit meshes shared by all Scene Entities of the same kind, sized by their Model matrix
+// (so GPU buffers and vertices are built once, whatever the amount of bodies/orbits)
+class MeshLibrary final
+{
+public:
+	// Build the unit sphere at every level of detail, and the unit circle. Warning: require an OpenGL Context
+	static void BuildUnitMeshes();
+
+	static const SphereMeshComponent& GetUnitSphere(const uint32_t lod) { return unitSpheres[lod]; }
+	static const CircleMeshComponent& GetUnitCircle() { return *unitCircle; }
+
+private:
+	// Finest level of detail first
+	static std::vector<SphereMeshComponent> unitSpheres;
+
+	static std::unique_ptr<CircleMeshComponent> unitCircle;
+};
+
+
+
+#endif // MESH_LIBRARY_H
@@ -1,6 +1,10 @@
 #include "QuadMeshComponent.h"
 
 #include <glad/glad.h>
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <utility>
 
@@ -38,6 +42,17 @@ void QuadMeshComponent::ComputeVertices()
 	}
 }
 
+float QuadMeshComponent::ComputeBoundingRadius() const
+{
+	float squaredBoundingRadius = 0.0f;
+	for (const Vertex2D& vertex : vertices)
+	{
+		squaredBoundingRadius = std::max(squaredBoundingRadius, glm::dot(vertex.position, vertex.position));
+	}
+
+	return std::sqrt(squaredBoundingRadius);
+}
+
 void QuadMeshComponent::StoreVertices()
 {
 	if (vertices.empty())
@@ -46,7 +61,7 @@ void QuadMeshComponent::StoreVertices()
 		assert(false);
 	}
 
-	vao = std::make_shared<VertexArray>();
+	vao.emplace();
 	VertexBuffer vbo(static_cast<const void*>(vertices.data()), vertices.size() * sizeof(Vertex2D));
 
 	// For 2D character glyphs, GLSL Vertex attribute definition can be more simply defined, i.e. as a single Vec4 instead of 2 Vec2
@@ -5,11 +5,11 @@
 
 #include <cstddef> // std::size_t
 #include <cstdint>
-#include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
-class VertexArray;
+#include "Buffers/VertexArray.h"
 
 
 
@@ -41,6 +41,9 @@ public:
 	// Render texture over the quad (e.g. the one of a character glyph)
 	void RenderGlyphs(const std::string& text, const uint32_t textureUnit) const;
 
+	// Return the radius of the circle centered on the quad space origin enclosing every quad (e.g. for frustum culling)
+	float ComputeBoundingRadius() const;
+
 	// Amount of vertices needed to shape a quad (formed of 2 triangles)
 	static constexpr int32_t QUAD_VERTEX_COUNT = 6;
 
@@ -50,7 +53,8 @@ private:
 	// List of Quad vertices (to be read per batch of 6 elements - batch not represented in data)
 	std::vector<Vertex2D> vertices;
 
-	std::shared_ptr<VertexArray> vao;
+	// Stored inline (empty until vertices are stored), so the VAO lives in the storage of the owning entity
+	std::optional<VertexArray> vao;
 
 	void ComputeVertices();
 
@@ -1,17 +1,35 @@
 #include "SphereMeshComponent.h"
 
-#include <glm/trigonometric.hpp>
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 
+#include <cassert>
+#include <iostream>
 #include <utility>
 
-#include "Utils/Constants.h"
+#include "Utils/TrigTable.h"
 
+namespace
+{
+	constexpr bool AreLODsSampled()
+	{
+		for (const uint32_t stripCount : SphereMeshComponent::LOD_STRIP_COUNTS)
+		{
+			if (TrigTable::IsSampled(stripCount) == false || TrigTable::IsSampled(2 * stripCount) == false)
+			{
+				return false;
+			}
+		}
 
+		return true;
+	}
 
-SphereMeshComponent::SphereMeshComponent(const float inRadius, const uint32_t inMeridianStripCount, const uint32_t inParallelStripCount) :
-	radius(inRadius),
+	static_assert(AreLODsSampled(), "Every level of detail should be built out of the trigonometric table");
+}
+
+
+
+SphereMeshComponent::SphereMeshComponent(const uint32_t inMeridianStripCount, const uint32_t inParallelStripCount) :
 	meridianStripCount(inMeridianStripCount),
 	parallelStripCount(inParallelStripCount)
 {
@@ -20,36 +38,62 @@ SphereMeshComponent::SphereMeshComponent(const float inRadius, const uint32_t in
 	StoreVertices();
 }
 
+uint32_t SphereMeshComponent::SelectLOD(const float projectedScreenRadius, const uint32_t currentLOD)
+{
+	uint32_t lod = currentLOD;
+
+	// Level i is drawn between thresholds i - 1 and i, only left once the radius is past one of them by the hysteresis margin
+	while (lod + 1 < LOD_COUNT && projectedScreenRadius < LOD_MIN_SCREEN_RADII[lod] * (1.0f - LOD_HYSTERESIS))
+	{
+		++lod;
+	}
+
+	while (lod > 0 && projectedScreenRadius > LOD_MIN_SCREEN_RADII[lod - 1] * (1.0f + LOD_HYSTERESIS))
+	{
+		--lod;
+	}
+
+	return lod;
+}
+
 void SphereMeshComponent::ComputeVertices()
 {
-	const float invMeridianStripCount = 1.0f / meridianStripCount;
-	const float invParallelStripCount = 1.0f / parallelStripCount;
-	const float invRadius = 1.0f / radius;
+	if (TrigTable::IsSampled(meridianStripCount) == false || TrigTable::IsSampled(2 * parallelStripCount) == false)
+	{
+		std::cout << "ERROR::SPHERE - Strip counts should fall on steps of the trigonometric table!" << std::endl;
+		assert(false);
+		return;
+	}
 
-	vertices.reserve((parallelStripCount + 1) * (meridianStripCount + 1));
+	const float invMeridianStripCount = 1.0f / static_cast<float>(meridianStripCount);
+	const float invParallelStripCount = 1.0f / static_cast<float>(parallelStripCount);
+
+	// Table steps between two meridians (over a turn) and between two parallels (over half a turn)
+	const int64_t meridianSteps = TrigTable::TURN_STEP_COUNT / meridianStripCount;
+	const int64_t parallelSteps = TrigTable::TURN_STEP_COUNT / (2 * parallelStripCount);
+
+	vertices.reserve(static_cast<std::size_t>(parallelStripCount + 1) * (meridianStripCount + 1));
 	for (uint32_t i = 0; i <= parallelStripCount; ++i)
 	{
-		const float iInvParallelStripsCount = i * invParallelStripCount;
-
-		// Angle between two squares (i.e. area formed by the intersection between one meridian strip and one parallel strip) of one parallel strip (in radians)
-		const float theta = GLMConstants::unitPi * (0.5f - iInvParallelStripsCount);
-		const float rCosTheta = radius * glm::cos(theta);
-		const float zCoor = radius * glm::sin(theta);
+		// Latitude of the parallel, from Pi/2 (i = 0) down to -Pi/2
+		const int64_t thetaStep = TrigTable::TURN_STEP_COUNT / 4 - i * parallelSteps;
+		const float cosTheta = TrigTable::Cos(thetaStep);
+		const float zCoor = TrigTable::Sin(thetaStep);
 
 		for (uint32_t j = 0; j <= meridianStripCount; ++j)
 		{
-			// Angle between two squares of one meridian strip (in radians)
-			const float jInvMeridianStripsCount = j * invMeridianStripCount;
-			const float phi = GLMConstants::doublePi * jInvMeridianStripsCount;
-			const float xCoor = rCosTheta * glm::cos(phi);
-			const float yCoor = rCosTheta * glm::sin(phi);
+			// Longitude of the meridian, from 0 to 2 Pi
+			const int64_t phiStep = j * meridianSteps;
+			const float xCoor = cosTheta * TrigTable::Cos(phiStep);
+			const float yCoor = cosTheta * TrigTable::Sin(phiStep);
 
+			// Radius being 1, normals are positions
 			Vertex vertex;
 			vertex.position = glm::vec3(xCoor, yCoor, zCoor);
-			vertex.normal = glm::vec3(xCoor * invRadius, yCoor * invRadius, zCoor * invRadius);
-			vertex.texCoords = glm::vec2(jInvMeridianStripsCount, iInvParallelStripsCount);
-			vertex.tangent = GLMConstants::zeroVector;
-			vertex.biTangent = GLMConstants::zeroVector;
+			vertex.normal = vertex.position;
+			vertex.texCoords = glm::vec2(static_cast<float>(j) * invMeridianStripCount, static_cast<float>(i) * invParallelStripCount);
+			vertex.tangent = glm::vec3(0.0f);
+			vertex.biTangent = glm::vec3(0.0f);
 			vertices.push_back(std::move(vertex));
 		}
 	}
@@ -1,21 +1,35 @@
 #ifndef SPHERE_H
 #define SPHERE_H
 
+#include <array>
+#include <cstddef> // std::size_t
 #include <cstdint>
 
 #include "MeshComponent.h"
 
 
 
+// Sphere of radius 1 centered on the Model space origin, scaled by the Model matrix (so a single mesh per level of detail is shared by all bodies)
 class SphereMeshComponent : public MeshComponent
 {
 public:
-	SphereMeshComponent(const float inRadius, const uint32_t inMeridianStripCount = 100, const uint32_t inParallelStripCount = 100);
+	// Amount of precomputed levels of detail, and strips along both meridians and parallels of each one (finest first, ~10k down to ~170 vertices)
+	static constexpr std::size_t LOD_COUNT = 4;
+	static constexpr std::array<uint32_t, LOD_COUNT> LOD_STRIP_COUNTS{ 100, 48, 24, 12 };
 
-	// Implicit copy constructor will be called when GetCelestialBody() is called, as we get a shallow copy of it every time
+	// Radius of a sphere projected on screen [in pixels] below which a level switches to the next coarser one
+	static constexpr std::array<float, LOD_COUNT - 1> LOD_MIN_SCREEN_RADII{ 80.0f, 32.0f, 12.0f };
+
+	// Relative margin the projected radius has to go beyond a threshold by before switching level, so spheres hovering around it do not pop
+	static constexpr float LOD_HYSTERESIS = 0.2f;
+
+	// Strip counts should fall on steps of the trigonometric table: meridian ones dividing a turn, parallel ones dividing half a turn
+	SphereMeshComponent(const uint32_t inMeridianStripCount = 100, const uint32_t inParallelStripCount = 100);
+
+	// Return the level of detail to draw a sphere projected at the provided screen radius [in pixels] with, out of the one drawn so far
+	static uint32_t SelectLOD(const float projectedScreenRadius, const uint32_t currentLOD);
 
 private:
-	float radius{ 0.0f };
 	uint32_t meridianStripCount{ 0 };
 	uint32_t parallelStripCount{ 0 };
 
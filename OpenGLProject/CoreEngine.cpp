@@ -4,24 +4,76 @@
 #include <glm/geometric.hpp>
 
 #include <algorithm>
-#include <cassert>
-#include <iostream>
-#include <unordered_map>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 #include <utility>
 
 #include "Application/Application.h"
 #include "Application/ApplicationControls.h"
 #include "Application/Window.h"
 #include "Cameras/Camera.h"
+#include "Components/Meshes/MeshLibrary.h"
 #include "Interactions/PerspectiveCameraController.h"
 #include "Rendering/GlyphLoader.h"
 #include "Rendering/Renderer.h"
 #include "Rendering/ShaderLoader.h"
-#include "Scene/SceneEntity.h"
-#include "Scene/Transform.h"
+#include "Scene/SceneSystems.h"
 
 CoreEngine* CoreEngine::instance = nullptr;
 
+namespace
+{
+	// Key of entities without Transform, drawn first
+	constexpr uint32_t farthestDepthKey = std::numeric_limits<uint32_t>::max();
+
+	uint32_t ToDepthKey(const float squaredDistance)
+	{
+		uint32_t depthKey = 0;
+		std::memcpy(&depthKey, &squaredDistance, sizeof(depthKey));
+
+		return depthKey;
+	}
+
+	// Stable LSD radix sort by decreasing depth key, 8 bits per pass (passes where all keys share the same byte being skipped, e.g. the sign byte)
+	template<typename DepthKeyType>
+	void SortByDecreasingDepthKey(std::vector<DepthKeyType>& depthKeys, std::vector<DepthKeyType>& scatteredDepthKeys)
+	{
+		scatteredDepthKeys.resize(depthKeys.size());
+
+		for (uint32_t shift = 0; shift < 32 && depthKeys.empty() == false; shift += 8)
+		{
+			// Keys are complemented, so the farthest entities come first
+			const auto GetDigit = [shift](const DepthKeyType& depthKey) { return (~depthKey.depthKey >> shift) & 0xFFu; };
+
+			std::array<uint32_t, 256> digitOffsets{};
+			for (const DepthKeyType& depthKey : depthKeys)
+			{
+				++digitOffsets[GetDigit(depthKey)];
+			}
+
+			if (digitOffsets[GetDigit(depthKeys.front())] == depthKeys.size())
+			{
+				continue;
+			}
+
+			uint32_t digitOffset = 0;
+			for (uint32_t& digitCount : digitOffsets)
+			{
+				digitOffset += std::exchange(digitCount, digitOffset);
+			}
+
+			for (const DepthKeyType& depthKey : depthKeys)
+			{
+				scatteredDepthKeys[digitOffsets[GetDigit(depthKey)]++] = depthKey;
+			}
+
+			depthKeys.swap(scatteredDepthKeys);
+		}
+	}
+}
+
 
 
 CoreEngine& CoreEngine::GetInstance()
@@ -38,6 +90,7 @@ void CoreEngine::SetUp()
 {
 	ShaderLibrary::BuildDefaultShaders();
 	GlyphLibrary::LoadASCIICharacters();
+	MeshLibrary::BuildUnitMeshes();
 }
 
 void CoreEngine::PrepareSceneForRendering()
@@ -124,57 +177,74 @@ void CoreEngine::UnqueueRenderCommands()
 
 void CoreEngine::OrderForTransparencyPass(const glm::vec3& cameraPosition)
 {
-	// Custom std::vector comparator so we order the closest body to the camera at the end
-	std::sort(scene->sceneEntities[RenderableType::TRANSPARENT_ENTITY].begin(), scene->sceneEntities[RenderableType::TRANSPARENT_ENTITY].end(),
-		[&cameraPosition](const std::unique_ptr<SceneEntity>& e1, const std::unique_ptr<SceneEntity>& e2)
+	const ComponentStore& componentStore = scene->componentStore;
+	const TransformHierarchy& transformHierarchy = componentStore.GetTransformHierarchy();
+	const bool isLegendDisplayed = Application::GetInstance().IsLegendDisplayed();
+
+	// Squared distances are computed once per entity (no sqrt needed, as they are ordered like distances)
+	transparentDepthKeys.clear();
+	for (uint32_t i = 0; i < componentStore.GetArchetypes().size(); ++i)
+	{
+		const Archetype& archetype = componentStore.GetArchetype(i);
+		if (archetype.renderType != RenderableType::TRANSPARENT_ENTITY || archetype.Has(ComponentType::MESH) == false
+			|| (archetype.Has(ComponentType::BILLBOARD) && isLegendDisplayed == false))
 		{
-			ITransformable* const transformable1 = dynamic_cast<ITransformable*>(e1.get());
-			ITransformable* const transformable2 = dynamic_cast<ITransformable*>(e2.get());
-			if (transformable1 == nullptr || transformable2 == nullptr)
+			continue;
+		}
+
+		const bool hasTransform = archetype.Has(ComponentType::TRANSFORM);
+		for (uint32_t row = 0; row < archetype.GetEntityCount(); ++row)
+		{
+			if (archetype.IsVisible(row) == false)
 			{
-				std::cout << "ERROR::CORE_ENGINE - Attempt to get transform from a Scene Entity that does not implement ITransformable!" << std::endl;
-				assert(false);
+				continue;
 			}
 
-			return glm::distance(cameraPosition, transformable1->GetTransform().GetPosition()) < glm::distance(cameraPosition, transformable2->GetTransform().GetPosition());
-		});
+			uint32_t depthKey = farthestDepthKey;
+			if (hasTransform)
+			{
+				const glm::vec3 cameraToEntity = glm::vec3(transformHierarchy.GetWorldMatrix(archetype.transformNodeIDs[row])[3]) - cameraPosition;
+				depthKey = ToDepthKey(glm::dot(cameraToEntity, cameraToEntity));
+			}
+
+			transparentDepthKeys.push_back(TransparentDepthKey{ depthKey, EntityLocation{ i, row } });
+		}
+	}
+
+	SortByDecreasingDepthKey(transparentDepthKeys, scatteredTransparentDepthKeys);
+
+	transparentDrawOrder.clear();
+	for (const TransparentDepthKey& transparentDepthKey : transparentDepthKeys)
+	{
+		transparentDrawOrder.push_back(transparentDepthKey.location);
+	}
 }
 
 void CoreEngine::Render(const float deltaTime)
 {
 	scene->sceneViewer.ProcessUserInput(deltaTime);
 
+	// Resolve all Model matrices once per frame, before any pass reads them (e.g. transparency sorting, parent positions)
+	SceneSystems::UpdateTransforms(scene->componentStore, scene->sceneViewer.GetCamera());
+	SceneSystems::UpdateLightSources(scene->componentStore);
+
+	// Flag entities outside the camera frustum once, so both the per-pass draws and the transparency sorting skip them
+	const Camera& camera = scene->sceneViewer.GetCamera();
+	SceneSystems::CullEntities(scene->componentStore, camera.ComputeProjectionView(ViewMode::FiniteLookAt, Application::GetInstance().GetWindow().GetAspectRatio()));
+	SceneSystems::SelectDetailLevels(scene->componentStore, camera, static_cast<float>(Application::GetInstance().GetWindow().GetHeight()));
+
 	for (const RenderCommand& renderCommand : renderQueue.queue)
 	{
 		renderCommand.Queue();
 
-		if (scene->sceneEntities.find(renderCommand.renderType) == scene->sceneEntities.end())
+		if (renderCommand.renderType == RenderableType::TRANSPARENT_ENTITY)
 		{
-			//std::cout << "SCENE::UPDATE - Handle for Scene Entity update has not been found!" << std::endl;
-			//assert(false);
-
-			continue;
+			SceneSystems::Render(scene->componentStore, transparentDrawOrder);
 		}
-
-		for (const std::unique_ptr<SceneEntity>& sceneEntity : scene->sceneEntities[renderCommand.renderType])
+		else
 		{
-			// If current Scene Entity implements ITransformable interface
-			if (ITransformable* const transformable = dynamic_cast<ITransformable*>(sceneEntity.get());
-				transformable != nullptr)
-			{
-				transformable->ComputeTransformVUniform(
-					deltaTime,
-					scene->sceneViewer.GetCamera(),
-					*scene->GetEntity<const ITransformable>(sceneEntity->parentID)
-				);
-			}
-
-			// If current Scene Entity implements IRenderable interface
-			if (IRenderable* const renderable = dynamic_cast<IRenderable*>(sceneEntity.get());
-				renderable != nullptr)
-			{
-				renderable->Render();
-			}
+			SceneSystems::Render(scene->componentStore, renderCommand.renderType);
+			SceneSystems::RenderInstances(scene->componentStore, renderCommand.renderType, instancedRenderer);
 		}
 	}
 }
@@ -185,13 +255,13 @@ void CoreEngine::Tick(const bool isPaused)
 	if (isPaused == false)
 	{
 		elapsedPlayTime = GetElapsedTime() - elapsedPauseTime;
-		deltaTime = elapsedPlayTime - lastFrameElapsedPlayTime;
+		deltaTime = static_cast<float>(elapsedPlayTime - lastFrameElapsedPlayTime);
 		lastFrameElapsedPlayTime = elapsedPlayTime;
 	}
 	else
 	{
 		elapsedPauseTime = GetElapsedTime() - elapsedPlayTime;
-		deltaTime = elapsedPauseTime - lastFrameElapsedPauseTime;
+		deltaTime = static_cast<float>(elapsedPauseTime - lastFrameElapsedPauseTime);
 		lastFrameElapsedPauseTime = elapsedPauseTime;
 	}
 
@@ -211,10 +281,9 @@ void CoreEngine::Refresh()
 	}
 }
 
-float CoreEngine::GetElapsedTime() const
+double CoreEngine::GetElapsedTime() const
 {
-	// @todo - Can we avoid static_casting at every frame?
-	return static_cast<float>(glfwGetTime());
+	return glfwGetTime();
 }
 
 void CoreEngine::SetScene(std::unique_ptr<Scene> inScene)
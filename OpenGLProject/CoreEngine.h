@@ -3,16 +3,20 @@
 
 #include <glm/vec3.hpp>
 
+#include <cstdint>
 #include <memory>
+#include <vector>
 
+#include "Rendering/InstancedRenderer.h"
 #include "Rendering/RenderQueue.h"
+#include "Scene/ComponentStore.h"
 #include "Scene/Scene.h"
 
 class Scene;
 
 
 
-// @todo - Do SPIKE for going full ECS instead of only Entity-Component Composition relationships
+// Scene Entities only own their GPU resources: every frame, Scene Systems resolve Model matrices and draw the entities out of the Component Store
 class CoreEngine
 {
 public:
@@ -36,7 +40,8 @@ public:
 	void SetScene(std::unique_ptr<Scene> inScene);
 
 	// Get time duration [in seconds] since the GLFW Window associated to the application has been created
-	float GetElapsedTime() const;
+	// (kept in double precision, as float would only be accurate to the millisecond after a few hours of run)
+	double GetElapsedTime() const;
 
 private:
 	static CoreEngine* instance;
@@ -46,23 +51,41 @@ private:
 
 	RenderQueue renderQueue;
 
+	// Batches entities with an instanced mesh (e.g. celestial bodies) into a few instanced draw calls per pass
+	InstancedRenderer instancedRenderer;
+
 	// Engine is focussed on rendering a single simulation scene for now
 	std::unique_ptr<Scene> scene;
 
 	// Time [in seconds] elapsed in Play mode since the GLFW Window associated to the application has been created
-	float elapsedPlayTime{ 0.0f };
+	double elapsedPlayTime{ 0.0 };
 	// Time [in seconds] elapsed in Pause mode since the GLFW Window associated to the application has been created
-	float elapsedPauseTime{ 0.0f };
+	double elapsedPauseTime{ 0.0 };
 
 	// Time cache [in seconds] to be able to compute Play delta time at next iteration
-	float lastFrameElapsedPlayTime{ 0.0f };
+	double lastFrameElapsedPlayTime{ 0.0 };
 	// Time cache [in seconds] to be able to compute Pause delta time at next iteration
-	float lastFrameElapsedPauseTime{ 0.0f };
+	double lastFrameElapsedPauseTime{ 0.0 };
+
+	// Transparent entity to draw, along with its squared distance to the camera as the bits of a positive float (ordered like the float itself)
+	struct TransparentDepthKey
+	{
+		uint32_t depthKey{ 0 };
+		EntityLocation location;
+	};
+
+	// Depth keys computed once per entity every frame, sorted in place (along with the buffer the radix sort scatters into)
+	std::vector<TransparentDepthKey> transparentDepthKeys;
+	std::vector<TransparentDepthKey> scatteredTransparentDepthKeys;
+
+	// Locations of transparent entities in the Component Store, from farthest to closest to the camera (rebuilt every frame)
+	std::vector<EntityLocation> transparentDrawOrder;
 
 	void Render(const float deltaTime);
 
-	// @todo - To be done only for entities in FOV
 	// Sort scene entities with level of transparency from farthest to closest according to camera, to render overlapping non-opaque objects correctly per frame
+	// (entities without Transform keep their order of addition, at the beginning). Entities drawing nothing this frame are left out (e.g. billboards
+	// while the legend is hidden), and the others are sorted by a radix sort on depth keys, in linear time whatever the amount of orbits/billboards
 	void OrderForTransparencyPass(const glm::vec3& cameraPosition);
 };
 
@@ -1,19 +1,23 @@
 #include "BeltEntity.h"
 
-#include <glm/mat4x4.hpp>
+#include <glm/geometric.hpp>
 #include <glm/trigonometric.hpp>
 #include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
 
-#include <cstdlib> // std::srand() and std::rand()
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <cstddef> // std::size_t
 #include <utility>
 
 #include "Application/Application.h"
-#include "CoreEngine.h"
-#include "Rendering/Renderer.h"
-#include "Rendering/Shader.h"
+#include "Cameras/Frustum.h"
 #include "Rendering/ShaderLoader.h"
-#include "Scene/Transform.h"
+#include "Utils/Constants.h"
+#include "Utils/CounterBasedRandom.h"
+#include "Utils/SIMDHelpers.h"
+#include "Utils/ThreadPool.h"
 
 
 
@@ -23,69 +27,239 @@ BeltEntity::BeltEntity(const std::string& inName, InstanceParams&& inInstancePar
 	torusParams(inTorusParams),
 	model(inInstanceParams.modelPath, ShaderLookUpID::Enum::BELT)
 {
-	ComputeInstanceTransforms();
-	StoreInstanceTransforms();
+	ComputeInstances(instanceParams, torusParams, instancePlacements, instanceRotationScaleColumns);
+	StoreInstances();
 }
 
-void BeltEntity::ComputeInstanceTransforms()
+BeltEntity::BeltEntity(const std::string& inName, InstanceParams&& inInstanceParams, TorusParams&& inTorusParams,
+	std::vector<glm::vec3>&& inInstancePlacements, std::vector<glm::vec4>&& inInstanceRotationScaleColumns) :
+	SceneEntity(inName),
+	instanceParams(inInstanceParams),
+	torusParams(inTorusParams),
+	instancePlacements(std::move(inInstancePlacements)),
+	instanceRotationScaleColumns(std::move(inInstanceRotationScaleColumns)),
+	model(inInstanceParams.modelPath, ShaderLookUpID::Enum::BELT)
+{
+	StoreInstances();
+}
+
+void BeltEntity::Regenerate(InstanceParams&& inInstanceParams, TorusParams&& inTorusParams)
+{
+	instanceParams = std::move(inInstanceParams);
+	torusParams = std::move(inTorusParams);
+
+	ComputeInstances(instanceParams, torusParams, instancePlacements, instanceRotationScaleColumns);
+	StoreInstances();
+}
+
+void BeltEntity::ComputeInstances(const InstanceParams& instanceParams, const TorusParams& torusParams,
+	std::vector<glm::vec3>& outPlacements, std::vector<glm::vec4>& outRotationScaleColumns)
 {
-	const float angleValue = 1.0f / instanceParams.count * 360.0f;
+	// Instances are spread evenly along the circle of radius majorRadius, so consecutive instances are neighbours on the torus
+	const float angleValue = GLMConstants::doublePi / static_cast<float>(instanceParams.count);
 
 	const float lowerBoundOffset = -torusParams.minorRadius;
 	const float upperBoundOffset = torusParams.minorRadius + 1.0f;
-	const int32_t rangeSpanOffset = static_cast<int32_t>(upperBoundOffset - lowerBoundOffset);
 
-	// Initialise random seed
-	std::srand(static_cast<uint32_t>(CoreEngine::GetInstance().GetElapsedTime()));
+	const float upperBoundScale = instanceParams.sizeRangeLowerBound + 0.01f * static_cast<float>(instanceParams.sizeRangeSpan);
+	const glm::vec3 rotationAxis(glm::normalize(glm::vec3(0.4f, 0.6f, 0.8f)));
 
-	transforms.reserve(instanceParams.count);
-	for (uint32_t i = 0; i < instanceParams.count; ++i)
+	outPlacements.resize(instanceParams.count);
+	outRotationScaleColumns.resize(static_cast<std::size_t>(instanceParams.count) * 3);
+
+	// Instances are computed by groups of SIMD lanes starting at multiples of the lane count (the last one being partially written),
+	// so every instance goes through the same computations whatever the way batches are split across threads
+	const std::size_t groupCount = (static_cast<std::size_t>(instanceParams.count) + SIMDHelpers::FLOAT_LANE_COUNT - 1) / SIMDHelpers::FLOAT_LANE_COUNT;
+	ThreadPool::GetInstance().ParallelFor(groupCount, MIN_INSTANCES_PER_THREAD / SIMDHelpers::FLOAT_LANE_COUNT, [&](const std::size_t begin, const std::size_t end)
 	{
-		Transform transform;
+		for (std::size_t group = begin; group < end; ++group)
+		{
+			const std::size_t firstInstance = group * SIMDHelpers::FLOAT_LANE_COUNT;
+			const std::size_t laneCount = std::min<std::size_t>(SIMDHelpers::FLOAT_LANE_COUNT, instanceParams.count - firstInstance);
+
+			std::array<CounterBasedRandom::Block, SIMDHelpers::FLOAT_LANE_COUNT> placementNumbers;
+			alignas(16) std::array<float, SIMDHelpers::FLOAT_LANE_COUNT> angles;
+			alignas(16) std::array<float, SIMDHelpers::FLOAT_LANE_COUNT> rotAngles;
+			for (std::size_t lane = 0; lane < SIMDHelpers::FLOAT_LANE_COUNT; ++lane)
+			{
+				const std::size_t i = firstInstance + lane;
+				placementNumbers[lane] = CounterBasedRandom::Generate(instanceParams.seed, i, PLACEMENT_RANDOM_BLOCK);
+
+				angles[lane] = static_cast<float>(i) * angleValue;
+
+				// Rotate instance by an angle in range [0, 2 Pi[ around a pre-determined axis
+				const CounterBasedRandom::Block rotationNumbers = CounterBasedRandom::Generate(instanceParams.seed, i, ROTATION_RANDOM_BLOCK);
+				rotAngles[lane] = CounterBasedRandom::ToRange(rotationNumbers[0], 0.0f, GLMConstants::doublePi);
+			}
+
+			alignas(16) std::array<float, SIMDHelpers::FLOAT_LANE_COUNT> sinAngles;
+			alignas(16) std::array<float, SIMDHelpers::FLOAT_LANE_COUNT> cosAngles;
+			alignas(16) std::array<float, SIMDHelpers::FLOAT_LANE_COUNT> sinRotAngles;
+			alignas(16) std::array<float, SIMDHelpers::FLOAT_LANE_COUNT> cosRotAngles;
+#if SIMD_SSE2_ENABLED
+			__m128 sines;
+			__m128 cosines;
+			SIMDHelpers::SinCos(_mm_load_ps(angles.data()), sines, cosines);
+			_mm_store_ps(sinAngles.data(), sines);
+			_mm_store_ps(cosAngles.data(), cosines);
+
+			SIMDHelpers::SinCos(_mm_load_ps(rotAngles.data()), sines, cosines);
+			_mm_store_ps(sinRotAngles.data(), sines);
+			_mm_store_ps(cosRotAngles.data(), cosines);
+#else
+			for (std::size_t lane = 0; lane < SIMDHelpers::FLOAT_LANE_COUNT; ++lane)
+			{
+				sinAngles[lane] = glm::sin(angles[lane]);
+				cosAngles[lane] = glm::cos(angles[lane]);
+				sinRotAngles[lane] = glm::sin(rotAngles[lane]);
+				cosRotAngles[lane] = glm::cos(rotAngles[lane]);
+			}
+#endif
 
-		const float angle = i * angleValue;
+			for (std::size_t lane = 0; lane < laneCount; ++lane)
+			{
+				const std::size_t i = firstInstance + lane;
 
-		const float xOffset = lowerBoundOffset + static_cast<float>(std::rand() % rangeSpanOffset);
-		const float x = glm::sin(angle) * torusParams.majorRadius + xOffset;
+				// Move instance along circle of radius majorRadius, by an offset in range [-minorRadius, minorRadius + 1[ along each axis
+				const float xOffset = CounterBasedRandom::ToRange(placementNumbers[lane][0], lowerBoundOffset, upperBoundOffset);
+				const float x = sinAngles[lane] * torusParams.majorRadius + xOffset;
 
-		// Keep height of model field smaller compared to width of x and z
-		const float yOffset = lowerBoundOffset + static_cast<float>(std::rand() % rangeSpanOffset);
-		const float y = yOffset * torusParams.flatnessFactor;
+				// Keep height of model field smaller compared to width of x and z
+				const float yOffset = CounterBasedRandom::ToRange(placementNumbers[lane][1], lowerBoundOffset, upperBoundOffset);
+				const float y = yOffset * torusParams.flatnessFactor;
 
-		const float zOffset = lowerBoundOffset + static_cast<float>(std::rand() % rangeSpanOffset);
-		const float z = glm::cos(angle) * torusParams.majorRadius + zOffset;
+				const float zOffset = CounterBasedRandom::ToRange(placementNumbers[lane][2], lowerBoundOffset, upperBoundOffset);
+				const float z = cosAngles[lane] * torusParams.majorRadius + zOffset;
 
-		// Move instance along circle of radius majorRadius in [-minorRadius, minorRadius]
-		// (added the range lower bound to the random number modulo by the range span to get a random value in range [lowerBound, lowerBound + rangeSpan])
-		transform.Translate(glm::vec3(x, y, z));
+				outPlacements[i] = glm::vec3(x, y, z);
 
-		// Resize instance in range [sizeRangeLowerBound, "sizeRangeLowerBound + 0.sizeRangeSpan"]
-		const float scale = instanceParams.sizeRangeLowerBound + 0.01f * static_cast<float>(std::rand() % instanceParams.sizeRangeSpan);
-		transform.Scale(glm::vec3(scale));
+				// Resize instance in range [sizeRangeLowerBound, "sizeRangeLowerBound + 0.sizeRangeSpan"[
+				const float scale = CounterBasedRandom::ToRange(placementNumbers[lane][3], instanceParams.sizeRangeLowerBound, upperBoundScale);
 
-		// Rotate instance by num degrees in range [0, 360] around a pre-determined axis
-		const float rotAngle = static_cast<float>(std::rand() % 361);
-		transform.Rotate(rotAngle, glm::vec3(0.4f, 0.6f, 0.8f));
+				// Scaled rotation matrix (Rodrigues' formula, i.e. what glm::rotate() computes, without normalising the axis each time)
+				const float cosAngle = cosRotAngles[lane];
+				const glm::vec3 axisSin = rotationAxis * sinRotAngles[lane];
+				const glm::vec3 axisOneMinusCos = rotationAxis * (1.0f - cosAngle);
 
-		// Add current model matrix to the list
-		transforms.push_back(std::move(transform));
+				glm::vec4* const columns = &outRotationScaleColumns[i * 3];
+				columns[0] = scale * glm::vec4(axisOneMinusCos.x * rotationAxis.x + cosAngle, axisOneMinusCos.x * rotationAxis.y + axisSin.z, axisOneMinusCos.x * rotationAxis.z - axisSin.y, 0.0f);
+				columns[1] = scale * glm::vec4(axisOneMinusCos.y * rotationAxis.x - axisSin.z, axisOneMinusCos.y * rotationAxis.y + cosAngle, axisOneMinusCos.y * rotationAxis.z + axisSin.x, 0.0f);
+				columns[2] = scale * glm::vec4(axisOneMinusCos.z * rotationAxis.x + axisSin.y, axisOneMinusCos.z * rotationAxis.y - axisSin.x, axisOneMinusCos.z * rotationAxis.z + cosAngle, 0.0f);
+			}
+		}
+	});
+}
+
+void BeltEntity::StoreInstances()
+{
+	model.StoreInstances(instanceRotationScaleColumns);
+
+	// Rotation columns being unit vectors, the length of the first scaled column is the instance scale
+	float maxSquaredScale = 0.0f;
+	for (std::size_t i = 0; i < instanceRotationScaleColumns.size(); i += 3)
+	{
+		maxSquaredScale = std::max(maxSquaredScale, glm::dot(instanceRotationScaleColumns[i], instanceRotationScaleColumns[i]));
 	}
+	instanceBoundingRadius = model.ComputeBoundingRadius() * std::sqrt(maxSquaredScale);
+
+	// Chunks are drawn until the next culling pass
+	const std::size_t chunkCount = (static_cast<std::size_t>(instanceParams.count) + INSTANCES_PER_CHUNK - 1) / INSTANCES_PER_CHUNK;
+	chunkCentersX.resize(chunkCount);
+	chunkCentersY.resize(chunkCount);
+	chunkCentersZ.resize(chunkCount);
+	chunkRadii.resize(chunkCount);
+	chunkVisibilityFlags.assign(chunkCount, 1);
+
+	UpdateChunkBounds(instancePlacements.data());
+}
+
+void BeltEntity::StreamInstancePositions(const glm::vec3* positions)
+{
+	glm::vec3* const instancePositions = model.BeginInstancePositionsUpdate();
+	std::copy(positions, positions + instanceParams.count, instancePositions);
+	model.EndInstancePositionsUpdate();
+
+	UpdateChunkBounds(positions);
+}
+
+void BeltEntity::UpdateChunkBounds(const glm::vec3* positions)
+{
+	ThreadPool::GetInstance().ParallelFor(chunkRadii.size(), MIN_INSTANCES_PER_THREAD / INSTANCES_PER_CHUNK, [&](const std::size_t begin, const std::size_t end)
+	{
+		for (std::size_t chunk = begin; chunk < end; ++chunk)
+		{
+			const std::size_t firstInstance = chunk * INSTANCES_PER_CHUNK;
+			const std::size_t endInstance = std::min<std::size_t>(firstInstance + INSTANCES_PER_CHUNK, instanceParams.count);
+
+			// Centered on the box bounding the chunk instances, which is tighter than their mean position for arcs
+			glm::vec3 minPosition = positions[firstInstance];
+			glm::vec3 maxPosition = positions[firstInstance];
+			for (std::size_t i = firstInstance + 1; i < endInstance; ++i)
+			{
+				minPosition = glm::min(minPosition, positions[i]);
+				maxPosition = glm::max(maxPosition, positions[i]);
+			}
+			const glm::vec3 center = 0.5f * (minPosition + maxPosition);
+
+			float maxSquaredDistance = 0.0f;
+			for (std::size_t i = firstInstance; i < endInstance; ++i)
+			{
+				const glm::vec3 centerToInstance = positions[i] - center;
+				maxSquaredDistance = std::max(maxSquaredDistance, glm::dot(centerToInstance, centerToInstance));
+			}
+
+			chunkCentersX[chunk] = center.x;
+			chunkCentersY[chunk] = center.y;
+			chunkCentersZ[chunk] = center.z;
+			chunkRadii[chunk] = std::sqrt(maxSquaredDistance) + instanceBoundingRadius;
+		}
+	});
 }
 
-void BeltEntity::StoreInstanceTransforms() const
+EntityComponents BeltEntity::GetComponents()
 {
-	model.StoreInstanceTransforms(transforms);
+	EntityComponents components;
+	components.Add(ComponentType::MESH);
+	components.mesh = this;
+
+	components.Add(ComponentType::MATERIAL);
+	components.material = &model.GetMaterials()[0];
+
+	components.Add(ComponentType::INSTANCE_CHUNKS);
+	components.chunkedInstances = this;
+
+	return components;
+}
+
+void BeltEntity::CullChunks(const Frustum& frustum)
+{
+	frustum.IntersectSpheres(chunkCentersX.data(), chunkCentersY.data(), chunkCentersZ.data(), chunkRadii.data(), chunkRadii.size(), chunkVisibilityFlags.data());
 }
 
 void BeltEntity::Render()
 {
-	const Material& modelMaterial = model.GetMaterials()[0];
-	const Shader& shader = modelMaterial.GetShader();
-	shader.Enable();
+	// Chunks being consecutive ranges of instances, a run of visible chunks is drawn with a single draw call
+	const std::size_t chunkCount = chunkVisibilityFlags.size();
+	std::size_t chunk = 0;
+	while (chunk < chunkCount)
+	{
+		if (chunkVisibilityFlags[chunk] == 0)
+		{
+			++chunk;
+			continue;
+		}
 
-	modelMaterial.EnableTextures();
-	model.RenderInstances(instanceParams.count);
-	modelMaterial.DisableTextures();
+		const std::size_t firstChunk = chunk;
+		while (chunk < chunkCount && chunkVisibilityFlags[chunk] != 0)
+		{
+			++chunk;
+		}
+
+		const uint32_t firstInstance = static_cast<uint32_t>(firstChunk * INSTANCES_PER_CHUNK);
+		const uint32_t endInstance = std::min(static_cast<uint32_t>(chunk * INSTANCES_PER_CHUNK), instanceParams.count);
+		model.RenderInstances(firstInstance, endInstance - firstInstance);
+	}
 
-	shader.Disable();
+	// Positions drawn from must not be overwritten until the GPU is done with them
+	model.FenceInstancePositions();
 }
@@ -1,6 +1,10 @@
 #ifndef BELT_H
 #define BELT_H
 
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include <cstddef> // std::size_t
 #include <cstdint>
 #include <filesystem>
 #include <string>
@@ -21,6 +25,9 @@ struct InstanceParams
 	// Range from where a random number will be picked from to determine the model size
 	float sizeRangeLowerBound{ 0.0f };
 	uint32_t sizeRangeSpan{ 0 };
+
+	// Key of the random numbers of every instance, so the same belt is built whatever the run or the amount of threads
+	uint64_t seed{ 0 };
 };
 
 // Torus built with instances (not with vertices like a real geometrical shape)
@@ -36,27 +43,79 @@ struct TorusParams
 	float flatnessFactor{ 0.0f };
 };
 
-class Transform;
-
-class BeltEntity : public SceneEntity, public IRenderable
+class BeltEntity : public SceneEntity, public IRenderable, public IChunkedInstances
 {
 public:
+	// Minimum amount of instances per batch when splitting their placement across threads
+	static constexpr std::size_t MIN_INSTANCES_PER_THREAD = 16384;
+
+	// Instances per chunk culled as a whole: consecutive instances being spread along the torus, a chunk is an arc of it
+	static constexpr uint32_t INSTANCES_PER_CHUNK = 512;
+
+	// Index of the random blocks (4 numbers each) drawn per instance out of the belt seed: one per user, so numbers never overlap
+	static constexpr uint32_t PLACEMENT_RANDOM_BLOCK = 0;
+	static constexpr uint32_t ROTATION_RANDOM_BLOCK = 1;
+	static constexpr uint32_t ORBIT_RANDOM_BLOCK = 2;
+
 	BeltEntity(const std::string& inName, InstanceParams&& inInstanceParams, TorusParams&& inTorusParams);
 
-	// IRenderable implementation
+	// Reuse instances computed beforehand out of the same parameters (e.g. restored from a snapshot), instead of computing them again
+	BeltEntity(const std::string& inName, InstanceParams&& inInstanceParams, TorusParams&& inTorusParams,
+		std::vector<glm::vec3>&& inInstancePlacements, std::vector<glm::vec4>&& inInstanceRotationScaleColumns);
+
+	// Made of the instanced rock Model and its baked-in material (no Transform, instances being placed in World Space), culled chunk by chunk
+	EntityComponents GetComponents() override;
+
+	// IRenderable implementation - Draw runs of consecutive visible chunks
 	void Render() override;
 	// IRenderable implementation
 
+	// IChunkedInstances implementation
+	void CullChunks(const Frustum& frustum) override;
+	// IChunkedInstances implementation
+
+	// Place instances again out of new parameters (e.g. after belt data has been edited), the rock Model staying loaded (its path being expected unchanged)
+	void Regenerate(InstanceParams&& inInstanceParams, TorusParams&& inTorusParams);
+
+	const InstanceParams& GetInstanceParams() const { return instanceParams; }
+	const TorusParams& GetTorusParams() const { return torusParams; }
+
+	// Placement of each instance on the torus when the belt is created
+	const std::vector<glm::vec3>& GetInstancePlacements() const { return instancePlacements; }
+	const std::vector<glm::vec4>& GetInstanceRotationScaleColumns() const { return instanceRotationScaleColumns; }
+
+	// Compute the placement and the first 3 Model matrix columns (rotation/scale) of every instance: instance i only depending on the seed and i,
+	// batches of instances are computed in parallel, and the same belt is produced bit-identically by every run
+	static void ComputeInstances(const InstanceParams& instanceParams, const TorusParams& torusParams,
+		std::vector<glm::vec3>& outPlacements, std::vector<glm::vec4>& outRotationScaleColumns);
+
+	// Stream the position of every instance for the next frames (one position per instance expected, rotation/scale staying the ones of the torus placement),
+	// and bound chunks again around them (rocks at different distances orbiting at different speeds, chunks slowly spread along the torus)
+	void StreamInstancePositions(const glm::vec3* positions);
+
 private:
 	InstanceParams instanceParams;
 	TorusParams torusParams;
-	std::vector<Transform> transforms;
+	std::vector<glm::vec3> instancePlacements;
+	std::vector<glm::vec4> instanceRotationScaleColumns;
 
 	// Model used to represent a Belt "Rock" for instancing (contains the Mesh + the baked-in Material definition, as opposed to traditional SceneEntities)
 	Model model;
 
-	void ComputeInstanceTransforms();
-	void StoreInstanceTransforms() const;
+	// Radius of the sphere enclosing any instance around its position, i.e. the rock Model scaled by the largest instance scale
+	float instanceBoundingRadius{ 0.0f };
+
+	// Bounding sphere of each chunk in World space (Structure-of-Arrays, so they are tested several at once), and whether it is in the camera frustum
+	std::vector<float> chunkCentersX;
+	std::vector<float> chunkCentersY;
+	std::vector<float> chunkCentersZ;
+	std::vector<float> chunkRadii;
+	std::vector<uint8_t> chunkVisibilityFlags;
+
+	void StoreInstances();
+
+	// Compute the bounding sphere of every chunk out of the position of every instance
+	void UpdateChunkBounds(const glm::vec3* positions);
 };
 
 
@@ -1,19 +1,12 @@
 #include "BillboardEntity.h"
 
-#include <glm/geometric.hpp>
-#include <glm/vec4.hpp>
-#include <glm/vec3.hpp>
-
 #include <cstdint>
 #include <iostream>
 #include <utility>
 #include <vector>
 
 #include "Application/Application.h"
-#include "Cameras/Camera.h"
 #include "CelestialBodyEntity.h"
-#include "Rendering/Renderer.h"
-#include "Rendering/Shader.h"
 #include "Rendering/ShaderLoader.h"
 #include "Rendering/GlyphLoader.h"
 #include "Rendering/Texture.h"
@@ -36,8 +29,8 @@ namespace
 BillboardEntity::BillboardEntity(const BodyData& inBodyData) :
 	SceneEntity(inBodyData.name + "Billboard"),
 	legend(inBodyData.name),
-	glyphTextureScaleFactor(inBodyData.radius * (parentID != 0 ? moonGlyphTextureScaleFactor : bodyGlyphTextureScaleFactor)),
-	quads(ComputeQuadParams(0.0f, inBodyData.radius * (parentID != 0 ? moonBilboardYStartScaleFactor : bodyBilboardYStartScaleFactor))),
+	glyphTextureScaleFactor(inBodyData.radius * (parentHandle.IsValid() ? moonGlyphTextureScaleFactor : bodyGlyphTextureScaleFactor)),
+	quads(ComputeQuadParams(0.0f, inBodyData.radius * (parentHandle.IsValid() ? moonBilboardYStartScaleFactor : bodyBilboardYStartScaleFactor))),
 	material(InitialiseMaterial(""))
 {
 
@@ -49,24 +42,22 @@ BlinnPhongMaterial BillboardEntity::InitialiseMaterial(const std::filesystem::pa
 	return BlinnPhongMaterial(ShaderLookUpID::Enum::BILLBOARD, std::vector<Texture>{ /* texturesLoadedFromTheGlyphLoader */ }, DiffuseProperties{ GLMConstants::whiteColour });
 }
 
-void BillboardEntity::ComputeTransformVUniform(const float /*deltaTime*/, const Camera& camera, std::optional<std::reference_wrapper<const ITransformable>> parentTransformable)
+EntityComponents BillboardEntity::GetComponents()
 {
-	if (Application::GetInstance().IsLegendDisplayed() == false)
-	{
-		return;
-	}
+	EntityComponents components;
+	components.Add(ComponentType::TRANSFORM);
+	components.Add(ComponentType::BILLBOARD);
 
-	transform.Reset();
+	components.Add(ComponentType::MESH);
+	components.mesh = this;
 
-	const glm::vec3 parentEntityPosition(parentTransformable.value().get().GetTransform().GetPosition());
+	components.Add(ComponentType::MATERIAL);
+	components.material = &material;
 
-	// Orient text billboards so the correct side (i.e. with the glyphs rendered in the correct direction) always faces the camera (~ look at)
-	const glm::vec3& billboardForward = glm::normalize(camera.GetPosition() - parentEntityPosition);
-	const glm::vec3& billboardRight = glm::cross(camera.GetTransform().GetUpVector(), billboardForward);
-	const glm::vec3& billboardUp = glm::cross(billboardForward, billboardRight);
+	components.Add(ComponentType::BOUNDS);
+	components.boundingRadius = quads.ComputeBoundingRadius();
 
-	transform.SetPosition(parentEntityPosition);
-	transform.SetRotation(RotationMatrix{ billboardRight, billboardUp, billboardForward });
+	return components;
 }
 
 std::vector<QuadParams> BillboardEntity::ComputeQuadParams(const float billboardXStart, const float billboardYStart)
@@ -128,12 +119,5 @@ void BillboardEntity::Render()
 		return;
 	}
 
-	const Shader& shader = material.GetShader();
-	shader.Enable();
-
-	Renderer::SetTransformVUniform(shader, transform);
-
 	quads.RenderGlyphs(legend, textureUnit);
-
-	shader.Disable();
 }
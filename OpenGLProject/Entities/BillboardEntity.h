@@ -2,27 +2,27 @@
 #define BILLBOARD_H
 
 #include <filesystem>
-#include <functional>
 #include <string>
 #include <vector>
 
 #include "Components/Meshes/QuadMeshComponent.h"
 #include "Rendering/BlinnPhongMaterial.h"
 #include "Scene/SceneEntity.h"
-#include "Scene/Transform.h"
 
 struct BodyData;
-class Camera;
 struct GlyphParams;
 
 
 
 // Create set of quads according to FreeType glyph texture and parameters retrieved out of the Glyph Loader
-class BillboardEntity : public SceneEntity, public ITransformable, public IRenderable
+class BillboardEntity : public SceneEntity, public IRenderable
 {
 public:
 	BillboardEntity(const BodyData& inBodyData);
 
+	// Made of a Transform facing the camera at the parent position, glyph quads and their material
+	EntityComponents GetComponents() override;
+
 	// IRenderable implementation
 	void Render() override;
 	// IRenderable implementation
@@ -38,12 +38,6 @@ private:
 	BlinnPhongMaterial material;
 	BlinnPhongMaterial InitialiseMaterial(const std::filesystem::path& texturePath);
 
-	Transform transform;
-	// ITransformable implementation
-	const Transform& GetTransform() const override { return transform; }
-	void ComputeTransformVUniform(const float deltaTime, const Camera& camera, std::optional<std::reference_wrapper<const ITransformable>> parentTransformable = std::nullopt) override;
-	// ITransformable implementation
-
 	// Sum up all the glyph advance values, as per FreeType convention (i.e. the width needed each glyph to be rendered, inclusive of horizontal spacing)
 	float ComputeBillboardWidth() const;
 
@@ -2,11 +2,9 @@
 
 //#include <glm/vec3.hpp>
 
-#include "Cameras/Camera.h"
 #include "Rendering/BlinnPhongMaterial.h"
-#include "Rendering/Renderer.h"
-#include "Rendering/Shader.h"
 #include "Rendering/ShaderLoader.h"
+#include "Scene/Transform.h"
 #include "Utils/Constants.h"
 
 
@@ -20,28 +18,32 @@ BodyRingsEntity::BodyRingsEntity(RingsData&& inRingsData) :
 
 }
 
-void BodyRingsEntity::ComputeTransformVUniform(const float /*deltaTime*/, const Camera& /*camera*/, std::optional<std::reference_wrapper<const ITransformable>> parentTransformable)
+EntityComponents BodyRingsEntity::GetComponents()
 {
-	transform.Set(parentTransformable.value().get().GetTransform().Get());
+	// Rotate (constant over time) around axis colinear to orbital plane and normal to orbital trajectory, the parent body Model matrix being applied on top
+	Transform localTransform;
+	localTransform.Rotate(-GLMConstants::halfPi, WorldSpace::XUnitVector);
 
 	// @todo - Make this model scaling work after it has been set in 3D modeling software
-	// transform.Scale(glm::vec3(ringsData.radius));
+	// localTransform.Scale(glm::vec3(ringsData.radius));
 
-	// Rotate (constant over time) around axis colinear to orbital plane and normal to orbital trajectory
-	transform.Rotate(-GLMConstants::halfPi, WorldSpace::XUnitVector);
+	EntityComponents components;
+	components.Add(ComponentType::TRANSFORM);
+	components.localMatrix = localTransform.Get();
+
+	components.Add(ComponentType::MESH);
+	components.mesh = this;
+
+	components.Add(ComponentType::MATERIAL);
+	components.material = &model.GetMaterials()[0];
+
+	components.Add(ComponentType::BOUNDS);
+	components.boundingRadius = model.ComputeBoundingRadius();
+
+	return components;
 }
 
 void BodyRingsEntity::Render()
 {
-	const BlinnPhongMaterial& modelMaterial = model.GetMaterials()[0];
-	const Shader& shader = modelMaterial.GetShader();
-	shader.Enable();
-
-	Renderer::SetTransformVUniform(shader, transform);
-
-	modelMaterial.EnableTextures();
 	model.Render();
-	modelMaterial.DisableTextures();
-
-	shader.Disable();
 }
@@ -2,18 +2,13 @@
 #define BODY_RINGS_H
 
 #include <filesystem>
-#include <functional>
-#include <optional>
 #include <string>
 
 #include "Models/Model.h"
 #include "Scene/SceneEntity.h"
-#include "Scene/Transform.h"
 
 
 
-class Camera;
-
 struct RingsData
 {
 	std::filesystem::path modelPath;
@@ -21,11 +16,16 @@ struct RingsData
 	float radius{ 0.0f };
 };
 
-class BodyRingsEntity : public SceneEntity, public ITransformable, public IRenderable
+class BodyRingsEntity : public SceneEntity, public IRenderable
 {
 public:
 	BodyRingsEntity(RingsData&& inRingsData);
 
+	// Made of a Transform relative to the parent body, and the ring Model (drawn with its baked-in material)
+	EntityComponents GetComponents() override;
+
+	const RingsData& GetRingsData() const { return ringsData; }
+
 	// IRenderable implementation
 	void Render() override;
 	// IRenderable implementation
@@ -36,12 +36,6 @@ private:
 	// Model used for the Celestial Body "Ring" (contains the Mesh + the baked-in Material definition, as opposed to traditional SceneEntities)
 	Model model;
 
-	Transform transform;
-	// ITransformable implementation
-	const Transform& GetTransform() const override { return transform; }
-	void ComputeTransformVUniform(const float deltaTime, const Camera& camera, std::optional<std::reference_wrapper<const ITransformable>> parentTransformable = std::nullopt) override;
-	// ITransformable implementation
-
 	std::string bodyParent;
 };
 
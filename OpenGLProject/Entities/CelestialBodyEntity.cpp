@@ -1,131 +1,100 @@
 #include "CelestialBodyEntity.h"
 
-#include <glad/glad.h>
-#include <glm/trigonometric.hpp>
-
-#include <utility>
 #include <vector>
 
-#include "Application/Application.h"
-#include "Cameras/Camera.h"
-#include "Components/Lights/LightSourceComponent.h"
 #include "Components/Lights/PointLightComponent.h"
-#include "Rendering/Renderer.h"
-#include "Rendering/Shader.h"
+#include "Components/Meshes/MeshLibrary.h"
+#include "Components/Meshes/SphereMeshComponent.h"
 #include "Rendering/ShaderLoader.h"
 #include "Rendering/Texture.h"
+#include "Simulation/CelestialBodyTable.h"
 #include "Utils/Constants.h"
 
 
 
-CelestialBodyEntity::CelestialBodyEntity(const BodyData& inBodyData) :
+CelestialBodyEntity::CelestialBodyEntity(const BodyData& inBodyData, const CelestialBodyTable& inBodyTable, const uint32_t inBodyIndex) :
 	SceneEntity(inBodyData.name),
-	bodyData(std::move(inBodyData)),
-	sphere(bodyData.radius),
-	material(InitialiseMaterial(bodyData.texturePath))
+	bodyData(inBodyData),
+	textureLayer(TextureArrayLibrary::AddDDS(bodyData.texturePath)),
+	material(InitialiseMaterial()),
+	bodyTable(inBodyTable),
+	bodyIndex(inBodyIndex)
 {
 	if (bodyData.type == "Star")
 	{
 		// Set up the lighting for all Scene Entities according to Star position/light emission parameters
-		lightSource = std::make_unique<PointLightComponent>(GetPosition(),
+		lightSource.emplace(GetPosition(),
 			ReflectionParams{ glm::vec3(0.25f), glm::vec3(0.95f), glm::vec3(0.0f) },
 			AttenuationParams{ 1.0f, 0.00045f, 0.00000075f });
 	}
-
-	orbitAngularFreq = bodyData.orbitalPeriod == 0.0f ? 0.0f : GLMConstants::doublePi * 1.0f / bodyData.orbitalPeriod;
-	spinAngularFreq = bodyData.spinPeriod == 0.0f ? 0.0f : GLMConstants::doublePi * 1.0f / bodyData.spinPeriod;
-
-	obliquityInRad = glm::radians(bodyData.obliquity);
-
-	const float orbitalInclinationInRad = glm::radians(bodyData.orbitalInclination);
-	distCosOrbInclination = bodyData.distanceToParent * glm::cos(orbitalInclinationInRad);
-	distSinOrbInclination = bodyData.distanceToParent * glm::sin(orbitalInclinationInRad);
 }
 
-BlinnPhongMaterial CelestialBodyEntity::InitialiseMaterial(const std::filesystem::path& texturePath)
+CelestialBodyEntity::~CelestialBodyEntity()
 {
-	Texture texture(texturePath, GL_TEXTURE_2D, { GL_REPEAT }, { GL_LINEAR }, TextureType::Enum::DIFFUSE);
-	texture.LoadDDS();
+	TextureArrayLibrary::RemoveLayer(textureLayer);
+}
 
+BlinnPhongMaterial CelestialBodyEntity::InitialiseMaterial() const
+{
+	// No Texture2D of its own: the texture array holding the body texture is bound by the Instanced Renderer for the whole batch
 	if (bodyData.type == "Star")
 	{
 		// Allow the Star texture to be rendered with higher intensity than a simple white light - give volcanic visual effect)
 		constexpr float oversaturatingFactor = 1.5f;
-		return BlinnPhongMaterial(ShaderLookUpID::Enum::STAR, std::vector<Texture>{ std::move(texture) }, DiffuseProperties{ GLMConstants::whiteColour * oversaturatingFactor });
+		return BlinnPhongMaterial(ShaderLookUpID::Enum::STAR, std::vector<Texture>{}, DiffuseProperties{ GLMConstants::whiteColour * oversaturatingFactor });
 	}
 	else
 	{
-		return BlinnPhongMaterial(ShaderLookUpID::Enum::DEFAULT, std::vector<Texture>{ std::move(texture) });
+		return BlinnPhongMaterial(ShaderLookUpID::Enum::BODY, std::vector<Texture>{});
 	}
 }
 
-void CelestialBodyEntity::ComputeTransformVUniform(const float deltaTime, const Camera& /*camera*/, std::optional<std::reference_wrapper<const ITransformable>> parentTransformable)
+EntityComponents CelestialBodyEntity::GetComponents()
 {
-	// @todo - Can we avoid redoing the computation all time from scratch and just add delta transform?
-	transform.Reset();
+	EntityComponents components;
+	components.Add(ComponentType::TRANSFORM);
 
-	const float alteredDeltaTime = deltaTime * Application::GetInstance().GetSpeedFactor();
+	components.Add(ComponentType::SPIN);
+	components.bodyTable = &bodyTable;
+	components.bodyIndex = bodyIndex;
 
-	ComputeCartesianPosition(alteredDeltaTime, parentTransformable);
+	components.Add(ComponentType::INSTANCED_MESH);
+	components.instancedMesh = this;
+	components.textureArrayIndex = textureLayer.arrayIndex;
+	components.textureLayer = textureLayer.layer;
 
-	transform.Translate(position);
+	components.Add(ComponentType::MESH_SCALE);
+	components.meshScale = bodyData.radius;
 
-	// Rotate the body (constant over time) around an axis colinear to orbital plane and tangent to orbital trajectory to reproduce its axial tilt
-	transform.Rotate(obliquityInRad, WorldSpace::ZUnitVector);
+	components.Add(ComponentType::MATERIAL);
+	components.material = &material;
 
-	// Angle travelled by the celestial body around itself for the current frame [in radians]
-	travelledSpinAngle += spinAngularFreq * alteredDeltaTime;
+	components.Add(ComponentType::BOUNDS);
+	components.boundingRadius = bodyData.radius;
 
-	// Rotate the body (non-constant over time) around axis normal to orbital plane to reproduce its spin
-	transform.Rotate(travelledSpinAngle, WorldSpace::YUnitVector);
+	components.Add(ComponentType::DETAIL_LEVELS);
+	components.detailLevels = this;
 
-	// Rotate the body (constant over time) around axis colinear to orbital plane and normal to orbital trajectory so its poles appear vertically
-	transform.Rotate(GLMConstants::halfPi, WorldSpace::XUnitVector);
-}
-
-void CelestialBodyEntity::ComputeCartesianPosition(const float deltaTime, std::optional<std::reference_wrapper<const ITransformable>> parentTransformable)
-{
-	position = glm::vec3(0.0f);
-
-	// Angle travelled by Planet (resp. Moon) around Star (resp. Planet) since the simulation started [in radians]
-	travelledOrbitAngle += orbitAngularFreq * deltaTime;
-	if (parentID == 0 || parentTransformable.has_value() == false)
+	if (lightSource.has_value())
 	{
-		travelledAngle = travelledOrbitAngle;
+		components.Add(ComponentType::LIGHT_SOURCE);
+		components.lightSource = &*lightSource;
 	}
-	// Circular translation of satellite around corresponding planet, taking into account satellite "orbital tilt"
-	else
-	{
-		// Warning: assumes body pointer is valid!
-		const CelestialBodyEntity& satelliteParentBodyRef = *dynamic_cast<const CelestialBodyEntity*>(&parentTransformable.value().get());
-
-		const float sinTravelledAngleParent = glm::sin(satelliteParentBodyRef.travelledAngle);
-
-		position += glm::vec3(
-			satelliteParentBodyRef.distCosOrbInclination * sinTravelledAngleParent,
-			satelliteParentBodyRef.distSinOrbInclination * sinTravelledAngleParent,
-			satelliteParentBodyRef.bodyData.distanceToParent * glm::cos(satelliteParentBodyRef.travelledAngle));
-	}
-
-	// Circular translation of body around Star, taking into account body "orbital tilt"
-	const float sinTravelledAngle = glm::sin(travelledOrbitAngle);
 
-	position += glm::vec3(
-		distCosOrbInclination * sinTravelledAngle,
-		distSinOrbInclination * sinTravelledAngle,
-		bodyData.distanceToParent * glm::cos(travelledOrbitAngle));
+	return components;
 }
 
-void CelestialBodyEntity::Render()
+glm::vec3 CelestialBodyEntity::GetPosition() const
 {
-	const Shader& shader = material.GetShader();
-	shader.Enable();
-
-	Renderer::SetTransformVUniform(shader, transform);
+	return bodyTable.GetPosition(bodyIndex);
+}
 
-	material.EnableTextures();
-	sphere.Render();
-	material.EnableTextures();
+void CelestialBodyEntity::SelectDetailLevel(const float projectedScreenRadius)
+{
+	sphereLOD = SphereMeshComponent::SelectLOD(projectedScreenRadius, sphereLOD);
+}
 
-	shader.Disable();
+const MeshComponent& CelestialBodyEntity::GetInstancedMesh() const
+{
+	return MeshLibrary::GetUnitSphere(sphereLOD);
 }
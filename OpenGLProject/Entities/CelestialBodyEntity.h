@@ -3,19 +3,17 @@
 
 #include <glm/vec3.hpp>
 
+#include <cstdint>
 #include <filesystem>
-#include <functional>
-#include <memory>
 #include <optional>
 #include <string>
 
-#include "Components/Meshes/SphereMeshComponent.h"
+#include "Components/Lights/PointLightComponent.h"
 #include "Rendering/BlinnPhongMaterial.h"
-#include "Scene/Transform.h"
+#include "Rendering/TextureArrayLibrary.h"
 #include "SceneEntity.h"
 
-class Camera;
-class LightSourceComponent;
+class CelestialBodyTable;
 
 
 
@@ -32,17 +30,23 @@ struct BodyData
 	float orbitalPeriod{ 0.0f };			// Time (sideral) the planet (resp. moon) takes to do one revolution around the star (resp. its planet) [in Main Planet days]
 	float spinPeriod{ 0.0f };				// Time (sideral) the planet takes to do a rotation on itself [in Main Planet days]	
 	float orbitalInclination{ 0.0f };		// Or "orbital tilt": angle between planet (resp. moon) orbit and the ecliptic [in degrees]
+	float eccentricity{ 0.0f };				// Deviation of the orbit from a circle, in [0, 1[ (distance to parent being the semi-major axis of the ellipse)
+	float longitudeOfAscendingNode{ 0.0f };	// Angle between the vernal equinox direction and the point where the orbit crosses the ecliptic northward [in degrees]
+	float argumentOfPeriapsis{ 0.0f };		// Angle between the ascending node and the point of the orbit closest to the parent, in the orbital plane [in degrees]
+	float meanAnomalyAtEpoch{ 0.0f };		// Fraction of the orbital period elapsed since periapsis when the simulation starts, as an angle [in degrees]
+	float mass{ 0.0f };						// Mass of the body, 0 when negligible/unknown (body then not attracting others in N-Body mode) [in kg]
 };
 
 // Represent a spherical mesh body, e.g. a planet, a dwarf planet or a moon
-class CelestialBodyEntity : public SceneEntity, public ITransformable, public IRenderable
+class CelestialBodyEntity : public SceneEntity, public IInstancedRenderable, public IDetailLevels
 {
 public:
 	// Default constructor (not needed)
 	CelestialBodyEntity() = delete;
 
 	// User-defined constructor (to be used when building a CelestialBody in-place from initialisation-list)
-	CelestialBodyEntity(const BodyData& inBodyData);
+	// Body motion is not computed by the entity itself, but read from the row of the Celestial Body Table it has been registered at
+	CelestialBodyEntity(const BodyData& inBodyData, const CelestialBodyTable& inBodyTable, const uint32_t inBodyIndex);
 
 	// Copy constructor (not needed - SCENE ENTITY GETTER RETURN NON-OWNING RAW PTR, HENCE NOT NEEDED)
 	CelestialBodyEntity(const CelestialBodyEntity& inCelestialBody) = delete;
@@ -52,53 +56,51 @@ public:
 	CelestialBodyEntity(CelestialBodyEntity&& inCelestialBody) = delete;
 	CelestialBodyEntity& operator = (CelestialBodyEntity&& inCelestialBody) = delete;
 
-	// Destructor (not virtual needed, as there are no class child classes)
-	~CelestialBodyEntity() = default;
+	// Destructor (not virtual needed, as there are no class child classes) - Give the texture layer back to its texture array
+	~CelestialBodyEntity();
 
 	const BodyData& GetBodyData() const { return bodyData; }
 
-	// Compute body position in Cartesian coordinates from Spherical ones
-	void ComputeCartesianPosition(const float deltaTime, std::optional<std::reference_wrapper<const ITransformable>> parentTransformable = std::nullopt);
-	const glm::vec3& GetPosition() const { return position; }
+	// Only called by the Scene when motion values of the body have been edited (radius and texture being baked into the mesh scale and the material)
+	void SetBodyData(const BodyData& inBodyData) { bodyData = inBodyData; }
+	uint32_t GetBodyIndex() const { return bodyIndex; }
 
-	// IRenderable implementation
-	void Render() override;
-	// IRenderable implementation
+	// Only called by the Scene when rows of the Celestial Body Table are compacted after a removal
+	void SetBodyIndex(const uint32_t inBodyIndex) { bodyIndex = inBodyIndex; }
 
-private:
-	BodyData bodyData;
+	// Body position in World Space, as computed by the Orbital Kernel for the current frame
+	glm::vec3 GetPosition() const;
 
-	SphereMeshComponent sphere;
-
-	BlinnPhongMaterial material;
-	BlinnPhongMaterial InitialiseMaterial(const std::filesystem::path& texturePath);
+	// Made of a Transform resolved out of the Celestial Body Table row, the shared unit sphere (at several levels of detail) scaled to the body radius,
+	// drawn with all other bodies sharing its shader and texture resolution, and its material, plus a light source for the Star
+	EntityComponents GetComponents() override;
 
-	Transform transform;
-	// ITransformable implementation
-	const Transform& GetTransform() const override { return transform; }
-	void ComputeTransformVUniform(const float deltaTime, const Camera& /*camera*/, std::optional<std::reference_wrapper<const ITransformable>> parentTransformable = std::nullopt) override;
-	// ITransformable implementation
+	// IInstancedRenderable implementation
+	const MeshComponent& GetInstancedMesh() const override;
+	// IInstancedRenderable implementation
 
-	std::shared_ptr<LightSourceComponent> lightSource;
+	// IDetailLevels implementation
+	void SelectDetailLevel(const float projectedScreenRadius) override;
+	// IDetailLevels implementation
 
-	glm::vec3 position{ 0.0f };
+private:
+	BodyData bodyData;
 
-	// Angle travelled by the planet (resp. moon) around the star (resp. planet) since the simulation started [in radians]
-	float travelledAngle{ 0.0f };
+	// Level of detail of the unit sphere drawn
+	uint32_t sphereLOD{ 0 };
 
-	// Angular frequency for orbital motion [in radians/Main Planet days]
-	float orbitAngularFreq{ 0.0f };
-	float travelledOrbitAngle{ 0.0f };
+	// Layer of the texture array holding the body texture, sampled through the material shader
+	TextureLayer textureLayer;
 
-	// Angular frequency for spin motion [in radians/Main Planet days]
-	float spinAngularFreq{ 0.0f };
-	float travelledSpinAngle{ 0.0f };
+	BlinnPhongMaterial material;
+	BlinnPhongMaterial InitialiseMaterial() const;
 
-	// Obliquity converted [in radians]
-	float obliquityInRad{ 0.0f };
+	// Stored inline (only set for stars), so the light lives in the pooled entity storage
+	std::optional<PointLightComponent> lightSource;
 
-	float distCosOrbInclination{ 0.0f };
-	float distSinOrbInclination{ 0.0f };
+	// Simulation-side storage of the body motion (owned by the Scene)
+	const CelestialBodyTable& bodyTable;
+	uint32_t bodyIndex{ 0 };
 };
 
 
@@ -7,7 +7,6 @@
 
 #include "Utils/Helpers.h"
 #include "Rendering/Renderer.h"
-#include "Rendering/Shader.h"
 #include "Rendering/ShaderLoader.h"
 #include "Rendering/Texture.h"
 
@@ -28,18 +27,21 @@ BlinnPhongMaterial GalaxyBackgroundEntity::InitialiseMaterial(const std::filesys
 	return BlinnPhongMaterial(ShaderLookUpID::Enum::GALAXY_BACKGROUND, std::vector<Texture>{ std::move(texture) });
 }
 
-void GalaxyBackgroundEntity::Render()
+EntityComponents GalaxyBackgroundEntity::GetComponents()
 {
-	const Shader& shader = material.GetShader();
-	shader.Enable();
+	EntityComponents components;
+	components.Add(ComponentType::MESH);
+	components.mesh = this;
 
-	Renderer::SetDepthFctToEqual();
+	components.Add(ComponentType::MATERIAL);
+	components.material = &material;
 
-	material.EnableTextures();
-	skybox.Render();
-	material.DisableTextures();
+	return components;
+}
 
+void GalaxyBackgroundEntity::Render()
+{
+	Renderer::SetDepthFctToEqual();
+	skybox.Render();
 	Renderer::SetDepthFctToLess();
-
-	shader.Disable();
 }
@@ -15,6 +15,9 @@ class GalaxyBackgroundEntity : public SceneEntity, public IRenderable
 public:
 	GalaxyBackgroundEntity(const std::filesystem::path& inTexturePath, const std::string& inName);
 
+	// Made of a skybox mesh and its material (no Transform, the skybox being drawn around the camera)
+	EntityComponents GetComponents() override;
+
 	// IRenderable implementation
 	void Render() override;
 	// IRenderable implementation
@@ -1,28 +1,40 @@
 #include "OrbitEntity.h"
 
 #include <glad/glad.h>
-#include <glm/trigonometric.hpp>
+#include <glm/exponential.hpp>
+#include <glm/mat3x3.hpp>
 #include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
 
 #include <utility>
 #include <vector>
 
-#include "Cameras/Camera.h"
 #include "CelestialBodyEntity.h"
-#include "Rendering/Renderer.h"
-#include "Rendering/Shader.h"
+#include "Components/Meshes/MeshLibrary.h"
 #include "Rendering/ShaderLoader.h"
 #include "Rendering/Texture.h"
-#include "Utils/Constants.h"
+#include "Simulation/OrbitalKernel.h"
 
 
 
 OrbitEntity::OrbitEntity(const BodyData& inBodyData) :
 	SceneEntity(inBodyData.name + "Orbit"),
-	circle(inBodyData.distanceToParent),
 	material(InitialiseMaterial(inBodyData.texturePath))
 {
-	orbInclinationInRad = glm::radians(inBodyData.orbitalInclination);
+	SetOrbit(inBodyData);
+}
+
+void OrbitEntity::SetOrbit(const BodyData& inBodyData)
+{
+	// Scale the unit circle to the semi-major axis, squash it into the orbit ellipse along its minor axis, then move its center away from the focus
+	const glm::mat3 orbitalFrame = OrbitalKernel::ComputeOrbitalFrame(inBodyData);
+	const float semiMajorAxis = inBodyData.distanceToParent;
+	const float semiMinorAxis = semiMajorAxis * glm::sqrt(1.0f - inBodyData.eccentricity * inBodyData.eccentricity);
+
+	orbitModel[0] = glm::vec4(orbitalFrame[0] * semiMinorAxis, 0.0f);
+	orbitModel[1] = glm::vec4(orbitalFrame[1] * semiMajorAxis, 0.0f);
+	orbitModel[2] = glm::vec4(orbitalFrame[2] * semiMajorAxis, 0.0f);
+	orbitModel[3] = glm::vec4(orbitalFrame[2] * -semiMajorAxis * inBodyData.eccentricity, 1.0f);
 }
 
 BlinnPhongMaterial OrbitEntity::InitialiseMaterial(const std::filesystem::path& texturePath)
@@ -33,31 +45,29 @@ BlinnPhongMaterial OrbitEntity::InitialiseMaterial(const std::filesystem::path&
 	return BlinnPhongMaterial(ShaderLookUpID::Enum::DEFAULT, std::vector<Texture>{ std::move(texture) });
 }
 
-void OrbitEntity::ComputeTransformVUniform(const float /*deltaTime*/, const Camera& /*camera*/, std::optional<std::reference_wrapper<const ITransformable>> parentTransformable)
+EntityComponents OrbitEntity::GetComponents()
 {
-	transform.Reset();
+	EntityComponents components;
+	components.Add(ComponentType::TRANSFORM);
+	components.localMatrix = orbitModel;
 
-	// Center the orbit (non-constant over time) around the parent planet for satellites
-	// Only moons have their parent position (= Planet) moving, whereas planets have their parent position (= Star) constant
-	if (parentID != 0)
-	{
-		transform.Translate(parentTransformable.value().get().GetTransform().GetPosition());
-	}
+	components.Add(ComponentType::ORBIT);
 
-	// Rotate the orbit (constant over time) around axis colinear to orbital plane and tangent to orbital trajectory to reproduce its axial tilt?
-	transform.Rotate(orbInclinationInRad, WorldSpace::ZUnitVector);
-}
+	components.Add(ComponentType::MESH);
+	components.mesh = this;
 
-void OrbitEntity::Render()
-{
-	const Shader& shader = material.GetShader();
-	shader.Enable();
+	components.Add(ComponentType::MATERIAL);
+	components.material = &material;
 
-	Renderer::SetTransformVUniform(shader, transform);
+	// Unit circle, the orbit Model matrix scaling it to the semi-major axis
+	components.Add(ComponentType::BOUNDS);
+	components.boundingRadius = 1.0f;
 
-	material.EnableTextures();
-	circle.Render();
-	material.DisableTextures();
+	return components;
+}
 
-	shader.Disable();
+void OrbitEntity::Render()
+{
+	// Unit circle, turned into the orbit ellipse by the Model matrix
+	MeshLibrary::GetUnitCircle().Render();
 }
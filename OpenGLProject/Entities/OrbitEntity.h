@@ -1,47 +1,43 @@
 #ifndef ORBIT_H
 #define ORBIT_H
 
+#include <glm/mat4x4.hpp>
+
 #include <filesystem>
-#include <functional>
-#include <optional>
 #include <string>
 
-#include "Components/Meshes/CircleMeshComponent.h"
 #include "Rendering/BlinnPhongMaterial.h"
 #include "Scene/SceneEntity.h"
-#include "Scene/Transform.h"
 
 struct BodyData;
-class Camera;
 
 
 
-class OrbitEntity : public SceneEntity, public ITransformable, public IRenderable
+class OrbitEntity : public SceneEntity, public IRenderable
 {
 public:
 	OrbitEntity(const BodyData& inBodyData);
 
+	// Made of a Transform resolved out of the orbit ellipse (centered around the parent position when attached), the shared unit circle and its material
+	EntityComponents GetComponents() override;
+
+	// Shape the orbit again after motion values of the body have been edited (the new Model matrix still having to be stored in the Component Store)
+	void SetOrbit(const BodyData& inBodyData);
+
+	const glm::mat4& GetOrbitModel() const { return orbitModel; }
+
 	// IRenderable implementation
 	void Render() override;
 	// IRenderable implementation
 
 private:
-	// @todo - Implement ellipse for a more realistic simulation (circular orbits with eccentricities close to 0 for now)
-	CircleMeshComponent circle;
-
 	BlinnPhongMaterial material;
 	BlinnPhongMaterial InitialiseMaterial(const std::filesystem::path& texturePath);
 
-	Transform transform;
-	// ITransformable implementation
-	const Transform& GetTransform() const override { return transform; }
-	void ComputeTransformVUniform(const float deltaTime, const Camera& camera, std::optional<std::reference_wrapper<const ITransformable>> parentTransformable = std::nullopt) override;
-	// ITransformable implementation
-
 	std::string bodyName;
 
-	// Orbital Inclination converted [in radians]
-	float orbInclinationInRad{ 0.0f };
+	// Model matrix of the orbit relative to its parent position, i.e. the orbit orientation (inclination, ascending node, periapsis) and shape (semi-axes)
+	glm::mat4 orbitModel{ 1.0f };
 };
 
 
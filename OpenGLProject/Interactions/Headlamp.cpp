@@ -23,10 +23,10 @@ void Headlamp::SetHeadlightState(const bool isActive)
 
 void Headlamp::UpdateHeadlight(const Camera& camera)
 {
-	if (headlightStartTime > 0.0f)
+	if (headlightStartTime > 0.0)
 	{
 		headlight.SetLightPositionFUniform(camera.GetPosition());
-		headlight.SetLightDirectionFUniform(camera.GetTransform().GetForwardVector());
+		headlight.SetLightDirectionFUniform(camera.GetOrientation().GetForwardVector());
 	}
 }
 
@@ -34,7 +34,7 @@ void Headlamp::UpdateHeadlightState(const int32_t action)
 {
 	const bool isReleaseActionRegistered = CoreEngine::GetInstance().GetElapsedTime() - headlightStartTime > ApplicationControls::KEY_RELEASE_SENSITIVITY;
 
-	if (action == GLFW_PRESS && headlightStartTime == 0.0f)
+	if (action == GLFW_PRESS && headlightStartTime == 0.0)
 	{
 		SetHeadlightState(true);
 		headlightStartTime = CoreEngine::GetInstance().GetElapsedTime();
@@ -25,7 +25,7 @@ public:
 private:
 	SpotLightComponent headlight;
 
-	float headlightStartTime{ 0.0f };
+	double headlightStartTime{ 0.0 };
 
 	// Turn on/off reflection params rather than creating/deleting a heap-allocated SpotLight instance
 	void SetHeadlightState(const bool isActive);
@@ -195,7 +195,7 @@ void PerspectiveCameraController::SetKeyboardInputGLFWCallback()
 			assert(false);
 		}
 
-		const auto& IsReleaseActionRegistered = [](const float pressTime) -> bool
+		const auto& IsReleaseActionRegistered = [](const double pressTime) -> bool
 		{
 			return CoreEngine::GetInstance().GetElapsedTime() - pressTime > ApplicationControls::KEY_RELEASE_SENSITIVITY;
 		};
@@ -203,7 +203,7 @@ void PerspectiveCameraController::SetKeyboardInputGLFWCallback()
 		// Pause simulation
 		if (key == GLFW_KEY_SPACE)
 		{
-			if (action == GLFW_PRESS && cameraController->pauseStartTime == 0.0f)
+			if (action == GLFW_PRESS && cameraController->pauseStartTime == 0.0)
 			{
 				Application::GetInstance().Pause(true);
 				cameraController->pauseStartTime = CoreEngine::GetInstance().GetElapsedTime();
@@ -212,13 +212,13 @@ void PerspectiveCameraController::SetKeyboardInputGLFWCallback()
 			if (action == GLFW_RELEASE && IsReleaseActionRegistered(cameraController->pauseStartTime))
 			{
 				Application::GetInstance().Pause(false);
-				cameraController->pauseStartTime = 0.0f;
+				cameraController->pauseStartTime = 0.0;
 			}
 		}
 		// Switch application cursor mode
 		else if (key == GLFW_KEY_TAB)
 		{
-			if (action == GLFW_PRESS && cameraController->cursorModeStartTime == 0.0f)
+			if (action == GLFW_PRESS && cameraController->cursorModeStartTime == 0.0)
 			{
 				window->SetCursorMode(GLFW_CURSOR_NORMAL);
 				cameraController->cursorModeStartTime = CoreEngine::GetInstance().GetElapsedTime();
@@ -227,13 +227,13 @@ void PerspectiveCameraController::SetKeyboardInputGLFWCallback()
 			if (action == GLFW_RELEASE && IsReleaseActionRegistered(cameraController->cursorModeStartTime))
 			{
 				window->SetCursorMode(GLFW_CURSOR_DISABLED);
-				cameraController->cursorModeStartTime = 0.0f;
+				cameraController->cursorModeStartTime = 0.0;
 			}
 		}
 		// Display legend on each celestial body of the simulation
 		else if (key == GLFW_KEY_L)
 		{
-			if (action == GLFW_PRESS && cameraController->displayLegendStartTime == 0.0f)
+			if (action == GLFW_PRESS && cameraController->displayLegendStartTime == 0.0)
 			{
 				Application::GetInstance().DisplayLegend(true);
 				cameraController->displayLegendStartTime = CoreEngine::GetInstance().GetElapsedTime();
@@ -242,7 +242,39 @@ void PerspectiveCameraController::SetKeyboardInputGLFWCallback()
 			if (action == GLFW_RELEASE && IsReleaseActionRegistered(cameraController->displayLegendStartTime))
 			{
 				Application::GetInstance().DisplayLegend(false);
-				cameraController->displayLegendStartTime = 0.0f;
+				cameraController->displayLegendStartTime = 0.0;
+			}
+		}
+		// Toggle N-Body mode (gravitational interactions between massive celestial bodies)
+		else if (key == GLFW_KEY_N)
+		{
+			if (action == GLFW_PRESS)
+			{
+				Application::GetInstance().EnableNBodyMode(Application::GetInstance().IsNBodyModeEnabled() == false);
+			}
+		}
+		// Save the whole simulation state to the snapshot file, or go back to the state it contains
+		else if (key == GLFW_KEY_F5 || key == GLFW_KEY_F9)
+		{
+			if (action == GLFW_PRESS)
+			{
+				Application::GetInstance().RequestSnapshot(key == GLFW_KEY_F5 ? SnapshotRequest::SAVE : SnapshotRequest::RESTORE);
+			}
+		}
+		// Toggle timeline recording (integrated states of N-Body mode)
+		else if (key == GLFW_KEY_T)
+		{
+			if (action == GLFW_PRESS)
+			{
+				Application::GetInstance().EnableTimelineRecording(Application::GetInstance().IsTimelineRecordingEnabled() == false);
+			}
+		}
+		// Scrub the simulated date backward/forward, held keys scrubbing further at each repeat
+		else if (key == GLFW_KEY_LEFT || key == GLFW_KEY_RIGHT)
+		{
+			if (action == GLFW_PRESS || action == GLFW_REPEAT)
+			{
+				Application::GetInstance().RequestScrub(key == GLFW_KEY_LEFT ? -ApplicationControls::SCRUB_STEP_DAYS : ApplicationControls::SCRUB_STEP_DAYS);
 			}
 		}
 		// @todo - Spot Light does not disappear at second 'H' key press
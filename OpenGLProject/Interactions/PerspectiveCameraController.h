@@ -19,6 +19,7 @@ public:
 	void ProcessUserInput(const float deltaTime);
 
 	PerspectiveCamera& GetCamera() { return camera; }
+	const PerspectiveCamera& GetCamera() const { return camera; }
 	Headlamp& GetHeadlamp() { return headlamp; }
 
 	// [dimensionless]
@@ -38,9 +39,9 @@ private:
 	float travelSpeed{ 20.0f };
 
 	// Time caching used to avoid detecting when a keyboard key has been released while it has been pressed just before
-	float pauseStartTime{ 0.0f };
-	float displayLegendStartTime{ 0.0f };
-	float cursorModeStartTime{ 0.0f };
+	double pauseStartTime{ 0.0 };
+	double displayLegendStartTime{ 0.0 };
+	double cursorModeStartTime{ 0.0 };
 
 	// Process input received from a mouse scroll-wheel event (vertical wheel-axis to be considered only)
 	void UpdateZoomLeft(const float yOffset);
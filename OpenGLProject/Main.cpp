@@ -1,4 +1,5 @@
 #include "Application/Application.h"
+#include "Simulation/SimulationBenchmarks.h"
 #include "Simulation/SolarSystem.h"
 
 #include <filesystem>
@@ -7,15 +8,29 @@
 
 
 
-int main(int /*argc*/, char** argv)
+int main(int argc, char** argv)
 {
 	const std::filesystem::path executablePath(argv[0]);
 
+	// Headless run of the simulation kernel benchmarks, no Window is created
+	if (argc > 1 && std::string(argv[1]) == SimulationBenchmarks::COMMAND_LINE_ARGUMENT)
+	{
+		SimulationBenchmarks::RunAll(executablePath);
+		return 0;
+	}
+
 	std::cout << "Executable path: " << executablePath.string() << std::endl;
 
+	// Resume from a snapshot file saved by a previous run
+	std::filesystem::path snapshotPath;
+	if (argc > 2 && std::string(argv[1]) == SolarSystem::SNAPSHOT_COMMAND_LINE_ARGUMENT)
+	{
+		snapshotPath = argv[2];
+	}
+
 	// 1 second corresponds to 1 Earth day in the Solar System simulation
 	Application::GetInstance().SetParameters(executablePath, "Solar System Simulation");
-	Application::GetInstance().SetScene(std::make_unique<SolarSystem>());
+	Application::GetInstance().SetScene(std::make_unique<SolarSystem>(snapshotPath));
 
 	Application::GetInstance().Run();
 }
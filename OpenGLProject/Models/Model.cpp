@@ -1,13 +1,19 @@
 #include "Model.h"
 
 #include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
 
+#include <algorithm>
+#include <cassert>
 #include <cstddef> // std::size_t
+#include <iostream>
+#include <utility>
 
+#include "Buffers/StreamingVertexBuffer.h"
 #include "Buffers/VertexBuffer.h"
 #include "ModelLoader.h"
 #include "Rendering/Renderer.h"
-#include "Scene/Transform.h"
 
 
 
@@ -18,24 +24,41 @@ Model::Model(const std::filesystem::path& inPath, const ShaderLookUpID::Enum inS
 	ModelLoader::LoadModel(*this, inPath);
 }
 
-void Model::StoreInstanceTransforms(const std::vector<Transform>& transforms) const
+void Model::StoreInstances(const std::vector<glm::vec4>& rotationScaleColumns)
 {
-	std::vector<glm::mat4> modelMatrices;
-	for (const Transform& transform : transforms)
+	// Instances only move, so the first 3 columns of their Model matrices are uploaded once and for all
+	const std::size_t instanceCount = rotationScaleColumns.size() / 3;
+
+	// Configure instanced arrays
+	instanceRotationScaleVbo.emplace(static_cast<const void*>(rotationScaleColumns.data()), rotationScaleColumns.size() * sizeof(glm::vec4));
+
+	// Set rotation/scale columns as instance vertex attributes for each mesh VAO already created
+	for (const MeshComponent& mesh : meshes)
 	{
-		modelMatrices.push_back(transform.Get());
+		mesh.StoreInstanceRotationScales();
 	}
 
-	// Configure instanced array
-	VertexBuffer vbo(static_cast<const void*>(modelMatrices.data()), modelMatrices.size() * Transform::GetMatrixSizeInBytes());
+	instanceRotationScaleVbo->Unbind();
 
-	// Set transformation matrices as an instance vertex attribute for each mesh VAO already created
-	for (const MeshComponent& mesh : meshes)
+	instancePositionVbo.emplace(instanceCount * sizeof(glm::vec3));
+}
+
+glm::vec3* Model::BeginInstancePositionsUpdate()
+{
+	if (instancePositionVbo.has_value() == false)
 	{
-		mesh.StoreInstanceTransforms();
+		std::cout << "ERROR::MODEL - Instances should be stored before instance positions are updated!" << std::endl;
+		assert(false);
+		return nullptr;
 	}
 
-	vbo.Unbind();
+	return static_cast<glm::vec3*>(instancePositionVbo->BeginWrite());
+}
+
+void Model::EndInstancePositionsUpdate()
+{
+	// Positions are read from the region just written by the next draw calls
+	instancePositionVbo->EndWrite();
 }
 
 void Model::Render() const
@@ -46,17 +69,57 @@ void Model::Render() const
 	}
 }
 
-void Model::RenderInstances(const uint32_t instanceCount) const
+void Model::RenderInstances(const uint32_t firstInstance, const uint32_t instanceCount) const
 {
+	if (instanceRotationScaleVbo.has_value() == false || instancePositionVbo.has_value() == false)
+	{
+		std::cout << "ERROR::MODEL - Instances should be stored before being rendered!" << std::endl;
+		assert(false);
+		return;
+	}
+
+	instanceRotationScaleVbo->Bind();
+	for (const MeshComponent& mesh : meshes)
+	{
+		mesh.StoreInstanceRotationScales(static_cast<std::size_t>(firstInstance) * 3 * sizeof(glm::vec4));
+	}
+	instanceRotationScaleVbo->Unbind();
+
+	instancePositionVbo->Bind();
+	for (const MeshComponent& mesh : meshes)
+	{
+		mesh.StoreInstancePositions(instancePositionVbo->GetCurrentRegionOffset() + static_cast<std::size_t>(firstInstance) * sizeof(glm::vec3));
+	}
+	instancePositionVbo->Unbind();
+
 	for (const MeshComponent& mesh : meshes)
 	{
 		mesh.RenderInstances(instanceCount);
 	}
 }
 
+void Model::FenceInstancePositions()
+{
+	if (instancePositionVbo.has_value())
+	{
+		instancePositionVbo->FenceCurrentRegion();
+	}
+}
+
+float Model::ComputeBoundingRadius() const
+{
+	float boundingRadius = 0.0f;
+	for (const MeshComponent& mesh : meshes)
+	{
+		boundingRadius = std::max(boundingRadius, mesh.ComputeBoundingRadius());
+	}
+
+	return boundingRadius;
+}
+
 void Model::AddMesh(MeshComponent&& mesh)
 {
-	meshes.emplace_back(mesh);
+	meshes.emplace_back(std::move(mesh));
 }
 
 void Model::AddMaterial(BlinnPhongMaterial&& material)
@@ -2,11 +2,16 @@
 #define MODEL_H
 
 #include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
 
 #include <cstdint>
 #include <filesystem>
+#include <optional>
 #include <vector>
 
+#include "Buffers/StreamingVertexBuffer.h"
+#include "Buffers/VertexBuffer.h"
 #include "Components/Meshes/MeshComponent.h"
 #include "Rendering/BlinnPhongMaterial.h"
 #include "Rendering/ShaderLoader.h"
@@ -14,18 +19,32 @@
 
 
 
-class Transform;
-
 // Set of Meshes with Materials already applied from a 3D Software (e.g. Blender, Maya, etc.)
 class Model
 {
 public:
 	Model(const std::filesystem::path& inPath, const ShaderLookUpID::Enum inShaderLookUpID, const bool inGammaCorrection = false);
 
-	void StoreInstanceTransforms(const std::vector<Transform>& transforms) const;
+	// Create instance buffers out of the first 3 Model matrix columns of each instance: rotation/scale is stored once, while positions are meant to be streamed every frame
+	void StoreInstances(const std::vector<glm::vec4>& rotationScaleColumns);
+
+	// Return where to write the position of every instance for the next frames (the GPU may still be reading the previous ones),
+	// then make them the ones instances are rendered at
+	glm::vec3* BeginInstancePositionsUpdate();
+	void EndInstancePositionsUpdate();
 
 	void Render() const;
-	void RenderInstances(const uint32_t instanceCount) const;
+
+	// Draw instances [firstInstance, firstInstance + instanceCount[ (e.g. a run of visible chunks): there is no base instance in OpenGL 4.0,
+	// so instance attributes are pointed at the first instance drawn instead
+	void RenderInstances(const uint32_t firstInstance, const uint32_t instanceCount) const;
+
+	// Protect the instance positions written last from being overwritten until the draw calls submitted so far are done reading them
+	// (to be called once every instance range of the frame has been drawn)
+	void FenceInstancePositions();
+
+	// Return the radius of the sphere centered on the Model space origin enclosing every Mesh
+	float ComputeBoundingRadius() const;
 
 	const std::vector<BlinnPhongMaterial>& GetMaterials() const { return materials; }
 	ShaderLookUpID::Enum GetShaderLookUpID() const { return shaderLookUpID; }
@@ -43,6 +62,10 @@ private:
 	std::vector<BlinnPhongMaterial> materials;
 	ShaderLookUpID::Enum shaderLookUpID;
 
+	// Per-instance data, referenced by the VAO of every Mesh. Stored inline (empty until instances are stored), as the Model lives in its owning entity
+	std::optional<VertexBuffer> instanceRotationScaleVbo;
+	std::optional<StreamingVertexBuffer> instancePositionVbo;
+
 	[[maybe_unused]] bool gammaCorrection{ false };
 };
 
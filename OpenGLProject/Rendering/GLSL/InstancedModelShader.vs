@@ -3,7 +3,7 @@
 layout (location = 0) in vec3 va_Position;
 layout (location = 1) in vec3 va_Normal;
 layout (location = 2) in vec2 va_TexCoords;
-layout (location = 5) in mat4 va_InstanceMatrix;		// locations 5, 6, 7 and 8 reserved for each column of the matrix
+layout (location = 5) in mat4 va_InstanceMatrix;		// locations 5, 6, 7 and 8 reserved for each column of the matrix (the 4th one, i.e. the position, being streamed as a vec3)
 
 out vec3 vo_Position;
 out vec3 vo_Normal;
@@ -0,0 +1,112 @@
+#include "InstancedRenderer.h"
+
+#include <algorithm>	// for std::max and std::sort
+#include <functional>	// for std::less
+#include <utility>
+
+#include "Buffers/StreamingVertexBuffer.h"
+#include "Components/Meshes/MeshComponent.h"
+#include "Shader.h"
+#include "TextureArrayLibrary.h"
+
+// Attribute pointers of a batch are derived from the layout of the whole struct: 4 matrix columns then the layer, without any padding
+static_assert(sizeof(InstanceData) == (4 * 4 + 1) * sizeof(float), "InstanceData layout should match the instance attributes registered by MeshComponent");
+
+
+
+InstancedRenderer::InstancedRenderer() = default;
+
+// Defined here, StreamingVertexBuffer being only forward-declared in header
+InstancedRenderer::~InstancedRenderer() = default;
+
+void InstancedRenderer::AddInstance(const ShaderLookUpID::Enum shaderLookUpID, const uint32_t textureArrayIndex, const MeshComponent& mesh, const InstanceData& instanceData)
+{
+	Instance instance;
+	instance.shaderLookUpID = shaderLookUpID;
+	instance.textureArrayIndex = textureArrayIndex;
+	instance.mesh = &mesh;
+	instance.data = instanceData;
+
+	instances.push_back(std::move(instance));
+}
+
+void InstancedRenderer::Render()
+{
+	if (instances.empty())
+	{
+		return;
+	}
+
+	// Instances of the same batch become contiguous (a handful of shaders/arrays/levels of detail, so a comparison sort is enough)
+	std::sort(instances.begin(), instances.end(), [](const Instance& lhs, const Instance& rhs)
+	{
+		if (lhs.shaderLookUpID != rhs.shaderLookUpID)
+		{
+			return lhs.shaderLookUpID < rhs.shaderLookUpID;
+		}
+
+		if (lhs.textureArrayIndex != rhs.textureArrayIndex)
+		{
+			return lhs.textureArrayIndex < rhs.textureArrayIndex;
+		}
+
+		return std::less<const MeshComponent*>()(lhs.mesh, rhs.mesh);
+	});
+
+	// The buffer is reallocated (rarely, e.g. when bodies are added at runtime), its previous regions being released once the GPU is done with them
+	if (instanceVbo == nullptr || instances.size() > instanceCapacity)
+	{
+		instanceCapacity = std::max(std::max(INITIAL_INSTANCE_CAPACITY, 2 * instanceCapacity), instances.size());
+		instanceVbo = std::make_unique<StreamingVertexBuffer>(instanceCapacity * sizeof(InstanceData));
+	}
+
+	InstanceData* const instanceData = static_cast<InstanceData*>(instanceVbo->BeginWrite());
+	for (std::size_t i = 0; i < instances.size(); ++i)
+	{
+		instanceData[i] = instances[i].data;
+	}
+	instanceVbo->EndWrite();
+
+	std::size_t batchStart = 0;
+	while (batchStart < instances.size())
+	{
+		const Instance& firstInstance = instances[batchStart];
+
+		std::size_t batchEnd = batchStart + 1;
+		while (batchEnd < instances.size()
+			&& instances[batchEnd].shaderLookUpID == firstInstance.shaderLookUpID
+			&& instances[batchEnd].textureArrayIndex == firstInstance.textureArrayIndex
+			&& instances[batchEnd].mesh == firstInstance.mesh)
+		{
+			++batchEnd;
+		}
+
+		RenderBatch(batchStart, batchEnd - batchStart);
+		batchStart = batchEnd;
+	}
+
+	instanceVbo->FenceCurrentRegion();
+
+	instances.clear();
+}
+
+void InstancedRenderer::RenderBatch(const std::size_t firstInstance, const std::size_t instanceCount) const
+{
+	const Instance& instance = instances[firstInstance];
+
+	const Shader& shader = ShaderLibrary::GetShader(instance.shaderLookUpID);
+	shader.Enable();
+
+	// Sampled by the diffuse texture sampler of the shader (see BlinnPhongMaterial)
+	TextureArrayLibrary::Enable(instance.textureArrayIndex, 0);
+
+	// No base instance before OpenGL 4.2: attribute pointers are moved to the first instance of the batch instead
+	instanceVbo->Bind();
+	instance.mesh->StoreInstanceModels(instanceVbo->GetCurrentRegionOffset() + firstInstance * sizeof(InstanceData));
+	instanceVbo->Unbind();
+
+	instance.mesh->RenderInstances(static_cast<uint32_t>(instanceCount));
+
+	TextureArrayLibrary::Disable();
+	shader.Disable();
+}
@@ -0,0 +1,66 @@
+#ifndef INSTANCED_RENDERER_H
+#define INSTANCED_RENDERER_H
+
+#include <glm/mat4x4.hpp>
+
+#include <cstddef> // std::size_t
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "ShaderLoader.h"
+
+class MeshComponent;
+class StreamingVertexBuffer;
+
+
+
+// Per-instance data read by instanced GLSL Vertex Shaders (see VertexAttributeLocation), laid out as streamed to the instance buffer
+struct InstanceData
+{
+	glm::mat4 model{ 1.0f };
+
+	// Layer of the texture array sampled by the instance (stored as a float, like any other vertex attribute)
+	float textureLayer{ 0.0f };
+};
+
+// Draw entities sharing a shader, a texture array and a mesh in a single instanced call: instances gathered over a pass are sorted by batch,
+// streamed to one instance buffer, and every batch draws its own range of it, so the amount of draw calls does not depend on the amount of entities
+class InstancedRenderer
+{
+public:
+	// Amount of instances the instance buffer is allocated for at first (doubled whenever a pass gathers more)
+	static constexpr std::size_t INITIAL_INSTANCE_CAPACITY = 64;
+
+	InstancedRenderer();
+	~InstancedRenderer();
+
+	// Queue an instance for the next Render() call
+	void AddInstance(const ShaderLookUpID::Enum shaderLookUpID, const uint32_t textureArrayIndex, const MeshComponent& mesh, const InstanceData& instanceData);
+
+	// Draw the instances queued since the last call, one draw call per batch
+	void Render();
+
+private:
+	struct Instance
+	{
+		ShaderLookUpID::Enum shaderLookUpID{ ShaderLookUpID::UNDEFINED };
+		uint32_t textureArrayIndex{ 0 };
+		const MeshComponent* mesh{ nullptr };
+
+		InstanceData data;
+	};
+
+	// Instances queued for the next draws, kept allocated from one pass to the next
+	std::vector<Instance> instances;
+
+	std::unique_ptr<StreamingVertexBuffer> instanceVbo;
+	std::size_t instanceCapacity{ 0 };
+
+	// Bind the shader and the texture array of a batch, point its mesh instance attributes to the range of the batch, and draw it
+	void RenderBatch(const std::size_t firstInstance, const std::size_t instanceCount) const;
+};
+
+
+
+#endif // INSTANCED_RENDERER_H
@@ -41,6 +41,7 @@ public:
 	void DisableTextures() const;
 
 	Shader& GetShader() const { return ShaderLibrary::GetShader(shaderLookUpID); }
+	ShaderLookUpID::Enum GetShaderLookUpID() const { return shaderLookUpID; }
 
 	const std::vector<Texture>& GetTextures() const { return textures; }
 
@@ -4,7 +4,6 @@
 #include <glfw/glfw3.h>
 #include <iostream>
 
-#include "Scene/Transform.h"
 #include "Shader.h"
 
 
@@ -71,9 +70,9 @@ void Renderer::SetDepthFctToLess()
 	glDepthFunc(GL_LESS);
 }
 
-void Renderer::SetTransformVUniform(const Shader& shader, const Transform& transform)
+void Renderer::SetTransformVUniform(const Shader& shader, const glm::mat4& model)
 {
-	shader.SetUniformMat4("vu_Model", transform.Get());
+	shader.SetUniformMat4("vu_Model", model);
 }
 
 void Renderer::Draw(const unsigned int mode, const int32_t startIndex, const int32_t count)
@@ -90,3 +89,8 @@ void Renderer::DrawInstances(const unsigned int mode, const int32_t startIndex,
 {
 	glDrawArraysInstanced(mode, startIndex, count, instanceCount);
 }
+
+void Renderer::DrawInstances(const unsigned int mode, const int32_t count, const void* offsetInBytes, const int32_t instanceCount)
+{
+	glDrawElementsInstanced(mode, count, GL_UNSIGNED_INT, offsetInBytes, instanceCount);
+}
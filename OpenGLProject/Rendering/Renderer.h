@@ -5,7 +5,6 @@
 #include <glm/mat4x4.hpp>
 
 class Shader;
-class Transform;
 
 
 
@@ -31,16 +30,13 @@ namespace Renderer
 	void EnableBlending();
 	void DisableBlending();
 
-	// @todo - Frustrum culling
-
 	// Set the function that will be used to compare each pixel depth value with the one stored in buffer
 	void SetDepthFctToEqual();
 	void SetDepthFctToLess();
 
-	// @todo - Drag to a Movement Component class?
-	// Called on a per-frame basis to update the Transform.
-	// Shader should already be enabled in each Scene Entity child Render() method prior to call this one. Uniform to be updated in child classes
-	void SetTransformVUniform(const Shader& shader, const Transform& transform);
+	// Called on a per-frame basis to update the Model matrix of the entity about to be drawn.
+	// Shader should already be enabled (by the Render System) prior to call this one
+	void SetTransformVUniform(const Shader& shader, const glm::mat4& model);
 
 	// Render a primitive without indices (e.g. for Orbit, Skybox and 2D Quad instance) - Warning: VAO must be bound prior to this call, and unbound afterwards
 	void Draw(const unsigned int mode, const int32_t startIndex, const int32_t count);
@@ -50,6 +46,9 @@ namespace Renderer
 
 	// Render primitives without indices using instancing (e.g. for 'Rock' Models in Belt instance) - Warning: VAO must be bound prior to this call, and unbound afterwards
 	void DrawInstances(const unsigned int mode, const int32_t startIndex, const int32_t count, const int32_t instanceCount);
+
+	// Render primitives with indices using instancing (e.g. for the unit sphere drawn once for all celestial bodies) - Warning: VAO must be bound prior to this call, and unbound afterwards
+	void DrawInstances(const unsigned int mode, const int32_t count, const void* offsetInBytes, const int32_t instanceCount);
 };
 
 
@@ -11,20 +11,21 @@ class Shader;
 // To be used to refer to any Shader instead of relying on raw strings (layer of security over the existence of LookUpIDs when instantiating or look-up functions)
 namespace ShaderLookUpID
 {
-	constexpr size_t Num = 5;
+	constexpr size_t Num = 6;
 
 	// Enum elements do not correspond to GLSL Shader names but on which Scene Entity/Object Mesh they are applied to
 	enum Enum
 	{
 		UNDEFINED = 0,
 		DEFAULT,
+		BODY,
 		STAR,
 		BILLBOARD,
 		GALAXY_BACKGROUND,
 		BELT,
 	};
 
-	constexpr std::array<Enum, Num> All = { DEFAULT, STAR, BILLBOARD, BELT, GALAXY_BACKGROUND, };
+	constexpr std::array<Enum, Num> All = { DEFAULT, BODY, STAR, BILLBOARD, BELT, GALAXY_BACKGROUND, };
 
 	constexpr Enum Get(const int index) { return All[index]; }
 };
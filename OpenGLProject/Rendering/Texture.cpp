@@ -105,6 +105,17 @@ void Texture::Unbind() const
 	glBindTexture(target, 0);
 }
 
+void Texture::Delete()
+{
+	if (rendererID == 0)
+	{
+		return;
+	}
+
+	glDeleteTextures(1, &rendererID);
+	rendererID = 0;
+}
+
 void Texture::Enable(const uint32_t textureUnit) const
 {
 	Activate(textureUnit);
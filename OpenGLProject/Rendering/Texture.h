@@ -95,6 +95,9 @@ public:
 	// Set everything back to default once texture is configured
 	void Disable() const;
 
+	// Delete the texture object and forget its name, so it cannot be bound or deleted again (e.g. once its content has been copied elsewhere)
+	void Delete();
+
 	uint32_t GetRendererID() const { return rendererID; }
 	const std::filesystem::path& GetImagePath() const { return imagePath; }
 
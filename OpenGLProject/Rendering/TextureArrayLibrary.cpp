@@ -0,0 +1,222 @@
+#include "TextureArrayLibrary.h"
+
+#include <glad/glad.h>
+
+#include <algorithm>	// for std::find_if and std::max
+#include <cassert>
+#include <cstddef> // std::size_t
+#include <iostream>
+#include <iterator>	// for std::distance and std::prev
+#include <utility>
+
+#include "Texture.h"
+
+std::vector<TextureArrayLibrary::TextureArray> TextureArrayLibrary::textureArrays;
+
+namespace
+{
+	// Read a whole mipmap level of the texture bound to the target (every layer of it for arrays)
+	void ReadLevel(const uint32_t target, const int32_t level, const bool isCompressed, void* outData)
+	{
+		if (isCompressed)
+		{
+			glGetCompressedTexImage(target, level, outData);
+		}
+		else
+		{
+			glGetTexImage(target, level, GL_RGBA, GL_UNSIGNED_BYTE, outData);
+		}
+	}
+
+	// Write consecutive layers of a mipmap level of the bound texture array
+	void WriteLayers(const int32_t level, const int32_t width, const int32_t height, const int32_t firstLayer, const int32_t layerCount,
+		const int32_t internalFormat, const bool isCompressed, const int32_t sizeInBytes, const void* data)
+	{
+		if (isCompressed)
+		{
+			glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, firstLayer, width, height, layerCount, internalFormat, sizeInBytes, data);
+		}
+		else
+		{
+			glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, firstLayer, width, height, layerCount, GL_RGBA, GL_UNSIGNED_BYTE, data);
+		}
+	}
+}
+
+
+
+TextureLayer TextureArrayLibrary::AddDDS(const std::filesystem::path& imagePath)
+{
+	// SOIL only creates 2D textures (or cubemaps): load it as such, then copy it into its layer
+	Texture texture(imagePath, GL_TEXTURE_2D, { GL_REPEAT }, { GL_LINEAR }, TextureType::Enum::DIFFUSE);
+	texture.LoadDDS();
+	texture.Bind();
+
+	TextureArray description;
+	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &description.width);
+	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &description.height);
+	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_INTERNAL_FORMAT, &description.internalFormat);
+
+	int32_t isCompressed = GL_FALSE;
+	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_COMPRESSED, &isCompressed);
+	description.isCompressed = isCompressed != GL_FALSE;
+
+	// Keep the mipmap levels stored in the DDS file, down to the first one missing
+	for (int32_t level = 0; (description.width >> level) > 0 || (description.height >> level) > 0; ++level)
+	{
+		int32_t levelWidth = 0;
+		int32_t levelHeight = 0;
+		glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_WIDTH, &levelWidth);
+		glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_HEIGHT, &levelHeight);
+		if (levelWidth == 0 || levelHeight == 0)
+		{
+			break;
+		}
+
+		int32_t levelSize = levelWidth * levelHeight * 4;
+		if (description.isCompressed)
+		{
+			glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_COMPRESSED_IMAGE_SIZE, &levelSize);
+		}
+		description.levelSizes.push_back(levelSize);
+	}
+
+	auto textureArrayIt = std::find_if(textureArrays.begin(), textureArrays.end(), [&description](const TextureArray& textureArray)
+	{
+		return textureArray.width == description.width && textureArray.height == description.height && textureArray.internalFormat == description.internalFormat
+			&& textureArray.levelSizes == description.levelSizes;
+	});
+
+	if (textureArrayIt == textureArrays.end())
+	{
+		textureArrays.push_back(std::move(description));
+		textureArrayIt = std::prev(textureArrays.end());
+	}
+
+	TextureArray& textureArray = *textureArrayIt;
+	if (textureArray.freeLayers.empty())
+	{
+		Reallocate(textureArray, std::max(INITIAL_LAYER_COUNT, 2 * textureArray.layerCount));
+	}
+
+	TextureLayer textureLayer;
+	textureLayer.arrayIndex = static_cast<uint32_t>(std::distance(textureArrays.begin(), textureArrayIt));
+	textureLayer.layer = textureArray.freeLayers.back();
+	textureArray.freeLayers.pop_back();
+
+	// Copy every level of the 2D texture into the layer
+	std::vector<uint8_t> levelData;
+	for (int32_t level = 0; level < static_cast<int32_t>(textureArray.levelSizes.size()); ++level)
+	{
+		const int32_t levelSize = textureArray.levelSizes[level];
+		levelData.resize(static_cast<std::size_t>(levelSize));
+
+		texture.Bind();
+		ReadLevel(GL_TEXTURE_2D, level, textureArray.isCompressed, levelData.data());
+
+		glBindTexture(GL_TEXTURE_2D_ARRAY, textureArray.rendererID);
+		WriteLayers(level, std::max(1, textureArray.width >> level), std::max(1, textureArray.height >> level), static_cast<int32_t>(textureLayer.layer), 1,
+			textureArray.internalFormat, textureArray.isCompressed, levelSize, levelData.data());
+	}
+
+	glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+	texture.Unbind();
+
+	// The 2D texture is not needed anymore, its content living in the layer
+	texture.Delete();
+
+	return textureLayer;
+}
+
+void TextureArrayLibrary::RemoveLayer(const TextureLayer& textureLayer)
+{
+	if (textureLayer.arrayIndex >= textureArrays.size())
+	{
+		std::cout << "ERROR::TEXTURE_ARRAY_LIBRARY - Layer " << textureLayer.layer << " cannot be removed, as texture array " << textureLayer.arrayIndex << " does not exist!" << std::endl;
+		assert(false);
+		return;
+	}
+
+	textureArrays[textureLayer.arrayIndex].freeLayers.push_back(textureLayer.layer);
+}
+
+void TextureArrayLibrary::Enable(const uint32_t arrayIndex, const uint32_t textureUnit)
+{
+	glActiveTexture(GL_TEXTURE0 + textureUnit);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, textureArrays[arrayIndex].rendererID);
+}
+
+void TextureArrayLibrary::Disable()
+{
+	glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+void TextureArrayLibrary::Reallocate(TextureArray& textureArray, const int32_t layerCount)
+{
+	int32_t maxLayerCount = 0;
+	glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayerCount);
+	if (layerCount > maxLayerCount)
+	{
+		std::cout << "ERROR::TEXTURE_ARRAY_LIBRARY - " << layerCount << " layers requested, whereas OpenGL allows " << maxLayerCount << " layers per texture array at most!" << std::endl;
+		assert(false);
+	}
+
+	uint32_t rendererID = 0;
+	glGenTextures(1, &rendererID);
+
+	const int32_t levelCount = static_cast<int32_t>(textureArray.levelSizes.size());
+	std::vector<uint8_t> levelData;
+	for (int32_t level = 0; level < levelCount; ++level)
+	{
+		const int32_t levelWidth = std::max(1, textureArray.width >> level);
+		const int32_t levelHeight = std::max(1, textureArray.height >> level);
+		const int32_t levelSize = textureArray.levelSizes[level];
+
+		// Read the layers of the previous storage before allocating the new one
+		if (textureArray.layerCount > 0)
+		{
+			levelData.resize(static_cast<std::size_t>(levelSize) * static_cast<std::size_t>(textureArray.layerCount));
+
+			glBindTexture(GL_TEXTURE_2D_ARRAY, textureArray.rendererID);
+			ReadLevel(GL_TEXTURE_2D_ARRAY, level, textureArray.isCompressed, levelData.data());
+		}
+
+		glBindTexture(GL_TEXTURE_2D_ARRAY, rendererID);
+		if (textureArray.isCompressed)
+		{
+			glCompressedTexImage3D(GL_TEXTURE_2D_ARRAY, level, textureArray.internalFormat, levelWidth, levelHeight, layerCount, 0, levelSize * layerCount, nullptr);
+		}
+		else
+		{
+			glTexImage3D(GL_TEXTURE_2D_ARRAY, level, textureArray.internalFormat, levelWidth, levelHeight, layerCount, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+		}
+
+		if (textureArray.layerCount > 0)
+		{
+			WriteLayers(level, levelWidth, levelHeight, 0, textureArray.layerCount, textureArray.internalFormat, textureArray.isCompressed,
+				levelSize * textureArray.layerCount, levelData.data());
+		}
+	}
+
+	// Same wrapping as 2D textures of bodies, levels of the DDS file being used when minifying
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, levelCount > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
+
+	glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+	if (textureArray.rendererID != 0)
+	{
+		glDeleteTextures(1, &textureArray.rendererID);
+	}
+	textureArray.rendererID = rendererID;
+
+	// New layers are free, lowest last
+	for (int32_t layer = layerCount - 1; layer >= textureArray.layerCount; --layer)
+	{
+		textureArray.freeLayers.push_back(static_cast<uint32_t>(layer));
+	}
+	textureArray.layerCount = layerCount;
+}
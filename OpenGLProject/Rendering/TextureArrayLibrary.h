@@ -0,0 +1,62 @@
+#ifndef TEXTURE_ARRAY_LIBRARY_H
+#define TEXTURE_ARRAY_LIBRARY_H
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+
+
+// Location of a texture packed into a texture array
+struct TextureLayer
+{
+	uint32_t arrayIndex{ 0 };
+	uint32_t layer{ 0 };
+};
+
+// Global access point to 2D texture arrays, each one packing the textures of the same resolution and format into its layers (e.g. all 2k DDS textures
+// of celestial bodies), so entities textured out of the same array are drawn in a single instanced call, each instance sampling its own layer
+class TextureArrayLibrary final
+{
+public:
+	// Load a DDS texture (mipmaps included) into a free layer of the array matching its resolution and format, creating the array or doubling
+	// its amount of layers if needed. Warning: require an OpenGL Context
+	static TextureLayer AddDDS(const std::filesystem::path& imagePath);
+
+	// Give a layer back, to be reused by the next texture of the same resolution and format (e.g. when a body is removed from the Scene)
+	static void RemoveLayer(const TextureLayer& textureLayer);
+
+	// Activate the texture unit then bind the array
+	static void Enable(const uint32_t arrayIndex, const uint32_t textureUnit);
+	static void Disable();
+
+private:
+	// Amount of layers allocated for an array when its first texture is added
+	static constexpr int32_t INITIAL_LAYER_COUNT = 4;
+
+	struct TextureArray
+	{
+		int32_t width{ 0 };
+		int32_t height{ 0 };
+		int32_t internalFormat{ 0 };
+		bool isCompressed{ false };
+
+		// Size of a single layer at each mipmap level [in bytes], finest level first
+		std::vector<int32_t> levelSizes;
+
+		// Layers allocated on the GPU, and the ones not holding any texture (lowest last, so it is reused first)
+		int32_t layerCount{ 0 };
+		std::vector<uint32_t> freeLayers;
+
+		uint32_t rendererID{ 0 };
+	};
+
+	static std::vector<TextureArray> textureArrays;
+
+	// Allocate storage for the provided amount of layers, the layers of the previous storage being copied over (level by level)
+	static void Reallocate(TextureArray& textureArray, const int32_t layerCount);
+};
+
+
+
+#endif // TEXTURE_ARRAY_LIBRARY_H
@@ -0,0 +1,217 @@
+#include "ComponentStore.h"
+
+#include <cassert>
+#include <iostream>
+#include <utility>
+
+namespace
+{
+	// Move the last element of a component array in place of the removed one (arrays of component types missing from the mask being left empty)
+	template<typename ComponentArray>
+	void SwapAndPop(ComponentArray& components, const std::size_t row)
+	{
+		if (components.empty())
+		{
+			return;
+		}
+
+		components[row] = std::move(components.back());
+		components.pop_back();
+	}
+}
+
+
+EntityLocation ComponentStore::AddEntity(const EntityHandle entityHandle, const RenderableType renderType, const EntityComponents& components)
+{
+	const uint32_t archetypeIndex = FindOrCreateArchetype(components.mask, renderType);
+	Archetype& archetype = archetypes[archetypeIndex];
+
+	const EntityLocation location{ archetypeIndex, static_cast<uint32_t>(archetype.GetEntityCount()) };
+	archetype.entityHandles.push_back(entityHandle);
+
+	if (archetype.Has(ComponentType::TRANSFORM))
+	{
+		// Bodies are already resolved in World Space by the Orbital Kernel, whereas orbits/billboards only follow the position of their body
+		TransformInheritance inheritance = TransformInheritance::FULL;
+		if (archetype.Has(ComponentType::SPIN))
+		{
+			inheritance = TransformInheritance::NONE;
+		}
+		else if (archetype.Has(ComponentType::ORBIT) || archetype.Has(ComponentType::BILLBOARD))
+		{
+			inheritance = TransformInheritance::POSITION;
+		}
+
+		archetype.transformNodeIDs.push_back(transformHierarchy.AddNode(components.localMatrix, inheritance));
+	}
+
+	if (archetype.Has(ComponentType::SPIN))
+	{
+		archetype.bodyTables.push_back(components.bodyTable);
+		archetype.bodyIndices.push_back(components.bodyIndex);
+	}
+
+	if (archetype.Has(ComponentType::MESH))
+	{
+		archetype.meshes.push_back(components.mesh);
+	}
+
+	if (archetype.Has(ComponentType::MATERIAL))
+	{
+		archetype.materials.push_back(components.material);
+	}
+
+	if (archetype.Has(ComponentType::LIGHT_SOURCE))
+	{
+		archetype.lightSources.push_back(components.lightSource);
+	}
+
+	if (archetype.Has(ComponentType::BOUNDS))
+	{
+		// Drawn until the next culling pass
+		archetype.boundingRadii.push_back(components.boundingRadius);
+		archetype.visibilityFlags.push_back(1);
+	}
+
+	if (archetype.Has(ComponentType::INSTANCE_CHUNKS))
+	{
+		archetype.chunkedInstances.push_back(components.chunkedInstances);
+	}
+
+	if (archetype.Has(ComponentType::DETAIL_LEVELS))
+	{
+		archetype.detailLevels.push_back(components.detailLevels);
+	}
+
+	if (archetype.Has(ComponentType::MESH_SCALE))
+	{
+		archetype.meshScales.push_back(components.meshScale);
+	}
+
+	if (archetype.Has(ComponentType::INSTANCED_MESH))
+	{
+		archetype.instancedMeshes.push_back(components.instancedMesh);
+		archetype.textureArrayIndices.push_back(components.textureArrayIndex);
+		archetype.textureLayers.push_back(components.textureLayer);
+	}
+
+	if (entityHandle.slotIndex >= entityLocations.size())
+	{
+		entityLocations.resize(static_cast<std::size_t>(entityHandle.slotIndex) + 1);
+	}
+	entityLocations[entityHandle.slotIndex] = location;
+
+	return location;
+}
+
+void ComponentStore::RemoveEntity(const EntityHandle entityHandle)
+{
+	const EntityLocation location = GetLocation(entityHandle);
+	if (location.IsValid() == false)
+	{
+		std::cout << "ERROR::COMPONENT_STORE - Entity " << entityHandle.slotIndex << " cannot be removed, as it is unknown" << std::endl;
+		assert(false);
+		return;
+	}
+
+	Archetype& archetype = archetypes[location.archetypeIndex];
+	if (archetype.Has(ComponentType::TRANSFORM))
+	{
+		transformHierarchy.RemoveNode(archetype.transformNodeIDs[location.row]);
+	}
+
+	SwapAndPop(archetype.entityHandles, location.row);
+	SwapAndPop(archetype.transformNodeIDs, location.row);
+	SwapAndPop(archetype.bodyTables, location.row);
+	SwapAndPop(archetype.bodyIndices, location.row);
+	SwapAndPop(archetype.meshes, location.row);
+	SwapAndPop(archetype.materials, location.row);
+	SwapAndPop(archetype.lightSources, location.row);
+	SwapAndPop(archetype.boundingRadii, location.row);
+	SwapAndPop(archetype.visibilityFlags, location.row);
+	SwapAndPop(archetype.chunkedInstances, location.row);
+	SwapAndPop(archetype.detailLevels, location.row);
+	SwapAndPop(archetype.meshScales, location.row);
+	SwapAndPop(archetype.instancedMeshes, location.row);
+	SwapAndPop(archetype.textureArrayIndices, location.row);
+	SwapAndPop(archetype.textureLayers, location.row);
+
+	// Entity previously stored in the last row now lives in the removed row
+	if (location.row < archetype.GetEntityCount())
+	{
+		entityLocations[archetype.entityHandles[location.row].slotIndex].row = location.row;
+	}
+
+	entityLocations[entityHandle.slotIndex] = EntityLocation{};
+}
+
+void ComponentStore::SetParent(const EntityHandle entityHandle, const EntityHandle parentEntityHandle)
+{
+	const EntityLocation location = GetLocation(entityHandle);
+	const EntityLocation parentLocation = GetLocation(parentEntityHandle);
+	if (location.IsValid() == false || parentLocation.IsValid() == false)
+	{
+		std::cout << "ERROR::COMPONENT_STORE - Entity " << entityHandle.slotIndex << " cannot be attached to entity " << parentEntityHandle.slotIndex << ", as one of them is unknown" << std::endl;
+		assert(false);
+		return;
+	}
+
+	const Archetype& archetype = archetypes[location.archetypeIndex];
+	const Archetype& parentArchetype = archetypes[parentLocation.archetypeIndex];
+	if (archetype.Has(ComponentType::TRANSFORM) == false || parentArchetype.Has(ComponentType::TRANSFORM) == false)
+	{
+		std::cout << "ERROR::COMPONENT_STORE - Entity " << entityHandle.slotIndex << " cannot be attached to entity " << parentEntityHandle.slotIndex << ", as one of them has no Transform" << std::endl;
+		assert(false);
+		return;
+	}
+
+	transformHierarchy.SetParent(archetype.transformNodeIDs[location.row], parentArchetype.transformNodeIDs[parentLocation.row]);
+}
+
+void ComponentStore::SetLocalMatrix(const EntityHandle entityHandle, const glm::mat4& localMatrix)
+{
+	const EntityLocation location = GetLocation(entityHandle);
+	if (location.IsValid() == false || archetypes[location.archetypeIndex].Has(ComponentType::TRANSFORM) == false)
+	{
+		std::cout << "ERROR::COMPONENT_STORE - Entity " << entityHandle.slotIndex << " is unknown or has no Transform" << std::endl;
+		assert(false);
+		return;
+	}
+
+	transformHierarchy.SetLocalMatrix(archetypes[location.archetypeIndex].transformNodeIDs[location.row], localMatrix);
+}
+
+EntityLocation ComponentStore::GetLocation(const EntityHandle entityHandle) const
+{
+	if (entityHandle.slotIndex >= entityLocations.size())
+	{
+		return EntityLocation{};
+	}
+
+	// Slot may have been reused by another entity since
+	const EntityLocation& location = entityLocations[entityHandle.slotIndex];
+	if (location.IsValid() == false || archetypes[location.archetypeIndex].entityHandles[location.row] != entityHandle)
+	{
+		return EntityLocation{};
+	}
+
+	return location;
+}
+
+uint32_t ComponentStore::FindOrCreateArchetype(const ComponentMask mask, const RenderableType renderType)
+{
+	for (uint32_t i = 0; i < archetypes.size(); ++i)
+	{
+		if (archetypes[i].mask == mask && archetypes[i].renderType == renderType)
+		{
+			return i;
+		}
+	}
+
+	Archetype archetype;
+	archetype.mask = mask;
+	archetype.renderType = renderType;
+	archetypes.push_back(std::move(archetype));
+
+	return static_cast<uint32_t>(archetypes.size() - 1);
+}
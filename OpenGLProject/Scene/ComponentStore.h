@@ -0,0 +1,137 @@
+#ifndef COMPONENT_STORE_H
+#define COMPONENT_STORE_H
+
+#include <glm/mat4x4.hpp>
+
+#include <cstddef> // std::size_t
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "EntityComponents.h"
+#include "EntityHandle.h"
+#include "Rendering/RenderQueue.h"
+#include "TransformHierarchy.h"
+
+
+
+// Where the components of an entity are stored: its Archetype, and its row in every array of it
+struct EntityLocation
+{
+	static constexpr uint32_t NO_ARCHETYPE_INDEX = std::numeric_limits<uint32_t>::max();
+
+	uint32_t archetypeIndex{ NO_ARCHETYPE_INDEX };
+	uint32_t row{ 0 };
+
+	bool IsValid() const { return archetypeIndex != NO_ARCHETYPE_INDEX; }
+};
+
+// Components of all entities sharing the same component types and render pass, laid out as a Structure of Arrays (one array per component,
+// arrays of component types missing from the mask staying empty)
+struct Archetype
+{
+	ComponentMask mask{ 0 };
+	RenderableType renderType{ RenderableType::ALL };
+
+	std::vector<EntityHandle> entityHandles;
+
+	// TRANSFORM - IDs of the nodes in the Transform Hierarchy (matrices being stored there, sorted by depth rather than by Archetype)
+	std::vector<uint32_t> transformNodeIDs;
+
+	// SPIN
+	std::vector<const CelestialBodyTable*> bodyTables;
+	std::vector<uint32_t> bodyIndices;
+
+	// MESH - Entities owning geometries drawn in different ways (Models, chunked instances, orbit lines, glyph quads), each row points to the entity
+	// drawing its own, a single virtual call per drawn row (the draw calls themselves costing far more)
+	std::vector<IRenderable*> meshes;
+
+	// MATERIAL - Owned by the entities, only read by the Render System when binding their shader and textures
+	std::vector<const Material*> materials;
+
+	// LIGHT_SOURCE
+	std::vector<PointLightComponent*> lightSources;
+
+	// BOUNDS - Radii in Model space, and whether each bounding sphere intersects the camera frustum (written by the Culling System every frame)
+	std::vector<float> boundingRadii;
+	std::vector<uint8_t> visibilityFlags;
+
+	// INSTANCE_CHUNKS
+	std::vector<IChunkedInstances*> chunkedInstances;
+
+	// DETAIL_LEVELS
+	std::vector<IDetailLevels*> detailLevels;
+
+	// MESH_SCALE
+	std::vector<float> meshScales;
+
+	// INSTANCED_MESH
+	std::vector<IInstancedRenderable*> instancedMeshes;
+	std::vector<uint32_t> textureArrayIndices;
+	std::vector<uint32_t> textureLayers;
+
+	bool Has(const ComponentType componentType) const { return (mask & ToComponentMask(componentType)) != 0; }
+
+	// Return whether an entity has to be drawn this frame (entities without bounding sphere always being drawn)
+	bool IsVisible(const std::size_t row) const { return Has(ComponentType::BOUNDS) == false || visibilityFlags[row] != 0; }
+
+	std::size_t GetEntityCount() const { return entityHandles.size(); }
+};
+
+// Archetype-based storage of the components of every Scene Entity (the entities themselves, owning GPU resources, being stored by the Scene).
+// Warning: removing an entity moves the last row of its Archetype in its place, so locations are only valid until the next removal
+class ComponentStore
+{
+public:
+	// Store the components of an entity in the Archetype matching their types and render pass (created if needed)
+	EntityLocation AddEntity(const EntityHandle entityHandle, const RenderableType renderType, const EntityComponents& components);
+
+	// Remove the components of an entity in O(1), the last row of its Archetype taking its place
+	void RemoveEntity(const EntityHandle entityHandle);
+
+	// Make the Model matrix of an entity relative to the one of its parent (how much of it is inherited depending on the entity component types)
+	void SetParent(const EntityHandle entityHandle, const EntityHandle parentEntityHandle);
+
+	// Overwrite the local Model matrix of an entity with a TRANSFORM component (e.g. after its data has been edited)
+	void SetLocalMatrix(const EntityHandle entityHandle, const glm::mat4& localMatrix);
+
+	// Return where the components of an entity are stored (invalid location if the entity is unknown or has been removed)
+	EntityLocation GetLocation(const EntityHandle entityHandle) const;
+
+	const std::vector<Archetype>& GetArchetypes() const { return archetypes; }
+	Archetype& GetArchetype(const uint32_t archetypeIndex) { return archetypes[archetypeIndex]; }
+	const Archetype& GetArchetype(const uint32_t archetypeIndex) const { return archetypes[archetypeIndex]; }
+
+	TransformHierarchy& GetTransformHierarchy() { return transformHierarchy; }
+	const TransformHierarchy& GetTransformHierarchy() const { return transformHierarchy; }
+
+	const glm::mat4& GetWorldMatrix(const EntityLocation& location) const { return transformHierarchy.GetWorldMatrix(archetypes[location.archetypeIndex].transformNodeIDs[location.row]); }
+
+	// Call a function on every Archetype made of all the required component types and none of the excluded ones
+	template<typename ArchetypeFunction>
+	void ForEachArchetype(const ComponentMask requiredMask, const ComponentMask excludedMask, const ArchetypeFunction& function)
+	{
+		for (Archetype& archetype : archetypes)
+		{
+			if ((archetype.mask & requiredMask) == requiredMask && (archetype.mask & excludedMask) == 0)
+			{
+				function(archetype);
+			}
+		}
+	}
+
+private:
+	std::vector<Archetype> archetypes;
+
+	// Model matrices of all entities with a TRANSFORM component
+	TransformHierarchy transformHierarchy;
+
+	// Location of each entity, indexed by the slot index of its handle (slots being reused, the index stays dense)
+	std::vector<EntityLocation> entityLocations;
+
+	uint32_t FindOrCreateArchetype(const ComponentMask mask, const RenderableType renderType);
+};
+
+
+
+#endif // COMPONENT_STORE_H
@@ -0,0 +1,114 @@
+#ifndef ENTITY_COMPONENTS_H
+#define ENTITY_COMPONENTS_H
+
+#include <glm/mat4x4.hpp>
+
+#include <cstdint>
+
+class CelestialBodyTable;
+class IChunkedInstances;
+class IDetailLevels;
+class IInstancedRenderable;
+class IRenderable;
+class Material;
+class PointLightComponent;
+
+
+
+// Kinds of data a Scene Entity can be made of. Entities made of the same kinds of components (and rendered in the same pass) share an Archetype,
+// storing each component in its own contiguous array, so Scene Systems iterate over plain data instead of querying every entity for interfaces
+enum class ComponentType : uint32_t
+{
+	// Node of the Transform Hierarchy, whose world matrix is the Model matrix of the entity (relative to the parent entity if attached to one)
+	TRANSFORM = 0,
+
+	// Orbit ellipse drawn around the parent position (i.e. only inheriting the parent position)
+	ORBIT,
+
+	// Motion of a celestial body (orbital position, axial tilt, spin), resolved in batch by the Orbital Kernel
+	SPIN,
+
+	// Geometry drawn by the Render System
+	MESH,
+
+	// Shader/textures the Render System binds before drawing the geometry (entities without it bind their own, e.g. Models with baked-in materials)
+	MATERIAL,
+
+	// Quad always facing the camera, anchored to the parent position
+	BILLBOARD,
+
+	// Point light following the entity position
+	LIGHT_SOURCE,
+
+	// Sphere enclosing the geometry around the Model space origin, tested against the camera frustum every frame (entities without it are always drawn)
+	BOUNDS,
+
+	// Instances grouped into chunks bounded on their own, culled chunk by chunk against the camera frustum every frame (e.g. belts, which have no Transform)
+	INSTANCE_CHUNKS,
+
+	// Mesh precomputed at several levels of detail, one being selected every frame out of the bounding sphere radius projected on screen
+	DETAIL_LEVELS,
+
+	// Uniform scale of the mesh only, applied to the Model matrix when drawing but not inherited by attached entities (e.g. body radius applied to the unit sphere)
+	MESH_SCALE,
+
+	// Mesh drawn by the Render System in a single instanced call with every entity sharing its shader, texture array and mesh, instead of the MESH one
+	// (its texture being a layer of a texture array, selected per instance)
+	INSTANCED_MESH,
+
+	COUNT
+};
+
+// Set of component types, one bit per type
+using ComponentMask = uint32_t;
+
+constexpr ComponentMask ToComponentMask(const ComponentType componentType)
+{
+	return ComponentMask{ 1 } << static_cast<uint32_t>(componentType);
+}
+
+// Initial value of each component of a Scene Entity, provided once when the entity is added to the Scene (values of types missing from the mask are ignored)
+struct EntityComponents
+{
+	ComponentMask mask{ 0 };
+
+	// TRANSFORM - Model matrix relative to the parent entity (or to World Space when not attached).
+	// For orbits, relative to the parent position, i.e. the orbit orientation (inclination, ascending node, periapsis) and shape (eccentricity)
+	glm::mat4 localMatrix{ 1.0f };
+
+	// SPIN - Row of the body in the Celestial Body Table (owned by the Scene)
+	const CelestialBodyTable* bodyTable{ nullptr };
+	uint32_t bodyIndex{ 0 };
+
+	// MESH - Non-owning ptr of the entity drawing its geometry
+	IRenderable* mesh{ nullptr };
+
+	// MATERIAL - Non-owning ptr of the material owned by the entity
+	const Material* material{ nullptr };
+
+	// LIGHT_SOURCE - Non-owning ptr of the light owned by the entity
+	PointLightComponent* lightSource{ nullptr };
+
+	// BOUNDS - Radius of the bounding sphere in Model space (scaled along with the Model matrix, e.g. unit circles of orbits)
+	float boundingRadius{ 0.0f };
+
+	// INSTANCE_CHUNKS - Non-owning ptr of the entity culling its chunks
+	IChunkedInstances* chunkedInstances{ nullptr };
+
+	// DETAIL_LEVELS - Non-owning ptr of the entity switching between its levels
+	IDetailLevels* detailLevels{ nullptr };
+
+	// MESH_SCALE - Factor applied to the mesh vertices
+	float meshScale{ 1.0f };
+
+	// INSTANCED_MESH - Non-owning ptr of the entity providing its mesh, and the layer holding its texture in the Texture Array Library
+	IInstancedRenderable* instancedMesh{ nullptr };
+	uint32_t textureArrayIndex{ 0 };
+	uint32_t textureLayer{ 0 };
+
+	void Add(const ComponentType componentType) { mask |= ToComponentMask(componentType); }
+};
+
+
+
+#endif // ENTITY_COMPONENTS_H
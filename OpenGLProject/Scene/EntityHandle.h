@@ -0,0 +1,27 @@
+#ifndef ENTITY_HANDLE_H
+#define ENTITY_HANDLE_H
+
+#include <cstdint>
+#include <limits>
+
+
+
+// Reference to a Scene Entity: the index of its slot in the Scene, and the generation of the slot when the entity was created.
+// Slots are reused once their entity is destroyed, their generation being incremented, so a handle kept after its entity has been destroyed
+// is detected by a single comparison instead of pointing to another entity
+struct EntityHandle
+{
+	static constexpr uint32_t NO_SLOT_INDEX = std::numeric_limits<uint32_t>::max();
+
+	uint32_t slotIndex{ NO_SLOT_INDEX };
+	uint32_t generation{ 0 };
+
+	bool IsValid() const { return slotIndex != NO_SLOT_INDEX; }
+
+	bool operator == (const EntityHandle& otherHandle) const { return slotIndex == otherHandle.slotIndex && generation == otherHandle.generation; }
+	bool operator != (const EntityHandle& otherHandle) const { return (*this == otherHandle) == false; }
+};
+
+
+
+#endif // ENTITY_HANDLE_H
@@ -0,0 +1,37 @@
+#ifndef ENTITY_POOL_H
+#define ENTITY_POOL_H
+
+#include <utility>
+
+#include "SceneEntity.h"
+#include "Utils/ObjectPool.h"
+
+
+
+// Type-erased access to a pool of Scene Entities, so the Scene can destroy an entity without knowing its concrete type
+class IEntityPool
+{
+public:
+	// Virtual destructor (needed, as class is not final)
+	virtual ~IEntityPool() = default;
+
+	virtual void Destroy(SceneEntity* const entity) = 0;
+};
+
+// Pool of Scene Entities of a single concrete type, so entities of the same type sit next to each other in memory
+template<typename EntityType>
+class EntityPool final : public IEntityPool
+{
+public:
+	template<typename... Args>
+	EntityType* Create(Args&&... args) { return entities.Create(std::forward<Args>(args)...); }
+
+	void Destroy(SceneEntity* const entity) override { entities.Destroy(static_cast<EntityType*>(entity)); }
+
+private:
+	ObjectPool<EntityType> entities;
+};
+
+
+
+#endif // ENTITY_POOL_H
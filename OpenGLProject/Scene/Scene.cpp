@@ -3,14 +3,16 @@
 #include <glm/geometric.hpp>
 
 #include <iostream>
-#include <unordered_map>
 #include <utility>
 
 #include "Application/Application.h"
 #include "Application/Window.h"
 #include "Cameras/Camera.h"
 #include "CoreEngine.h"
+#include "Entities/BeltEntity.h"
+#include "Entities/BodyRingsEntity.h"
 #include "Entities/CelestialBodyEntity.h"
+#include "Entities/OrbitEntity.h"
 #include "SceneEntity.h"
 #include "Transform.h"
 
@@ -36,59 +38,114 @@ void Scene::Update(const float deltaTime)
 
 void Scene::AllocateMemory(const size_t numOfBytes)
 {
-	sceneEntities.reserve(sceneEntities.size() + numOfBytes);
+	entitySlots.reserve(entitySlots.size() + numOfBytes);
+	entitySlotsByName.reserve(entitySlotsByName.size() + numOfBytes);
 }
 
-void Scene::TagEntityAsAttached(const uint32_t entityIDBase, const uint32_t entityIDChild) const
+void Scene::TagEntityAsAttached(const EntityHandle entityHandleBase, const EntityHandle entityHandleChild)
 {
-	SceneEntity* const eChild = GetEntity<SceneEntity>(entityIDChild);
-	eChild->parentID = entityIDBase;
+	SceneEntity* const eChild = GetEntity<SceneEntity>(entityHandleChild);
+	eChild->parentHandle = entityHandleBase;
+
+	componentStore.SetParent(entityHandleChild, entityHandleBase);
 }
 
-uint32_t Scene::AddEntity(const RenderableType handle, std::unique_ptr<SceneEntity> inEntity)
+EntityHandle Scene::RegisterEntity(const RenderableType renderType, SceneEntity& entity, IEntityPool& pool)
 {
-	const uint32_t addedEntityID = inEntity->GetID();
-	sceneEntities[handle].push_back(std::move(inEntity));
+	EntityHandle addedEntityHandle;
+	if (freeEntitySlotIndices.empty() == false)
+	{
+		addedEntityHandle.slotIndex = freeEntitySlotIndices.back();
+		freeEntitySlotIndices.pop_back();
+	}
+	else
+	{
+		addedEntityHandle.slotIndex = static_cast<uint32_t>(entitySlots.size());
+		entitySlots.emplace_back();
+	}
 
-	return addedEntityID;
+	EntitySlot& entitySlot = entitySlots[addedEntityHandle.slotIndex];
+	entitySlot.entity = &entity;
+	entitySlot.pool = &pool;
+	addedEntityHandle.generation = entitySlot.generation;
+
+	entity.SetHandle(addedEntityHandle);
+
+	// Unnamed entities (e.g. background) can only be looked up by handle
+	const std::string& addedEntityName = entity.GetName();
+	if (addedEntityName.length() != 0)
+	{
+		if (entitySlotsByName.emplace(addedEntityName, addedEntityHandle.slotIndex).second == false)
+		{
+			std::cout << "ERROR::SCENE - Scene Entity name \"" << addedEntityName << "\" is already taken" << std::endl;
+			assert(false);
+		}
+	}
+
+	componentStore.AddEntity(addedEntityHandle, renderType, entity.GetComponents());
+
+	return addedEntityHandle;
+}
+
+void Scene::DestroyEntity(const EntityHandle entityHandle)
+{
+	SceneEntity* const entity = GetEntity<SceneEntity>(entityHandle);
+	if (entity == nullptr)
+	{
+		std::cout << "ERROR::SCENE - Scene Entity cannot be destroyed, as it has already been" << std::endl;
+		assert(false);
+		return;
+	}
+
+	componentStore.RemoveEntity(entityHandle);
+
+	const auto& nameSlotIt = entitySlotsByName.find(entity->GetName());
+	if (nameSlotIt != entitySlotsByName.end() && nameSlotIt->second == entityHandle.slotIndex)
+	{
+		entitySlotsByName.erase(nameSlotIt);
+	}
+
+	EntitySlot& entitySlot = entitySlots[entityHandle.slotIndex];
+	entitySlot.pool->Destroy(entity);
+	entitySlot.entity = nullptr;
+	entitySlot.pool = nullptr;
+	++entitySlot.generation;
+
+	freeEntitySlotIndices.push_back(entityHandle.slotIndex);
 }
 
 template<typename EntityType>
-EntityType* Scene::GetEntity(const uint32_t entityID) const
+EntityType* Scene::GetEntity(const EntityHandle entityHandle) const
 {
-	if (entityID == 0)
+	if (entityHandle.slotIndex >= entitySlots.size())
 	{
 		return nullptr;
 	}
 
-	for (const auto& entityPair : sceneEntities)
+	// Stale handle: the entity has been destroyed since (its slot being free or reused by another entity)
+	const EntitySlot& entitySlot = entitySlots[entityHandle.slotIndex];
+	if (entitySlot.generation != entityHandle.generation || entitySlot.entity == nullptr)
 	{
-		for (const std::unique_ptr<SceneEntity>& entityPtr : entityPair.second)
-		{
-			if (entityPtr->GetID() == entityID)
-			{
-				EntityType* const downcastedEntity = dynamic_cast<EntityType*>(entityPtr.get());
-				if (downcastedEntity == nullptr)
-				{
-					std::cout << "ERROR::SCENE - Scene Entity has failed being downcasted" << std::endl;
-					assert(false);
-				}
-
-				return downcastedEntity;
-			}
-		}
+		return nullptr;
+	}
+
+	EntityType* const downcastedEntity = dynamic_cast<EntityType*>(entitySlot.entity);
+	if (downcastedEntity == nullptr)
+	{
+		std::cout << "ERROR::SCENE - Scene Entity has failed being downcasted" << std::endl;
+		assert(false);
 	}
 
-	return nullptr;
+	return downcastedEntity;
 }
 
 // Specialisation prototypes needed here in the source file, so function definition above doesn't have to be included in the header file
-template SceneEntity* Scene::GetEntity<SceneEntity>(const uint32_t entityID) const;
-template const SceneEntity* Scene::GetEntity<const SceneEntity>(const uint32_t entityID) const;
-template ITransformable* Scene::GetEntity<ITransformable>(const uint32_t entityID) const;
-template const ITransformable* Scene::GetEntity<const ITransformable>(const uint32_t entityID) const;
-template CelestialBodyEntity* Scene::GetEntity<CelestialBodyEntity>(const uint32_t entityID) const;
-template const CelestialBodyEntity* Scene::GetEntity<const CelestialBodyEntity>(const uint32_t entityID) const;
+template SceneEntity* Scene::GetEntity<SceneEntity>(const EntityHandle entityHandle) const;
+template const SceneEntity* Scene::GetEntity<const SceneEntity>(const EntityHandle entityHandle) const;
+template CelestialBodyEntity* Scene::GetEntity<CelestialBodyEntity>(const EntityHandle entityHandle) const;
+template const CelestialBodyEntity* Scene::GetEntity<const CelestialBodyEntity>(const EntityHandle entityHandle) const;
+template BeltEntity* Scene::GetEntity<BeltEntity>(const EntityHandle entityHandle) const;
+template const BeltEntity* Scene::GetEntity<const BeltEntity>(const EntityHandle entityHandle) const;
 
 template<typename EntityType>
 EntityType* Scene::GetEntity(const std::string& entityName) const
@@ -98,34 +155,31 @@ EntityType* Scene::GetEntity(const std::string& entityName) const
 		return nullptr;
 	}
 
-	for (const auto& entityPair : sceneEntities)
+	const auto& nameSlotIt = entitySlotsByName.find(entityName);
+	if (nameSlotIt == entitySlotsByName.end())
 	{
-		for (const std::unique_ptr<SceneEntity>& entityPtr : entityPair.second)
-		{
-			if (entityPtr->GetName() == entityName)
-			{
-				EntityType* const downcastedEntity = dynamic_cast<EntityType*>(entityPtr.get());
-				if (downcastedEntity == nullptr)
-				{
-					std::cout << "ERROR::SCENE - Scene Entity has failed being downcasted" << std::endl;
-					assert(false);
-				}
-
-				return downcastedEntity;
-			}
-		}
+		return nullptr;
+	}
+
+	SceneEntity* const entity = entitySlots[nameSlotIt->second].entity;
+
+	EntityType* const downcastedEntity = dynamic_cast<EntityType*>(entity);
+	if (downcastedEntity == nullptr)
+	{
+		std::cout << "ERROR::SCENE - Scene Entity has failed being downcasted" << std::endl;
+		assert(false);
 	}
 
-	return nullptr;
+	return downcastedEntity;
 }
 
 // Specialisation prototypes needed here in the source file, so function definition above doesn't have to be included in the header file
 template SceneEntity* Scene::GetEntity<SceneEntity>(const std::string& entityName) const;
 template const SceneEntity* Scene::GetEntity<const SceneEntity>(const std::string& entityName) const;
-template ITransformable* Scene::GetEntity<ITransformable>(const std::string& entityName) const;
-template const ITransformable* Scene::GetEntity<const ITransformable>(const std::string& entityName) const;
 template CelestialBodyEntity* Scene::GetEntity<CelestialBodyEntity>(const std::string& entityName) const;
 template const CelestialBodyEntity* Scene::GetEntity<const CelestialBodyEntity>(const std::string& entityName) const;
+template OrbitEntity* Scene::GetEntity<OrbitEntity>(const std::string& entityName) const;
+template const BodyRingsEntity* Scene::GetEntity<const BodyRingsEntity>(const std::string& entityName) const;
 
 void Scene::SetSceneViewerTransformStart(const glm::vec3& inPosition, const EulerAngles& inRotationInRad)
 {
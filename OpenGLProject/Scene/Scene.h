@@ -7,9 +7,15 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <typeindex>
+#include <typeinfo>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "ComponentStore.h"
+#include "EntityHandle.h"
+#include "EntityPool.h"
 #include "Interactions/PerspectiveCameraController.h"
 #include "Rendering/RenderQueue.h"
 
@@ -18,6 +24,17 @@ class SceneEntity;
 
 
 
+// Entry of the Scene entity table a handle points to
+struct EntitySlot
+{
+	// Non-owning ptr of the entity (nullptr once destroyed), owned by the pool of its concrete type
+	SceneEntity* entity{ nullptr };
+	IEntityPool* pool{ nullptr };
+
+	// Incremented each time the entity of the slot is destroyed, so handles to it are detected as stale
+	uint32_t generation{ 0 };
+};
+
 // Act as an Entity Manager, since there is a single Scene to take care of.
 // Warning: shaders need to be all loaded before instantiating this class!
 class Scene
@@ -28,35 +45,69 @@ public:
 	// Virtual destructor (needed to handle any custom polymorphic deletion in child classes)
 	virtual ~Scene();
 
-	// Hash map of ptrs owning all Entities of the Scene.
-	// Warning: ownership should never be transferred!
-	std::unordered_map<RenderableType, std::vector<std::unique_ptr<SceneEntity>>> sceneEntities;
+	// Components of all Entities of the Scene, grouped by Archetype, iterated every frame by Scene Systems
+	ComponentStore componentStore;
 
 	// Count as "in-editor" camera rather than a Scene Entity that would be instantiated from the Application layer
 	PerspectiveCameraController sceneViewer;
 
 	virtual void Update(const float deltaTime);
 
-	// Return a non-owning reference of a Scene Entity referred to by its ID
+	// Return a non-owning reference of a Scene Entity referred to by its handle (constant time, nullptr if the entity has been destroyed since)
 	template<typename EntityType = const SceneEntity>
-	EntityType* GetEntity(const uint32_t entityID) const;
+	EntityType* GetEntity(const EntityHandle entityHandle) const;
 
-	// Return a non-owning reference of a Scene Entity referred to by its name
+	// Return a non-owning reference of a Scene Entity referred to by its name (constant time)
 	template<typename EntityType = const SceneEntity>
 	EntityType* GetEntity(const std::string& entityName) const;
 
 protected:
+	// Pools owning all Entities of the Scene (i.e. their GPU resources), one per concrete entity type.
+	// Warning: ownership should never be transferred!
+	std::unordered_map<std::type_index, std::unique_ptr<IEntityPool>> entityPools;
+
+	// Entity table handles point to, and indices of the slots whose entity has been destroyed (reused first)
+	std::vector<EntitySlot> entitySlots;
+	std::vector<uint32_t> freeEntitySlotIndices;
+
+	// Slot of each named entity, keyed by its name
+	std::unordered_map<std::string, uint32_t> entitySlotsByName;
+
 	// Re-allocate the total number of bytes needed for the vector after adding the provided capacity
 	void AllocateMemory(const size_t numOfBytes);
 
 	// Make Scene Entity model matrix (i.e. transform) inherit the one from its parent provided as argument (called "attachment" or anchoring)
-	void TagEntityAsAttached(const uint32_t entityIDBase, const uint32_t entityIDChild) const;
+	void TagEntityAsAttached(const EntityHandle entityHandleBase, const EntityHandle entityHandleChild);
+
+	// Construct an entity in the pool of its type, index it by handle and name, and store its components in the Archetype matching their types and the render pass
+	template<typename EntityType, typename... Args>
+	EntityHandle CreateEntity(const RenderableType renderType, Args&&... args);
 
-	uint32_t AddEntity(const RenderableType handle, std::unique_ptr<SceneEntity> inEntity);
+	// Remove the entity components from the Component Store and destroy it in O(1), its handles becoming stale
+	// (entities attached to it are detached, their local Model matrix becoming relative to World Space)
+	void DestroyEntity(const EntityHandle entityHandle);
 
 	void SetSceneViewerTransformStart(const glm::vec3& inPosition, const EulerAngles& inRotation);
+
+private:
+	// Give a slot and a handle to an entity just created in the provided pool, and register its components
+	EntityHandle RegisterEntity(const RenderableType renderType, SceneEntity& entity, IEntityPool& pool);
 };
 
+template<typename EntityType, typename... Args>
+EntityHandle Scene::CreateEntity(const RenderableType renderType, Args&&... args)
+{
+	std::unique_ptr<IEntityPool>& pool = entityPools[std::type_index(typeid(EntityType))];
+	if (pool == nullptr)
+	{
+		pool = std::make_unique<EntityPool<EntityType>>();
+	}
+
+	EntityType* const entity = static_cast<EntityPool<EntityType>&>(*pool).Create(std::forward<Args>(args)...);
+
+	return RegisterEntity(renderType, *entity, *pool);
+}
+
 
 
 #endif // SCENE_H
@@ -2,26 +2,46 @@
 #define SCENE_ENTITY_H
 
 #include <cstdint>
-#include <functional>
-#include <optional>
 #include <string>
 
+#include "EntityComponents.h"
+#include "EntityHandle.h"
 
+class Frustum;
+class MeshComponent;
 
-// Should be "implemented" by all Scene Entity child classes that can be drawable/renderable on screen
+
+// Should be "implemented" by all Scene Entity child classes that can be drawable/renderable on screen (registered as their MESH component)
 class IRenderable
 {
 public:
-	// Constain OpenGL functiosns that draw meshes with materials applied on them to the screen in a certain order
+	// Contain OpenGL functions that draw meshes to the screen. The shader/textures of the MATERIAL component, if any, are bound by the Render System beforehand
 	virtual void Render() = 0;
 };
 
-class ITransformable
+// Should be "implemented" by Scene Entities drawing many instances, grouped into chunks of neighbour instances bounded on their own (registered as their INSTANCE_CHUNKS component)
+class IChunkedInstances
+{
+public:
+	// Flag the chunks whose World space bounding sphere intersects the frustum, the only ones drawn by the next Render() call
+	virtual void CullChunks(const Frustum& frustum) = 0;
+};
+
+// Should be "implemented" by Scene Entities whose mesh is precomputed at several levels of detail (registered as their DETAIL_LEVELS component)
+class IDetailLevels
+{
+public:
+	// Select the level drawn by the next Render() calls, out of the radius of the entity bounding sphere projected on screen [in pixels]
+	virtual void SelectDetailLevel(const float projectedScreenRadius) = 0;
+};
+
+// Should be "implemented" by Scene Entities drawn in a single instanced call along with all others sharing their shader, texture array and mesh
+// (registered as their INSTANCED_MESH component)
+class IInstancedRenderable
 {
 public:
-	virtual const class Transform& GetTransform() const = 0;
-	virtual void ComputeTransformVUniform(const float deltaTime, const class Camera& camera, std::optional<std::reference_wrapper<const ITransformable>> parentTransformable = std::nullopt) = 0;
-	//virtual void Attach() = 0;
+	// Return the mesh the next instanced draw call should use for this entity (e.g. at the level of detail selected)
+	virtual const MeshComponent& GetInstancedMesh() const = 0;
 };
 
 
@@ -47,17 +67,20 @@ public:
 	// Virtual destructor (needed, as class is not final)
 	virtual ~SceneEntity() = default;
 
-	uint32_t GetID() const { return ID; }
+	EntityHandle GetHandle() const { return handle; }
 	const std::string& GetName() const { return name; }
 
-	uint32_t parentID{ 0 };
+	// Only called by the Scene when the entity is created in one of its pools
+	void SetHandle(const EntityHandle inHandle) { handle = inHandle; }
+
+	// Describe the components the entity is made of, called once when it is added to the Scene (its components then being stored in the Component Store)
+	virtual EntityComponents GetComponents() { return EntityComponents{}; }
+
+	EntityHandle parentHandle;
 
 protected:
-	uint32_t ID{ 0 };
+	EntityHandle handle;
 	std::string name;
-
-private:
-	static uint32_t entityIDCounter;
 };
 
 
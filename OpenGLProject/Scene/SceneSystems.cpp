@@ -0,0 +1,316 @@
+#include "SceneSystems.h"
+
+#include <glm/geometric.hpp>
+#include <glm/trigonometric.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+#include "Application/Application.h"
+#include "Cameras/Camera.h"
+#include "Cameras/Frustum.h"
+#include "Components/Lights/PointLightComponent.h"
+#include "Rendering/InstancedRenderer.h"
+#include "Rendering/Material.h"
+#include "Rendering/Renderer.h"
+#include "Rendering/Shader.h"
+#include "SceneEntity.h"
+#include "Simulation/CelestialBodyTable.h"
+#include "Transform.h"
+#include "Utils/ThreadPool.h"
+
+namespace
+{
+	// Run a task over every row of an Archetype, on the Thread Pool if the Archetype is large enough
+	template<typename RowFunction>
+	void ForEachRow(const Archetype& archetype, const RowFunction& function)
+	{
+		ThreadPool::GetInstance().ParallelFor(archetype.GetEntityCount(), SceneSystems::MIN_ENTITIES_PER_THREAD, [&function](const std::size_t begin, const std::size_t end)
+		{
+			for (std::size_t row = begin; row < end; ++row)
+			{
+				function(row);
+			}
+		});
+	}
+
+	// Model matrix the mesh of an entity is drawn with
+	glm::mat4 ComputeMeshModelMatrix(const ComponentStore& componentStore, const Archetype& archetype, const std::size_t row)
+	{
+		glm::mat4 model = componentStore.GetTransformHierarchy().GetWorldMatrix(archetype.transformNodeIDs[row]);
+
+		// Shared unit meshes are sized here, so attached entities do not inherit the scale
+		if (archetype.Has(ComponentType::MESH_SCALE))
+		{
+			const float meshScale = archetype.meshScales[row];
+			model[0] *= meshScale;
+			model[1] *= meshScale;
+			model[2] *= meshScale;
+		}
+
+		return model;
+	}
+
+	void RenderRow(const ComponentStore& componentStore, const Archetype& archetype, const std::size_t row)
+	{
+		// Hidden legends are skipped before their material and glyph textures get bound
+		if (archetype.Has(ComponentType::BILLBOARD) && Application::GetInstance().IsLegendDisplayed() == false)
+		{
+			return;
+		}
+
+		IRenderable* const mesh = archetype.meshes[row];
+
+		// Entities without Material bind their own (e.g. Models with baked-in materials)
+		if (archetype.Has(ComponentType::MATERIAL) == false)
+		{
+			mesh->Render();
+			return;
+		}
+
+		const Material& material = *archetype.materials[row];
+		const Shader& shader = material.GetShader();
+		shader.Enable();
+
+		if (archetype.Has(ComponentType::TRANSFORM))
+		{
+			Renderer::SetTransformVUniform(shader, ComputeMeshModelMatrix(componentStore, archetype, row));
+		}
+
+		material.EnableTextures();
+		mesh->Render();
+		material.DisableTextures();
+
+		shader.Disable();
+	}
+}
+
+
+
+void SceneSystems::UpdateTransforms(ComponentStore& componentStore, const Camera& camera)
+{
+	UpdateBodyTransforms(componentStore);
+	componentStore.GetTransformHierarchy().Update();
+	UpdateBillboardTransforms(componentStore, camera);
+}
+
+void SceneSystems::UpdateBodyTransforms(ComponentStore& componentStore)
+{
+	constexpr ComponentMask requiredMask = ToComponentMask(ComponentType::TRANSFORM) | ToComponentMask(ComponentType::SPIN);
+
+	TransformHierarchy& transformHierarchy = componentStore.GetTransformHierarchy();
+
+	// Position, axial tilt and spin of all bodies have already been resolved in batch by the Orbital Kernel at Scene update
+	// (unchanged when paused, so bodies and everything attached to them are then skipped by the hierarchy update)
+	componentStore.ForEachArchetype(requiredMask, 0, [&transformHierarchy](Archetype& archetype)
+	{
+		ForEachRow(archetype, [&transformHierarchy, &archetype](const std::size_t row)
+		{
+			transformHierarchy.SetLocalMatrix(archetype.transformNodeIDs[row], archetype.bodyTables[row]->GetModelMatrix(archetype.bodyIndices[row]));
+		});
+	});
+}
+
+void SceneSystems::UpdateBillboardTransforms(ComponentStore& componentStore, const Camera& camera)
+{
+	if (Application::GetInstance().IsLegendDisplayed() == false)
+	{
+		return;
+	}
+
+	constexpr ComponentMask requiredMask = ToComponentMask(ComponentType::TRANSFORM) | ToComponentMask(ComponentType::BILLBOARD);
+
+	const glm::vec3 cameraPosition = camera.GetPosition();
+	const glm::vec3 cameraUp = camera.GetOrientation().GetUpVector();
+
+	TransformHierarchy& transformHierarchy = componentStore.GetTransformHierarchy();
+
+	componentStore.ForEachArchetype(requiredMask, 0, [&](Archetype& archetype)
+	{
+		ForEachRow(archetype, [&](const std::size_t row)
+		{
+			// Anchored to the parent position by the hierarchy update
+			const uint32_t nodeID = archetype.transformNodeIDs[row];
+			const glm::vec3 parentEntityPosition(transformHierarchy.GetWorldMatrix(nodeID)[3]);
+
+			// Orient text billboards so the correct side (i.e. with the glyphs rendered in the correct direction) always faces the camera (~ look at)
+			const glm::vec3 billboardForward = glm::normalize(cameraPosition - parentEntityPosition);
+			const glm::vec3 billboardRight = glm::cross(cameraUp, billboardForward);
+			const glm::vec3 billboardUp = glm::cross(billboardForward, billboardRight);
+
+			glm::mat4 model(1.0f);
+			model[0] = glm::vec4(billboardRight, 0.0f);
+			model[1] = glm::vec4(billboardUp, 0.0f);
+			model[2] = glm::vec4(billboardForward, 0.0f);
+			model[3] = glm::vec4(parentEntityPosition, 1.0f);
+
+			transformHierarchy.SetWorldMatrix(nodeID, model);
+		});
+	});
+}
+
+void SceneSystems::UpdateLightSources(ComponentStore& componentStore)
+{
+	constexpr ComponentMask requiredMask = ToComponentMask(ComponentType::TRANSFORM) | ToComponentMask(ComponentType::LIGHT_SOURCE);
+
+	const TransformHierarchy& transformHierarchy = componentStore.GetTransformHierarchy();
+
+	// Not split across threads, as it updates uniform buffers
+	componentStore.ForEachArchetype(requiredMask, 0, [&transformHierarchy](Archetype& archetype)
+	{
+		for (std::size_t row = 0; row < archetype.GetEntityCount(); ++row)
+		{
+			const glm::vec3 lightPosition(transformHierarchy.GetWorldMatrix(archetype.transformNodeIDs[row])[3]);
+			archetype.lightSources[row]->SetLightPositionFUniform(lightPosition);
+		}
+	});
+}
+
+void SceneSystems::CullEntities(ComponentStore& componentStore, const glm::mat4& projectionView)
+{
+	constexpr ComponentMask requiredMask = ToComponentMask(ComponentType::TRANSFORM) | ToComponentMask(ComponentType::BOUNDS);
+
+	const Frustum frustum(projectionView);
+	const TransformHierarchy& transformHierarchy = componentStore.GetTransformHierarchy();
+
+	componentStore.ForEachArchetype(requiredMask, 0, [&frustum, &transformHierarchy](Archetype& archetype)
+	{
+		ThreadPool::GetInstance().ParallelFor(archetype.GetEntityCount(), MIN_ENTITIES_PER_THREAD, [&](const std::size_t begin, const std::size_t end)
+		{
+			// World matrices are scattered in the hierarchy, so spheres are gathered into contiguous arrays first
+			constexpr std::size_t blockSize = 64;
+			alignas(16) std::array<float, blockSize> centersX{};
+			alignas(16) std::array<float, blockSize> centersY{};
+			alignas(16) std::array<float, blockSize> centersZ{};
+			alignas(16) std::array<float, blockSize> radii{};
+
+			for (std::size_t blockBegin = begin; blockBegin < end; blockBegin += blockSize)
+			{
+				const std::size_t blockCount = std::min(blockSize, end - blockBegin);
+				for (std::size_t i = 0; i < blockCount; ++i)
+				{
+					const std::size_t row = blockBegin + i;
+					const glm::mat4& worldMatrix = transformHierarchy.GetWorldMatrix(archetype.transformNodeIDs[row]);
+
+					centersX[i] = worldMatrix[3].x;
+					centersY[i] = worldMatrix[3].y;
+					centersZ[i] = worldMatrix[3].z;
+
+					// Largest axis scale, so spheres still enclose non-uniformly scaled geometry (e.g. elliptic orbits)
+					const float maxSquaredScale = std::max({ glm::dot(glm::vec3(worldMatrix[0]), glm::vec3(worldMatrix[0])),
+						glm::dot(glm::vec3(worldMatrix[1]), glm::vec3(worldMatrix[1])),
+						glm::dot(glm::vec3(worldMatrix[2]), glm::vec3(worldMatrix[2])) });
+					radii[i] = archetype.boundingRadii[row] * std::sqrt(maxSquaredScale);
+				}
+
+				frustum.IntersectSpheres(centersX.data(), centersY.data(), centersZ.data(), radii.data(), blockCount, &archetype.visibilityFlags[blockBegin]);
+			}
+		});
+	});
+
+	// Few entities with a few dozen chunks each, so not split across threads
+	componentStore.ForEachArchetype(ToComponentMask(ComponentType::INSTANCE_CHUNKS), 0, [&frustum](Archetype& archetype)
+	{
+		for (IChunkedInstances* const chunkedInstances : archetype.chunkedInstances)
+		{
+			chunkedInstances->CullChunks(frustum);
+		}
+	});
+}
+
+void SceneSystems::SelectDetailLevels(ComponentStore& componentStore, const Camera& camera, const float viewportHeight)
+{
+	constexpr ComponentMask requiredMask = ToComponentMask(ComponentType::TRANSFORM) | ToComponentMask(ComponentType::BOUNDS) | ToComponentMask(ComponentType::DETAIL_LEVELS);
+
+	// Screen radius of a sphere of radius r at distance d: r / d * (viewport height / 2) / tan(fovY / 2)
+	const float projectionScale = 0.5f * viewportHeight / glm::tan(0.5f * glm::radians(camera.GetFovY()));
+	const glm::vec3 cameraPosition = camera.GetPosition();
+
+	const TransformHierarchy& transformHierarchy = componentStore.GetTransformHierarchy();
+
+	componentStore.ForEachArchetype(requiredMask, 0, [&](Archetype& archetype)
+	{
+		ForEachRow(archetype, [&](const std::size_t row)
+		{
+			// Levels of culled entities are selected again once they are back in view
+			if (archetype.IsVisible(row) == false)
+			{
+				return;
+			}
+
+			const glm::mat4& worldMatrix = transformHierarchy.GetWorldMatrix(archetype.transformNodeIDs[row]);
+			const float radius = archetype.boundingRadii[row] * glm::length(glm::vec3(worldMatrix[0]));
+			const float distance = glm::length(glm::vec3(worldMatrix[3]) - cameraPosition);
+
+			// Camera inside the sphere: as close as it gets
+			const float projectedScreenRadius = distance > radius ? projectionScale * radius / distance : viewportHeight;
+			archetype.detailLevels[row]->SelectDetailLevel(projectedScreenRadius);
+		});
+	});
+}
+
+void SceneSystems::Render(const ComponentStore& componentStore, const RenderableType renderType)
+{
+	for (const Archetype& archetype : componentStore.GetArchetypes())
+	{
+		if (archetype.renderType != renderType || archetype.Has(ComponentType::MESH) == false)
+		{
+			continue;
+		}
+
+		for (std::size_t row = 0; row < archetype.GetEntityCount(); ++row)
+		{
+			if (archetype.IsVisible(row))
+			{
+				RenderRow(componentStore, archetype, row);
+			}
+		}
+	}
+}
+
+void SceneSystems::RenderInstances(const ComponentStore& componentStore, const RenderableType renderType, InstancedRenderer& instancedRenderer)
+{
+	constexpr ComponentMask requiredMask = ToComponentMask(ComponentType::TRANSFORM) | ToComponentMask(ComponentType::MATERIAL) | ToComponentMask(ComponentType::INSTANCED_MESH);
+
+	for (const Archetype& archetype : componentStore.GetArchetypes())
+	{
+		if (archetype.renderType != renderType || (archetype.mask & requiredMask) != requiredMask)
+		{
+			continue;
+		}
+
+		for (std::size_t row = 0; row < archetype.GetEntityCount(); ++row)
+		{
+			if (archetype.IsVisible(row) == false)
+			{
+				continue;
+			}
+
+			InstanceData instanceData;
+			instanceData.model = ComputeMeshModelMatrix(componentStore, archetype, row);
+			instanceData.textureLayer = static_cast<float>(archetype.textureLayers[row]);
+
+			instancedRenderer.AddInstance(archetype.materials[row]->GetShaderLookUpID(), archetype.textureArrayIndices[row],
+				archetype.instancedMeshes[row]->GetInstancedMesh(), instanceData);
+		}
+	}
+
+	instancedRenderer.Render();
+}
+
+void SceneSystems::Render(const ComponentStore& componentStore, const std::vector<EntityLocation>& locations)
+{
+	for (const EntityLocation& location : locations)
+	{
+		const Archetype& archetype = componentStore.GetArchetype(location.archetypeIndex);
+		if (archetype.Has(ComponentType::MESH))
+		{
+			RenderRow(componentStore, archetype, location.row);
+		}
+	}
+}
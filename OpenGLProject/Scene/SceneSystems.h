@@ -0,0 +1,56 @@
+#ifndef SCENE_SYSTEMS_H
+#define SCENE_SYSTEMS_H
+
+#include <glm/mat4x4.hpp>
+
+#include <cstddef> // std::size_t
+#include <vector>
+
+#include "ComponentStore.h"
+#include "Rendering/RenderQueue.h"
+
+class Camera;
+class InstancedRenderer;
+
+
+
+// Functions run every frame over Archetypes of the Component Store, each one only reading/writing the component arrays it needs. Rows are independent
+// within a system (entities only read components of their parent, written by a system run before), so large Archetypes are split across the Thread Pool
+namespace SceneSystems
+{
+	// Minimum amount of entities per batch when splitting an Archetype across threads (a row is cheap, so only large Archetypes are worth it)
+	constexpr std::size_t MIN_ENTITIES_PER_THREAD = 1024;
+
+	// Resolve the Model matrix of every entity: local matrices of bodies first (out of the Celestial Body Table), then the whole Transform Hierarchy
+	// in a single pass (skipping unchanged subtrees), and finally billboards, facing the camera at the position the hierarchy has anchored them to
+	void UpdateTransforms(ComponentStore& componentStore, const Camera& camera);
+
+	void UpdateBodyTransforms(ComponentStore& componentStore);
+	void UpdateBillboardTransforms(ComponentStore& componentStore, const Camera& camera);
+
+	// Move point lights to the position of the entity owning them
+	void UpdateLightSources(ComponentStore& componentStore);
+
+	// Flag entities whose World space bounding sphere intersects the frustum of the provided Projection-View matrix, the others being skipped by
+	// every pass (spheres gathered per block of rows, then tested several at once). Chunked instances (e.g. belts) cull their own chunks
+	void CullEntities(ComponentStore& componentStore, const glm::mat4& projectionView);
+
+	// Let visible entities with several levels of detail pick the one to draw, out of the radius of their World space bounding sphere
+	// projected on a viewport of the provided height [in pixels] (i.e. out of its distance to the camera and the camera field of view)
+	void SelectDetailLevels(ComponentStore& componentStore, const Camera& camera, const float viewportHeight);
+
+	// Draw every visible entity of the Archetypes rendered in the provided pass
+	void Render(const ComponentStore& componentStore, const RenderableType renderType);
+
+	// Draw every visible entity with an instanced mesh of the Archetypes rendered in the provided pass, with one draw call per shader, texture array
+	// and mesh they share (e.g. all celestial bodies at the same level of detail and texture resolution), whatever the amount of entities.
+	// Instances being drawn in batch order, entities with an instanced mesh are expected to be opaque
+	void RenderInstances(const ComponentStore& componentStore, const RenderableType renderType, InstancedRenderer& instancedRenderer);
+
+	// Draw entities in the provided order (e.g. sorted by distance to the camera)
+	void Render(const ComponentStore& componentStore, const std::vector<EntityLocation>& locations);
+};
+
+
+
+#endif // SCENE_SYSTEMS_H
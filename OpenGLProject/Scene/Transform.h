@@ -7,8 +7,6 @@
 #include <glm/vec4.hpp>
 
 #include <cstddef>		// std::size_t
-#include <functional>	// std::reference_wrapper
-#include <optional>
 
 
 
@@ -46,12 +44,12 @@ struct RotationMatrix
 	const glm::vec3 GetForwardVector() const { return matrix[2]; }
 };
 
-// Correspond to the Scene Transform (position, rotation, scale) of the Scene Entity
+// Correspond to the Scene Transform (position, rotation, scale) of the Scene Entity, i.e. hot data only (the Model matrix), read every frame.
+// Cold data used to build the rotation (Euler angles, LookAt vectors) lives in Orientation, only kept by objects steered by the user (e.g. cameras)
 class Transform
 {
 public:
 	Transform() = default;
-	Transform(const glm::vec3& position, const EulerAngles& rotation);
 
 	const glm::mat4& Get() const { return model; }
 	void Set(const glm::mat4& inModel) { model = inModel; }
@@ -62,18 +60,9 @@ public:
 	// Store position directly in Model matrix
 	void SetPosition(const glm::vec3& inPosition);
 
-	// Get rotation info out of local cache
-	const EulerAngles& GetRotation() const { return rotation; }
-
-	// Store rotation direcly in Model matrix (per column) and update Euler Angles by deduction
+	// Store rotation direcly in Model matrix (per column)
 	void SetRotation(const RotationMatrix& inRotation);
 
-	// Overwrite Euler Angles and update LookAt vectors accordingly
-	void SetRotation(const EulerAngles& inRotationInRad);
-
-	// Increment Euler Angles and update LookAt vectors accordingly
-	void UpdateRotation(const EulerAngles& newAngles);
-
 	void Reset();
 
 	// @todo - Methods below to be moved to Movement Component or similar?
@@ -89,14 +78,35 @@ public:
 	static constexpr size_t GetMatrixSizeInBytes() { return sizeof(model); }
 	static constexpr size_t GetColumnSizeInBytes() { return static_cast<size_t>(sizeof(model) * 0.25f); }
 
+private:
+	// Warning: ensure this is the only member variable, so we guarantee Transform data/size is always the same from Vertex buffers POV
+	glm::mat4 model{ 1.0f };
+};
+
+// Rotation steered by Euler angles, with the LookAt vectors deduced from them (cold data, only updated on user input)
+class Orientation
+{
+public:
+	Orientation() = default;
+	Orientation(const EulerAngles& inRotationInRad);
+
+	// Get rotation info out of local cache
+	const EulerAngles& GetRotation() const { return rotation; }
+
+	// Overwrite Euler Angles and update LookAt vectors accordingly
+	void SetRotation(const EulerAngles& inRotationInRad);
+
+	// Increment Euler Angles and update LookAt vectors accordingly
+	void UpdateRotation(const EulerAngles& newAngles);
+
+	// Gather LookAt vectors as the columns of a rotation matrix (to be stored in a Transform)
+	RotationMatrix GetRotationMatrix() const { return RotationMatrix{ rightVector, upVector, forwardVector }; }
+
 	const glm::vec3& GetUpVector() const { return upVector; }
 	const glm::vec3& GetRightVector() const { return rightVector; }
 	const glm::vec3& GetForwardVector() const { return forwardVector; }
 
 private:
-	// Warning: ensure this is the only member variable, so we guarantee Transform data/size is always the same from Vertex buffers POV
-	glm::mat4 model{ 1.0f };
-
 	// Euler angles [in radians] for embedded LookAt vectors (simpler to keep track as is, and save expensive computations per frame)
 	EulerAngles rotation;
 
@@ -104,11 +114,8 @@ private:
 	glm::vec3 rightVector{ 0.0f, 1.0f, 0.0f };
 	glm::vec3 upVector{ 1.0f, 0.0f, 0.0f };
 
-	// Compute new LookAt vectors Forward, Right, Up, before updating Model matrix
+	// Compute new LookAt vectors Forward, Right, Up
 	void UpdateLookAtVectors();
-
-	// Update Model matrix on a per-column basis (i.e. by LookAt vectors, provided or not)
-	void UpdateModelMatrix(std::optional<std::reference_wrapper<const RotationMatrix>> inRotation = std::nullopt);
 };
 
 
@@ -0,0 +1,230 @@
+#include "TransformHierarchy.h"
+
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+
+#include "Utils/ThreadPool.h"
+
+
+
+uint32_t TransformHierarchy::AddNode(const glm::mat4& localMatrix, const TransformInheritance inheritance)
+{
+	const uint32_t nodeIndex = static_cast<uint32_t>(nodeIDs.size());
+
+	uint32_t nodeID = static_cast<uint32_t>(nodeIndices.size());
+	if (freeNodeIDs.empty() == false)
+	{
+		nodeID = freeNodeIDs.back();
+		freeNodeIDs.pop_back();
+	}
+
+	localMatrices.push_back(localMatrix);
+	worldMatrices.push_back(localMatrix);
+	parentIndices.push_back(NO_PARENT_INDEX);
+	inheritances.push_back(inheritance);
+	localDirtyFlags.push_back(1);
+	worldChangedFlags.push_back(0);
+
+	depths.push_back(0);
+	nodeIDs.push_back(nodeID);
+
+	if (nodeID == nodeIndices.size())
+	{
+		nodeIndices.push_back(nodeIndex);
+	}
+	else
+	{
+		nodeIndices[nodeID] = nodeIndex;
+	}
+
+	// Appending a root after deeper nodes splits the levels apart
+	isOrderDirty = true;
+
+	return nodeID;
+}
+
+void TransformHierarchy::RemoveNode(const uint32_t nodeID)
+{
+	const uint32_t nodeIndex = nodeIndices[nodeID];
+	nodeIDs[nodeIndex] = NO_NODE_ID;
+	freeNodeIDs.push_back(nodeID);
+
+	isOrderDirty = true;
+}
+
+void TransformHierarchy::SetParent(const uint32_t nodeID, const uint32_t parentNodeID)
+{
+	if (nodeID >= nodeIndices.size() || parentNodeID >= nodeIndices.size() || nodeID == parentNodeID)
+	{
+		std::cout << "ERROR::TRANSFORM_HIERARCHY - Node " << nodeID << " cannot be attached to node " << parentNodeID << std::endl;
+		assert(false);
+		return;
+	}
+
+	const uint32_t nodeIndex = nodeIndices[nodeID];
+	parentIndices[nodeIndex] = nodeIndices[parentNodeID];
+	localDirtyFlags[nodeIndex] = 1;
+
+	isOrderDirty = true;
+}
+
+void TransformHierarchy::SetLocalMatrix(const uint32_t nodeID, const glm::mat4& localMatrix)
+{
+	const uint32_t nodeIndex = nodeIndices[nodeID];
+	if (localMatrices[nodeIndex] != localMatrix)
+	{
+		localMatrices[nodeIndex] = localMatrix;
+		localDirtyFlags[nodeIndex] = 1;
+	}
+}
+
+uint32_t TransformHierarchy::GetParentNodeID(const uint32_t nodeID) const
+{
+	const uint32_t parentIndex = parentIndices[nodeIndices[nodeID]];
+	return parentIndex == NO_PARENT_INDEX ? NO_PARENT_INDEX : nodeIDs[parentIndex];
+}
+
+void TransformHierarchy::Update()
+{
+	if (isOrderDirty)
+	{
+		SortByDepth();
+	}
+
+	// Levels are run one after the other, as each one reads world matrices written by the previous one
+	for (std::size_t level = 0; level < GetLevelCount(); ++level)
+	{
+		const std::size_t levelBegin = levelOffsets[level];
+		ThreadPool::GetInstance().ParallelFor(levelOffsets[level + 1] - levelBegin, MIN_NODES_PER_THREAD, [this, levelBegin](const std::size_t begin, const std::size_t end)
+		{
+			for (std::size_t i = levelBegin + begin; i < levelBegin + end; ++i)
+			{
+				UpdateNode(i);
+			}
+		});
+	}
+}
+
+void TransformHierarchy::UpdateNode(const std::size_t nodeIndex)
+{
+	const uint32_t parentIndex = parentIndices[nodeIndex];
+	const bool isInheritingParent = parentIndex != NO_PARENT_INDEX && inheritances[nodeIndex] != TransformInheritance::NONE;
+
+	const bool hasWorldMatrixChanged = localDirtyFlags[nodeIndex] != 0 || (isInheritingParent && worldChangedFlags[parentIndex] != 0);
+	worldChangedFlags[nodeIndex] = hasWorldMatrixChanged ? 1 : 0;
+	localDirtyFlags[nodeIndex] = 0;
+
+	if (hasWorldMatrixChanged == false)
+	{
+		return;
+	}
+
+	glm::mat4& worldMatrix = worldMatrices[nodeIndex];
+	if (isInheritingParent == false)
+	{
+		worldMatrix = localMatrices[nodeIndex];
+	}
+	else if (inheritances[nodeIndex] == TransformInheritance::FULL)
+	{
+		worldMatrix = worldMatrices[parentIndex] * localMatrices[nodeIndex];
+	}
+	else
+	{
+		worldMatrix = localMatrices[nodeIndex];
+		worldMatrix[3] += glm::vec4(glm::vec3(worldMatrices[parentIndex][3]), 0.0f);
+	}
+}
+
+void TransformHierarchy::SortByDepth()
+{
+	// Children of removed nodes become roots, world matrices being resolved again relative to World Space
+	for (std::size_t i = 0; i < nodeIDs.size(); ++i)
+	{
+		if (parentIndices[i] != NO_PARENT_INDEX && nodeIDs[parentIndices[i]] == NO_NODE_ID)
+		{
+			parentIndices[i] = NO_PARENT_INDEX;
+			localDirtyFlags[i] = 1;
+		}
+	}
+
+	const std::size_t nodeCount = nodeIDs.size();
+
+	// Walk up to the root of each node (hierarchies are shallow, so it is cheaper than sorting the nodes topologically first)
+	for (std::size_t i = 0; i < nodeCount; ++i)
+	{
+		uint32_t depth = 0;
+		for (uint32_t ancestorIndex = parentIndices[i]; ancestorIndex != NO_PARENT_INDEX; ancestorIndex = parentIndices[ancestorIndex])
+		{
+			if (++depth > nodeCount)
+			{
+				std::cout << "ERROR::TRANSFORM_HIERARCHY - Node " << nodeIDs[i] << " is its own ancestor" << std::endl;
+				assert(false);
+				return;
+			}
+		}
+
+		depths[i] = depth;
+	}
+
+	std::vector<uint32_t> sortedIndices(nodeCount);
+	std::iota(sortedIndices.begin(), sortedIndices.end(), 0);
+	sortedIndices.erase(std::remove_if(sortedIndices.begin(), sortedIndices.end(), [this](const uint32_t i) { return nodeIDs[i] == NO_NODE_ID; }), sortedIndices.end());
+	std::stable_sort(sortedIndices.begin(), sortedIndices.end(), [this](const uint32_t i1, const uint32_t i2) { return depths[i1] < depths[i2]; });
+
+	std::vector<uint32_t> newIndices(nodeCount, NO_PARENT_INDEX);
+	for (uint32_t newIndex = 0; newIndex < sortedIndices.size(); ++newIndex)
+	{
+		newIndices[sortedIndices[newIndex]] = newIndex;
+	}
+
+	// Gather every array in the new order
+	const auto Reorder = [&sortedIndices](auto& values)
+	{
+		std::remove_reference_t<decltype(values)> sortedValues;
+		sortedValues.reserve(values.size());
+		for (const uint32_t oldIndex : sortedIndices)
+		{
+			sortedValues.push_back(values[oldIndex]);
+		}
+
+		values = std::move(sortedValues);
+	};
+
+	Reorder(localMatrices);
+	Reorder(worldMatrices);
+	Reorder(parentIndices);
+	Reorder(inheritances);
+	Reorder(localDirtyFlags);
+	Reorder(worldChangedFlags);
+	Reorder(depths);
+	Reorder(nodeIDs);
+
+	for (uint32_t& parentIndex : parentIndices)
+	{
+		if (parentIndex != NO_PARENT_INDEX)
+		{
+			parentIndex = newIndices[parentIndex];
+		}
+	}
+
+	levelOffsets.clear();
+	for (uint32_t i = 0; i < nodeIDs.size(); ++i)
+	{
+		nodeIndices[nodeIDs[i]] = i;
+
+		while (levelOffsets.size() <= depths[i])
+		{
+			levelOffsets.push_back(i);
+		}
+	}
+	levelOffsets.push_back(static_cast<uint32_t>(nodeIDs.size()));
+
+	isOrderDirty = false;
+}
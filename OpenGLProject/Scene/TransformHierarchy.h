@@ -0,0 +1,119 @@
+#ifndef TRANSFORM_HIERARCHY_H
+#define TRANSFORM_HIERARCHY_H
+
+#include <glm/mat4x4.hpp>
+
+#include <cstddef> // std::size_t
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+
+
+// How the world matrix of a node is derived from the one of its parent
+enum class TransformInheritance : uint8_t
+{
+	// Local matrix already in World Space (e.g. bodies resolved by the Orbital Kernel), the parent only constraining the update order
+	NONE = 0,
+
+	// Local matrix offset by the parent position, ignoring its rotation/scale (e.g. orbits, billboards)
+	POSITION,
+
+	// Local matrix relative to the whole parent matrix (e.g. rings spinning and tilting with their body)
+	FULL,
+};
+
+// Parent/child attachment of all Scene Transforms, flattened into contiguous arrays sorted by depth (roots first), so a single linear pass
+// resolves every world matrix, each parent being always updated before its children. Nodes whose local matrix has not changed, and whose
+// parent world matrix has not either, are skipped, so static subtrees (e.g. orbits of planets, rings when paused) cost nothing per frame.
+// Nodes of the same depth (i.e. level) only read world matrices of the previous level, so each level is split across the Thread Pool.
+// Nodes are referred to by IDs that stay valid when arrays get sorted again
+class TransformHierarchy
+{
+public:
+	// Index value of a node that has no parent node
+	static constexpr uint32_t NO_PARENT_INDEX = std::numeric_limits<uint32_t>::max();
+
+	// Minimum amount of nodes per batch when splitting a level across threads (a node is cheap, so only wide levels are worth it)
+	static constexpr std::size_t MIN_NODES_PER_THREAD = 2048;
+
+	// Register a root node and return its ID, reusing the one of a removed node if any (world matrix resolved at next update)
+	uint32_t AddNode(const glm::mat4& localMatrix, const TransformInheritance inheritance);
+
+	// Unregister a node, its children becoming roots (arrays are compacted at next update)
+	void RemoveNode(const uint32_t nodeID);
+
+	// Attach a node to another one (nodes are sorted by depth again at next update)
+	void SetParent(const uint32_t nodeID, const uint32_t parentNodeID);
+
+	// Overwrite the local matrix of a node, only flagging it as dirty if the matrix has actually changed.
+	// Can be called on distinct nodes from several threads at once
+	void SetLocalMatrix(const uint32_t nodeID, const glm::mat4& localMatrix);
+
+	// Overwrite the world matrix of a leaf node after the update, for nodes also depending on data outside the hierarchy (e.g. billboards facing the camera)
+	void SetWorldMatrix(const uint32_t nodeID, const glm::mat4& worldMatrix) { worldMatrices[nodeIndices[nodeID]] = worldMatrix; }
+
+	const glm::mat4& GetWorldMatrix(const uint32_t nodeID) const { return worldMatrices[nodeIndices[nodeID]]; }
+
+	// Return the ID of the parent of a node, or NO_PARENT_INDEX
+	uint32_t GetParentNodeID(const uint32_t nodeID) const;
+
+	// Return whether the world matrix of a node has been resolved again by the last update
+	bool HasWorldMatrixChanged(const uint32_t nodeID) const { return worldChangedFlags[nodeIndices[nodeID]] != 0; }
+
+	// Resolve the world matrices of all dirty nodes and of their descendants, level by level
+	void Update();
+
+	std::size_t GetNodeCount() const { return nodeIDs.size(); }
+
+	// Return the amount of distinct depths, as of the last update
+	std::size_t GetLevelCount() const { return levelOffsets.empty() ? 0 : levelOffsets.size() - 1; }
+
+private:
+	// Hot data, read/written by the update pass (all sorted by depth)
+
+	std::vector<glm::mat4> localMatrices;
+	std::vector<glm::mat4> worldMatrices;
+
+	// Index of the parent node in the arrays (or NO_PARENT_INDEX), always lower than the index of the node itself once sorted
+	std::vector<uint32_t> parentIndices;
+
+	std::vector<TransformInheritance> inheritances;
+
+	// Set when the local matrix changes, cleared by the update pass
+	std::vector<uint8_t> localDirtyFlags;
+
+	// Set by the update pass for each world matrix it has resolved again
+	std::vector<uint8_t> worldChangedFlags;
+
+	// Cold data, only used when nodes are added/attached
+
+	// Number of ancestors of each node (sorted by depth)
+	std::vector<uint32_t> depths;
+
+	// Index of the first node of each level, plus the node count (so level L spans [levelOffsets[L], levelOffsets[L + 1][)
+	std::vector<uint32_t> levelOffsets;
+
+	// ID of the node stored at each index (or NO_NODE_ID for a removed node not compacted yet), and index of the node with each ID
+	std::vector<uint32_t> nodeIDs;
+	std::vector<uint32_t> nodeIndices;
+
+	static constexpr uint32_t NO_NODE_ID = std::numeric_limits<uint32_t>::max();
+
+	// IDs of removed nodes, reused by the next nodes added
+	std::vector<uint32_t> freeNodeIDs;
+
+	// Whether a node has been added/attached/removed since the last sort
+	bool isOrderDirty{ false };
+
+	// Sort all arrays by depth, keeping the order of addition between nodes of the same depth, and find where each level starts
+	// (removed nodes being dropped from the arrays)
+	void SortByDepth();
+
+	// Resolve the world matrix of the node stored at the provided index, if needed
+	void UpdateNode(const std::size_t nodeIndex);
+};
+
+
+
+#endif // TRANSFORM_HIERARCHY_H
@@ -0,0 +1,97 @@
+#include "BeltRockTable.h"
+
+#include <cstddef> // std::ptrdiff_t
+#include <iterator>
+#include <type_traits>
+
+
+
+uint32_t BeltRockTable::AddRock(const glm::vec3& periapsisAxis, const glm::vec3& semiMinorAxis, const float eccentricity, const double orbitFreq, const double orbitPhaseAtEpoch)
+{
+	const uint32_t rockIndex = static_cast<uint32_t>(GetRockCount());
+
+	orbitFreqs.push_back(orbitFreq);
+	orbitPhasesAtEpoch.push_back(orbitPhaseAtEpoch);
+	eccentricities.push_back(eccentricity);
+
+	periapsisAxes.push_back(periapsisAxis);
+	semiMinorAxes.push_back(semiMinorAxis);
+
+	meanAnomalies.push_back(0.0f);
+	sinEccentricAnomalies.push_back(0.0f);
+	cosEccentricAnomalies.push_back(1.0f);
+
+	positions.push_back(periapsisAxis * (1.0f - eccentricity));
+
+	return rockIndex;
+}
+
+void BeltRockTable::SetRock(const std::size_t rockIndex, const glm::vec3& periapsisAxis, const glm::vec3& semiMinorAxis, const float eccentricity, const double orbitFreq, const double orbitPhaseAtEpoch)
+{
+	orbitFreqs[rockIndex] = orbitFreq;
+	orbitPhasesAtEpoch[rockIndex] = orbitPhaseAtEpoch;
+	eccentricities[rockIndex] = eccentricity;
+
+	periapsisAxes[rockIndex] = periapsisAxis;
+	semiMinorAxes[rockIndex] = semiMinorAxis;
+
+	meanAnomalies[rockIndex] = 0.0f;
+	sinEccentricAnomalies[rockIndex] = 0.0f;
+	cosEccentricAnomalies[rockIndex] = 1.0f;
+
+	positions[rockIndex] = periapsisAxis * (1.0f - eccentricity);
+}
+
+void BeltRockTable::Reserve(const std::size_t rockCount)
+{
+	orbitFreqs.reserve(rockCount);
+	orbitPhasesAtEpoch.reserve(rockCount);
+	eccentricities.reserve(rockCount);
+	periapsisAxes.reserve(rockCount);
+	semiMinorAxes.reserve(rockCount);
+	meanAnomalies.reserve(rockCount);
+	sinEccentricAnomalies.reserve(rockCount);
+	cosEccentricAnomalies.reserve(rockCount);
+	positions.reserve(rockCount);
+}
+
+void BeltRockTable::Resize(const std::size_t rockCount)
+{
+	orbitFreqs.resize(rockCount);
+	orbitPhasesAtEpoch.resize(rockCount);
+	eccentricities.resize(rockCount);
+	periapsisAxes.resize(rockCount);
+	semiMinorAxes.resize(rockCount);
+	meanAnomalies.resize(rockCount);
+	sinEccentricAnomalies.resize(rockCount);
+	cosEccentricAnomalies.resize(rockCount);
+	positions.resize(rockCount);
+}
+
+void BeltRockTable::ResizeRange(const std::size_t firstRockIndex, const std::size_t rockCount, const std::size_t newRockCount)
+{
+	const std::ptrdiff_t rangeEnd = static_cast<std::ptrdiff_t>(firstRockIndex + rockCount);
+	const std::ptrdiff_t newRangeEnd = static_cast<std::ptrdiff_t>(firstRockIndex + newRockCount);
+
+	const auto ResizeValueRange = [rangeEnd, newRangeEnd, rockCount, newRockCount](auto& values)
+	{
+		if (newRockCount > rockCount)
+		{
+			values.insert(std::next(values.begin(), rangeEnd), newRockCount - rockCount, typename std::remove_reference_t<decltype(values)>::value_type{});
+		}
+		else
+		{
+			values.erase(std::next(values.begin(), newRangeEnd), std::next(values.begin(), rangeEnd));
+		}
+	};
+
+	ResizeValueRange(orbitFreqs);
+	ResizeValueRange(orbitPhasesAtEpoch);
+	ResizeValueRange(eccentricities);
+	ResizeValueRange(periapsisAxes);
+	ResizeValueRange(semiMinorAxes);
+	ResizeValueRange(meanAnomalies);
+	ResizeValueRange(sinEccentricAnomalies);
+	ResizeValueRange(cosEccentricAnomalies);
+	ResizeValueRange(positions);
+}
@@ -0,0 +1,55 @@
+#ifndef BELT_ROCK_TABLE_H
+#define BELT_ROCK_TABLE_H
+
+#include <glm/vec3.hpp>
+
+#include <cstddef> // std::size_t
+#include <cstdint>
+#include <vector>
+
+
+
+// Simulation-side storage of the Keplerian orbit of every belt rock around the Star, laid out as a Structure of Arrays like the Celestial Body Table,
+// but only with what moving an instance along its orbit needs (rocks have no parent other than the Star, no spin, and their rotation/scale never change).
+// Rocks of all belts are stored in a single table, so the Orbital Kernel can advance them in batches split across threads
+class BeltRockTable
+{
+public:
+	// Register a rock and return its index in every array of the table
+	uint32_t AddRock(const glm::vec3& periapsisAxis, const glm::vec3& semiMinorAxis, const float eccentricity, const double orbitFreq, const double orbitPhaseAtEpoch);
+
+	// Overwrite the orbit of a rock already registered (e.g. after Resize(), by batches of rocks filled in parallel)
+	void SetRock(const std::size_t rockIndex, const glm::vec3& periapsisAxis, const glm::vec3& semiMinorAxis, const float eccentricity, const double orbitFreq, const double orbitPhaseAtEpoch);
+
+	void Reserve(const std::size_t rockCount);
+	void Resize(const std::size_t rockCount);
+
+	// Grow/shrink the range of rocks [firstRockIndex, firstRockIndex + rockCount[ (e.g. the rocks of a belt) to the new amount of rocks,
+	// rocks being added/removed at the end of the range, and rocks after it moving accordingly (added rocks still having to be set)
+	void ResizeRange(const std::size_t firstRockIndex, const std::size_t rockCount, const std::size_t newRockCount);
+
+	std::size_t GetRockCount() const { return eccentricities.size(); }
+
+	// Frequency for orbital motion, i.e. mean motion [in turns/Main Planet days]
+	std::vector<double> orbitFreqs;
+	// Mean anomaly of the rock on its orbit at epoch [in turns]
+	std::vector<double> orbitPhasesAtEpoch;
+	// Eccentricity of the orbit, in [0, 1[
+	std::vector<float> eccentricities;
+
+	// Orbit semi-axes in World Space: semi-major axis pointing to the periapsis, and semi-minor axis pointing to the rock position a quarter of eccentric anomaly later
+	std::vector<glm::vec3> periapsisAxes;
+	std::vector<glm::vec3> semiMinorAxes;
+
+	// Kernel intermediates: mean anomalies wrapped in [0, 2Pi[ [in radians], and sine/cosine of the eccentric anomalies
+	std::vector<float> meanAnomalies;
+	std::vector<float> sinEccentricAnomalies;
+	std::vector<float> cosEccentricAnomalies;
+
+	// Kernel outputs: positions in World Space, streamed to the instance buffers of the belts
+	std::vector<glm::vec3> positions;
+};
+
+
+
+#endif // BELT_ROCK_TABLE_H
@@ -0,0 +1,154 @@
+#include "CelestialBodyTable.h"
+
+#include <glm/exponential.hpp>
+#include <glm/mat3x3.hpp>
+#include <glm/trigonometric.hpp>
+
+#include <cassert>
+#include <iostream>
+
+#include "Entities/CelestialBodyEntity.h"
+#include "OrbitalKernel.h"
+
+
+
+uint32_t CelestialBodyTable::AddBody(const BodyData& bodyData, const int32_t parentIndex)
+{
+	const uint32_t bodyIndex = static_cast<uint32_t>(GetBodyCount());
+	if (parentIndex >= static_cast<int32_t>(bodyIndex))
+	{
+		std::cout << "ERROR::CELESTIAL_BODY_TABLE - Body " << bodyData.name << " has been added before its parent body!" << std::endl;
+		assert(false);
+	}
+
+	parentIndices.push_back(parentIndex);
+
+	// Motion parameters are filled below
+	orbitFreqs.push_back(0.0);
+	orbitPhasesAtEpoch.push_back(0.0);
+	eccentricities.push_back(0.0f);
+	spinFreqs.push_back(0.0);
+	spinPhasesAtEpoch.push_back(0.0);
+	periapsisAxes.emplace_back(0.0f);
+	semiMinorAxes.emplace_back(0.0f);
+	sinObliquities.push_back(0.0f);
+	cosObliquities.push_back(1.0f);
+
+	meanAnomalies.push_back(0.0f);
+	spinAngles.push_back(0.0f);
+
+	sinEccentricAnomalies.push_back(0.0f);
+	cosEccentricAnomalies.push_back(1.0f);
+	sinSpinAngles.push_back(0.0f);
+	cosSpinAngles.push_back(1.0f);
+
+	localPositions.emplace_back(0.0f);
+	modelMatrices.emplace_back(1.0f);
+
+	SetBody(bodyIndex, bodyData);
+
+	return bodyIndex;
+}
+
+void CelestialBodyTable::SetBody(const uint32_t bodyIndex, const BodyData& bodyData)
+{
+	// Parabolic and hyperbolic trajectories are not handled by the Kepler equation solved by the Orbital Kernel
+	if (bodyData.eccentricity < 0.0f || bodyData.eccentricity >= 1.0f)
+	{
+		std::cout << "ERROR::CELESTIAL_BODY_TABLE - Body " << bodyData.name << " does not have an elliptical orbit (eccentricity " << bodyData.eccentricity << ")!" << std::endl;
+		assert(false);
+	}
+
+	orbitFreqs[bodyIndex] = bodyData.orbitalPeriod == 0.0f ? 0.0 : 1.0 / static_cast<double>(bodyData.orbitalPeriod);
+	orbitPhasesAtEpoch[bodyIndex] = static_cast<double>(bodyData.meanAnomalyAtEpoch) / 360.0;
+	eccentricities[bodyIndex] = bodyData.eccentricity;
+
+	spinFreqs[bodyIndex] = bodyData.spinPeriod == 0.0f ? 0.0 : 1.0 / static_cast<double>(bodyData.spinPeriod);
+	spinPhasesAtEpoch[bodyIndex] = 0.0;
+
+	// Distance to parent is considered as the semi-major axis of the orbit
+	const glm::mat3 orbitalFrame = OrbitalKernel::ComputeOrbitalFrame(bodyData);
+	const float semiMinorAxisLength = bodyData.distanceToParent * glm::sqrt(1.0f - bodyData.eccentricity * bodyData.eccentricity);
+	periapsisAxes[bodyIndex] = bodyData.distanceToParent * orbitalFrame[2];
+	semiMinorAxes[bodyIndex] = semiMinorAxisLength * orbitalFrame[0];
+
+	const float obliquityInRad = glm::radians(bodyData.obliquity);
+	sinObliquities[bodyIndex] = glm::sin(obliquityInRad);
+	cosObliquities[bodyIndex] = glm::cos(obliquityInRad);
+}
+
+std::vector<int32_t> CelestialBodyTable::RemoveBodies(const std::vector<uint8_t>& removedFlags)
+{
+	std::vector<int32_t> newIndices(GetBodyCount(), NO_PARENT_INDEX);
+
+	int32_t keptCount = 0;
+	for (std::size_t i = 0; i < GetBodyCount(); ++i)
+	{
+		if (removedFlags[i] != 0)
+		{
+			continue;
+		}
+
+		const int32_t parentIndex = parentIndices[i];
+		if (parentIndex != NO_PARENT_INDEX && removedFlags[static_cast<std::size_t>(parentIndex)] != 0)
+		{
+			std::cout << "ERROR::CELESTIAL_BODY_TABLE - Body " << i << " is kept while its parent body is removed!" << std::endl;
+			assert(false);
+			return std::vector<int32_t>();
+		}
+
+		newIndices[i] = keptCount++;
+	}
+
+	// Parents being kept before their satellites, satellites stay after their parent once compacted
+	for (int32_t& parentIndex : parentIndices)
+	{
+		if (parentIndex != NO_PARENT_INDEX)
+		{
+			parentIndex = newIndices[static_cast<std::size_t>(parentIndex)];
+		}
+	}
+
+	CompactRows(parentIndices, newIndices);
+	CompactRows(orbitFreqs, newIndices);
+	CompactRows(orbitPhasesAtEpoch, newIndices);
+	CompactRows(eccentricities, newIndices);
+	CompactRows(spinFreqs, newIndices);
+	CompactRows(spinPhasesAtEpoch, newIndices);
+	CompactRows(periapsisAxes, newIndices);
+	CompactRows(semiMinorAxes, newIndices);
+	CompactRows(sinObliquities, newIndices);
+	CompactRows(cosObliquities, newIndices);
+	CompactRows(meanAnomalies, newIndices);
+	CompactRows(spinAngles, newIndices);
+	CompactRows(sinEccentricAnomalies, newIndices);
+	CompactRows(cosEccentricAnomalies, newIndices);
+	CompactRows(sinSpinAngles, newIndices);
+	CompactRows(cosSpinAngles, newIndices);
+	CompactRows(localPositions, newIndices);
+	CompactRows(modelMatrices, newIndices);
+
+	return newIndices;
+}
+
+void CelestialBodyTable::Reserve(const std::size_t bodyCount)
+{
+	parentIndices.reserve(bodyCount);
+	orbitFreqs.reserve(bodyCount);
+	orbitPhasesAtEpoch.reserve(bodyCount);
+	eccentricities.reserve(bodyCount);
+	spinFreqs.reserve(bodyCount);
+	spinPhasesAtEpoch.reserve(bodyCount);
+	periapsisAxes.reserve(bodyCount);
+	semiMinorAxes.reserve(bodyCount);
+	sinObliquities.reserve(bodyCount);
+	cosObliquities.reserve(bodyCount);
+	meanAnomalies.reserve(bodyCount);
+	spinAngles.reserve(bodyCount);
+	sinEccentricAnomalies.reserve(bodyCount);
+	cosEccentricAnomalies.reserve(bodyCount);
+	sinSpinAngles.reserve(bodyCount);
+	cosSpinAngles.reserve(bodyCount);
+	localPositions.reserve(bodyCount);
+	modelMatrices.reserve(bodyCount);
+}
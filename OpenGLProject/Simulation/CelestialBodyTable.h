@@ -0,0 +1,105 @@
+#ifndef CELESTIAL_BODY_TABLE_H
+#define CELESTIAL_BODY_TABLE_H
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+#include <cstddef> // std::size_t
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+struct BodyData;
+
+
+
+// Simulation-side storage of all celestial body motion parameters, laid out as a Structure of Arrays (one contiguous array per parameter)
+// so the Orbital Kernel can advance every body in a single batched pass, instead of each Celestial Body Entity doing it on its own.
+// Warning: bodies must be added parents first, so a single linear pass is enough to resolve satellite positions
+class CelestialBodyTable
+{
+public:
+	// Index value of a body that has no parent body (i.e. orbiting the origin of the Scene)
+	static constexpr int32_t NO_PARENT_INDEX = -1;
+
+	// Register a body and return its index in every array of the table
+	uint32_t AddBody(const BodyData& bodyData, const int32_t parentIndex = NO_PARENT_INDEX);
+
+	// Overwrite the motion parameters of a body already registered (e.g. after its data has been edited), its parent staying the same
+	void SetBody(const uint32_t bodyIndex, const BodyData& bodyData);
+
+	// Remove every flagged body (descendants of a flagged body must be flagged as well), the remaining ones keeping their order,
+	// and return the new index of each body (or NO_PARENT_INDEX for removed ones)
+	std::vector<int32_t> RemoveBodies(const std::vector<uint8_t>& removedFlags);
+
+	// Move values of the bodies kept by a removal to their new index, for arrays stored alongside the table (one value per body)
+	template<typename ValueType>
+	static void CompactRows(std::vector<ValueType>& values, const std::vector<int32_t>& newIndices);
+
+	void Reserve(const std::size_t bodyCount);
+
+	std::size_t GetBodyCount() const { return parentIndices.size(); }
+
+	const glm::vec3 GetPosition(const uint32_t bodyIndex) const { return glm::vec3(modelMatrices[bodyIndex][3]); }
+	const glm::mat4& GetModelMatrix(const uint32_t bodyIndex) const { return modelMatrices[bodyIndex]; }
+
+	// Index of the parent body (or NO_PARENT_INDEX), always lower than the index of the body itself
+	std::vector<int32_t> parentIndices;
+
+	// Frequency for orbital motion, i.e. mean motion [in turns/Main Planet days], in double precision so phases can be evaluated far from the epoch
+	std::vector<double> orbitFreqs;
+	// Mean anomaly of the body on its orbit at epoch [in turns]
+	std::vector<double> orbitPhasesAtEpoch;
+	// Eccentricity of the orbit, in [0, 1[ (0 being a circular orbit)
+	std::vector<float> eccentricities;
+
+	// Frequency for spin motion [in turns/Main Planet days]
+	std::vector<double> spinFreqs;
+	// Angle of the body around its spin axis at epoch [in turns]
+	std::vector<double> spinPhasesAtEpoch;
+
+	// Orbit semi-axes in World Space (constant over time, so only computed once): semi-major axis pointing to the periapsis,
+	// and semi-minor axis pointing to the body position a quarter of eccentric anomaly later
+	std::vector<glm::vec3> periapsisAxes;
+	std::vector<glm::vec3> semiMinorAxes;
+
+	// Sine/cosine of the obliquity (constant over time, so only computed once)
+	std::vector<float> sinObliquities;
+	std::vector<float> cosObliquities;
+
+	// Kernel intermediates: mean anomalies and spin angles at the simulated date, wrapped in [0, 2Pi[ [in radians]
+	std::vector<float> meanAnomalies;
+	std::vector<float> spinAngles;
+
+	// Kernel intermediates: sine/cosine of the eccentric anomalies and spin angles, computed in batch before Model matrices are assembled
+	std::vector<float> sinEccentricAnomalies;
+	std::vector<float> cosEccentricAnomalies;
+	std::vector<float> sinSpinAngles;
+	std::vector<float> cosSpinAngles;
+
+	// Kernel intermediates: positions relative to the parent body
+	std::vector<glm::vec3> localPositions;
+
+	// Kernel outputs: final Model matrices in World Space (position stored in the 4th column)
+	std::vector<glm::mat4> modelMatrices;
+};
+
+template<typename ValueType>
+void CelestialBodyTable::CompactRows(std::vector<ValueType>& values, const std::vector<int32_t>& newIndices)
+{
+	// New indices are never greater than old ones, so values can be moved in place front to back
+	std::size_t keptCount = 0;
+	for (std::size_t i = 0; i < newIndices.size(); ++i)
+	{
+		if (newIndices[i] != NO_PARENT_INDEX)
+		{
+			values[keptCount++] = std::move(values[i]);
+		}
+	}
+
+	values.resize(keptCount);
+}
+
+
+
+#endif // CELESTIAL_BODY_TABLE_H
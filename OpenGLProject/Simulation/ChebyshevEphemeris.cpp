@@ -0,0 +1,271 @@
+#include "ChebyshevEphemeris.h"
+
+#include <glm/ext/scalar_constants.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "CelestialBodyTable.h"
+
+namespace
+{
+	constexpr uint32_t ephemerisVersion = 1;
+
+	// FNV-1a hash, accumulated over raw bytes
+	void HashBytes(uint64_t& hash, const void* bytes, const std::size_t size)
+	{
+		const unsigned char* const byteArray = static_cast<const unsigned char*>(bytes);
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			hash ^= byteArray[i];
+			hash *= 1099511628211ull;
+		}
+	}
+
+	template<typename ValueType>
+	void HashArray(uint64_t& hash, const std::vector<ValueType>& values)
+	{
+		HashBytes(hash, values.data(), values.size() * sizeof(ValueType));
+	}
+
+	// Whether the coefficients of a body fit in the available ones, without overflowing while computing where they end
+	bool IsRecordInBounds(const uint64_t coefficientOffset, const uint32_t segmentCount, const uint64_t segmentCoefficientCount, const uint64_t availableCoefficientCount)
+	{
+		return coefficientOffset <= availableCoefficientCount && segmentCount <= (availableCoefficientCount - coefficientOffset) / segmentCoefficientCount;
+	}
+}
+
+
+
+bool ChebyshevEphemeris::Build(const CelestialBodyTable& table, const PositionSampler& sampler, const EphemerisParams& params, const uint64_t fingerprint, const std::filesystem::path& filePath)
+{
+	const uint32_t bodyCount = static_cast<uint32_t>(table.GetBodyCount());
+	const uint32_t coefficientCount = params.coefficientCount;
+
+	// Segment layout of each body, so coefficient offsets are known before fitting
+	std::vector<BodyRecord> records(bodyCount);
+	uint64_t totalCoefficientCount = 0;
+	for (uint32_t i = 0; i < bodyCount; ++i)
+	{
+		// Bodies without orbital motion (e.g. the Sun) get a single segment over the whole time span
+		const double orbitalPeriod = table.orbitFreqs[i] == 0.0 ? params.timeSpan : 1.0 / std::abs(table.orbitFreqs[i]);
+
+		// Eccentric orbits need shorter segments, as the body speeds up by (1 + e) / (1 - e) between apoapsis and periapsis
+		const double eccentricity = static_cast<double>(table.eccentricities[i]);
+		const double segmentsPerOrbit = params.segmentsPerOrbit * (1.0 + eccentricity) / (1.0 - eccentricity);
+		const double segmentSpan = std::min(params.timeSpan, orbitalPeriod / segmentsPerOrbit);
+
+		records[i].segmentCount = static_cast<uint32_t>(std::ceil(params.timeSpan / segmentSpan));
+		records[i].segmentSpan = params.timeSpan / records[i].segmentCount;
+		records[i].coefficientOffset = totalCoefficientCount;
+
+		totalCoefficientCount += static_cast<uint64_t>(records[i].segmentCount) * 3 * coefficientCount;
+	}
+
+	// Chebyshev nodes in [-1, 1], and cosine table used to project samples onto each polynomial degree
+	std::vector<double> nodes(coefficientCount);
+	std::vector<double> projections(static_cast<std::size_t>(coefficientCount) * coefficientCount);
+	for (uint32_t k = 0; k < coefficientCount; ++k)
+	{
+		const double nodeAngle = glm::pi<double>() * (k + 0.5) / coefficientCount;
+		nodes[k] = std::cos(nodeAngle);
+		for (uint32_t j = 0; j < coefficientCount; ++j)
+		{
+			projections[static_cast<std::size_t>(j) * coefficientCount + k] = std::cos(j * nodeAngle) * (j == 0 ? 1.0 : 2.0) / coefficientCount;
+		}
+	}
+
+	std::vector<float> fittedCoefficients(totalCoefficientCount);
+	std::vector<glm::dvec3> samples(coefficientCount);
+	for (uint32_t i = 0; i < bodyCount; ++i)
+	{
+		const BodyRecord& record = records[i];
+		float* bodyCoefficients = fittedCoefficients.data() + record.coefficientOffset;
+
+		for (uint32_t segment = 0; segment < record.segmentCount; ++segment)
+		{
+			const double segmentMiddle = params.startElapsedDays + (segment + 0.5) * record.segmentSpan;
+			for (uint32_t k = 0; k < coefficientCount; ++k)
+			{
+				samples[k] = sampler(i, segmentMiddle + 0.5 * record.segmentSpan * nodes[k]);
+			}
+
+			for (uint32_t axis = 0; axis < 3; ++axis)
+			{
+				for (uint32_t j = 0; j < coefficientCount; ++j)
+				{
+					double coefficient = 0.0;
+					for (uint32_t k = 0; k < coefficientCount; ++k)
+					{
+						coefficient += projections[static_cast<std::size_t>(j) * coefficientCount + k] * samples[k][axis];
+					}
+
+					*bodyCoefficients++ = static_cast<float>(coefficient);
+				}
+			}
+		}
+	}
+
+	std::filesystem::create_directories(filePath.parent_path());
+
+	std::ofstream fileStream(filePath, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (fileStream.fail())
+	{
+		std::cout << "ERROR::CHEBYSHEV_EPHEMERIS - File " << filePath.filename().string() << " could not be created!" << std::endl;
+		return false;
+	}
+
+	Header fileHeader;
+	fileHeader.version = ephemerisVersion;
+	fileHeader.fingerprint = fingerprint;
+	fileHeader.startElapsedDays = params.startElapsedDays;
+	fileHeader.timeSpan = params.timeSpan;
+	fileHeader.bodyCount = bodyCount;
+	fileHeader.coefficientCount = coefficientCount;
+
+	fileStream.write(reinterpret_cast<const char*>(&fileHeader), sizeof(Header));
+	fileStream.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(BodyRecord));
+	fileStream.write(reinterpret_cast<const char*>(fittedCoefficients.data()), fittedCoefficients.size() * sizeof(float));
+
+	return fileStream.good();
+}
+
+uint64_t ChebyshevEphemeris::ComputeFingerprint(const CelestialBodyTable& table, const EphemerisParams& params)
+{
+	uint64_t hash = 14695981039346656037ull;
+
+	HashBytes(hash, &ephemerisVersion, sizeof(ephemerisVersion));
+	HashBytes(hash, &params.startElapsedDays, sizeof(params.startElapsedDays));
+	HashBytes(hash, &params.timeSpan, sizeof(params.timeSpan));
+	HashBytes(hash, &params.segmentsPerOrbit, sizeof(params.segmentsPerOrbit));
+	HashBytes(hash, &params.coefficientCount, sizeof(params.coefficientCount));
+
+	HashArray(hash, table.orbitFreqs);
+	HashArray(hash, table.orbitPhasesAtEpoch);
+	HashArray(hash, table.eccentricities);
+	HashArray(hash, table.periapsisAxes);
+	HashArray(hash, table.semiMinorAxes);
+
+	return hash;
+}
+
+bool ChebyshevEphemeris::Open(const std::filesystem::path& filePath, const uint64_t expectedFingerprint, const std::size_t expectedBodyCount)
+{
+	Close();
+
+	if (file.Open(filePath) == false || file.GetSize() < sizeof(Header))
+	{
+		Close();
+		return false;
+	}
+
+	const char* const fileData = static_cast<const char*>(file.GetData());
+	const Header* const fileHeader = reinterpret_cast<const Header*>(fileData);
+
+	const Header defaultHeader;
+	if (std::memcmp(fileHeader->magic, defaultHeader.magic, sizeof(defaultHeader.magic)) != 0 || fileHeader->version != ephemerisVersion ||
+		fileHeader->fingerprint != expectedFingerprint || fileHeader->bodyCount != expectedBodyCount || fileHeader->bodyCount == 0 || fileHeader->coefficientCount == 0)
+	{
+		Close();
+		return false;
+	}
+
+	const BodyRecord* const records = reinterpret_cast<const BodyRecord*>(fileData + sizeof(Header));
+	const uint64_t coefficientsByteOffset = sizeof(Header) + static_cast<uint64_t>(fileHeader->bodyCount) * sizeof(BodyRecord);
+	if (file.GetSize() < coefficientsByteOffset)
+	{
+		std::cout << "ERROR::CHEBYSHEV_EPHEMERIS - File " << filePath.filename().string() << " is truncated, and will be rebuilt" << std::endl;
+		Close();
+		return false;
+	}
+
+	// Every body should read its coefficients within the file (checked before any of them is read, as records may be corrupted)
+	const uint64_t availableCoefficientCount = (file.GetSize() - coefficientsByteOffset) / sizeof(float);
+	const uint64_t segmentCoefficientCount = 3 * static_cast<uint64_t>(fileHeader->coefficientCount);
+	for (uint32_t i = 0; i < fileHeader->bodyCount; ++i)
+	{
+		const BodyRecord& record = records[i];
+		if (record.segmentCount == 0 || record.segmentSpan <= 0.0 ||
+			IsRecordInBounds(record.coefficientOffset, record.segmentCount, segmentCoefficientCount, availableCoefficientCount) == false)
+		{
+			std::cout << "ERROR::CHEBYSHEV_EPHEMERIS - File " << filePath.filename().string() << " has an invalid record for body " << i << ", and will be rebuilt" << std::endl;
+			Close();
+			return false;
+		}
+	}
+
+	// Coefficients of the last body end the file
+	const BodyRecord& lastRecord = records[fileHeader->bodyCount - 1];
+	const uint64_t totalCoefficientCount = lastRecord.coefficientOffset + lastRecord.segmentCount * segmentCoefficientCount;
+	if (file.GetSize() != coefficientsByteOffset + totalCoefficientCount * sizeof(float))
+	{
+		std::cout << "ERROR::CHEBYSHEV_EPHEMERIS - File " << filePath.filename().string() << " is truncated, and will be rebuilt" << std::endl;
+		Close();
+		return false;
+	}
+
+	header = fileHeader;
+	bodyRecords = records;
+	coefficients = reinterpret_cast<const float*>(fileData + coefficientsByteOffset);
+
+	return true;
+}
+
+void ChebyshevEphemeris::Close()
+{
+	file.Close();
+
+	header = nullptr;
+	bodyRecords = nullptr;
+	coefficients = nullptr;
+}
+
+bool ChebyshevEphemeris::IsCovering(const double elapsedDays) const
+{
+	return header != nullptr && elapsedDays >= header->startElapsedDays && elapsedDays <= header->startElapsedDays + header->timeSpan;
+}
+
+void ChebyshevEphemeris::Evaluate(const double elapsedDays, glm::vec3* outLocalPositions) const
+{
+	const uint32_t coefficientCount = header->coefficientCount;
+	const double timeSinceStart = elapsedDays - header->startElapsedDays;
+
+	for (uint32_t i = 0; i < header->bodyCount; ++i)
+	{
+		const BodyRecord& record = bodyRecords[i];
+
+		// Time span end belongs to the last segment
+		const double segmentTime = timeSinceStart / record.segmentSpan;
+		const uint32_t segment = std::min(static_cast<uint32_t>(segmentTime), record.segmentCount - 1);
+
+		// Normalised time in [-1, 1] within the segment (only this part needs to be converted to single precision)
+		const float x = static_cast<float>(2.0 * (segmentTime - segment) - 1.0);
+		const float twoX = 2.0f * x;
+
+		const float* segmentCoefficients = coefficients + record.coefficientOffset + static_cast<uint64_t>(segment) * 3 * coefficientCount;
+
+		// Clenshaw recurrence: b(j) = 2x * b(j + 1) - b(j + 2) + c(j), then f(x) = x * b(1) - b(2) + c(0)
+		glm::vec3 position(0.0f);
+		for (uint32_t axis = 0; axis < 3; ++axis)
+		{
+			const float* axisCoefficients = segmentCoefficients + axis * coefficientCount;
+
+			float b1 = 0.0f;
+			float b2 = 0.0f;
+			for (uint32_t j = coefficientCount - 1; j > 0; --j)
+			{
+				const float b0 = twoX * b1 - b2 + axisCoefficients[j];
+				b2 = b1;
+				b1 = b0;
+			}
+
+			position[axis] = x * b1 - b2 + axisCoefficients[0];
+		}
+
+		outLocalPositions[i] = position;
+	}
+}
@@ -0,0 +1,91 @@
+#ifndef CHEBYSHEV_EPHEMERIS_H
+#define CHEBYSHEV_EPHEMERIS_H
+
+#include <glm/vec3.hpp>
+
+#include <cstddef> // std::size_t
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+
+#include "Utils/MemoryMappedFile.h"
+
+class CelestialBodyTable;
+
+
+
+struct EphemerisParams
+{
+	// Time span covered by the ephemeris [in Main Planet days since the epoch]
+	double startElapsedDays{ 0.0 };
+	double timeSpan{ 7305.0 };
+
+	// Amount of segments a circular orbit is split into, each segment being fitted by its own polynomials (more for eccentric orbits)
+	uint32_t segmentsPerOrbit{ 2 };
+
+	// Amount of Chebyshev coefficients per segment and axis (i.e. polynomial degree + 1), the default reaching float precision with 2 segments per orbit
+	uint32_t coefficientCount{ 12 };
+};
+
+// Precomputed body positions relative to their parent, stored as piecewise Chebyshev polynomials (like JPL Development Ephemerides do),
+// in a binary file memory-mapped at runtime. Evaluating a position costs a few multiply-adds per axis (Clenshaw recurrence),
+// whatever the cost of the model positions have been fitted from.
+// File layout: header, then one record per body (segment span, segment count, offset of its coefficients), then all coefficients as floats,
+// ordered by body, segment, axis (X, Y, Z), then degree
+class ChebyshevEphemeris
+{
+public:
+	// Source of the positions to fit [in World Space units, relative to the parent body], for a given body index and amount of days since the epoch
+	using PositionSampler = std::function<glm::dvec3(const uint32_t bodyIndex, const double elapsedDays)>;
+
+	// Fit every body of the table out of the sampler over the time span of the parameters, and write the result to a binary file.
+	// Segment span of each body derives from its orbital period, so fast moons get many short segments and slow bodies a few long ones
+	static bool Build(const CelestialBodyTable& table, const PositionSampler& sampler, const EphemerisParams& params, const uint64_t fingerprint, const std::filesystem::path& filePath);
+
+	// Hash of everything the ephemeris content depends on (orbital data of the table, and fitting parameters), stored in the file header,
+	// so an outdated file is detected and rebuilt instead of being reused
+	static uint64_t ComputeFingerprint(const CelestialBodyTable& table, const EphemerisParams& params);
+
+	// Map an ephemeris file, and return whether it succeeded and matches the fingerprint/amount of bodies expected
+	bool Open(const std::filesystem::path& filePath, const uint64_t expectedFingerprint, const std::size_t expectedBodyCount);
+	void Close();
+
+	bool IsOpen() const { return file.IsOpen(); }
+
+	// Whether positions can be evaluated at the provided time [in Main Planet days since the epoch]
+	bool IsCovering(const double elapsedDays) const;
+
+	// Write the position of every body at the provided time (that should be covered by the ephemeris) into the output array
+	void Evaluate(const double elapsedDays, glm::vec3* outLocalPositions) const;
+
+private:
+	struct Header
+	{
+		char magic[4]{ 'C', 'H', 'E', 'B' };
+		uint32_t version{ 1 };
+		uint64_t fingerprint{ 0 };
+		double startElapsedDays{ 0.0 };
+		double timeSpan{ 0.0 };
+		uint32_t bodyCount{ 0 };
+		uint32_t coefficientCount{ 0 };
+	};
+
+	struct BodyRecord
+	{
+		double segmentSpan{ 0.0 };
+		uint32_t segmentCount{ 0 };
+		uint32_t padding{ 0 };
+		uint64_t coefficientOffset{ 0 };
+	};
+
+	MemoryMappedFile file;
+
+	// Non-owning views on the mapped file
+	const Header* header{ nullptr };
+	const BodyRecord* bodyRecords{ nullptr };
+	const float* coefficients{ nullptr };
+};
+
+
+
+#endif // CHEBYSHEV_EPHEMERIS_H
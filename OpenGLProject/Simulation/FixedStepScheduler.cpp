@@ -0,0 +1,54 @@
+#include "FixedStepScheduler.h"
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+
+
+
+FixedStepScheduler::FixedStepScheduler(const FixedStepParams& inParams) :
+	params(inParams),
+	stepSize(inParams.baseStepSize),
+	lastStepSize(inParams.baseStepSize)
+{
+	if (params.baseStepSize <= 0.0 || params.maxStepSize < params.baseStepSize || params.maxStepsPerFrame == 0)
+	{
+		std::cout << "ERROR::FIXED_STEP_SCHEDULER - Step sizes or step budget provided are invalid!" << std::endl;
+		assert(false);
+	}
+}
+
+uint32_t FixedStepScheduler::Accumulate(const double simulatedDeltaTime)
+{
+	accumulator += simulatedDeltaTime;
+
+	// Only power-of-two multiples of the base step size are used, so the same speed always leads to the same step sequence
+	stepSize = params.baseStepSize;
+	while (accumulator >= stepSize * params.maxStepsPerFrame && stepSize * 2.0 <= params.maxStepSize)
+	{
+		stepSize *= 2.0;
+	}
+
+	double stepCount = std::floor(accumulator / stepSize);
+	if (stepCount > params.maxStepsPerFrame)
+	{
+		// Better slow the simulation down than letting each frame take longer than the previous one
+		const double excessStepCount = stepCount - params.maxStepsPerFrame;
+		droppedTime += excessStepCount * stepSize;
+		accumulator -= excessStepCount * stepSize;
+		stepCount = params.maxStepsPerFrame;
+	}
+
+	accumulator -= stepCount * stepSize;
+	if (stepCount > 0.0)
+	{
+		lastStepSize = stepSize;
+	}
+
+	return static_cast<uint32_t>(stepCount);
+}
+
+void FixedStepScheduler::Reset()
+{
+	accumulator = 0.0;
+}
@@ -0,0 +1,62 @@
+#ifndef FIXED_STEP_SCHEDULER_H
+#define FIXED_STEP_SCHEDULER_H
+
+#include <cstdint>
+
+
+
+struct FixedStepParams
+{
+	// Step size used as long as the step budget allows it [in Main Planet days]
+	double baseStepSize{ 1.0 / 64.0 };
+
+	// Largest step size the simulation remains stable/accurate with [in Main Planet days]
+	double maxStepSize{ 4096.0 };
+
+	// Maximum amount of steps run per frame, bounding simulation cost whatever the simulation speed
+	uint32_t maxStepsPerFrame{ 8 };
+};
+
+// Split the (speed-scaled) time elapsed between frames into a whole amount of fixed-size simulation steps, so simulation results
+// do not depend on the display refresh rate. The remainder is carried over to the next frame, and exposed as an interpolation factor
+// so rendering can blend the last two simulated states.
+// When simulation speed is so high the step budget would be exceeded, the step size is doubled (up to its maximum) instead of running more steps
+class FixedStepScheduler
+{
+public:
+	FixedStepScheduler() = default;
+	FixedStepScheduler(const FixedStepParams& inParams);
+
+	// Add simulated time to consume [in Main Planet days], and return the amount of steps (all of size GetStepSize()) to run this frame
+	uint32_t Accumulate(const double simulatedDeltaTime);
+
+	// Forget any simulated time not consumed yet (e.g. after a jump in time)
+	void Reset();
+
+	// Size of the steps returned by the last call to Accumulate [in Main Planet days]
+	double GetStepSize() const { return stepSize; }
+
+	// Position of the rendered state between the last two simulation steps, in [0, 1[ (relative to the last step run, which may have been
+	// of another size than the current one when no step has been run this frame)
+	double GetInterpolationFactor() const { return accumulator / lastStepSize; }
+
+	// Simulated time that could not be consumed within the step budget even at max step size, i.e. how much the simulation lags behind [in Main Planet days]
+	double GetDroppedTime() const { return droppedTime; }
+
+private:
+	FixedStepParams params;
+
+	double stepSize{ params.baseStepSize };
+
+	// Size of the last step actually run, i.e. the span between the last two simulated states [in Main Planet days]
+	double lastStepSize{ params.baseStepSize };
+
+	// Simulated time not consumed by a whole step yet [in Main Planet days]
+	double accumulator{ 0.0 };
+
+	double droppedTime{ 0.0 };
+};
+
+
+
+#endif // FIXED_STEP_SCHEDULER_H
@@ -0,0 +1,193 @@
+#include "DormandPrinceIntegrator.h"
+
+#include <glm/common.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+
+#include "Simulation/NBodySystem.h"
+
+namespace
+{
+	// Butcher tableau of the method (lower triangular part, the 7th row being the 5th order solution weights)
+	constexpr double stageWeights[7][6] =
+	{
+		{ 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 },
+		{ 1.0 / 5.0, 0.0, 0.0, 0.0, 0.0, 0.0 },
+		{ 3.0 / 40.0, 9.0 / 40.0, 0.0, 0.0, 0.0, 0.0 },
+		{ 44.0 / 45.0, -56.0 / 15.0, 32.0 / 9.0, 0.0, 0.0, 0.0 },
+		{ 19372.0 / 6561.0, -25360.0 / 2187.0, 64448.0 / 6561.0, -212.0 / 729.0, 0.0, 0.0 },
+		{ 9017.0 / 3168.0, -355.0 / 33.0, 46732.0 / 5247.0, 49.0 / 176.0, -5103.0 / 18656.0, 0.0 },
+		{ 35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0, 11.0 / 84.0 },
+	};
+
+	// Difference between 5th and 4th order solution weights, giving the error estimate
+	constexpr double errorWeights[7] = { 71.0 / 57600.0, 0.0, -71.0 / 16695.0, 71.0 / 1920.0, -17253.0 / 339200.0, 22.0 / 525.0, -1.0 / 40.0 };
+
+	// Substep size changes are bounded, so a single bad estimate does not make it collapse or explode
+	constexpr double minScaleFactor = 0.2;
+	constexpr double maxScaleFactor = 5.0;
+	constexpr double safetyFactor = 0.9;
+
+	// Below this fraction of the step size, tolerance is considered out of reach
+	constexpr double minSubstepFraction = 1e-12;
+}
+
+
+
+void DormandPrinceIntegrator::Reset()
+{
+	substepSize = 0.0;
+	isFirstStageValid = false;
+}
+
+void DormandPrinceIntegrator::Step(NBodySystem& system, const double stepSize)
+{
+	const std::size_t stateSize = 6 * system.GetBodyCount();
+	if (state.size() != stateSize)
+	{
+		state.resize(stateSize);
+		stageState.resize(stateSize);
+		nextState.resize(stateSize);
+		for (std::vector<double>& stageDerivative : stageDerivatives)
+		{
+			stageDerivative.resize(stateSize);
+		}
+		isFirstStageValid = false;
+	}
+
+	LoadState(system, state);
+	if (substepSize == 0.0)
+	{
+		substepSize = stepSize;
+	}
+
+	double remainingTime = stepSize;
+	while (remainingTime > 0.0)
+	{
+		// The last substep is shortened to land exactly on the end of the step, without changing the size carried to the next step
+		const bool isShortened = substepSize >= remainingTime;
+		const double duration = isShortened ? remainingTime : substepSize;
+
+		const double error = TrySubstep(system, duration);
+		const double scaleFactor = glm::clamp(safetyFactor * std::pow(std::max(error, 1e-10), -0.2), minScaleFactor, maxScaleFactor);
+
+		if (error <= 1.0)
+		{
+			std::swap(state, nextState);
+			std::swap(stageDerivatives[0], stageDerivatives[STAGE_COUNT - 1]);
+			isFirstStageValid = true;
+			remainingTime = isShortened ? 0.0 : remainingTime - duration;
+
+			if (isShortened == false)
+			{
+				substepSize = duration * scaleFactor;
+			}
+		}
+		else
+		{
+			substepSize = duration * scaleFactor;
+			if (substepSize < stepSize * minSubstepFraction)
+			{
+				std::cout << "ERROR::DORMAND_PRINCE_INTEGRATOR - Tolerance cannot be met, step is left unfinished" << std::endl;
+				assert(false);
+				break;
+			}
+		}
+	}
+
+	StoreState(state, system);
+
+	// Accelerations computed last are the ones of the stored state only if the first stage was evaluated on it
+	system.InvalidateAccelerations();
+}
+
+double DormandPrinceIntegrator::TrySubstep(NBodySystem& system, const double duration)
+{
+	const std::size_t stateSize = state.size();
+
+	if (isFirstStageValid == false)
+	{
+		EvaluateDerivative(system, state, stageDerivatives[0]);
+		isFirstStageValid = true;
+	}
+
+	for (std::size_t stage = 1; stage < STAGE_COUNT; ++stage)
+	{
+		std::vector<double>& stageOutput = stage == STAGE_COUNT - 1 ? nextState : stageState;
+		for (std::size_t i = 0; i < stateSize; ++i)
+		{
+			double increment = 0.0;
+			for (std::size_t previousStage = 0; previousStage < stage; ++previousStage)
+			{
+				increment += stageWeights[stage][previousStage] * stageDerivatives[previousStage][i];
+			}
+
+			stageOutput[i] = state[i] + duration * increment;
+		}
+
+		EvaluateDerivative(system, stageOutput, stageDerivatives[stage]);
+	}
+
+	// Root mean square of the error of each component divided by its tolerance
+	double squaredErrorSum = 0.0;
+	for (std::size_t i = 0; i < stateSize; ++i)
+	{
+		double errorEstimate = 0.0;
+		for (std::size_t stage = 0; stage < STAGE_COUNT; ++stage)
+		{
+			errorEstimate += errorWeights[stage] * stageDerivatives[stage][i];
+		}
+		errorEstimate *= duration;
+
+		const double tolerance = ABSOLUTE_TOLERANCE + RELATIVE_TOLERANCE * std::max(std::abs(state[i]), std::abs(nextState[i]));
+		squaredErrorSum += (errorEstimate / tolerance) * (errorEstimate / tolerance);
+	}
+
+	return stateSize == 0 ? 0.0 : std::sqrt(squaredErrorSum / static_cast<double>(stateSize));
+}
+
+void DormandPrinceIntegrator::EvaluateDerivative(NBodySystem& system, const std::vector<double>& inState, std::vector<double>& outDerivative)
+{
+	const std::size_t bodyCount = system.GetBodyCount();
+
+	for (uint32_t i = 0; i < bodyCount; ++i)
+	{
+		system.SetPosition(i, glm::dvec3(inState[i], inState[bodyCount + i], inState[2 * bodyCount + i]));
+	}
+	system.ComputeAccelerations();
+
+	std::copy(inState.begin() + 3 * bodyCount, inState.end(), outDerivative.begin());
+	for (uint32_t i = 0; i < bodyCount; ++i)
+	{
+		const glm::dvec3 acceleration = system.GetAcceleration(i);
+		outDerivative[3 * bodyCount + i] = acceleration.x;
+		outDerivative[4 * bodyCount + i] = acceleration.y;
+		outDerivative[5 * bodyCount + i] = acceleration.z;
+	}
+}
+
+void DormandPrinceIntegrator::LoadState(const NBodySystem& system, std::vector<double>& outState)
+{
+	const std::size_t bodyCount = system.GetBodyCount();
+
+	std::copy(system.GetPositionsX().begin(), system.GetPositionsX().end(), outState.begin());
+	std::copy(system.GetPositionsY().begin(), system.GetPositionsY().end(), outState.begin() + bodyCount);
+	std::copy(system.GetPositionsZ().begin(), system.GetPositionsZ().end(), outState.begin() + 2 * bodyCount);
+	std::copy(system.GetVelocitiesX().begin(), system.GetVelocitiesX().end(), outState.begin() + 3 * bodyCount);
+	std::copy(system.GetVelocitiesY().begin(), system.GetVelocitiesY().end(), outState.begin() + 4 * bodyCount);
+	std::copy(system.GetVelocitiesZ().begin(), system.GetVelocitiesZ().end(), outState.begin() + 5 * bodyCount);
+}
+
+void DormandPrinceIntegrator::StoreState(const std::vector<double>& inState, NBodySystem& system)
+{
+	const std::size_t bodyCount = system.GetBodyCount();
+
+	for (uint32_t i = 0; i < bodyCount; ++i)
+	{
+		system.SetPosition(i, glm::dvec3(inState[i], inState[bodyCount + i], inState[2 * bodyCount + i]));
+		system.SetVelocity(i, glm::dvec3(inState[3 * bodyCount + i], inState[4 * bodyCount + i], inState[5 * bodyCount + i]));
+	}
+}
@@ -0,0 +1,54 @@
+#ifndef DORMAND_PRINCE_INTEGRATOR_H
+#define DORMAND_PRINCE_INTEGRATOR_H
+
+#include <array>
+#include <vector>
+
+#include "NBodyIntegrator.h"
+
+
+
+// Explicit Runge-Kutta 5(4) method (Dormand & Prince 1980): each step is split into substeps whose size adapts so the embedded error estimate
+// stays below the tolerance, substep size being carried from one step to the next. Not symplectic, so energy error keeps growing over time,
+// but accuracy is controlled directly rather than through step size
+class DormandPrinceIntegrator : public NBodyIntegrator
+{
+public:
+	// Per-component tolerance on positions [in AU] and velocities [in AU/day]: absolute + relative * |value|
+	static constexpr double ABSOLUTE_TOLERANCE = 1e-14;
+	static constexpr double RELATIVE_TOLERANCE = 1e-11;
+
+	void Step(NBodySystem& system, const double stepSize) override;
+
+	void Reset() override;
+
+	const char* GetName() const override { return "Dormand-Prince"; }
+
+private:
+	static constexpr std::size_t STAGE_COUNT = 7;
+
+	// Substep size accepted last [in days], 0 until the first substep
+	double substepSize{ 0.0 };
+
+	// Derivative at the start of the next substep, already computed as the last stage of the previous one ("First Same As Last" property)
+	bool isFirstStageValid{ false };
+
+	// State vectors laid out as positions X/Y/Z then velocities X/Y/Z of all bodies
+	std::vector<double> state;
+	std::vector<double> stageState;
+	std::vector<double> nextState;
+	std::array<std::vector<double>, STAGE_COUNT> stageDerivatives;
+
+	// Try a substep from the current state, return its error relative to the tolerance (accepted when not greater than 1)
+	double TrySubstep(NBodySystem& system, const double duration);
+
+	// Derivative of the state (velocities, then accelerations out of the system acceleration loop)
+	static void EvaluateDerivative(NBodySystem& system, const std::vector<double>& inState, std::vector<double>& outDerivative);
+
+	static void LoadState(const NBodySystem& system, std::vector<double>& outState);
+	static void StoreState(const std::vector<double>& inState, NBodySystem& system);
+};
+
+
+
+#endif // DORMAND_PRINCE_INTEGRATOR_H
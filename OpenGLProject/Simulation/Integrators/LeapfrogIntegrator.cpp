@@ -0,0 +1,25 @@
+#include "LeapfrogIntegrator.h"
+
+#include "Simulation/NBodySystem.h"
+
+
+
+void LeapfrogIntegrator::Step(NBodySystem& system, const double stepSize)
+{
+	KickDriftKick(system, stepSize);
+}
+
+void LeapfrogIntegrator::KickDriftKick(NBodySystem& system, const double stepSize)
+{
+	if (system.AreAccelerationsUpToDate() == false)
+	{
+		system.ComputeAccelerations();
+	}
+
+	system.Kick(0.5 * stepSize);
+	system.Drift(stepSize);
+
+	// Accelerations at the new positions remain valid for the first kick of the next step
+	system.ComputeAccelerations();
+	system.Kick(0.5 * stepSize);
+}
@@ -0,0 +1,22 @@
+#ifndef LEAPFROG_INTEGRATOR_H
+#define LEAPFROG_INTEGRATOR_H
+
+#include "NBodyIntegrator.h"
+
+
+
+// Kick-drift-kick leapfrog (i.e. velocity Verlet): symplectic, so energy error stays bounded over time instead of accumulating
+class LeapfrogIntegrator : public NBodyIntegrator
+{
+public:
+	void Step(NBodySystem& system, const double stepSize) override;
+
+	const char* GetName() const override { return "Leapfrog"; }
+
+	// Single kick-drift-kick sequence, reused as a building block by higher order compositions
+	static void KickDriftKick(NBodySystem& system, const double stepSize);
+};
+
+
+
+#endif // LEAPFROG_INTEGRATOR_H
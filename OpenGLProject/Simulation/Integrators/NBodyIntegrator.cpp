@@ -0,0 +1,30 @@
+#include "NBodyIntegrator.h"
+
+#include <cassert>
+#include <iostream>
+
+#include "DormandPrinceIntegrator.h"
+#include "LeapfrogIntegrator.h"
+#include "WisdomHolmanIntegrator.h"
+#include "YoshidaIntegrator.h"
+
+
+
+std::unique_ptr<NBodyIntegrator> NBodyIntegrator::Create(const NBodyIntegratorType integratorType)
+{
+	switch (integratorType)
+	{
+	case NBodyIntegratorType::LEAPFROG:
+		return std::make_unique<LeapfrogIntegrator>();
+	case NBodyIntegratorType::YOSHIDA4:
+		return std::make_unique<YoshidaIntegrator>();
+	case NBodyIntegratorType::WISDOM_HOLMAN:
+		return std::make_unique<WisdomHolmanIntegrator>();
+	case NBodyIntegratorType::DORMAND_PRINCE:
+		return std::make_unique<DormandPrinceIntegrator>();
+	default:
+		std::cout << "ERROR::N_BODY_INTEGRATOR - Unknown integrator type, leapfrog will be used instead" << std::endl;
+		assert(false);
+		return std::make_unique<LeapfrogIntegrator>();
+	}
+}
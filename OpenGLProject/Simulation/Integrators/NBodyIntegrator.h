@@ -0,0 +1,45 @@
+#ifndef N_BODY_INTEGRATOR_H
+#define N_BODY_INTEGRATOR_H
+
+#include <memory>
+
+class NBodySystem;
+
+
+
+// Integration schemes available to advance an N-Body System, from the cheapest to the most accurate per step depending on the scenario
+enum class NBodyIntegratorType
+{
+	// 2nd order symplectic (velocity Verlet), 1 acceleration evaluation per step
+	LEAPFROG = 0,
+	// 4th order symplectic (3 leapfrog substeps), 3 acceleration evaluations per step
+	YOSHIDA4,
+	// 2nd order symplectic, exact Kepler motion around the central body plus kicks from the other bodies, 1 acceleration evaluation per step
+	WISDOM_HOLMAN,
+	// 5th order explicit Runge-Kutta with embedded 4th order error estimate, substeps adapted to a tolerance (not symplectic)
+	DORMAND_PRINCE,
+	COUNT,
+};
+
+// Scheme moving an N-Body System state from one step to the next
+class NBodyIntegrator
+{
+public:
+	// Virtual destructor (needed, as class is not final)
+	virtual ~NBodyIntegrator() = default;
+
+	// Factory returning the integrator matching the provided type
+	static std::unique_ptr<NBodyIntegrator> Create(const NBodyIntegratorType integratorType);
+
+	// Advance positions/velocities of the system by the provided amount of time [in days]
+	virtual void Step(NBodySystem& system, const double stepSize) = 0;
+
+	// Forget any state carried from one step to the next (e.g. after the bodies of the system changed)
+	virtual void Reset() {}
+
+	virtual const char* GetName() const = 0;
+};
+
+
+
+#endif // N_BODY_INTEGRATOR_H
@@ -0,0 +1,217 @@
+#include "WisdomHolmanIntegrator.h"
+
+#include <glm/geometric.hpp>
+
+#include <cmath>
+#include <cstddef> // std::size_t
+#include <cstdint>
+
+#include "LeapfrogIntegrator.h"
+#include "Simulation/NBodySystem.h"
+
+namespace
+{
+	// Index of the body every Kepler orbit is computed around
+	constexpr std::size_t centralBodyIndex = 0;
+
+	// Stumpff functions c2(z) = (1 - cos(sqrt(z))) / z and c3(z) = (sqrt(z) - sin(sqrt(z))) / sqrt(z)^3, extended to negative z (hyperbolic orbits).
+	// Series are used close to 0, where closed forms lose precision to cancellation
+	void ComputeStumpffFunctions(const double z, double& outC2, double& outC3)
+	{
+		if (std::abs(z) < 1.0)
+		{
+			outC2 = 0.0;
+			outC3 = 0.0;
+
+			// c2 = sum of (-z)^k / (2k + 2)!, c3 = sum of (-z)^k / (2k + 3)!
+			double c2Term = 0.5;
+			double c3Term = 1.0 / 6.0;
+			for (uint32_t k = 0; k < 12; ++k)
+			{
+				outC2 += c2Term;
+				outC3 += c3Term;
+				c2Term *= -z / static_cast<double>((2 * k + 3) * (2 * k + 4));
+				c3Term *= -z / static_cast<double>((2 * k + 4) * (2 * k + 5));
+			}
+		}
+		else if (z > 0.0)
+		{
+			const double sqrtZ = std::sqrt(z);
+			outC2 = (1.0 - std::cos(sqrtZ)) / z;
+			outC3 = (sqrtZ - std::sin(sqrtZ)) / (z * sqrtZ);
+		}
+		else
+		{
+			const double sqrtMinusZ = std::sqrt(-z);
+			outC2 = (std::cosh(sqrtMinusZ) - 1.0) / -z;
+			outC3 = (std::sinh(sqrtMinusZ) - sqrtMinusZ) / (-z * sqrtMinusZ);
+		}
+	}
+}
+
+
+
+void WisdomHolmanIntegrator::Step(NBodySystem& system, const double stepSize)
+{
+	const std::size_t bodyCount = system.GetBodyCount();
+	if (bodyCount < 2 || system.GetMass(centralBodyIndex) == 0.0)
+	{
+		LeapfrogIntegrator::KickDriftKick(system, stepSize);
+		return;
+	}
+
+	double totalMass = 0.0;
+	glm::dvec3 weightedPositions(0.0);
+	glm::dvec3 totalMomentum(0.0);
+	for (uint32_t i = 0; i < bodyCount; ++i)
+	{
+		totalMass += system.GetMass(i);
+		weightedPositions += system.GetMass(i) * system.GetPosition(i);
+		totalMomentum += system.GetMass(i) * system.GetVelocity(i);
+	}
+	glm::dvec3 barycentrePosition = weightedPositions / totalMass;
+	const glm::dvec3 barycentreVelocity = totalMomentum / totalMass;
+
+	// Democratic heliocentric coordinates: positions relative to the central body, velocities relative to the barycentre
+	const glm::dvec3 centralBodyPosition = system.GetPosition(centralBodyIndex);
+	for (uint32_t i = 0; i < bodyCount; ++i)
+	{
+		system.SetPosition(i, system.GetPosition(i) - centralBodyPosition);
+		system.SetVelocity(i, system.GetVelocity(i) - barycentreVelocity);
+	}
+
+	const double halfStepSize = 0.5 * stepSize;
+
+	DriftCentralMomentum(system, halfStepSize);
+
+	// Kicks only account for the other bodies, the central one being handled by Kepler drifts
+	system.ComputeAccelerations(centralBodyIndex + 1);
+	system.Kick(halfStepSize);
+
+	const double centralGravitationalParam = system.GetGravitationalParam(centralBodyIndex);
+	for (uint32_t i = centralBodyIndex + 1; i < bodyCount; ++i)
+	{
+		glm::dvec3 position = system.GetPosition(i);
+		glm::dvec3 velocity = system.GetVelocity(i);
+		DriftKepler(centralGravitationalParam, position, velocity, stepSize);
+
+		system.SetPosition(i, position);
+		system.SetVelocity(i, velocity);
+	}
+
+	system.ComputeAccelerations(centralBodyIndex + 1);
+	system.Kick(halfStepSize);
+
+	DriftCentralMomentum(system, halfStepSize);
+
+	// Back to barycentric coordinates, the barycentre moving in straight line, and the central body state following from the others
+	glm::dvec3 weightedHeliocentricPositions(0.0);
+	glm::dvec3 barycentricMomentum(0.0);
+	for (uint32_t i = centralBodyIndex + 1; i < bodyCount; ++i)
+	{
+		weightedHeliocentricPositions += system.GetMass(i) * system.GetPosition(i);
+		barycentricMomentum += system.GetMass(i) * system.GetVelocity(i);
+	}
+
+	barycentrePosition += barycentreVelocity * stepSize;
+	const glm::dvec3 newCentralBodyPosition = barycentrePosition - weightedHeliocentricPositions / totalMass;
+	const glm::dvec3 newCentralBodyVelocity = barycentreVelocity - barycentricMomentum / system.GetMass(centralBodyIndex);
+
+	for (uint32_t i = centralBodyIndex + 1; i < bodyCount; ++i)
+	{
+		system.SetPosition(i, system.GetPosition(i) + newCentralBodyPosition);
+		system.SetVelocity(i, system.GetVelocity(i) + barycentreVelocity);
+	}
+
+	system.SetPosition(centralBodyIndex, newCentralBodyPosition);
+	system.SetVelocity(centralBodyIndex, newCentralBodyVelocity);
+
+	// Accelerations left in the system only account for part of the bodies
+	system.InvalidateAccelerations();
+}
+
+void WisdomHolmanIntegrator::DriftCentralMomentum(NBodySystem& system, const double duration)
+{
+	const std::size_t bodyCount = system.GetBodyCount();
+
+	glm::dvec3 momentum(0.0);
+	for (uint32_t i = centralBodyIndex + 1; i < bodyCount; ++i)
+	{
+		momentum += system.GetMass(i) * system.GetVelocity(i);
+	}
+
+	const glm::dvec3 displacement = momentum * (duration / system.GetMass(centralBodyIndex));
+	for (uint32_t i = centralBodyIndex + 1; i < bodyCount; ++i)
+	{
+		system.SetPosition(i, system.GetPosition(i) + displacement);
+	}
+}
+
+void WisdomHolmanIntegrator::DriftKepler(const double gravitationalParam, glm::dvec3& inOutPosition, glm::dvec3& inOutVelocity, const double duration)
+{
+	const double initialDistance = glm::length(inOutPosition);
+	if (initialDistance == 0.0 || gravitationalParam == 0.0)
+	{
+		inOutPosition += inOutVelocity * duration;
+		return;
+	}
+
+	const double sqrtGravitationalParam = std::sqrt(gravitationalParam);
+	const double radialFactor = glm::dot(inOutPosition, inOutVelocity) / sqrtGravitationalParam;
+	// Inverse of the semi-major axis (negative for hyperbolic orbits)
+	const double alpha = 2.0 / initialDistance - glm::dot(inOutVelocity, inOutVelocity) / gravitationalParam;
+
+	// Newton iterations on the universal anomaly, starting from its value for a circular orbit for ellipses, and from its asymptotic value
+	// for hyperbolas (Vallado), where Newton would otherwise only gain a constant amount per iteration on the exponential-like time of flight
+	double universalAnomaly = sqrtGravitationalParam * duration / initialDistance;
+	if (alpha > 0.0)
+	{
+		universalAnomaly = sqrtGravitationalParam * alpha * duration;
+	}
+	else if (alpha < 0.0)
+	{
+		const double semiMajorAxis = 1.0 / alpha;
+		const double direction = duration >= 0.0 ? 1.0 : -1.0;
+		const double denominator = glm::dot(inOutPosition, inOutVelocity) + direction * std::sqrt(-gravitationalParam * semiMajorAxis) * (1.0 - initialDistance * alpha);
+		const double logArgument = -2.0 * gravitationalParam * alpha * duration / denominator;
+		if (logArgument > 0.0)
+		{
+			universalAnomaly = direction * std::sqrt(-semiMajorAxis) * std::log(logArgument);
+		}
+	}
+
+	double c2 = 0.5;
+	double c3 = 1.0 / 6.0;
+	double distance = initialDistance;
+	for (uint32_t iteration = 0; iteration < 50; ++iteration)
+	{
+		const double squaredAnomaly = universalAnomaly * universalAnomaly;
+		ComputeStumpffFunctions(alpha * squaredAnomaly, c2, c3);
+
+		const double timeOfFlight = radialFactor * squaredAnomaly * c2 + (1.0 - alpha * initialDistance) * squaredAnomaly * universalAnomaly * c3 + initialDistance * universalAnomaly;
+		distance = radialFactor * universalAnomaly * (1.0 - alpha * squaredAnomaly * c3) + (1.0 - alpha * initialDistance) * squaredAnomaly * c2 + initialDistance;
+
+		const double correction = (timeOfFlight - sqrtGravitationalParam * duration) / distance;
+		universalAnomaly -= correction;
+		if (std::abs(correction) <= 1e-15 * std::abs(universalAnomaly))
+		{
+			break;
+		}
+	}
+
+	const double squaredAnomaly = universalAnomaly * universalAnomaly;
+	ComputeStumpffFunctions(alpha * squaredAnomaly, c2, c3);
+
+	// Lagrange f and g coefficients expressing the new state out of the initial one
+	const double f = 1.0 - squaredAnomaly * c2 / initialDistance;
+	const double g = duration - squaredAnomaly * universalAnomaly * c3 / sqrtGravitationalParam;
+
+	const glm::dvec3 position = f * inOutPosition + g * inOutVelocity;
+	distance = glm::length(position);
+
+	const double fDot = sqrtGravitationalParam / (distance * initialDistance) * universalAnomaly * (alpha * squaredAnomaly * c3 - 1.0);
+	const double gDot = 1.0 - squaredAnomaly * c2 / distance;
+
+	inOutVelocity = fDot * inOutPosition + gDot * inOutVelocity;
+	inOutPosition = position;
+}
@@ -0,0 +1,32 @@
+#ifndef WISDOM_HOLMAN_INTEGRATOR_H
+#define WISDOM_HOLMAN_INTEGRATOR_H
+
+#include <glm/vec3.hpp>
+
+#include "NBodyIntegrator.h"
+
+
+
+// Symplectic map splitting motion into exact Kepler orbits around the central body (index 0 of the system, e.g. the Sun) and kicks due to
+// all other bodies (Wisdom & Holman 1991), in democratic heliocentric coordinates (Duncan, Levison & Lee 1998).
+// Error scales with the ratio of the other bodies' attraction to the central one, instead of the full attraction like leapfrog does,
+// so it allows much larger steps for planets. Moons are strongly perturbed by their planet in this splitting though, and limit step size
+class WisdomHolmanIntegrator : public NBodyIntegrator
+{
+public:
+	void Step(NBodySystem& system, const double stepSize) override;
+
+	const char* GetName() const override { return "Wisdom-Holman"; }
+
+	// Move a body along its Kepler orbit around a fixed attractor of the provided gravitational parameter for the provided duration,
+	// solved in universal variables so any conic (elliptic or not) is handled
+	static void DriftKepler(const double gravitationalParam, glm::dvec3& inOutPosition, glm::dvec3& inOutVelocity, const double duration);
+
+private:
+	// Heliocentric positions move by the momentum of the central body (i.e. the opposite of all others) divided by its mass
+	static void DriftCentralMomentum(NBodySystem& system, const double duration);
+};
+
+
+
+#endif // WISDOM_HOLMAN_INTEGRATOR_H
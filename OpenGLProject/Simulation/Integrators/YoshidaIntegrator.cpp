@@ -0,0 +1,20 @@
+#include "YoshidaIntegrator.h"
+
+#include <cmath>
+
+#include "LeapfrogIntegrator.h"
+#include "Simulation/NBodySystem.h"
+
+
+
+void YoshidaIntegrator::Step(NBodySystem& system, const double stepSize)
+{
+	// w1 = 1 / (2 - 2^(1/3)), w0 = 1 - 2 * w1, so the 3rd order error terms of the substeps cancel out
+	static const double cubicRootOfTwo = std::cbrt(2.0);
+	static const double outerWeight = 1.0 / (2.0 - cubicRootOfTwo);
+	static const double innerWeight = 1.0 - 2.0 * outerWeight;
+
+	LeapfrogIntegrator::KickDriftKick(system, outerWeight * stepSize);
+	LeapfrogIntegrator::KickDriftKick(system, innerWeight * stepSize);
+	LeapfrogIntegrator::KickDriftKick(system, outerWeight * stepSize);
+}
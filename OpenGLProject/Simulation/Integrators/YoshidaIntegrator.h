@@ -0,0 +1,20 @@
+#ifndef YOSHIDA_INTEGRATOR_H
+#define YOSHIDA_INTEGRATOR_H
+
+#include "NBodyIntegrator.h"
+
+
+
+// 4th order symplectic integrator built out of 3 leapfrog substeps (Yoshida 1990), the middle one going backward in time.
+// Costs 3 times a leapfrog step, but error drops 16 times when step size is halved instead of 4
+class YoshidaIntegrator : public NBodyIntegrator
+{
+public:
+	void Step(NBodySystem& system, const double stepSize) override;
+
+	const char* GetName() const override { return "Yoshida4"; }
+};
+
+
+
+#endif // YOSHIDA_INTEGRATOR_H
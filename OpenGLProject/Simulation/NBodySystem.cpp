@@ -0,0 +1,441 @@
+#include "NBodySystem.h"
+
+#include <glm/geometric.hpp>
+
+#include <cmath>
+
+#include "CelestialBodyTable.h"
+#include "OrbitalKernel.h"
+#include "Utils/SIMDHelpers.h"
+#include "Utils/ThreadPool.h"
+
+
+
+NBodySystem::NBodySystem() :
+	integrator(NBodyIntegrator::Create(NBodyIntegratorType::LEAPFROG))
+{
+
+}
+
+NBodySystem::NBodySystem(NBodySystem&& inNBodySystem) noexcept = default;
+NBodySystem& NBodySystem::operator = (NBodySystem&& inNBodySystem) noexcept = default;
+
+NBodySystem::~NBodySystem() = default;
+
+uint32_t NBodySystem::AddBody(const double mass, const glm::dvec3& position, const glm::dvec3& velocity)
+{
+	const uint32_t bodyIndex = static_cast<uint32_t>(GetBodyCount());
+
+	masses.push_back(mass);
+	gravitationalParams.push_back(GRAVITATIONAL_CONSTANT * mass);
+
+	positionsX.push_back(position.x);
+	positionsY.push_back(position.y);
+	positionsZ.push_back(position.z);
+
+	velocitiesX.push_back(velocity.x);
+	velocitiesY.push_back(velocity.y);
+	velocitiesZ.push_back(velocity.z);
+
+	accelerationsX.push_back(0.0);
+	accelerationsY.push_back(0.0);
+	accelerationsZ.push_back(0.0);
+
+	previousPositionsX.push_back(position.x);
+	previousPositionsY.push_back(position.y);
+	previousPositionsZ.push_back(position.z);
+
+	areAccelerationsUpToDate = false;
+	isDriftReferenceSet = false;
+
+	return bodyIndex;
+}
+
+void NBodySystem::Reserve(const std::size_t bodyCount)
+{
+	for (std::vector<double>* const array : { &masses, &gravitationalParams, &positionsX, &positionsY, &positionsZ, &velocitiesX, &velocitiesY, &velocitiesZ,
+		&accelerationsX, &accelerationsY, &accelerationsZ, &previousPositionsX, &previousPositionsY, &previousPositionsZ })
+	{
+		array->reserve(bodyCount);
+	}
+}
+
+void NBodySystem::Clear()
+{
+	for (std::vector<double>* const array : { &masses, &gravitationalParams, &positionsX, &positionsY, &positionsZ, &velocitiesX, &velocitiesY, &velocitiesZ,
+		&accelerationsX, &accelerationsY, &accelerationsZ, &previousPositionsX, &previousPositionsY, &previousPositionsZ })
+	{
+		array->clear();
+	}
+
+	areAccelerationsUpToDate = false;
+	isDriftReferenceSet = false;
+	stepCount = 0;
+
+	integrator->Reset();
+}
+
+void NBodySystem::LoadKeplerianState(const CelestialBodyTable& table, const std::vector<double>& bodyMasses, const std::vector<double>& semiMajorAxes,
+	const std::vector<uint32_t>& attractorIndices, const double elapsedDays, std::vector<int32_t>& outNBodyIndices)
+{
+	const uint32_t bodyCount = static_cast<uint32_t>(table.GetBodyCount());
+
+	Clear();
+	Reserve(bodyCount);
+	outNBodyIndices.assign(bodyCount, -1);
+
+	// Absolute state of every body (massive or not, as a massive moon may orbit a body without mass), parents being resolved first
+	std::vector<glm::dvec3> positions(bodyCount, glm::dvec3(0.0));
+	std::vector<glm::dvec3> velocities(bodyCount, glm::dvec3(0.0));
+	for (uint32_t i = 0; i < bodyCount; ++i)
+	{
+		const double gravitationalParam = GRAVITATIONAL_CONSTANT * (bodyMasses[attractorIndices[i]] + bodyMasses[i]);
+		OrbitalKernel::ComputeStateVectorReference(table, i, elapsedDays, semiMajorAxes[i], gravitationalParam, positions[i], velocities[i]);
+
+		const int32_t parentIndex = table.parentIndices[i];
+		if (parentIndex != CelestialBodyTable::NO_PARENT_INDEX)
+		{
+			positions[i] += positions[parentIndex];
+			velocities[i] += velocities[parentIndex];
+		}
+
+		if (bodyMasses[i] > 0.0)
+		{
+			outNBodyIndices[i] = static_cast<int32_t>(AddBody(bodyMasses[i], positions[i], velocities[i]));
+		}
+	}
+
+	MoveToBarycentricFrame();
+	ResetDriftReference();
+}
+
+void NBodySystem::SetPosition(const uint32_t bodyIndex, const glm::dvec3& position)
+{
+	positionsX[bodyIndex] = position.x;
+	positionsY[bodyIndex] = position.y;
+	positionsZ[bodyIndex] = position.z;
+}
+
+void NBodySystem::SetVelocity(const uint32_t bodyIndex, const glm::dvec3& velocity)
+{
+	velocitiesX[bodyIndex] = velocity.x;
+	velocitiesY[bodyIndex] = velocity.y;
+	velocitiesZ[bodyIndex] = velocity.z;
+}
+
+glm::dvec3 NBodySystem::GetInterpolatedPosition(const uint32_t bodyIndex, const double interpolationFactor) const
+{
+	const glm::dvec3 previousPosition(previousPositionsX[bodyIndex], previousPositionsY[bodyIndex], previousPositionsZ[bodyIndex]);
+	return previousPosition + (GetPosition(bodyIndex) - previousPosition) * interpolationFactor;
+}
+
+void NBodySystem::MoveToBarycentricFrame()
+{
+	const std::size_t bodyCount = GetBodyCount();
+
+	double totalMass = 0.0;
+	glm::dvec3 weightedPositions(0.0);
+	glm::dvec3 weightedVelocities(0.0);
+	for (std::size_t i = 0; i < bodyCount; ++i)
+	{
+		totalMass += masses[i];
+		weightedPositions += masses[i] * glm::dvec3(positionsX[i], positionsY[i], positionsZ[i]);
+		weightedVelocities += masses[i] * glm::dvec3(velocitiesX[i], velocitiesY[i], velocitiesZ[i]);
+	}
+
+	if (totalMass == 0.0)
+	{
+		return;
+	}
+
+	const glm::dvec3 barycentrePosition = weightedPositions / totalMass;
+	const glm::dvec3 barycentreVelocity = weightedVelocities / totalMass;
+	for (std::size_t i = 0; i < bodyCount; ++i)
+	{
+		positionsX[i] -= barycentrePosition.x;
+		positionsY[i] -= barycentrePosition.y;
+		positionsZ[i] -= barycentrePosition.z;
+		previousPositionsX[i] = positionsX[i];
+		previousPositionsY[i] = positionsY[i];
+		previousPositionsZ[i] = positionsZ[i];
+
+		velocitiesX[i] -= barycentreVelocity.x;
+		velocitiesY[i] -= barycentreVelocity.y;
+		velocitiesZ[i] -= barycentreVelocity.z;
+	}
+
+	isDriftReferenceSet = false;
+}
+
+void NBodySystem::SetIntegrator(const NBodyIntegratorType integratorType)
+{
+	integrator = NBodyIntegrator::Create(integratorType);
+}
+
+void NBodySystem::Step(const double stepSize)
+{
+	if (isDriftReferenceSet == false)
+	{
+		ResetDriftReference();
+	}
+
+	previousPositionsX = positionsX;
+	previousPositionsY = positionsY;
+	previousPositionsZ = positionsZ;
+
+	integrator->Step(*this, stepSize);
+
+	++stepCount;
+}
+
+void NBodySystem::Kick(const double duration)
+{
+	for (std::size_t i = 0; i < GetBodyCount(); ++i)
+	{
+		velocitiesX[i] += accelerationsX[i] * duration;
+		velocitiesY[i] += accelerationsY[i] * duration;
+		velocitiesZ[i] += accelerationsZ[i] * duration;
+	}
+}
+
+void NBodySystem::Drift(const double duration)
+{
+	for (std::size_t i = 0; i < GetBodyCount(); ++i)
+	{
+		positionsX[i] += velocitiesX[i] * duration;
+		positionsY[i] += velocitiesY[i] * duration;
+		positionsZ[i] += velocitiesZ[i] * duration;
+	}
+
+	areAccelerationsUpToDate = false;
+}
+
+void NBodySystem::ComputeAccelerations(const std::size_t firstSourceIndex)
+{
+	const auto ComputeBatch = [this, firstSourceIndex](const std::size_t begin, const std::size_t end)
+	{
+		if (isSIMDEnabled)
+		{
+			ComputeAccelerationsSIMD(begin, end, firstSourceIndex);
+		}
+		else
+		{
+			ComputeAccelerationsScalar(begin, end, firstSourceIndex);
+		}
+	};
+
+	// Each batch only writes the accelerations of its own bodies, so batches can run concurrently without synchronisation
+	if (isMultithreadingEnabled)
+	{
+		ThreadPool::GetInstance().ParallelFor(GetBodyCount(), MIN_BODIES_PER_THREAD, ComputeBatch);
+	}
+	else
+	{
+		ComputeBatch(0, GetBodyCount());
+	}
+
+	// Accelerations due to a subset of bodies are not the ones a step can start from
+	areAccelerationsUpToDate = firstSourceIndex == 0;
+}
+
+void NBodySystem::ComputeAccelerationsScalar(const std::size_t begin, const std::size_t end, const std::size_t firstSourceIndex)
+{
+	const std::size_t bodyCount = GetBodyCount();
+
+	for (std::size_t i = begin; i < end; ++i)
+	{
+		double accelerationX = 0.0;
+		double accelerationY = 0.0;
+		double accelerationZ = 0.0;
+
+		for (std::size_t j = firstSourceIndex; j < bodyCount; ++j)
+		{
+			if (j == i)
+			{
+				continue;
+			}
+
+			const double deltaX = positionsX[j] - positionsX[i];
+			const double deltaY = positionsY[j] - positionsY[i];
+			const double deltaZ = positionsZ[j] - positionsZ[i];
+
+			// a = GM * d / |d|^3
+			const double squaredDistance = deltaX * deltaX + deltaY * deltaY + deltaZ * deltaZ;
+			const double factor = gravitationalParams[j] / (squaredDistance * std::sqrt(squaredDistance));
+
+			accelerationX += factor * deltaX;
+			accelerationY += factor * deltaY;
+			accelerationZ += factor * deltaZ;
+		}
+
+		accelerationsX[i] = accelerationX;
+		accelerationsY[i] = accelerationY;
+		accelerationsZ[i] = accelerationZ;
+	}
+}
+
+void NBodySystem::ComputeAccelerationsSIMD(const std::size_t begin, const std::size_t end, const std::size_t firstSourceIndex)
+{
+#if SIMD_SSE2_ENABLED
+	const std::size_t bodyCount = GetBodyCount();
+	const __m128d zeroLane = _mm_setzero_pd();
+	const __m128d oneLane = _mm_set1_pd(1.0);
+
+	for (std::size_t i = begin; i < end; ++i)
+	{
+		const __m128d positionX = _mm_set1_pd(positionsX[i]);
+		const __m128d positionY = _mm_set1_pd(positionsY[i]);
+		const __m128d positionZ = _mm_set1_pd(positionsZ[i]);
+
+		__m128d accelerationX = zeroLane;
+		__m128d accelerationY = zeroLane;
+		__m128d accelerationZ = zeroLane;
+
+		std::size_t j = firstSourceIndex;
+		for (; j + SIMDHelpers::DOUBLE_LANE_COUNT <= bodyCount; j += SIMDHelpers::DOUBLE_LANE_COUNT)
+		{
+			const __m128d deltaX = _mm_sub_pd(_mm_loadu_pd(positionsX.data() + j), positionX);
+			const __m128d deltaY = _mm_sub_pd(_mm_loadu_pd(positionsY.data() + j), positionY);
+			const __m128d deltaZ = _mm_sub_pd(_mm_loadu_pd(positionsZ.data() + j), positionZ);
+
+			const __m128d squaredDistance = _mm_add_pd(_mm_add_pd(_mm_mul_pd(deltaX, deltaX), _mm_mul_pd(deltaY, deltaY)), _mm_mul_pd(deltaZ, deltaZ));
+
+			// The body itself is at distance 0, where 1/0 gives infinity: mask it out rather than branching
+			const __m128d isOtherBody = _mm_cmpneq_pd(squaredDistance, zeroLane);
+			const __m128d inverseCubedDistance = _mm_and_pd(isOtherBody, _mm_div_pd(oneLane, _mm_mul_pd(squaredDistance, _mm_sqrt_pd(squaredDistance))));
+			const __m128d factor = _mm_mul_pd(_mm_loadu_pd(gravitationalParams.data() + j), inverseCubedDistance);
+
+			accelerationX = _mm_add_pd(accelerationX, _mm_mul_pd(factor, deltaX));
+			accelerationY = _mm_add_pd(accelerationY, _mm_mul_pd(factor, deltaY));
+			accelerationZ = _mm_add_pd(accelerationZ, _mm_mul_pd(factor, deltaZ));
+		}
+
+		// Horizontal sum of both lanes
+		double lanes[SIMDHelpers::DOUBLE_LANE_COUNT];
+		_mm_storeu_pd(lanes, accelerationX);
+		double sumX = lanes[0] + lanes[1];
+		_mm_storeu_pd(lanes, accelerationY);
+		double sumY = lanes[0] + lanes[1];
+		_mm_storeu_pd(lanes, accelerationZ);
+		double sumZ = lanes[0] + lanes[1];
+
+		// Remaining body not filling a whole SIMD register
+		for (; j < bodyCount; ++j)
+		{
+			if (j == i)
+			{
+				continue;
+			}
+
+			const double deltaX = positionsX[j] - positionsX[i];
+			const double deltaY = positionsY[j] - positionsY[i];
+			const double deltaZ = positionsZ[j] - positionsZ[i];
+			const double squaredDistance = deltaX * deltaX + deltaY * deltaY + deltaZ * deltaZ;
+			const double factor = gravitationalParams[j] / (squaredDistance * std::sqrt(squaredDistance));
+
+			sumX += factor * deltaX;
+			sumY += factor * deltaY;
+			sumZ += factor * deltaZ;
+		}
+
+		accelerationsX[i] = sumX;
+		accelerationsY[i] = sumY;
+		accelerationsZ[i] = sumZ;
+	}
+#else
+	ComputeAccelerationsScalar(begin, end, firstSourceIndex);
+#endif
+}
+
+void NBodySystem::SetComputeOptions(const bool inIsSIMDEnabled, const bool inIsMultithreadingEnabled)
+{
+	isSIMDEnabled = inIsSIMDEnabled;
+	isMultithreadingEnabled = inIsMultithreadingEnabled;
+}
+
+void NBodySystem::ResetDriftReference()
+{
+	referenceEnergy = ComputeTotalEnergy();
+	referenceMomentum = ComputeTotalMomentum();
+	referenceAngularMomentum = ComputeTotalAngularMomentum();
+	stepCount = 0;
+	isDriftReferenceSet = true;
+}
+
+NBodyDiagnostics NBodySystem::ComputeDiagnostics() const
+{
+	NBodyDiagnostics diagnostics;
+	diagnostics.stepCount = stepCount;
+	diagnostics.totalEnergy = ComputeTotalEnergy();
+
+	if (isDriftReferenceSet == false)
+	{
+		return diagnostics;
+	}
+
+	if (referenceEnergy != 0.0)
+	{
+		diagnostics.relativeEnergyDrift = std::abs((diagnostics.totalEnergy - referenceEnergy) / referenceEnergy);
+	}
+
+	// Total momentum is close to 0 in the barycentric frame, so its drift is compared to the momentum magnitudes at play instead
+	double momentumScale = 0.0;
+	for (std::size_t i = 0; i < GetBodyCount(); ++i)
+	{
+		momentumScale += masses[i] * glm::length(GetVelocity(static_cast<uint32_t>(i)));
+	}
+	if (momentumScale != 0.0)
+	{
+		diagnostics.relativeMomentumDrift = glm::length(ComputeTotalMomentum() - referenceMomentum) / momentumScale;
+	}
+
+	const double referenceAngularMomentumNorm = glm::length(referenceAngularMomentum);
+	if (referenceAngularMomentumNorm != 0.0)
+	{
+		diagnostics.relativeAngularMomentumDrift = glm::length(ComputeTotalAngularMomentum() - referenceAngularMomentum) / referenceAngularMomentumNorm;
+	}
+
+	return diagnostics;
+}
+
+double NBodySystem::ComputeTotalEnergy() const
+{
+	const std::size_t bodyCount = GetBodyCount();
+
+	double energy = 0.0;
+	for (std::size_t i = 0; i < bodyCount; ++i)
+	{
+		const glm::dvec3 position = GetPosition(static_cast<uint32_t>(i));
+		const glm::dvec3 velocity = GetVelocity(static_cast<uint32_t>(i));
+		energy += 0.5 * masses[i] * glm::dot(velocity, velocity);
+
+		for (std::size_t j = i + 1; j < bodyCount; ++j)
+		{
+			energy -= gravitationalParams[i] * masses[j] / glm::distance(position, GetPosition(static_cast<uint32_t>(j)));
+		}
+	}
+
+	return energy;
+}
+
+glm::dvec3 NBodySystem::ComputeTotalMomentum() const
+{
+	glm::dvec3 momentum(0.0);
+	for (std::size_t i = 0; i < GetBodyCount(); ++i)
+	{
+		momentum += masses[i] * GetVelocity(static_cast<uint32_t>(i));
+	}
+
+	return momentum;
+}
+
+glm::dvec3 NBodySystem::ComputeTotalAngularMomentum() const
+{
+	glm::dvec3 angularMomentum(0.0);
+	for (std::size_t i = 0; i < GetBodyCount(); ++i)
+	{
+		angularMomentum += masses[i] * glm::cross(GetPosition(static_cast<uint32_t>(i)), GetVelocity(static_cast<uint32_t>(i)));
+	}
+
+	return angularMomentum;
+}
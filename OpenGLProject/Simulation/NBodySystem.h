@@ -0,0 +1,172 @@
+#ifndef N_BODY_SYSTEM_H
+#define N_BODY_SYSTEM_H
+
+#include <glm/vec3.hpp>
+
+#include <cstddef> // std::size_t
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Integrators/NBodyIntegrator.h"
+
+class CelestialBodyTable;
+
+
+
+// Conserved quantities of an N-Body System, and how far they drifted from the reference taken when the integration started
+// (an exact integration would keep them constant, so drifts measure the accumulated integration error)
+struct NBodyDiagnostics
+{
+	uint64_t stepCount{ 0 };
+
+	// Kinetic plus potential energy [in kg.AU^2/days^2]
+	double totalEnergy{ 0.0 };
+	// |E - E0| / |E0|
+	double relativeEnergyDrift{ 0.0 };
+	// |P - P0| divided by the sum of momentum norms of all bodies
+	double relativeMomentumDrift{ 0.0 };
+	// |L - L0| / |L0|
+	double relativeAngularMomentumDrift{ 0.0 };
+};
+
+// Massive bodies moving under their mutual Newtonian gravity, in physical units (positions in AU, time in days, masses in kg).
+// State is stored in double precision as a Structure of Arrays, so the O(N^2) pairwise acceleration loop runs 2 bodies
+// at a time with SSE2, and is split across the threads of the Thread Pool for large body counts.
+// How state moves from one step to the next is delegated to a pluggable N-Body Integrator (leapfrog by default)
+class NBodySystem
+{
+public:
+	// Newton's gravitational constant [in AU^3/(kg.days^2)]
+	static constexpr double GRAVITATIONAL_CONSTANT = 6.67430e-11 * 86400.0 * 86400.0 / (1.495978707e11 * 1.495978707e11 * 1.495978707e11);
+
+	// Minimum amount of bodies per batch when splitting the acceleration loop across threads (below, synchronisation costs more than it saves)
+	static constexpr std::size_t MIN_BODIES_PER_THREAD = 64;
+
+	NBodySystem();
+
+	// Copy constructor (not needed, integrator state is not shareable)
+	NBodySystem(const NBodySystem& inNBodySystem) = delete;
+	NBodySystem& operator = (const NBodySystem& inNBodySystem) = delete;
+
+	// Move constructor (needed to return systems built by helper functions)
+	NBodySystem(NBodySystem&& inNBodySystem) noexcept;
+	NBodySystem& operator = (NBodySystem&& inNBodySystem) noexcept;
+
+	~NBodySystem();
+
+	// Register a body and return its index in every array of the system
+	uint32_t AddBody(const double mass, const glm::dvec3& position, const glm::dvec3& velocity);
+
+	void Reserve(const std::size_t bodyCount);
+	void Clear();
+
+	// Replace the bodies of the system by every body of the table having a mass, placed on its Keplerian orbit at the provided date [in Main Planet days since the epoch].
+	// Physical semi-major axes [in AU] and masses [in kg] are provided per table row, as well as the row each body orbits (its parent, or the central Star).
+	// Output the index in the system of each table row, or -1 for rows without mass
+	void LoadKeplerianState(const CelestialBodyTable& table, const std::vector<double>& bodyMasses, const std::vector<double>& semiMajorAxes,
+		const std::vector<uint32_t>& attractorIndices, const double elapsedDays, std::vector<int32_t>& outNBodyIndices);
+
+	std::size_t GetBodyCount() const { return masses.size(); }
+
+	double GetMass(const uint32_t bodyIndex) const { return masses[bodyIndex]; }
+	double GetGravitationalParam(const uint32_t bodyIndex) const { return gravitationalParams[bodyIndex]; }
+
+	glm::dvec3 GetPosition(const uint32_t bodyIndex) const { return glm::dvec3(positionsX[bodyIndex], positionsY[bodyIndex], positionsZ[bodyIndex]); }
+	glm::dvec3 GetVelocity(const uint32_t bodyIndex) const { return glm::dvec3(velocitiesX[bodyIndex], velocitiesY[bodyIndex], velocitiesZ[bodyIndex]); }
+	glm::dvec3 GetAcceleration(const uint32_t bodyIndex) const { return glm::dvec3(accelerationsX[bodyIndex], accelerationsY[bodyIndex], accelerationsZ[bodyIndex]); }
+
+	// Overwrite the state of a body (e.g. by integrators changing coordinates). Warning: accelerations are not invalidated
+	void SetPosition(const uint32_t bodyIndex, const glm::dvec3& position);
+	void SetVelocity(const uint32_t bodyIndex, const glm::dvec3& velocity);
+
+	// Whole state arrays, read-only (e.g. to be copied into snapshots or timeline frames)
+	const std::vector<double>& GetMasses() const { return masses; }
+	const std::vector<double>& GetPositionsX() const { return positionsX; }
+	const std::vector<double>& GetPositionsY() const { return positionsY; }
+	const std::vector<double>& GetPositionsZ() const { return positionsZ; }
+	const std::vector<double>& GetVelocitiesX() const { return velocitiesX; }
+	const std::vector<double>& GetVelocitiesY() const { return velocitiesY; }
+	const std::vector<double>& GetVelocitiesZ() const { return velocitiesZ; }
+
+	// Position blended between the one before the last step (factor 0) and the current one (factor 1)
+	glm::dvec3 GetInterpolatedPosition(const uint32_t bodyIndex, const double interpolationFactor) const;
+
+	// Move positions/velocities to the frame where the barycentre of the system is at rest at the origin, so the system does not drift away
+	void MoveToBarycentricFrame();
+
+	// Choose the integration scheme used by the next steps
+	void SetIntegrator(const NBodyIntegratorType integratorType);
+	const NBodyIntegrator& GetIntegrator() const { return *integrator; }
+
+	// Advance the system by one step [in days] of the current integrator
+	void Step(const double stepSize);
+
+	// Integrator building blocks: velocities += accelerations * duration, and positions += velocities * duration [duration in days]
+	void Kick(const double duration);
+	void Drift(const double duration);
+
+	// Compute the acceleration of every body due to bodies [firstSourceIndex, count[ (i.e. all bodies by default)
+	void ComputeAccelerations(const std::size_t firstSourceIndex = 0);
+
+	// Accelerations stay valid between steps as long as positions do not change, saving one evaluation per step
+	bool AreAccelerationsUpToDate() const { return areAccelerationsUpToDate; }
+	void InvalidateAccelerations() { areAccelerationsUpToDate = false; }
+
+	// Choose how the acceleration loop is run (mainly for benchmarking purposes)
+	void SetComputeOptions(const bool inIsSIMDEnabled, const bool inIsMultithreadingEnabled);
+
+	// Take the current conserved quantities as reference for drifts (done automatically before the first step)
+	void ResetDriftReference();
+
+	// Compute conserved quantities (O(N^2), so not meant to be called every step) and their drift since the reference
+	NBodyDiagnostics ComputeDiagnostics() const;
+
+private:
+	// State arrays, only changed through the methods above (integrators included)
+	std::vector<double> masses;
+	// Masses multiplied by the gravitational constant [in AU^3/days^2]
+	std::vector<double> gravitationalParams;
+
+	std::vector<double> positionsX;
+	std::vector<double> positionsY;
+	std::vector<double> positionsZ;
+
+	std::vector<double> velocitiesX;
+	std::vector<double> velocitiesY;
+	std::vector<double> velocitiesZ;
+
+	std::vector<double> accelerationsX;
+	std::vector<double> accelerationsY;
+	std::vector<double> accelerationsZ;
+
+	// Positions before the last step, for rendering interpolation
+	std::vector<double> previousPositionsX;
+	std::vector<double> previousPositionsY;
+	std::vector<double> previousPositionsZ;
+
+	std::unique_ptr<NBodyIntegrator> integrator;
+
+	bool areAccelerationsUpToDate{ false };
+
+	bool isSIMDEnabled{ true };
+	bool isMultithreadingEnabled{ true };
+
+	uint64_t stepCount{ 0 };
+	bool isDriftReferenceSet{ false };
+	double referenceEnergy{ 0.0 };
+	glm::dvec3 referenceMomentum{ 0.0 };
+	glm::dvec3 referenceAngularMomentum{ 0.0 };
+
+	// Accelerations of bodies [begin, end[ due to bodies [firstSourceIndex, count[
+	void ComputeAccelerationsScalar(const std::size_t begin, const std::size_t end, const std::size_t firstSourceIndex);
+	void ComputeAccelerationsSIMD(const std::size_t begin, const std::size_t end, const std::size_t firstSourceIndex);
+
+	double ComputeTotalEnergy() const;
+	glm::dvec3 ComputeTotalMomentum() const;
+	glm::dvec3 ComputeTotalAngularMomentum() const;
+};
+
+
+
+#endif // N_BODY_SYSTEM_H
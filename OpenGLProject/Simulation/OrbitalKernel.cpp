@@ -0,0 +1,326 @@
+#include "OrbitalKernel.h"
+
+#include <glm/ext/scalar_constants.hpp>
+#include <glm/geometric.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/trigonometric.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include <cmath>
+
+#include "BeltRockTable.h"
+#include "CelestialBodyTable.h"
+#include "Entities/CelestialBodyEntity.h"
+#include "Utils/Constants.h"
+#include "Utils/SIMDHelpers.h"
+#include "Utils/ThreadPool.h"
+
+
+
+void OrbitalKernel::Propagate(CelestialBodyTable& table, const double elapsedDays, const bool isSIMDEnabled)
+{
+	PropagateOrbits(table, elapsedDays, isSIMDEnabled);
+	PropagateSpins(table, elapsedDays, isSIMDEnabled);
+
+	AssembleModelMatrices(table);
+}
+
+void OrbitalKernel::PropagateOrbits(CelestialBodyTable& table, const double elapsedDays, const bool isSIMDEnabled)
+{
+	const std::size_t bodyCount = table.GetBodyCount();
+
+	const auto EvaluateAngles = isSIMDEnabled ? &EvaluateAnglesSIMD : &EvaluateAnglesScalar;
+	const auto SolveKeplerEquation = isSIMDEnabled ? &SolveKeplerEquationSIMD : &SolveKeplerEquationScalar;
+
+	// Sine/cosine of the mean anomalies are only an intermediate step, overwritten by the ones of the eccentric anomalies
+	EvaluateAngles(table.orbitPhasesAtEpoch.data(), table.orbitFreqs.data(), elapsedDays, table.meanAnomalies.data(), table.sinEccentricAnomalies.data(), table.cosEccentricAnomalies.data(), bodyCount);
+	SolveKeplerEquation(table.meanAnomalies.data(), table.eccentricities.data(), table.sinEccentricAnomalies.data(), table.cosEccentricAnomalies.data(), bodyCount);
+
+	ComputeLocalPositions(table);
+}
+
+void OrbitalKernel::PropagateSpins(CelestialBodyTable& table, const double elapsedDays, const bool isSIMDEnabled)
+{
+	const auto EvaluateAngles = isSIMDEnabled ? &EvaluateAnglesSIMD : &EvaluateAnglesScalar;
+	EvaluateAngles(table.spinPhasesAtEpoch.data(), table.spinFreqs.data(), elapsedDays, table.spinAngles.data(), table.sinSpinAngles.data(), table.cosSpinAngles.data(), table.GetBodyCount());
+}
+
+void OrbitalKernel::PropagateOrbits(BeltRockTable& table, const double elapsedDays, const bool isSIMDEnabled)
+{
+	const auto EvaluateAngles = isSIMDEnabled ? &EvaluateAnglesSIMD : &EvaluateAnglesScalar;
+	const auto SolveKeplerEquation = isSIMDEnabled ? &SolveKeplerEquationSIMD : &SolveKeplerEquationScalar;
+
+	// Every stage of a batch only touches the rows of its own rocks, so batches can run concurrently without synchronisation
+	const auto PropagateBatch = [&table, elapsedDays, EvaluateAngles, SolveKeplerEquation](const std::size_t begin, const std::size_t end)
+	{
+		const std::size_t count = end - begin;
+		EvaluateAngles(table.orbitPhasesAtEpoch.data() + begin, table.orbitFreqs.data() + begin, elapsedDays,
+			table.meanAnomalies.data() + begin, table.sinEccentricAnomalies.data() + begin, table.cosEccentricAnomalies.data() + begin, count);
+		SolveKeplerEquation(table.meanAnomalies.data() + begin, table.eccentricities.data() + begin,
+			table.sinEccentricAnomalies.data() + begin, table.cosEccentricAnomalies.data() + begin, count);
+
+		for (std::size_t i = begin; i < end; ++i)
+		{
+			table.positions[i] = table.periapsisAxes[i] * (table.cosEccentricAnomalies[i] - table.eccentricities[i]) + table.semiMinorAxes[i] * table.sinEccentricAnomalies[i];
+		}
+	};
+
+	ThreadPool::GetInstance().ParallelFor(table.GetRockCount(), MIN_ROCKS_PER_THREAD, PropagateBatch);
+}
+
+void OrbitalKernel::EvaluateAnglesScalar(const double* phasesAtEpoch, const double* freqs, const double elapsedDays, float* outAngles, float* outSines, float* outCosines, const std::size_t count)
+{
+	const double doublePi = 2.0 * glm::pi<double>();
+
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		// Only the fractional part of the amount of turns matters, and it is kept in double precision until then,
+		// so the angle is as accurate decades away from the epoch as it is right at it
+		const double turns = phasesAtEpoch[i] + freqs[i] * elapsedDays;
+		outAngles[i] = static_cast<float>(doublePi * (turns - std::floor(turns)));
+
+		outSines[i] = std::sin(outAngles[i]);
+		outCosines[i] = std::cos(outAngles[i]);
+	}
+}
+
+void OrbitalKernel::EvaluateAnglesSIMD(const double* phasesAtEpoch, const double* freqs, const double elapsedDays, float* outAngles, float* outSines, float* outCosines, const std::size_t count)
+{
+	std::size_t i = 0;
+
+#if SIMD_SSE2_ENABLED
+	const __m128d elapsedDaysLane = _mm_set1_pd(elapsedDays);
+	const __m128 doublePiLane = _mm_set1_ps(GLMConstants::doublePi);
+
+	for (; i + SIMDHelpers::FLOAT_LANE_COUNT <= count; i += SIMDHelpers::FLOAT_LANE_COUNT)
+	{
+		// A 128-bit register only holds 2 doubles, so the 4 bodies are split into 2 halves until the fractional part is extracted
+		const __m128d lowTurns = _mm_add_pd(_mm_loadu_pd(phasesAtEpoch + i), _mm_mul_pd(_mm_loadu_pd(freqs + i), elapsedDaysLane));
+		const __m128d highTurns = _mm_add_pd(_mm_loadu_pd(phasesAtEpoch + i + 2), _mm_mul_pd(_mm_loadu_pd(freqs + i + 2), elapsedDaysLane));
+
+		const __m128 fractionalTurns = _mm_movelh_ps(
+			_mm_cvtpd_ps(_mm_sub_pd(lowTurns, SIMDHelpers::Floor(lowTurns))),
+			_mm_cvtpd_ps(_mm_sub_pd(highTurns, SIMDHelpers::Floor(highTurns))));
+
+		const __m128 angle = _mm_mul_ps(fractionalTurns, doublePiLane);
+		_mm_storeu_ps(outAngles + i, angle);
+
+		__m128 sines;
+		__m128 cosines;
+		SIMDHelpers::SinCos(angle, sines, cosines);
+		_mm_storeu_ps(outSines + i, sines);
+		_mm_storeu_ps(outCosines + i, cosines);
+	}
+#endif
+
+	// Remaining bodies not filling a whole SIMD register (or all of them when SSE2 is not available)
+	EvaluateAnglesScalar(phasesAtEpoch + i, freqs + i, elapsedDays, outAngles + i, outSines + i, outCosines + i, count - i);
+}
+
+void OrbitalKernel::SolveKeplerEquationScalar(const float* meanAnomalies, const float* eccentricities, float* inOutSines, float* inOutCosines, const std::size_t count)
+{
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		const float meanAnomaly = meanAnomalies[i];
+		const float eccentricity = eccentricities[i];
+
+		// Third-order starting guess, reusing sine/cosine of the mean anomaly
+		float eccentricAnomaly = meanAnomaly + eccentricity * inOutSines[i] * (1.0f + eccentricity * inOutCosines[i]);
+
+		// Halley iterations on f(E) = E - e * sin(E) - M
+		for (uint32_t iteration = 0; iteration < KEPLER_ITERATION_COUNT; ++iteration)
+		{
+			const float eSinE = eccentricity * std::sin(eccentricAnomaly);
+			const float eCosE = eccentricity * std::cos(eccentricAnomaly);
+
+			const float f = eccentricAnomaly - eSinE - meanAnomaly;
+			const float firstDerivative = 1.0f - eCosE;
+			eccentricAnomaly -= 2.0f * f * firstDerivative / (2.0f * firstDerivative * firstDerivative - f * eSinE);
+		}
+
+		inOutSines[i] = std::sin(eccentricAnomaly);
+		inOutCosines[i] = std::cos(eccentricAnomaly);
+	}
+}
+
+void OrbitalKernel::SolveKeplerEquationSIMD(const float* meanAnomalies, const float* eccentricities, float* inOutSines, float* inOutCosines, const std::size_t count)
+{
+	std::size_t i = 0;
+
+#if SIMD_SSE2_ENABLED
+	const __m128 oneLane = _mm_set1_ps(1.0f);
+	const __m128 twoLane = _mm_set1_ps(2.0f);
+
+	for (; i + SIMDHelpers::FLOAT_LANE_COUNT <= count; i += SIMDHelpers::FLOAT_LANE_COUNT)
+	{
+		const __m128 meanAnomaly = _mm_loadu_ps(meanAnomalies + i);
+		const __m128 eccentricity = _mm_loadu_ps(eccentricities + i);
+
+		const __m128 eSinM = _mm_mul_ps(eccentricity, _mm_loadu_ps(inOutSines + i));
+		const __m128 eCosM = _mm_mul_ps(eccentricity, _mm_loadu_ps(inOutCosines + i));
+		__m128 eccentricAnomaly = _mm_add_ps(meanAnomaly, _mm_mul_ps(eSinM, _mm_add_ps(oneLane, eCosM)));
+
+		// Same iteration count on every lane: circular orbits simply converge at once
+		for (uint32_t iteration = 0; iteration < KEPLER_ITERATION_COUNT; ++iteration)
+		{
+			__m128 sines;
+			__m128 cosines;
+			SIMDHelpers::SinCos(eccentricAnomaly, sines, cosines);
+			const __m128 eSinE = _mm_mul_ps(eccentricity, sines);
+			const __m128 eCosE = _mm_mul_ps(eccentricity, cosines);
+
+			const __m128 f = _mm_sub_ps(_mm_sub_ps(eccentricAnomaly, eSinE), meanAnomaly);
+			const __m128 firstDerivative = _mm_sub_ps(oneLane, eCosE);
+			const __m128 numerator = _mm_mul_ps(_mm_mul_ps(twoLane, f), firstDerivative);
+			const __m128 denominator = _mm_sub_ps(_mm_mul_ps(twoLane, _mm_mul_ps(firstDerivative, firstDerivative)), _mm_mul_ps(f, eSinE));
+			eccentricAnomaly = _mm_sub_ps(eccentricAnomaly, _mm_div_ps(numerator, denominator));
+		}
+
+		__m128 sines;
+		__m128 cosines;
+		SIMDHelpers::SinCos(eccentricAnomaly, sines, cosines);
+		_mm_storeu_ps(inOutSines + i, sines);
+		_mm_storeu_ps(inOutCosines + i, cosines);
+	}
+#endif
+
+	// Remaining bodies not filling a whole SIMD register (or all of them when SSE2 is not available)
+	SolveKeplerEquationScalar(meanAnomalies + i, eccentricities + i, inOutSines + i, inOutCosines + i, count - i);
+}
+
+void OrbitalKernel::ComputeLocalPositions(CelestialBodyTable& table)
+{
+	const std::size_t bodyCount = table.GetBodyCount();
+
+	for (std::size_t i = 0; i < bodyCount; ++i)
+	{
+		// Elliptical translation of body around its parent (focus of the ellipse), already oriented in World Space by the orbit semi-axes
+		table.localPositions[i] = table.periapsisAxes[i] * (table.cosEccentricAnomalies[i] - table.eccentricities[i]) + table.semiMinorAxes[i] * table.sinEccentricAnomalies[i];
+	}
+}
+
+void OrbitalKernel::AssembleModelMatrices(CelestialBodyTable& table)
+{
+	const std::size_t bodyCount = table.GetBodyCount();
+
+	for (std::size_t i = 0; i < bodyCount; ++i)
+	{
+		glm::vec3 position = table.localPositions[i];
+
+		// Parents are always stored before their children, so their World position is already up-to-date
+		const int32_t parentIndex = table.parentIndices[i];
+		if (parentIndex != CelestialBodyTable::NO_PARENT_INDEX)
+		{
+			position += glm::vec3(table.modelMatrices[parentIndex][3]);
+		}
+
+		// Closed form of Translate(position) * Rotate(obliquity, Z) * Rotate(spin, Y) * Rotate(Pi/2, X), i.e. the axial tilt,
+		// then the spin around the axis normal to the orbital plane, then the rotation making the poles appear vertically
+		const float sinObliquity = table.sinObliquities[i];
+		const float cosObliquity = table.cosObliquities[i];
+		const float sinSpin = table.sinSpinAngles[i];
+		const float cosSpin = table.cosSpinAngles[i];
+
+		glm::mat4& model = table.modelMatrices[i];
+		model[0] = glm::vec4(cosObliquity * cosSpin, sinObliquity * cosSpin, -sinSpin, 0.0f);
+		model[1] = glm::vec4(cosObliquity * sinSpin, sinObliquity * sinSpin, cosSpin, 0.0f);
+		model[2] = glm::vec4(sinObliquity, -cosObliquity, 0.0f, 0.0f);
+		model[3] = glm::vec4(position, 1.0f);
+	}
+}
+
+glm::mat3 OrbitalKernel::ComputeOrbitalFrame(const BodyData& bodyData)
+{
+	const float inclinationInRad = glm::radians(bodyData.orbitalInclination);
+	const float ascendingNodeInRad = glm::radians(bodyData.longitudeOfAscendingNode);
+	const float periapsisInRad = glm::radians(bodyData.argumentOfPeriapsis);
+
+	const float sinI = glm::sin(inclinationInRad);
+	const float cosI = glm::cos(inclinationInRad);
+	const float sinNode = glm::sin(ascendingNodeInRad);
+	const float cosNode = glm::cos(ascendingNodeInRad);
+	const float sinPeriapsis = glm::sin(periapsisInRad);
+	const float cosPeriapsis = glm::cos(periapsisInRad);
+
+	// Classic perifocal unit vectors expressed in the ecliptic frame (X to the vernal equinox, Z to the ecliptic north pole),
+	// then swizzled to World Space where the ecliptic is the XZ plane (ecliptic X along World Z, ecliptic Y along World X, ecliptic Z along World Y)
+	const glm::vec3 periapsisDirection(
+		sinNode * cosPeriapsis + cosNode * sinPeriapsis * cosI,
+		sinPeriapsis * sinI,
+		cosNode * cosPeriapsis - sinNode * sinPeriapsis * cosI);
+	const glm::vec3 quarterDirection(
+		cosNode * cosPeriapsis * cosI - sinNode * sinPeriapsis,
+		cosPeriapsis * sinI,
+		-cosNode * sinPeriapsis - sinNode * cosPeriapsis * cosI);
+	const glm::vec3 orbitalPlaneNormal(
+		-cosNode * sinI,
+		cosI,
+		sinNode * sinI);
+
+	return glm::mat3(quarterDirection, orbitalPlaneNormal, periapsisDirection);
+}
+
+double OrbitalKernel::SolveKeplerEquationReference(const double meanAnomaly, const double eccentricity)
+{
+	// Newton iterations until convergence (starting from Pi for high eccentricities, where starting from the mean anomaly can overshoot)
+	double eccentricAnomaly = eccentricity < 0.8 ? meanAnomaly : glm::pi<double>();
+	for (uint32_t iteration = 0; iteration < 50; ++iteration)
+	{
+		const double correction = (eccentricAnomaly - eccentricity * std::sin(eccentricAnomaly) - meanAnomaly) / (1.0 - eccentricity * std::cos(eccentricAnomaly));
+		eccentricAnomaly -= correction;
+		if (std::abs(correction) < 1e-15)
+		{
+			break;
+		}
+	}
+
+	return eccentricAnomaly;
+}
+
+glm::dvec3 OrbitalKernel::ComputeLocalPositionReference(const CelestialBodyTable& table, const uint32_t bodyIndex, const double elapsedDays)
+{
+	const double doublePi = 2.0 * glm::pi<double>();
+
+	const double turns = table.orbitPhasesAtEpoch[bodyIndex] + table.orbitFreqs[bodyIndex] * elapsedDays;
+	const double meanAnomaly = doublePi * (turns - std::floor(turns));
+	const double eccentricity = static_cast<double>(table.eccentricities[bodyIndex]);
+	const double eccentricAnomaly = SolveKeplerEquationReference(meanAnomaly, eccentricity);
+
+	return glm::dvec3(table.periapsisAxes[bodyIndex]) * (std::cos(eccentricAnomaly) - eccentricity) + glm::dvec3(table.semiMinorAxes[bodyIndex]) * std::sin(eccentricAnomaly);
+}
+
+void OrbitalKernel::ComputeStateVectorReference(const CelestialBodyTable& table, const uint32_t bodyIndex, const double elapsedDays, const double semiMajorAxis,
+	const double gravitationalParam, glm::dvec3& outPosition, glm::dvec3& outVelocity)
+{
+	outPosition = glm::dvec3(0.0);
+	outVelocity = glm::dvec3(0.0);
+
+	// Orbit axes are stored scaled for the Scene, only their directions are kept here
+	const glm::dvec3 periapsisAxis(table.periapsisAxes[bodyIndex]);
+	const glm::dvec3 semiMinorAxis(table.semiMinorAxes[bodyIndex]);
+	if (semiMajorAxis == 0.0 || glm::length(periapsisAxis) == 0.0 || glm::length(semiMinorAxis) == 0.0)
+	{
+		return;
+	}
+	const glm::dvec3 periapsisDirection = glm::normalize(periapsisAxis);
+	const glm::dvec3 semiMinorDirection = glm::normalize(semiMinorAxis);
+
+	const double doublePi = 2.0 * glm::pi<double>();
+
+	const double turns = table.orbitPhasesAtEpoch[bodyIndex] + table.orbitFreqs[bodyIndex] * elapsedDays;
+	const double meanAnomaly = doublePi * (turns - std::floor(turns));
+	const double eccentricity = static_cast<double>(table.eccentricities[bodyIndex]);
+	const double eccentricAnomaly = SolveKeplerEquationReference(meanAnomaly, eccentricity);
+
+	const double sinEccentricAnomaly = std::sin(eccentricAnomaly);
+	const double cosEccentricAnomaly = std::cos(eccentricAnomaly);
+	const double semiMinorAxisFactor = std::sqrt(1.0 - eccentricity * eccentricity);
+
+	outPosition = semiMajorAxis * ((cosEccentricAnomaly - eccentricity) * periapsisDirection + semiMinorAxisFactor * sinEccentricAnomaly * semiMinorDirection);
+
+	// Derivative of the position with respect to time, with dE/dt = n / (1 - e * cos(E)) and mean motion n = sqrt(mu / a^3)
+	const double distance = semiMajorAxis * (1.0 - eccentricity * cosEccentricAnomaly);
+	const double speedFactor = std::sqrt(gravitationalParam * semiMajorAxis) / distance;
+	outVelocity = speedFactor * (-sinEccentricAnomaly * periapsisDirection + semiMinorAxisFactor * cosEccentricAnomaly * semiMinorDirection);
+}
@@ -0,0 +1,73 @@
+#ifndef ORBITAL_KERNEL_H
+#define ORBITAL_KERNEL_H
+
+#include <glm/mat3x3.hpp>
+#include <glm/vec3.hpp>
+
+#include <cstddef> // std::size_t
+#include <cstdint>
+
+struct BodyData;
+class BeltRockTable;
+class CelestialBodyTable;
+
+
+
+// Batched propagation of every celestial body of a Celestial Body Table: evaluate mean anomalies/spin angles at the simulated date, solve the Kepler equation,
+// then emit final Model matrices in one pass. Nothing is accumulated from one call to the next, so any date costs the same to reach.
+// Trigonometry is done 4 bodies at a time with SSE2 when available, with a scalar fallback (also used for the remaining bodies of each batch)
+namespace OrbitalKernel
+{
+	// Fixed amount of Halley iterations solving the Kepler equation, enough to reach float precision for eccentricities up to 0.95
+	// (residual still around 1e-5 radians for 0.99), without any per-body convergence test that would break SIMD lanes apart
+	constexpr uint32_t KEPLER_ITERATION_COUNT = 3;
+
+	// Place all bodies of the table where they are the provided amount of days after the epoch [in Main Planet days] and update their Model matrices
+	void Propagate(CelestialBodyTable& table, const double elapsedDays, const bool isSIMDEnabled = true);
+
+	// Stages of Propagate, so local positions can come from another source (e.g. an ephemeris) before Model matrices are assembled
+	void PropagateOrbits(CelestialBodyTable& table, const double elapsedDays, const bool isSIMDEnabled = true);
+	void PropagateSpins(CelestialBodyTable& table, const double elapsedDays, const bool isSIMDEnabled = true);
+
+	// Minimum amount of belt rocks per batch when splitting their propagation across threads (below, synchronisation costs more than it saves)
+	constexpr std::size_t MIN_ROCKS_PER_THREAD = 4096;
+
+	// Place all rocks of the table where they are the provided amount of days after the epoch [in Main Planet days], batches of rocks being propagated in parallel
+	void PropagateOrbits(BeltRockTable& table, const double elapsedDays, const bool isSIMDEnabled = true);
+
+	// Compute each angle out of its phase at epoch plus its frequency times elapsed days [both in turns], wrapped in [0, 2Pi[, and output its sine/cosine
+	void EvaluateAnglesScalar(const double* phasesAtEpoch, const double* freqs, const double elapsedDays, float* outAngles, float* outSines, float* outCosines, const std::size_t count);
+	void EvaluateAnglesSIMD(const double* phasesAtEpoch, const double* freqs, const double elapsedDays, float* outAngles, float* outSines, float* outCosines, const std::size_t count);
+
+	// Solve the Kepler equation M = E - e * sin(E) for the eccentric anomaly E, and output its sine/cosine.
+	// Sine/cosine arrays must contain the ones of the mean anomalies as input, as they are used for the starting guess
+	void SolveKeplerEquationScalar(const float* meanAnomalies, const float* eccentricities, float* inOutSines, float* inOutCosines, const std::size_t count);
+	void SolveKeplerEquationSIMD(const float* meanAnomalies, const float* eccentricities, float* inOutSines, float* inOutCosines, const std::size_t count);
+
+	// Positions relative to the parent body out of the sine/cosine of the eccentric anomalies computed beforehand
+	void ComputeLocalPositions(CelestialBodyTable& table);
+
+	// Build World positions (resolving parents linearly) and Model matrices out of local positions and spin angle sine/cosine computed beforehand
+	void AssembleModelMatrices(CelestialBodyTable& table);
+
+	// Solve the Kepler equation for a single mean anomaly [in radians] in double precision, iterating until convergence
+	double SolveKeplerEquationReference(const double meanAnomaly, const double eccentricity);
+
+	// Reference position of a single body relative to its parent, fully computed in double precision (Kepler equation solved to convergence),
+	// much slower than the batched path, but accurate enough to fit other position sources against
+	glm::dvec3 ComputeLocalPositionReference(const CelestialBodyTable& table, const uint32_t bodyIndex, const double elapsedDays);
+
+	// Physical position/velocity of a single body relative to its parent, for the provided semi-major axis and gravitational parameter (units are those of the inputs,
+	// e.g. AU and AU^3/days^2 give AU and AU/day). Velocity is derived from the gravitational parameter rather than the orbital period, so the orbit is the one gravity keeps
+	void ComputeStateVectorReference(const CelestialBodyTable& table, const uint32_t bodyIndex, const double elapsedDays, const double semiMajorAxis,
+		const double gravitationalParam, glm::dvec3& outPosition, glm::dvec3& outVelocity);
+
+	// Unit vectors of the orbit in World Space out of the body orbital elements (inclination, longitude of ascending node, argument of periapsis):
+	// 1st column points to the body a quarter of eccentric anomaly after periapsis, 2nd column is the orbital plane normal, 3rd column points to periapsis.
+	// Warning: this frame matches the one of the local Circle Mesh (i.e. drawn in the XZ plane, starting along Z), so it can be used as an Orbit Model matrix
+	glm::mat3 ComputeOrbitalFrame(const BodyData& bodyData);
+};
+
+
+
+#endif // ORBITAL_KERNEL_H
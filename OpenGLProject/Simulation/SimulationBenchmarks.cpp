@@ -0,0 +1,315 @@
+#include "SimulationBenchmarks.h"
+
+#include <glm/ext/scalar_constants.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstring> // std::memcmp()
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+
+#include "CelestialBodyTable.h"
+#include "ChebyshevEphemeris.h"
+#include "Entities/BeltEntity.h"
+#include "Entities/CelestialBodyEntity.h"
+#include "NBodySystem.h"
+#include "OrbitalKernel.h"
+#include "Utils/Helpers.h"
+
+namespace
+{
+	// Delta time of a 60 FPS frame at default simulation speed [in Main Planet days]
+	constexpr double benchmarkDeltaTime = 1.0 / 60.0;
+
+	// Build a catalog of planets (every 10th body) each followed by its moons, so the parent resolution pass is exercised as well
+	CelestialBodyTable BuildSyntheticCatalog(const uint32_t bodyCount)
+	{
+		CelestialBodyTable table;
+		table.Reserve(bodyCount);
+
+		int32_t lastPlanetIndex = CelestialBodyTable::NO_PARENT_INDEX;
+		for (uint32_t i = 0; i < bodyCount; ++i)
+		{
+			BodyData bodyData;
+			bodyData.distanceToParent = 10.0f + static_cast<float>(i % 1000);
+			bodyData.obliquity = static_cast<float>(i % 90);
+			bodyData.orbitalPeriod = 1.0f + static_cast<float>(i % 365);
+			bodyData.spinPeriod = 0.5f + static_cast<float>(i % 30);
+			bodyData.orbitalInclination = static_cast<float>(i % 45);
+			bodyData.eccentricity = static_cast<float>(i % 95) * 0.01f;
+			bodyData.longitudeOfAscendingNode = static_cast<float>(i % 360);
+			bodyData.argumentOfPeriapsis = static_cast<float>((i * 7) % 360);
+			bodyData.meanAnomalyAtEpoch = static_cast<float>((i * 13) % 360);
+
+			const bool isPlanet = i % 10 == 0;
+			const uint32_t bodyIndex = table.AddBody(bodyData, isPlanet ? CelestialBodyTable::NO_PARENT_INDEX : lastPlanetIndex);
+			if (isPlanet)
+			{
+				lastPlanetIndex = static_cast<int32_t>(bodyIndex);
+			}
+		}
+
+		return table;
+	}
+
+	// Build a Sun-like star surrounded by Earth-mass bodies on circular orbits between 0.5 and 30.5 AU, spread in angle and slightly inclined
+	NBodySystem BuildSyntheticNBodySystem(const uint32_t bodyCount)
+	{
+		constexpr double starMass = 1.989e30;
+		constexpr double bodyMass = 5.972e24;
+
+		NBodySystem system;
+		system.Reserve(bodyCount);
+		system.AddBody(starMass, glm::dvec3(0.0), glm::dvec3(0.0));
+
+		for (uint32_t i = 1; i < bodyCount; ++i)
+		{
+			const double radius = 0.5 + 30.0 * static_cast<double>(i) / static_cast<double>(bodyCount);
+			const double angle = 2.0 * glm::pi<double>() * static_cast<double>((i * 37) % 360) / 360.0;
+			const double height = 0.01 * radius * static_cast<double>(static_cast<int32_t>(i % 21) - 10) / 10.0;
+			const double speed = std::sqrt(NBodySystem::GRAVITATIONAL_CONSTANT * starMass / radius);
+
+			system.AddBody(bodyMass, glm::dvec3(radius * std::cos(angle), height, radius * std::sin(angle)), glm::dvec3(-speed * std::sin(angle), 0.0, speed * std::cos(angle)));
+		}
+
+		system.MoveToBarycentricFrame();
+		return system;
+	}
+
+	// Physical description of the Solar System out of its CSV file (orbit directions only, as distances are given separately in AU)
+	struct SolarSystemCatalog
+	{
+		CelestialBodyTable table;
+		std::vector<double> masses;
+		std::vector<double> semiMajorAxes;
+		std::vector<uint32_t> attractorIndices;
+	};
+
+	SolarSystemCatalog LoadSolarSystemCatalog(const std::filesystem::path& executablePath)
+	{
+		constexpr double astronomicalUnit = 149597870.7;
+
+		SolarSystemCatalog catalog;
+
+		ResourceCSVParser bodyCSVParser(FileHelper::GetSolutionAbsolutePath(executablePath) + "/Data/CelestialBodyData.csv");
+		const float earthOrbitalPeriod = std::stof(bodyCSVParser.GetParsedCSVLine("Earth")[5]);
+
+		std::unordered_map<std::string, uint32_t> bodyIndices;
+		for (const std::vector<std::string>& celestialBodyParams : bodyCSVParser.GetParsedCSV())
+		{
+			const std::string celestialBodyType(celestialBodyParams[1]);
+			const bool isMoon = celestialBodyType == "Moon";
+
+			BodyData bodyData;
+			bodyData.name = celestialBodyParams[0];
+			bodyData.distanceToParent = 1.0f;
+			bodyData.orbitalPeriod = std::stof(celestialBodyParams[5]) * (celestialBodyType == "DwarfPlanet" ? earthOrbitalPeriod : 1.0f);
+			bodyData.orbitalInclination = std::stof(celestialBodyParams[7]);
+			bodyData.eccentricity = std::stof(celestialBodyParams[8]);
+			bodyData.longitudeOfAscendingNode = std::stof(celestialBodyParams[9]);
+			bodyData.argumentOfPeriapsis = std::stof(celestialBodyParams[10]);
+			bodyData.meanAnomalyAtEpoch = std::stof(celestialBodyParams[11]);
+
+			// Bodies without parent orbit the Star, listed first
+			const uint32_t attractorIndex = isMoon ? bodyIndices[celestialBodyParams[13]] : 0;
+			const uint32_t bodyIndex = catalog.table.AddBody(bodyData, isMoon ? static_cast<int32_t>(attractorIndex) : CelestialBodyTable::NO_PARENT_INDEX);
+			bodyIndices[bodyData.name] = bodyIndex;
+
+			catalog.masses.push_back(std::stod(celestialBodyParams[12]));
+			catalog.semiMajorAxes.push_back(std::stod(celestialBodyParams[3]) / astronomicalUnit);
+			catalog.attractorIndices.push_back(attractorIndex);
+		}
+
+		return catalog;
+	}
+
+	// Call the provided function once per simulated frame, and return its average duration [in milliseconds]
+	template<typename FrameFunction>
+	double MeasureMillisecondsPerFrame(const uint32_t frameCount, const FrameFunction& RunFrame)
+	{
+		double elapsedDays = 0.0;
+
+		const auto start = std::chrono::steady_clock::now();
+		for (uint32_t frame = 0; frame < frameCount; ++frame)
+		{
+			elapsedDays += benchmarkDeltaTime;
+			RunFrame(elapsedDays);
+		}
+		const auto end = std::chrono::steady_clock::now();
+
+		return std::chrono::duration<double, std::milli>(end - start).count() / frameCount;
+	}
+}
+
+
+
+void SimulationBenchmarks::RunAll(const std::filesystem::path& executablePath)
+{
+	RunOrbitalKernel({ 50, 1000, 10000, 100000 }, 200);
+	RunChebyshevEphemeris({ 50, 1000, 10000, 100000 }, 200);
+	RunNBody({ 50, 200, 1000, 4000 }, 100);
+	RunNBodyIntegrators(executablePath, 1.0, 1e-10);
+	RunBeltGeneration({ 25000, 1000000, 10000000 });
+}
+
+void SimulationBenchmarks::RunOrbitalKernel(const std::vector<uint32_t>& bodyCounts, const uint32_t frameCount)
+{
+	std::cout << "BENCHMARK::ORBITAL_KERNEL - " << frameCount << " frames per run" << std::endl;
+
+	for (const uint32_t bodyCount : bodyCounts)
+	{
+		CelestialBodyTable table = BuildSyntheticCatalog(bodyCount);
+
+		const double scalarTime = MeasureMillisecondsPerFrame(frameCount, [&table](const double elapsedDays) { OrbitalKernel::Propagate(table, elapsedDays, false); });
+		const double SIMDTime = MeasureMillisecondsPerFrame(frameCount, [&table](const double elapsedDays) { OrbitalKernel::Propagate(table, elapsedDays, true); });
+
+		std::cout << "  " << bodyCount << " bodies: scalar " << scalarTime << " ms/frame, SIMD " << SIMDTime << " ms/frame (x" << scalarTime / SIMDTime << ")" << std::endl;
+	}
+}
+
+void SimulationBenchmarks::RunChebyshevEphemeris(const std::vector<uint32_t>& bodyCounts, const uint32_t frameCount)
+{
+	std::cout << "BENCHMARK::CHEBYSHEV_EPHEMERIS - " << frameCount << " frames per run" << std::endl;
+
+	const std::filesystem::path ephemerisPath(std::filesystem::temp_directory_path() / "BenchmarkEphemeris.bin");
+
+	EphemerisParams params;
+	params.timeSpan = frameCount * benchmarkDeltaTime;
+
+	for (const uint32_t bodyCount : bodyCounts)
+	{
+		CelestialBodyTable table = BuildSyntheticCatalog(bodyCount);
+
+		const uint64_t fingerprint = ChebyshevEphemeris::ComputeFingerprint(table, params);
+		const auto SampleKeplerianPosition = [&table](const uint32_t bodyIndex, const double elapsedDays)
+		{
+			return OrbitalKernel::ComputeLocalPositionReference(table, bodyIndex, elapsedDays);
+		};
+
+		ChebyshevEphemeris ephemeris;
+		if (ChebyshevEphemeris::Build(table, SampleKeplerianPosition, params, fingerprint, ephemerisPath) == false ||
+			ephemeris.Open(ephemerisPath, fingerprint, table.GetBodyCount()) == false)
+		{
+			std::cout << "ERROR::SIMULATION_BENCHMARKS - Ephemeris could not be built!" << std::endl;
+			return;
+		}
+
+		const double keplerTime = MeasureMillisecondsPerFrame(frameCount, [&table](const double elapsedDays) { OrbitalKernel::PropagateOrbits(table, elapsedDays); });
+		const double ephemerisTime = MeasureMillisecondsPerFrame(frameCount, [&table, &ephemeris](const double elapsedDays) { ephemeris.Evaluate(elapsedDays, table.localPositions.data()); });
+
+		std::cout << "  " << bodyCount << " bodies: Kepler SIMD " << keplerTime << " ms/frame, ephemeris " << ephemerisTime << " ms/frame" << std::endl;
+	}
+
+	std::filesystem::remove(ephemerisPath);
+}
+
+void SimulationBenchmarks::RunNBody(const std::vector<uint32_t>& bodyCounts, const uint32_t stepCount)
+{
+	std::cout << "BENCHMARK::N_BODY - " << stepCount << " leapfrog steps of 1/8 day per run" << std::endl;
+
+	constexpr double stepSize = 1.0 / 8.0;
+
+	for (const uint32_t bodyCount : bodyCounts)
+	{
+		const auto MeasureStepsPerSecond = [bodyCount, stepCount](const bool isSIMDEnabled, const bool isMultithreadingEnabled, NBodyDiagnostics& outDiagnostics)
+		{
+			NBodySystem system = BuildSyntheticNBodySystem(bodyCount);
+			system.SetComputeOptions(isSIMDEnabled, isMultithreadingEnabled);
+			system.ResetDriftReference();
+
+			const auto start = std::chrono::steady_clock::now();
+			for (uint32_t step = 0; step < stepCount; ++step)
+			{
+				system.Step(stepSize);
+			}
+			const auto end = std::chrono::steady_clock::now();
+
+			outDiagnostics = system.ComputeDiagnostics();
+			return stepCount / std::chrono::duration<double>(end - start).count();
+		};
+
+		NBodyDiagnostics diagnostics;
+		const double scalarRate = MeasureStepsPerSecond(false, false, diagnostics);
+		const double SIMDRate = MeasureStepsPerSecond(true, false, diagnostics);
+		const double threadedRate = MeasureStepsPerSecond(true, true, diagnostics);
+
+		std::cout << "  " << bodyCount << " bodies: scalar " << scalarRate << " steps/s, SIMD " << SIMDRate << " steps/s, SIMD + threads " << threadedRate
+			<< " steps/s (energy drift " << diagnostics.relativeEnergyDrift << ", momentum drift " << diagnostics.relativeMomentumDrift << ")" << std::endl;
+	}
+}
+
+void SimulationBenchmarks::RunNBodyIntegrators(const std::filesystem::path& executablePath, const double simulatedYears, const double energyErrorBound)
+{
+	std::cout << "BENCHMARK::N_BODY_INTEGRATORS - Solar System catalog, " << simulatedYears << " simulated years per run, energy error bound " << energyErrorBound << std::endl;
+
+	const SolarSystemCatalog catalog = LoadSolarSystemCatalog(executablePath);
+	const double simulatedDays = simulatedYears * 365.25;
+
+	std::string cheapestConfiguration("none");
+	double cheapestTime = 0.0;
+
+	for (uint32_t integratorIndex = 0; integratorIndex < static_cast<uint32_t>(NBodyIntegratorType::COUNT); ++integratorIndex)
+	{
+		// Adaptive integrators pick their own substeps, step size then only sets how often the state is output
+		for (const double stepSize : { 1.0 / 128.0, 1.0 / 32.0, 1.0 / 8.0, 1.0 / 2.0 })
+		{
+			std::vector<int32_t> nBodyIndices;
+			NBodySystem system;
+			system.SetIntegrator(static_cast<NBodyIntegratorType>(integratorIndex));
+			system.LoadKeplerianState(catalog.table, catalog.masses, catalog.semiMajorAxes, catalog.attractorIndices, 0.0, nBodyIndices);
+
+			const uint64_t stepCount = static_cast<uint64_t>(std::llround(simulatedDays / stepSize));
+
+			const auto start = std::chrono::steady_clock::now();
+			for (uint64_t step = 0; step < stepCount; ++step)
+			{
+				system.Step(stepSize);
+			}
+			const auto end = std::chrono::steady_clock::now();
+
+			const double secondsPerYear = std::chrono::duration<double>(end - start).count() / simulatedYears;
+			const double energyError = system.ComputeDiagnostics().relativeEnergyDrift;
+
+			std::cout << "  " << system.GetIntegrator().GetName() << ", steps of " << stepSize << " days: " << secondsPerYear << " s/simulated year, energy error " << energyError << std::endl;
+
+			if (energyError <= energyErrorBound && (cheapestTime == 0.0 || secondsPerYear < cheapestTime))
+			{
+				cheapestConfiguration = std::string(system.GetIntegrator().GetName()) + " with steps of " + std::to_string(stepSize) + " days";
+				cheapestTime = secondsPerYear;
+			}
+		}
+	}
+
+	std::cout << "  Cheapest configuration within the bound: " << cheapestConfiguration << std::endl;
+}
+
+void SimulationBenchmarks::RunBeltGeneration(const std::vector<uint32_t>& instanceCounts)
+{
+	std::cout << "BENCHMARK::BELT_GENERATION - Kuiper Belt-like torus" << std::endl;
+
+	const TorusParams torusParams{ 60.0f, 10.0f, 0.4f };
+
+	for (const uint32_t instanceCount : instanceCounts)
+	{
+		const InstanceParams instanceParams{ std::filesystem::path(), instanceCount, 0.05f, 20, 2 };
+
+		std::vector<glm::vec3> placements;
+		std::vector<glm::vec4> rotationScaleColumns;
+		const auto start = std::chrono::steady_clock::now();
+		BeltEntity::ComputeInstances(instanceParams, torusParams, placements, rotationScaleColumns);
+		const auto end = std::chrono::steady_clock::now();
+
+		std::vector<glm::vec3> otherPlacements;
+		std::vector<glm::vec4> otherRotationScaleColumns;
+		BeltEntity::ComputeInstances(instanceParams, torusParams, otherPlacements, otherRotationScaleColumns);
+		const bool isReproducible = std::memcmp(placements.data(), otherPlacements.data(), placements.size() * sizeof(glm::vec3)) == 0 &&
+			std::memcmp(rotationScaleColumns.data(), otherRotationScaleColumns.data(), rotationScaleColumns.size() * sizeof(glm::vec4)) == 0;
+
+		std::cout << "  " << instanceCount << " instances: " << std::chrono::duration<double, std::milli>(end - start).count() << " ms"
+			<< (isReproducible ? " (bit-identical when computed again)" : " (ERROR: different when computed again)") << std::endl;
+	}
+}
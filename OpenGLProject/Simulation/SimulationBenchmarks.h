@@ -0,0 +1,38 @@
+#ifndef SIMULATION_BENCHMARKS_H
+#define SIMULATION_BENCHMARKS_H
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+
+
+// Micro-benchmarks of the simulation kernels, run headless (i.e. without any Window nor OpenGL Context) from the command line
+namespace SimulationBenchmarks
+{
+	// Command-line argument triggering the benchmarks instead of the Application
+	constexpr const char* COMMAND_LINE_ARGUMENT = "--benchmark";
+
+	// Run every benchmark below and print their results to the console (executable path being needed to locate Data files)
+	void RunAll(const std::filesystem::path& executablePath);
+
+	// Compare SIMD and scalar paths of the Orbital Kernel on synthetic catalogs of the provided sizes
+	void RunOrbitalKernel(const std::vector<uint32_t>& bodyCounts, const uint32_t frameCount);
+
+	// Compare Keplerian orbit propagation with Chebyshev ephemeris evaluation (fitted over a short time span, to keep the file small)
+	void RunChebyshevEphemeris(const std::vector<uint32_t>& bodyCounts, const uint32_t frameCount);
+
+	// Report N-Body integration steps per second versus body count, with scalar, SIMD and multithreaded SIMD acceleration loops
+	void RunNBody(const std::vector<uint32_t>& bodyCounts, const uint32_t stepCount);
+
+	// Integrate the Solar System catalog with every N-Body integrator and several step sizes, report wall time per simulated year and energy error,
+	// and name the cheapest configuration whose energy error stays below the provided bound
+	void RunNBodyIntegrators(const std::filesystem::path& executablePath, const double simulatedYears, const double energyErrorBound);
+
+	// Report the time taken to place the instances of belts of the provided sizes on their torus, and check placing them twice gives bit-identical matrices
+	void RunBeltGeneration(const std::vector<uint32_t>& instanceCounts);
+};
+
+
+
+#endif // SIMULATION_BENCHMARKS_H
@@ -0,0 +1,19 @@
+#include "SimulationClock.h"
+
+
+
+SimulationClock::SimulationClock(const double inJulianDate) :
+	julianDate(inJulianDate)
+{
+
+}
+
+void SimulationClock::Advance(const double deltaTime)
+{
+	julianDate += deltaTime;
+}
+
+void SimulationClock::SeekTo(const double inJulianDate)
+{
+	julianDate = inJulianDate;
+}
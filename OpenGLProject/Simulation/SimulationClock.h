@@ -0,0 +1,34 @@
+#ifndef SIMULATION_CLOCK_H
+#define SIMULATION_CLOCK_H
+
+
+
+// Keep track of the simulated date as a Julian date (i.e. amount of days elapsed since January 1st, 4713 BC at noon), in double precision
+// so it does not drift over decades of simulated time. Body phases are evaluated from it directly, instead of being accumulated frame after frame
+class SimulationClock
+{
+public:
+	// Julian date of the J2000 epoch (January 1st, 2000 at noon), at which orbital elements of the CSV data are given
+	static constexpr double J2000_JULIAN_DATE = 2451545.0;
+
+	SimulationClock() = default;
+	SimulationClock(const double inJulianDate);
+
+	// Move the simulated date forward (or backward) by the provided (already speed-scaled) delta time [in Main Planet days]
+	void Advance(const double deltaTime);
+
+	// Jump to the provided date at once, whatever the distance to the current one
+	void SeekTo(const double inJulianDate);
+
+	double GetJulianDate() const { return julianDate; }
+
+	// Amount of days elapsed since the epoch of the orbital elements (negative before it)
+	double GetElapsedDaysSinceEpoch() const { return julianDate - J2000_JULIAN_DATE; }
+
+private:
+	double julianDate{ J2000_JULIAN_DATE };
+};
+
+
+
+#endif // SIMULATION_CLOCK_H
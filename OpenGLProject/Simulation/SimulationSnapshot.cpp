@@ -0,0 +1,172 @@
+#include "SimulationSnapshot.h"
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace
+{
+	constexpr uint32_t snapshotVersion = 1;
+
+	// Sections start at multiples of this size in the file, so mapped arrays are aligned for SIMD loads
+	constexpr uint64_t sectionAlignment = 16;
+
+	uint64_t AlignOffset(const uint64_t byteOffset)
+	{
+		return (byteOffset + sectionAlignment - 1) / sectionAlignment * sectionAlignment;
+	}
+}
+
+
+
+bool SimulationSnapshot::Write(const std::filesystem::path& filePath, const uint64_t fingerprint, const uint32_t bodyCount, const std::vector<SnapshotSection>& sections)
+{
+	Header fileHeader;
+	fileHeader.version = snapshotVersion;
+	fileHeader.fingerprint = fingerprint;
+	fileHeader.bodyCount = bodyCount;
+	fileHeader.sectionCount = static_cast<uint32_t>(sections.size());
+
+	// Offsets of all sections are known upfront, so the file is written in a single sequential pass
+	std::vector<SectionRecord> records(sections.size());
+	uint64_t byteOffset = sizeof(Header) + sections.size() * sizeof(SectionRecord);
+	for (std::size_t i = 0; i < sections.size(); ++i)
+	{
+		byteOffset = AlignOffset(byteOffset);
+
+		records[i].type = sections[i].type;
+		records[i].index = sections[i].index;
+		records[i].elementSize = sections[i].elementSize;
+		records[i].elementCount = sections[i].elementCount;
+		records[i].byteOffset = byteOffset;
+
+		byteOffset += records[i].elementCount * records[i].elementSize;
+	}
+
+	std::filesystem::create_directories(filePath.parent_path());
+
+	std::ofstream fileStream(filePath, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (fileStream.fail())
+	{
+		std::cout << "ERROR::SIMULATION_SNAPSHOT - File " << filePath.filename().string() << " could not be created!" << std::endl;
+		return false;
+	}
+
+	fileStream.write(reinterpret_cast<const char*>(&fileHeader), sizeof(Header));
+	fileStream.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(SectionRecord));
+
+	constexpr std::array<char, sectionAlignment> paddingBytes{};
+	uint64_t writtenByteCount = sizeof(Header) + records.size() * sizeof(SectionRecord);
+	for (std::size_t i = 0; i < sections.size(); ++i)
+	{
+		fileStream.write(paddingBytes.data(), static_cast<std::streamsize>(records[i].byteOffset - writtenByteCount));
+
+		const uint64_t sectionByteCount = records[i].elementCount * records[i].elementSize;
+		fileStream.write(static_cast<const char*>(sections[i].data), static_cast<std::streamsize>(sectionByteCount));
+		writtenByteCount = records[i].byteOffset + sectionByteCount;
+	}
+
+	return fileStream.good();
+}
+
+uint64_t SimulationSnapshot::ComputeNameHash(const std::string& name)
+{
+	// FNV-1a hash
+	uint64_t hash = 14695981039346656037ull;
+	for (const char character : name)
+	{
+		hash ^= static_cast<unsigned char>(character);
+		hash *= 1099511628211ull;
+	}
+
+	return hash;
+}
+
+bool SimulationSnapshot::Open(const std::filesystem::path& filePath, const uint64_t expectedFingerprint, const std::size_t expectedBodyCount)
+{
+	Close();
+
+	if (file.Open(filePath) == false || file.GetSize() < sizeof(Header))
+	{
+		Close();
+		return false;
+	}
+
+	const char* const fileData = static_cast<const char*>(file.GetData());
+	const Header* const fileHeader = reinterpret_cast<const Header*>(fileData);
+
+	const Header defaultHeader;
+	if (std::memcmp(fileHeader->magic, defaultHeader.magic, sizeof(defaultHeader.magic)) != 0 || fileHeader->version != snapshotVersion)
+	{
+		std::cout << "ERROR::SIMULATION_SNAPSHOT - File " << filePath.filename().string() << " is not a snapshot, or has been written by another version" << std::endl;
+		Close();
+		return false;
+	}
+
+	if (fileHeader->fingerprint != expectedFingerprint || fileHeader->bodyCount != expectedBodyCount)
+	{
+		std::cout << "ERROR::SIMULATION_SNAPSHOT - File " << filePath.filename().string() << " has been taken with other celestial body data" << std::endl;
+		Close();
+		return false;
+	}
+
+	// Every section is expected to end within the file
+	const SectionRecord* const records = reinterpret_cast<const SectionRecord*>(fileData + sizeof(Header));
+	if (file.GetSize() < sizeof(Header) + fileHeader->sectionCount * sizeof(SectionRecord))
+	{
+		std::cout << "ERROR::SIMULATION_SNAPSHOT - File " << filePath.filename().string() << " is truncated" << std::endl;
+		Close();
+		return false;
+	}
+
+	for (uint32_t i = 0; i < fileHeader->sectionCount; ++i)
+	{
+		if (records[i].byteOffset + records[i].elementCount * records[i].elementSize > file.GetSize())
+		{
+			std::cout << "ERROR::SIMULATION_SNAPSHOT - File " << filePath.filename().string() << " is truncated" << std::endl;
+			Close();
+			return false;
+		}
+	}
+
+	header = fileHeader;
+	sectionRecords = records;
+
+	return true;
+}
+
+void SimulationSnapshot::Close()
+{
+	file.Close();
+
+	header = nullptr;
+	sectionRecords = nullptr;
+}
+
+const void* SimulationSnapshot::FindSection(const SnapshotSectionType type, const uint32_t index, const std::size_t elementSize, std::size_t& outElementCount) const
+{
+	outElementCount = 0;
+	if (IsOpen() == false)
+	{
+		return nullptr;
+	}
+
+	// A few dozen sections at most, so they are searched linearly
+	for (uint32_t i = 0; i < header->sectionCount; ++i)
+	{
+		const SectionRecord& record = sectionRecords[i];
+		if (record.type == type && record.index == index)
+		{
+			if (record.elementSize != elementSize)
+			{
+				return nullptr;
+			}
+
+			outElementCount = static_cast<std::size_t>(record.elementCount);
+			return static_cast<const char*>(file.GetData()) + record.byteOffset;
+		}
+	}
+
+	return nullptr;
+}
@@ -0,0 +1,184 @@
+#ifndef SIMULATION_SNAPSHOT_H
+#define SIMULATION_SNAPSHOT_H
+
+#include <glm/vec3.hpp>
+
+#include <algorithm>
+#include <cstddef> // std::size_t
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "Scene/Transform.h"
+#include "Utils/MemoryMappedFile.h"
+
+
+
+// Kind of array stored in a section of a snapshot file (values are part of the file format, so new kinds are only appended)
+enum class SnapshotSectionType : uint32_t
+{
+	// Single SnapshotState element
+	STATE = 0,
+
+	// Per N-Body System body
+	N_BODY_MASSES,
+	N_BODY_POSITIONS_X,
+	N_BODY_POSITIONS_Y,
+	N_BODY_POSITIONS_Z,
+	N_BODY_VELOCITIES_X,
+	N_BODY_VELOCITIES_Y,
+	N_BODY_VELOCITIES_Z,
+
+	// Per row of the Celestial Body Table: index in the N-Body System, or -1
+	N_BODY_INDICES,
+
+	// Per belt particle (rocks of all belts)
+	BELT_PARTICLE_POSITIONS_X,
+	BELT_PARTICLE_POSITIONS_Y,
+	BELT_PARTICLE_POSITIONS_Z,
+	BELT_PARTICLE_VELOCITIES_X,
+	BELT_PARTICLE_VELOCITIES_Y,
+	BELT_PARTICLE_VELOCITIES_Z,
+	BELT_PARTICLE_ACCELERATIONS_X,
+	BELT_PARTICLE_ACCELERATIONS_Y,
+	BELT_PARTICLE_ACCELERATIONS_Z,
+
+	// Per belt: single SnapshotBelt element, then per instance of the belt (one section of each type per belt, the section index being the belt index)
+	BELT,
+	BELT_INSTANCE_PLACEMENTS,
+	BELT_INSTANCE_ROTATION_SCALE_COLUMNS,
+	BELT_ROCK_ORBIT_FREQS,
+	BELT_ROCK_ORBIT_PHASES_AT_EPOCH,
+	BELT_ROCK_ECCENTRICITIES,
+	BELT_ROCK_PERIAPSIS_AXES,
+	BELT_ROCK_SEMI_MINOR_AXES,
+};
+
+// Values of the simulation and of the camera not tied to a body or a rock
+struct SnapshotState
+{
+	double julianDate{ 0.0 };
+
+	// Simulated date belt particle state corresponds to [in Main Planet days since the epoch]
+	double beltParticleElapsedDays{ 0.0 };
+
+	// Speed factor of the Application, and the one to go back to when the snapshot has been taken while paused
+	float speedFactor{ 1.0f };
+	float pausedSpeedFactor{ 0.0f };
+
+	glm::vec3 cameraPosition{ 0.0f };
+	EulerAngles cameraRotation;
+
+	uint32_t isNBodyModeEnabled{ 0 };
+	uint32_t padding{ 0 };
+};
+
+// Parameters a belt has been built with, so its stored instances are only reused if the belt data has not changed since
+struct SnapshotBelt
+{
+	uint64_t nameHash{ 0 };
+	uint64_t seed{ 0 };
+	uint32_t instanceCount{ 0 };
+	uint32_t sizeRangeSpan{ 0 };
+	float sizeRangeLowerBound{ 0.0f };
+	float majorRadius{ 0.0f };
+	float minorRadius{ 0.0f };
+	float flatnessFactor{ 0.0f };
+};
+
+// Caller-owned array to write as a section of a snapshot file
+struct SnapshotSection
+{
+	SnapshotSectionType type{ SnapshotSectionType::STATE };
+	uint32_t index{ 0 };
+
+	const void* data{ nullptr };
+	uint32_t elementSize{ 0 };
+	std::size_t elementCount{ 0 };
+
+	template<typename ElementType>
+	static SnapshotSection Make(const SnapshotSectionType type, const uint32_t index, const ElementType* elements, const std::size_t elementCount)
+	{
+		return SnapshotSection{ type, index, elements, static_cast<uint32_t>(sizeof(ElementType)), elementCount };
+	}
+
+	template<typename ElementType>
+	static SnapshotSection Make(const SnapshotSectionType type, const uint32_t index, const std::vector<ElementType>& elements)
+	{
+		return Make(type, index, elements.data(), elements.size());
+	}
+};
+
+// Whole simulation state (date, speed, camera, N-Body and belt particle states, belt instances) stored as raw arrays in a versioned binary file,
+// memory-mapped when read: restoring a section is a single copy out of the mapped pages, whatever the amount of belt rocks.
+// File layout: header, then one record per section (type, index, element size and count, offset), then every section starting at a 16-byte boundary
+class SimulationSnapshot
+{
+public:
+	// Write every section to a binary file, along with the fingerprint/amount of bodies of the simulation they have been taken from
+	static bool Write(const std::filesystem::path& filePath, const uint64_t fingerprint, const uint32_t bodyCount, const std::vector<SnapshotSection>& sections);
+
+	// Hash of a name (e.g. of a belt) stored in the file instead of the name itself, the same across runs and platforms (unlike std::hash)
+	static uint64_t ComputeNameHash(const std::string& name);
+
+	// Map a snapshot file, and return whether it succeeded and matches the fingerprint/amount of bodies expected
+	bool Open(const std::filesystem::path& filePath, const uint64_t expectedFingerprint, const std::size_t expectedBodyCount);
+	void Close();
+
+	bool IsOpen() const { return file.IsOpen(); }
+
+	// View on the elements of a section in the mapped file (nullptr if the file has no such section, or if its elements are not of the expected type)
+	template<typename ElementType>
+	const ElementType* GetSection(const SnapshotSectionType type, const uint32_t index, std::size_t& outElementCount) const
+	{
+		return static_cast<const ElementType*>(FindSection(type, index, sizeof(ElementType), outElementCount));
+	}
+
+	// Copy the elements of a section into the provided array, and return whether the section exists with exactly the expected amount of elements
+	template<typename ElementType>
+	bool ReadSection(const SnapshotSectionType type, const uint32_t index, ElementType* outElements, const std::size_t expectedElementCount) const
+	{
+		std::size_t elementCount = 0;
+		const ElementType* const elements = GetSection<ElementType>(type, index, elementCount);
+		if (elements == nullptr || elementCount != expectedElementCount)
+		{
+			return false;
+		}
+
+		std::copy(elements, elements + elementCount, outElements);
+		return true;
+	}
+
+private:
+	struct Header
+	{
+		char magic[4]{ 'S', 'N', 'A', 'P' };
+		uint32_t version{ 1 };
+		uint64_t fingerprint{ 0 };
+		uint32_t bodyCount{ 0 };
+		uint32_t sectionCount{ 0 };
+	};
+
+	struct SectionRecord
+	{
+		SnapshotSectionType type{ SnapshotSectionType::STATE };
+		uint32_t index{ 0 };
+		uint32_t elementSize{ 0 };
+		uint32_t padding{ 0 };
+		uint64_t elementCount{ 0 };
+		uint64_t byteOffset{ 0 };
+	};
+
+	MemoryMappedFile file;
+
+	// Non-owning views on the mapped file
+	const Header* header{ nullptr };
+	const SectionRecord* sectionRecords{ nullptr };
+
+	const void* FindSection(const SnapshotSectionType type, const uint32_t index, const std::size_t elementSize, std::size_t& outElementCount) const;
+};
+
+
+
+#endif // SIMULATION_SNAPSHOT_H
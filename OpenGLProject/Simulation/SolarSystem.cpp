@@ -1,225 +1,929 @@
 #include "SolarSystem.h"
 
+#include <glm/ext/scalar_constants.hpp>
+#include <glm/geometric.hpp>
 #include <glm/vec3.hpp>
 #include <glm/trigonometric.hpp>
 
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef> // std::size_t
 #include <cstdint>
+#include <filesystem>
 #include <iostream>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "Application/Application.h"
 #include "Application/Window.h"
-#include "Cameras/PerspectiveCamera.h"
 #include "Entities/BeltEntity.h"
 #include "Entities/BillboardEntity.h"
 #include "Entities/BodyRingsEntity.h"
 #include "Entities/CelestialBodyEntity.h"
 #include "Entities/GalaxyBackgroundEntity.h"
 #include "Entities/OrbitEntity.h"
+#include "OrbitalKernel.h"
 #include "Rendering/RenderQueue.h"
+#include "Scene/Transform.h"
+#include "Utils/CounterBasedRandom.h"
 #include "Utils/Helpers.h"
+#include "Utils/ThreadPool.h"
 
+namespace
+{
+	using BodyCSVLine = std::vector<std::string>;
+
+	// Kilometers in an astronomical unit, to keep physical distances in N-Body mode
+	constexpr double astronomicalUnit = 149597870.7;
+
+	double ComputePhysicalDistanceToParent(const BodyCSVLine& celestialBodyParams)
+	{
+		return std::stod(celestialBodyParams[3]) / astronomicalUnit;
+	}
+}
 
 
-SolarSystem::SolarSystem()
+
+SolarSystem::SolarSystem(const std::filesystem::path& inSnapshotPath) :
+	snapshotter(*this, inSnapshotPath)
 {
 	BuildMilkyWayBackground();
 	BuildCelestialBodySystems();
-	BuildBelts();
+
+	// Snapshot to resume from is opened before belts are built, so they can reuse its instances
+	SimulationSnapshot startSnapshot;
+	if (inSnapshotPath.empty() == false && snapshotter.Open(inSnapshotPath, startSnapshot) == false)
+	{
+		std::cout << "ERROR::SOLAR_SYSTEM - Snapshot " << inSnapshotPath.filename().string() << " could not be opened, the simulation starts from the epoch" << std::endl;
+	}
+
+	BuildBelts(startSnapshot);
+
+	LoadEphemeris();
+	nBodySystem.SetIntegrator(N_BODY_INTEGRATOR_TYPE);
+
+	// Place celestial bodies where they are at the starting date, before the first frame is simulated
+	SeekTo(clock.GetJulianDate());
 
 	// Need to override Camera Transform start, now that Solar System data objects have been initialised
 	// rotation = (does nothing, around orbital plane normal, around orbital plane tangent)
 	Scene::SetSceneViewerTransformStart(
 		glm::vec3(0.0f, Scene::GetEntity<const CelestialBodyEntity>("Sun")->GetBodyData().radius * 1.75f, -25.0f),
 		EulerAngles{ 0.0f, glm::radians(90.0f), glm::radians(-25.0f) });
+
+	if (startSnapshot.IsOpen())
+	{
+		snapshotter.RestoreState(startSnapshot);
+	}
+
+	// CSV files edited while running are applied at the next update
+	reloader.Open();
+}
+
+void SolarSystem::Update(const float deltaTime)
+{
+	Scene::Update(deltaTime);
+
+	reloader.ReloadChangedDataFiles();
+
+	snapshotter.Update();
+
+	if (Application::GetInstance().IsNBodyModeEnabled() != isNBodyModeEnabled)
+	{
+		EnableNBodyMode(Application::GetInstance().IsNBodyModeEnabled());
+	}
+
+	timeline.Update();
+
+	const uint32_t stepCount = stepScheduler.Accumulate(static_cast<double>(deltaTime) * Application::GetInstance().GetSpeedFactor());
+	for (uint32_t i = 0; i < stepCount; ++i)
+	{
+		previousStepElapsedDays = clock.GetElapsedDaysSinceEpoch();
+		Step(stepScheduler.GetStepSize());
+	}
+
+	// Render the state interpolated between the last two steps, so motion stays smooth whatever the amount of steps run this frame
+	const double currentStepElapsedDays = clock.GetElapsedDaysSinceEpoch();
+	const double renderElapsedDays = previousStepElapsedDays + (currentStepElapsedDays - previousStepElapsedDays) * stepScheduler.GetInterpolationFactor();
+	PlaceCelestialBodies(renderElapsedDays);
+}
+
+void SolarSystem::Step(const double stepSize)
+{
+	if (isNBodyModeEnabled)
+	{
+		nBodySystem.Step(stepSize);
+	}
+
+	clock.Advance(stepSize);
+
+	// Belt particles are stepped once enough N-Body steps have been run, attractors being then at the end of the particle step
+	if (isNBodyModeEnabled && clock.GetElapsedDaysSinceEpoch() - beltParticleElapsedDays >= BELT_PARTICLE_STEP_SIZE)
+	{
+		for (uint32_t i = 0; i < beltAttractorNBodyIndices.size(); ++i)
+		{
+			beltParticles.SetAttractorPosition(i, nBodySystem.GetPosition(beltAttractorNBodyIndices[i]));
+		}
+
+		beltParticles.Step(BELT_PARTICLE_STEP_SIZE);
+		beltParticleElapsedDays += BELT_PARTICLE_STEP_SIZE;
+
+		// Frames are recorded once body and particle states correspond to the same date
+		timeline.RecordFrame();
+	}
+}
+
+void SolarSystem::SeekTo(const double julianDate)
+{
+	clock.SeekTo(julianDate);
+
+	// No previous state to blend from after a jump in time
+	stepScheduler.Reset();
+	previousStepElapsedDays = clock.GetElapsedDaysSinceEpoch();
+
+	// N-Body state is built out of the Keplerian elements at the new date
+	if (isNBodyModeEnabled)
+	{
+		nBodySystem.LoadKeplerianState(bodyTable, bodyMasses, physicalDistancesToParent, nBodyReferenceIndices, previousStepElapsedDays, nBodyIndices);
+		LoadBeltParticles();
+	}
+
+	PlaceCelestialBodies(previousStepElapsedDays);
+}
+
+void SolarSystem::EnableNBodyMode(const bool inIsNBodyModeEnabled)
+{
+	if (inIsNBodyModeEnabled == isNBodyModeEnabled)
+	{
+		return;
+	}
+
+	if (isNBodyModeEnabled)
+	{
+		const NBodyDiagnostics diagnostics = nBodySystem.ComputeDiagnostics();
+		std::cout << "N-Body mode disabled after " << diagnostics.stepCount << " steps - relative drifts: energy " << diagnostics.relativeEnergyDrift
+			<< ", momentum " << diagnostics.relativeMomentumDrift << ", angular momentum " << diagnostics.relativeAngularMomentumDrift << std::endl;
+	}
+
+	isNBodyModeEnabled = inIsNBodyModeEnabled;
+
+	// Belt rocks go back to their Keplerian orbit, particles being launched again out of it the next time N-Body mode is enabled
+	if (isNBodyModeEnabled == false)
+	{
+		beltParticles.Clear();
+	}
+
+	stepScheduler = FixedStepScheduler(isNBodyModeEnabled ? N_BODY_STEP_PARAMS : KEPLERIAN_STEP_PARAMS);
+
+	// Start over from the Keplerian state at the current date (integrated positions are not carried back when leaving N-Body mode)
+	SeekTo(clock.GetJulianDate());
+}
+
+void SolarSystem::LoadEphemeris()
+{
+	const EphemerisParams params;
+	const uint64_t fingerprint = ChebyshevEphemeris::ComputeFingerprint(bodyTable, params);
+	const std::filesystem::path ephemerisPath(FileHelper::GetSolutionAbsolutePath() + "/Data/Cache/CelestialBodyEphemeris.bin");
+
+	// Only fit positions again when CSV data or fitting parameters changed since the file was written
+	if (ephemeris.Open(ephemerisPath, fingerprint, bodyTable.GetBodyCount()))
+	{
+		return;
+	}
+
+	std::cout << "Celestial body ephemeris cache missing or outdated, building it..." << std::endl;
+
+	const auto SampleKeplerianPosition = [this](const uint32_t bodyIndex, const double elapsedDays)
+	{
+		return OrbitalKernel::ComputeLocalPositionReference(bodyTable, bodyIndex, elapsedDays);
+	};
+
+	if (ChebyshevEphemeris::Build(bodyTable, SampleKeplerianPosition, params, fingerprint, ephemerisPath) == false ||
+		ephemeris.Open(ephemerisPath, fingerprint, bodyTable.GetBodyCount()) == false)
+	{
+		std::cout << "ERROR::SOLAR_SYSTEM - Ephemeris cache could not be built, Keplerian elements will be used instead" << std::endl;
+	}
+}
+
+void SolarSystem::PlaceCelestialBodies(const double elapsedDays)
+{
+	if (isNBodyModeEnabled)
+	{
+		// Bodies without mass keep their Keplerian motion relative to their (possibly integrated) parent
+		OrbitalKernel::PropagateOrbits(bodyTable, elapsedDays);
+
+		const double interpolationFactor = stepScheduler.GetInterpolationFactor();
+		for (uint32_t i = 0; i < bodyTable.GetBodyCount(); ++i)
+		{
+			const int32_t nBodyIndex = nBodyIndices[i];
+			const int32_t referenceNBodyIndex = nBodyIndices[nBodyReferenceIndices[i]];
+			if (nBodyIndex == -1 || referenceNBodyIndex == -1)
+			{
+				continue;
+			}
+
+			const glm::dvec3 physicalLocalPosition = nBodySystem.GetInterpolatedPosition(static_cast<uint32_t>(nBodyIndex), interpolationFactor) -
+				nBodySystem.GetInterpolatedPosition(static_cast<uint32_t>(referenceNBodyIndex), interpolationFactor);
+			bodyTable.localPositions[i] = glm::vec3(physicalLocalPosition * nBodyDisplayScales[i]);
+		}
+	}
+	else if (ephemeris.IsCovering(elapsedDays))
+	{
+		ephemeris.Evaluate(elapsedDays, bodyTable.localPositions.data());
+	}
+	else
+	{
+		OrbitalKernel::PropagateOrbits(bodyTable, elapsedDays);
+	}
+
+	OrbitalKernel::PropagateSpins(bodyTable, elapsedDays);
+	OrbitalKernel::AssembleModelMatrices(bodyTable);
+
+	PlaceBeltRocks(elapsedDays);
+}
+
+void SolarSystem::LoadBeltAttractors()
+{
+	beltParticles.ClearAttractors();
+	beltAttractorNBodyIndices.clear();
+
+	// Moons stay close to their parent compared to belt distances, so their mass is added to the one of their parent
+	// (bodies being added parents first, a backward pass also handles moons of moons)
+	std::vector<double> systemMasses(bodyMasses);
+	for (std::size_t i = bodyTable.GetBodyCount(); i-- > 0;)
+	{
+		const int32_t parentIndex = bodyTable.parentIndices[i];
+		if (parentIndex != CelestialBodyTable::NO_PARENT_INDEX)
+		{
+			systemMasses[static_cast<std::size_t>(parentIndex)] += systemMasses[i];
+		}
+	}
+
+	for (std::size_t i = 0; i < bodyTable.GetBodyCount(); ++i)
+	{
+		const int32_t nBodyIndex = nBodyIndices[i];
+		if (bodyTable.parentIndices[i] == CelestialBodyTable::NO_PARENT_INDEX && nBodyIndex != -1)
+		{
+			beltAttractorNBodyIndices.push_back(static_cast<uint32_t>(nBodyIndex));
+			beltParticles.AddAttractor(NBodySystem::GRAVITATIONAL_CONSTANT * systemMasses[i], nBodySystem.GetPosition(static_cast<uint32_t>(nBodyIndex)));
+		}
+	}
+}
+
+void SolarSystem::LoadBeltParticles()
+{
+	// Frames recorded so far belong to another run
+	timeline.Clear();
+
+	beltParticles.Clear();
+	LoadBeltAttractors();
+
+	const uint32_t starNBodyIndex = static_cast<uint32_t>(nBodyIndices[STAR_BODY_INDEX]);
+	const glm::dvec3 starPosition = nBodySystem.GetPosition(starNBodyIndex);
+	const glm::dvec3 starVelocity = nBodySystem.GetVelocity(starNBodyIndex);
+	const double starGravitationalParam = nBodySystem.GetGravitationalParam(starNBodyIndex);
+
+	const double elapsedDays = clock.GetElapsedDaysSinceEpoch();
+	OrbitalKernel::PropagateOrbits(beltRocks, elapsedDays);
+
+	beltParticles.Reserve(beltRocks.GetRockCount());
+	for (const BeltRockGroup& group : beltRockGroups)
+	{
+		const std::size_t endRockIndex = group.firstRockIndex + group.beltEntity->GetInstanceParams().count;
+		for (std::size_t i = group.firstRockIndex; i < endRockIndex; ++i)
+		{
+			// Physical distance to the Star out of the Scene one (inverse of the belt distance map)
+			const glm::dvec3 scenePosition(beltRocks.positions[i]);
+			const double sceneRadius = glm::length(scenePosition);
+			const double physicalRadius = group.ToPhysicalRadius(sceneRadius);
+			const double physicalSemiMajorAxis = group.ToPhysicalRadius(static_cast<double>(glm::length(beltRocks.periapsisAxes[i])));
+
+			// Velocity along the Keplerian orbit (derivative of the position with respect to the eccentric anomaly), its norm following the vis-viva equation
+			const glm::dvec3 velocityDirection = glm::normalize(
+				glm::dvec3(beltRocks.semiMinorAxes[i] * beltRocks.cosEccentricAnomalies[i] - beltRocks.periapsisAxes[i] * beltRocks.sinEccentricAnomalies[i]));
+			const double speed = std::sqrt(starGravitationalParam * (2.0 / physicalRadius - 1.0 / physicalSemiMajorAxis));
+
+			beltParticles.AddParticle(starPosition + scenePosition * (physicalRadius / sceneRadius), starVelocity + velocityDirection * speed);
+		}
+	}
+
+	beltParticles.ComputeAccelerations();
+	beltParticleElapsedDays = elapsedDays;
+}
+
+void SolarSystem::PlaceBeltRocks(const double elapsedDays)
+{
+	if (isNBodyModeEnabled)
+	{
+		PlaceBeltParticles(elapsedDays);
+	}
+	else
+	{
+		OrbitalKernel::PropagateOrbits(beltRocks, elapsedDays);
+	}
+
+	// Only positions change from one frame to the next, rotation/scale of rocks being stored once and for all in the instance buffers
+	for (const BeltRockGroup& group : beltRockGroups)
+	{
+		group.beltEntity->StreamInstancePositions(beltRocks.positions.data() + group.firstRockIndex);
+	}
+}
+
+void SolarSystem::PlaceBeltParticles(const double elapsedDays)
+{
+	const uint32_t starNBodyIndex = static_cast<uint32_t>(nBodyIndices[STAR_BODY_INDEX]);
+	const glm::vec3 starPosition(nBodySystem.GetInterpolatedPosition(starNBodyIndex, stepScheduler.GetInterpolationFactor()));
+
+	// Particles are only stepped once per day, so they are moved along their velocity up to the rendered date
+	const float extrapolationDays = static_cast<float>(elapsedDays - beltParticleElapsedDays);
+
+	for (const BeltRockGroup& group : beltRockGroups)
+	{
+		const std::size_t firstRockIndex = group.firstRockIndex;
+		const float physicalInnerRadius = static_cast<float>(group.physicalInnerRadius);
+		const float sceneInnerRadius = static_cast<float>(group.sceneInnerRadius);
+		const float sceneUnitsPerLogRadius = static_cast<float>(group.sceneUnitsPerLogRadius);
+
+		const auto PlaceBatch = [&](const std::size_t begin, const std::size_t end)
+		{
+			for (std::size_t i = firstRockIndex + begin; i < firstRockIndex + end; ++i)
+			{
+				const glm::vec3 physicalPosition = glm::vec3(
+					beltParticles.positionsX[i] + beltParticles.velocitiesX[i] * extrapolationDays,
+					beltParticles.positionsY[i] + beltParticles.velocitiesY[i] * extrapolationDays,
+					beltParticles.positionsZ[i] + beltParticles.velocitiesZ[i] * extrapolationDays) - starPosition;
+
+				const float physicalRadius = glm::length(physicalPosition);
+				const float sceneRadius = std::max(0.0f, sceneInnerRadius + sceneUnitsPerLogRadius * std::log(physicalRadius / physicalInnerRadius));
+				beltRocks.positions[i] = physicalPosition * (sceneRadius / physicalRadius);
+			}
+		};
+		ThreadPool::GetInstance().ParallelFor(group.beltEntity->GetInstanceParams().count, TestParticleSystem::MIN_PARTICLES_PER_THREAD, PlaceBatch);
+	}
 }
 
 void SolarSystem::BuildMilkyWayBackground()
 {
 	// Background which can never be reached (based off a Skybox)
-	Scene::AddEntity(
+	Scene::CreateEntity<GalaxyBackgroundEntity>(
 		RenderableType::BACKGROUND,
-		std::make_unique<GalaxyBackgroundEntity>(FileHelper::GetSolutionAbsolutePath() + "/Textures/MilkyWay/stars.dds", "MilkyWay")
+		FileHelper::GetSolutionAbsolutePath() + "/Textures/MilkyWay/stars.dds", "MilkyWay"
 	);
 }
 
 void SolarSystem::BuildCelestialBodySystems()
 {
-	// Required to scale distance of current celestial body according to the previous one 
-	// (diverging from proper simulation here, for travel end-user convenience)
-	std::string celestialBodyNameCache("");
-
 	const std::string currentSolutionPath(FileHelper::GetSolutionAbsolutePath());
 
-	std::unordered_map<std::string, std::filesystem::path> bodyPaths;
-	FileHelper::ListModelPaths(currentSolutionPath + "/Textures/CelestialBodies/", bodyPaths);
+	FileHelper::ListModelPaths(currentSolutionPath + "/Textures/CelestialBodies/", bodyTexturePaths);
 
-	ResourceCSVParser bodyCSVParser(currentSolutionPath + "/Data/CelestialBodyData.csv");
+	ResourceCSVParser bodyCSVParser(currentSolutionPath + DATA_DIRECTORY + BODY_DATA_FILE_NAME);
 	Scene::AllocateMemory(bodyCSVParser.GetCSVLinesCount());
+	bodyTable.Reserve(bodyCSVParser.GetCSVLinesCount());
 
 	// Required to scale radius and distance to Sun of each celestial body for end user experience convenience
 	const std::vector<std::string>& EarthLine = bodyCSVParser.GetParsedCSVLine("Earth");
-	const float earthRadius = std::stof(EarthLine[2]);
-	const float sunEarthDistance = std::stof(EarthLine[3]);
+	mainPlanetRadius = std::stof(EarthLine[2]);
+	mainPlanetDistanceToStar = std::stof(EarthLine[3]);
+	mainPlanetOrbitalPeriod = std::stof(EarthLine[5]);
+
+	// Process each CSV line and create a Body instance out of it, parents first, so the Celestial Body Table and the Transform Hierarchy
+	// can resolve every body in a single pass
+	for (const BodyCSVLine* const celestialBodyLine : OrderBodiesParentsFirst(bodyCSVParser.GetParsedCSV()))
+	{
+		const std::string celestialBodyParentName(GetBodyParentName(*celestialBodyLine));
+		const CelestialBodyEntity* const parentBodyEntity = celestialBodyParentName.length() != 0 ? Scene::GetEntity<const CelestialBodyEntity>(celestialBodyParentName) : nullptr;
 
-	// Process each CSV line and create a Body instance out of it
-	for (const std::vector<std::string>& celestialBodyParams : bodyCSVParser.GetParsedCSV())
+		CreateCelestialBody(*celestialBodyLine, ScaleBodyData(*celestialBodyLine, parentBodyEntity != nullptr ? &parentBodyEntity->GetBodyData() : nullptr, GetLastRootBodyData()));
+	}
+
+	BuildBodyRings();
+}
+
+bool SolarSystem::IsBodyCSVLineComplete(const BodyCSVLine& celestialBodyParams)
+{
+	constexpr std::size_t minColumnCount = 13;
+	return celestialBodyParams.size() >= minColumnCount && (celestialBodyParams[1] != "Moon" || celestialBodyParams.size() > minColumnCount);
+}
+
+std::string SolarSystem::GetBodyParentName(const BodyCSVLine& celestialBodyParams)
+{
+	return celestialBodyParams[1] == "Moon" ? celestialBodyParams[13] : "";
+}
+
+std::vector<const BodyCSVLine*> SolarSystem::OrderBodiesParentsFirst(const std::vector<BodyCSVLine>& bodyCSVLines)
+{
+	std::unordered_map<std::string, std::size_t> lineIndices;
+	for (std::size_t i = 0; i < bodyCSVLines.size(); ++i)
 	{
-		const std::string celestialBodyName(celestialBodyParams[0]);
-		const std::string celestialBodyType(celestialBodyParams[1]);
-		const std::string celestialBodyParentName(celestialBodyType == "Moon" ? celestialBodyParams[8] : "");
+		lineIndices[bodyCSVLines[i][0]] = i;
+	}
 
-		const float distanceToParent = std::stof(celestialBodyParams[3]);
-		float scaledDistanceToParent = 0.0f;
-		if (celestialBodyType == "Star")
+	std::vector<uint32_t> depths(bodyCSVLines.size(), 0);
+	for (std::size_t i = 0; i < bodyCSVLines.size(); ++i)
+	{
+		for (std::string parentName = GetBodyParentName(bodyCSVLines[i]); parentName.length() != 0; )
 		{
-			scaledDistanceToParent = 0.0f;
+			const auto& parentLineIt = lineIndices.find(parentName);
+			if (parentLineIt == lineIndices.end() || ++depths[i] > bodyCSVLines.size())
+			{
+				std::cout << "ERROR::SOLAR_SYSTEM - Parent body " << parentName << " of " << bodyCSVLines[i][0] << " is unknown or its own ancestor!" << std::endl;
+				assert(false);
+				break;
+			}
+
+			parentName = GetBodyParentName(bodyCSVLines[parentLineIt->second]);
 		}
-		else if (celestialBodyType == "Moon")
-		{
-			constexpr float earthRadiusScaleFactor = 1000.0f;
+	}
+
+	std::vector<const BodyCSVLine*> orderedLines;
+	orderedLines.reserve(bodyCSVLines.size());
+	for (const BodyCSVLine& celestialBodyParams : bodyCSVLines)
+	{
+		orderedLines.push_back(&celestialBodyParams);
+	}
+
+	std::stable_sort(orderedLines.begin(), orderedLines.end(), [&bodyCSVLines, &depths](const BodyCSVLine* line1, const BodyCSVLine* line2)
+	{
+		return depths[static_cast<std::size_t>(line1 - bodyCSVLines.data())] < depths[static_cast<std::size_t>(line2 - bodyCSVLines.data())];
+	});
+
+	return orderedLines;
+}
 
-			const float scaledTravelDistance = distanceToParent / sunEarthDistance * earthRadiusScaleFactor;
-			scaledDistanceToParent = Scene::GetEntity<const CelestialBodyEntity>(celestialBodyParentName)->GetBodyData().radius + scaledTravelDistance;
+BodyData SolarSystem::ScaleBodyData(const BodyCSVLine& celestialBodyParams, const BodyData* parentBodyData, const BodyData* previousRootBodyData)
+{
+	const std::string celestialBodyName(celestialBodyParams[0]);
+	const std::string celestialBodyType(celestialBodyParams[1]);
+
+	const float distanceToParent = std::stof(celestialBodyParams[3]);
+	float scaledDistanceToParent = 0.0f;
+	if (celestialBodyType == "Star")
+	{
+		scaledDistanceToParent = 0.0f;
+	}
+	else if (celestialBodyType == "Moon")
+	{
+		constexpr float earthRadiusScaleFactor = 1000.0f;
+
+		const float scaledTravelDistance = distanceToParent / mainPlanetDistanceToStar * earthRadiusScaleFactor;
+		scaledDistanceToParent = parentBodyData->radius + scaledTravelDistance;
+	}
+	// "Planet" and "Dwarf Planet" types, scaled according to the previous one (diverging from proper simulation here, for travel end-user convenience)
+	else
+	{
+		constexpr float sunEarthDistanceScaleFactor = 10.0f;
+
+		const float scaledTravelDistance = distanceToParent / mainPlanetDistanceToStar * sunEarthDistanceScaleFactor;
+		if (previousRootBodyData->type == "Star")
+		{
+			scaledDistanceToParent = previousRootBodyData->radius * 2.0f + scaledTravelDistance;
 		}
-		// "Planet" and "Dwarf Planet" types
 		else
 		{
-			constexpr float sunEarthDistanceScaleFactor = 10.0f;
+			scaledDistanceToParent = previousRootBodyData->distanceToParent + scaledTravelDistance;
+		}
+	}
 
-			const BodyData& celestialBodyData = Scene::GetEntity<const CelestialBodyEntity>(celestialBodyNameCache)->GetBodyData();
-			const float scaledTravelDistance = distanceToParent / sunEarthDistance * sunEarthDistanceScaleFactor;
-			if (celestialBodyName == "Mercury")
-			{
-				scaledDistanceToParent = celestialBodyData.radius * 2.0f + scaledTravelDistance;
-			}
-			else
+	const std::filesystem::path& texturePath(bodyTexturePaths[celestialBodyName]);
+	const float scaledRadius = std::stof(celestialBodyParams[2]) / mainPlanetRadius * (celestialBodyType == "Star" ? 0.5f : 1.0f);
+	const float obliquity = std::stof(celestialBodyParams[4]);
+	const float scaledOrbitalPeriod = std::stof(celestialBodyParams[5]) * (celestialBodyType == "DwarfPlanet" ? mainPlanetOrbitalPeriod : 1.0f);
+	const float spinPeriod = std::stof(celestialBodyParams[6]);
+	const float orbitalInclination = std::stof(celestialBodyParams[7]);
+	const float eccentricity = std::stof(celestialBodyParams[8]);
+	const float longitudeOfAscendingNode = std::stof(celestialBodyParams[9]);
+	const float argumentOfPeriapsis = std::stof(celestialBodyParams[10]);
+	const float meanAnomalyAtEpoch = std::stof(celestialBodyParams[11]);
+	const float mass = std::stof(celestialBodyParams[12]);
+
+	return BodyData{ texturePath, celestialBodyName, celestialBodyType, scaledRadius, scaledDistanceToParent, obliquity, scaledOrbitalPeriod, spinPeriod, orbitalInclination,
+		eccentricity, longitudeOfAscendingNode, argumentOfPeriapsis, meanAnomalyAtEpoch, mass };
+}
+
+void SolarSystem::CreateCelestialBody(const BodyCSVLine& celestialBodyParams, const BodyData& bodyData)
+{
+	// Moons orbit around their parent body, necessarily added before (looked up once per line)
+	const std::string celestialBodyParentName(GetBodyParentName(celestialBodyParams));
+	const bool isEntityMoonRelated = celestialBodyParentName.length() != 0;
+	const CelestialBodyEntity* const parentBodyEntity = isEntityMoonRelated ? Scene::GetEntity<const CelestialBodyEntity>(celestialBodyParentName) : nullptr;
+
+	// Row of the parent Planet in the Celestial Body Table has necessarily been added before
+	const int32_t parentBodyIndex = isEntityMoonRelated ?
+		static_cast<int32_t>(parentBodyEntity->GetBodyIndex()) :
+		CelestialBodyTable::NO_PARENT_INDEX;
+	const uint32_t bodyIndex = bodyTable.AddBody(bodyData, parentBodyIndex);
+
+	const double physicalDistanceToParent = ComputePhysicalDistanceToParent(celestialBodyParams);
+	bodyMasses.push_back(static_cast<double>(bodyData.mass));
+	physicalDistancesToParent.push_back(physicalDistanceToParent);
+	nBodyIndices.push_back(-1);
+	nBodyReferenceIndices.push_back(isEntityMoonRelated ? static_cast<uint32_t>(parentBodyIndex) : STAR_BODY_INDEX);
+	nBodyDisplayScales.push_back(physicalDistanceToParent == 0.0 ? 0.0 : static_cast<double>(bodyData.distanceToParent) / physicalDistanceToParent);
+
+	const EntityHandle addedBodyHandle = Scene::CreateEntity<CelestialBodyEntity>(
+		RenderableType::OPAQUE_ENTITY,
+		bodyData, bodyTable, bodyIndex
+	);
+	bodyEntityHandles.push_back(addedBodyHandle);
+
+	// Make Moon Transform the one of the parent Planet, not the Sun!
+	if (isEntityMoonRelated)
+	{
+		Scene::TagEntityAsAttached(parentBodyEntity->GetHandle(), addedBodyHandle);
+	}
+
+	const EntityHandle addedOrbitHandle = Scene::CreateEntity<OrbitEntity>(
+		RenderableType::TRANSPARENT_ENTITY,
+		bodyData
+	);
+
+	// Make Moon Orbit Transform the one of the parent Planet, not the Moon itself!
+	if (isEntityMoonRelated)
+	{
+		Scene::TagEntityAsAttached(parentBodyEntity->GetHandle(), addedOrbitHandle);
+	}
+
+	const EntityHandle addedBillboardHandle = Scene::CreateEntity<BillboardEntity>(
+		RenderableType::TRANSPARENT_ENTITY,
+		bodyData
+	);
+
+	// Make Billboard Transform the one of the planet/moon
+	Scene::TagEntityAsAttached(addedBodyHandle, addedBillboardHandle);
+}
+
+void SolarSystem::UpdateCelestialBody(const uint32_t bodyIndex, const BodyCSVLine& celestialBodyParams, const BodyData& bodyData)
+{
+	bodyTable.SetBody(bodyIndex, bodyData);
+
+	const double physicalDistanceToParent = ComputePhysicalDistanceToParent(celestialBodyParams);
+	bodyMasses[bodyIndex] = static_cast<double>(bodyData.mass);
+	physicalDistancesToParent[bodyIndex] = physicalDistanceToParent;
+	nBodyDisplayScales[bodyIndex] = physicalDistanceToParent == 0.0 ? 0.0 : static_cast<double>(bodyData.distanceToParent) / physicalDistanceToParent;
+
+	Scene::GetEntity<CelestialBodyEntity>(bodyEntityHandles[bodyIndex])->SetBodyData(bodyData);
+
+	OrbitEntity* const orbitEntity = Scene::GetEntity<OrbitEntity>(bodyData.name + "Orbit");
+	if (orbitEntity != nullptr)
+	{
+		orbitEntity->SetOrbit(bodyData);
+		componentStore.SetLocalMatrix(orbitEntity->GetHandle(), orbitEntity->GetOrbitModel());
+	}
+}
+
+void SolarSystem::DestroyCelestialBody(const uint32_t bodyIndex)
+{
+	// Satellites coming after their parent, a single pass flags moons of the removed body at any depth
+	std::vector<uint8_t> removedFlags(bodyTable.GetBodyCount(), 0);
+	removedFlags[bodyIndex] = 1;
+	for (std::size_t i = bodyIndex + 1; i < bodyTable.GetBodyCount(); ++i)
+	{
+		const int32_t parentIndex = bodyTable.parentIndices[i];
+		if (parentIndex != CelestialBodyTable::NO_PARENT_INDEX && removedFlags[static_cast<std::size_t>(parentIndex)] != 0)
+		{
+			removedFlags[i] = 1;
+		}
+	}
+
+	// Entities depending on a removed body are named after it, so they are looked up in constant time
+	for (std::size_t i = bodyIndex; i < bodyTable.GetBodyCount(); ++i)
+	{
+		if (removedFlags[i] == 0)
+		{
+			continue;
+		}
+
+		const std::string bodyName(Scene::GetEntity(bodyEntityHandles[i])->GetName());
+		for (const char* const dependentEntitySuffix : { "Orbit", "Billboard", "Rings" })
+		{
+			const SceneEntity* const dependentEntity = Scene::GetEntity(bodyName + dependentEntitySuffix);
+			if (dependentEntity != nullptr)
 			{
-				scaledDistanceToParent = celestialBodyData.distanceToParent + scaledTravelDistance;
+				Scene::DestroyEntity(dependentEntity->GetHandle());
 			}
 		}
 
-		const std::filesystem::path& texturePath(bodyPaths[celestialBodyName]);
-		const float scaledRadius = std::stof(celestialBodyParams[2]) / earthRadius * (celestialBodyType == "Star" ? 0.5f : 1.0f);
-		const float obliquity = std::stof(celestialBodyParams[4]);
-		const float scaledOrbitalPeriod = std::stof(celestialBodyParams[5]) * (celestialBodyType == "DwarfPlanet" ? Scene::GetEntity<const CelestialBodyEntity>("Earth")->GetBodyData().orbitalPeriod : 1.0f);
-		const float spinPeriod = std::stof(celestialBodyParams[6]);
-		const float orbitalInclination = std::stof(celestialBodyParams[7]);
+		Scene::DestroyEntity(bodyEntityHandles[i]);
+	}
 
-		const BodyData bodyData{ texturePath, celestialBodyName, celestialBodyType, scaledRadius, scaledDistanceToParent, obliquity, scaledOrbitalPeriod, spinPeriod, orbitalInclination };
+	const std::vector<int32_t> newBodyIndices = bodyTable.RemoveBodies(removedFlags);
+	CelestialBodyTable::CompactRows(bodyEntityHandles, newBodyIndices);
+	CelestialBodyTable::CompactRows(bodyMasses, newBodyIndices);
+	CelestialBodyTable::CompactRows(physicalDistancesToParent, newBodyIndices);
+	CelestialBodyTable::CompactRows(nBodyIndices, newBodyIndices);
+	CelestialBodyTable::CompactRows(nBodyReferenceIndices, newBodyIndices);
+	CelestialBodyTable::CompactRows(nBodyDisplayScales, newBodyIndices);
 
-		const uint32_t addedBodyID = Scene::AddEntity(
-			RenderableType::OPAQUE_ENTITY,
-			std::make_unique<CelestialBodyEntity>(bodyData)
-		);
+	// Reference bodies of the remaining bodies (their parent, or the Star) are never removed
+	for (uint32_t& nBodyReferenceIndex : nBodyReferenceIndices)
+	{
+		nBodyReferenceIndex = static_cast<uint32_t>(newBodyIndices[nBodyReferenceIndex]);
+	}
 
-		const bool isEntityMoonRelated = celestialBodyParentName.length() != 0;
+	// Only rows after the removed one have moved, in the table and in the SPIN components of the Component Store
+	for (uint32_t i = bodyIndex; i < bodyEntityHandles.size(); ++i)
+	{
+		Scene::GetEntity<CelestialBodyEntity>(bodyEntityHandles[i])->SetBodyIndex(i);
 
-		// Make Moon Transform the one of the parent Planet, not the Sun!
-		if (isEntityMoonRelated)
+		const EntityLocation location = componentStore.GetLocation(bodyEntityHandles[i]);
+		componentStore.GetArchetype(location.archetypeIndex).bodyIndices[location.row] = i;
+	}
+}
+
+const BodyData* SolarSystem::GetLastRootBodyData() const
+{
+	for (std::size_t bodyIndex = bodyTable.GetBodyCount(); bodyIndex-- > 0;)
+	{
+		if (bodyTable.parentIndices[bodyIndex] == CelestialBodyTable::NO_PARENT_INDEX)
 		{
-			Scene::TagEntityAsAttached(Scene::GetEntity(celestialBodyParentName)->GetID(), addedBodyID);
+			return &Scene::GetEntity<const CelestialBodyEntity>(bodyEntityHandles[bodyIndex])->GetBodyData();
 		}
+	}
 
-		const uint32_t addedOrbitID = Scene::AddEntity(
-			RenderableType::TRANSPARENT_ENTITY,
-			std::make_unique<OrbitEntity>(bodyData)
-		);
+	return nullptr;
+}
+
+bool SolarSystem::AddCelestialBody(const BodyCSVLine& celestialBodyParams)
+{
+	if (IsBodyCSVLineComplete(celestialBodyParams) == false)
+	{
+		std::cout << "ERROR::SOLAR_SYSTEM - Celestial body line is missing values" << std::endl;
+		return false;
+	}
+
+	const std::string& celestialBodyName = celestialBodyParams[0];
+	if (celestialBodyParams[1] == "Star" || Scene::GetEntity(celestialBodyName) != nullptr)
+	{
+		std::cout << "ERROR::SOLAR_SYSTEM - Celestial body " << celestialBodyName << " cannot be added, as it is a star or its name is already taken" << std::endl;
+		return false;
+	}
+
+	const std::string celestialBodyParentName(GetBodyParentName(celestialBodyParams));
+	const CelestialBodyEntity* const parentBodyEntity = celestialBodyParentName.length() != 0 ? Scene::GetEntity<const CelestialBodyEntity>(celestialBodyParentName) : nullptr;
+	if (celestialBodyParentName.length() != 0 && parentBodyEntity == nullptr)
+	{
+		std::cout << "ERROR::SOLAR_SYSTEM - Parent body " << celestialBodyParentName << " of " << celestialBodyName << " is not in the Scene" << std::endl;
+		return false;
+	}
 
-		// Make Moon Orbit Transform the one of the parent Planet, not the Moon itself!
-		if (isEntityMoonRelated)
+	// Texture may have been added to the folder since it has been listed
+	if (bodyTexturePaths.find(celestialBodyName) == bodyTexturePaths.end())
+	{
+		FileHelper::ListModelPaths(FileHelper::GetSolutionAbsolutePath() + "/Textures/CelestialBodies/", bodyTexturePaths);
+		if (bodyTexturePaths.find(celestialBodyName) == bodyTexturePaths.end())
 		{
-			Scene::TagEntityAsAttached(Scene::GetEntity(celestialBodyParentName)->GetID(), addedOrbitID);
+			std::cout << "ERROR::SOLAR_SYSTEM - No texture found for celestial body " << celestialBodyName << std::endl;
+			return false;
 		}
+	}
 
-		const uint32_t addedBillboardID = Scene::AddEntity(
-			RenderableType::TRANSPARENT_ENTITY,
-			std::make_unique<BillboardEntity>(bodyData)
-		);
+	CreateCelestialBody(celestialBodyParams, ScaleBodyData(celestialBodyParams, parentBodyEntity != nullptr ? &parentBodyEntity->GetBodyData() : nullptr, GetLastRootBodyData()));
+	OnCelestialBodiesChanged();
 
-		// Make Billboard Transform the one of the planet/moon
-		Scene::TagEntityAsAttached(addedBodyID, addedBillboardID);
+	return true;
+}
 
-		celestialBodyNameCache = celestialBodyName;
+bool SolarSystem::RemoveCelestialBody(const std::string& celestialBodyName)
+{
+	const CelestialBodyEntity* const celestialBodyEntity = Scene::GetEntity<const CelestialBodyEntity>(celestialBodyName);
+	if (celestialBodyEntity == nullptr || celestialBodyEntity->GetBodyIndex() == STAR_BODY_INDEX)
+	{
+		std::cout << "ERROR::SOLAR_SYSTEM - Celestial body " << celestialBodyName << " cannot be removed, as it is not in the Scene or it is the Star" << std::endl;
+		return false;
 	}
 
-	BuildBodyRings();
+	DestroyCelestialBody(celestialBodyEntity->GetBodyIndex());
+	OnCelestialBodiesChanged();
+
+	return true;
+}
+
+void SolarSystem::OnCelestialBodiesChanged()
+{
+	// Ephemeris has been fitted for the bodies of the CSV file, so positions are evaluated out of the Keplerian elements from now on
+	// (the cache being fitted again at next start if the CSV file has been changed accordingly)
+	ephemeris.Close();
+
+	// Set of massive bodies having changed, the N-Body state is built again out of the Keplerian elements at the current date
+	if (isNBodyModeEnabled)
+	{
+		SeekTo(clock.GetJulianDate());
+	}
 }
 
 void SolarSystem::BuildBodyRings()
 {
 	const std::string currentSolutionPath(FileHelper::GetSolutionAbsolutePath());
 
-	std::unordered_map<std::string, std::filesystem::path> ringPaths;
-	FileHelper::ListModelPaths(currentSolutionPath + "/Models/Rings/", ringPaths);
+	FileHelper::ListModelPaths(currentSolutionPath + "/Models/Rings/", ringModelPaths);
 
-	ResourceCSVParser ringCSVParser(currentSolutionPath + "/Data/RingData.csv");
+	ResourceCSVParser ringCSVParser(currentSolutionPath + DATA_DIRECTORY + RING_DATA_FILE_NAME);
 	Scene::AllocateMemory(ringCSVParser.GetCSVLinesCount());
 
 	// Process each CSV line and create a Rings instance out of it
 	for (const std::vector<std::string>& ringParams : ringCSVParser.GetParsedCSV())
 	{
-		const std::string bodyParent(ringParams[0]);
-		const std::filesystem::path modelPath(ringPaths[ringParams[1]]);
-		const float radius = std::stof(ringParams[2]);
+		CreateBodyRings(ringParams);
+	}
+}
 
-		// Create Rings Scene Entity and store it as transparent in IRenderable map, NOT in Body System
-		const uint32_t addedBodyRingsID = Scene::AddEntity(
-			RenderableType::TRANSPARENT_ENTITY,
-			std::make_unique<BodyRingsEntity>(RingsData{ modelPath, bodyParent, radius })
-		);
+void SolarSystem::CreateBodyRings(const std::vector<std::string>& ringParams)
+{
+	const std::string bodyParent(ringParams[0]);
+	const std::filesystem::path modelPath(ringModelPaths[ringParams[1]]);
+	const float radius = std::stof(ringParams[2]);
+
+	// Create Rings Scene Entity and store it as transparent in IRenderable map, NOT in Body System
+	const EntityHandle addedBodyRingsHandle = Scene::CreateEntity<BodyRingsEntity>(
+		RenderableType::TRANSPARENT_ENTITY,
+		RingsData{ modelPath, bodyParent, radius }
+	);
 
-		Scene::TagEntityAsAttached(Scene::GetEntity(bodyParent)->GetID(), addedBodyRingsID);
-	}
+	Scene::TagEntityAsAttached(Scene::GetEntity(bodyParent)->GetHandle(), addedBodyRingsHandle);
 }
 
-void SolarSystem::BuildBelts()
+void SolarSystem::BuildBelts(const SimulationSnapshot& startSnapshot)
 {
 	const std::string currentSolutionPath(FileHelper::GetSolutionAbsolutePath());
 
-	std::unordered_map<std::string, std::filesystem::path> beltPaths;
-	FileHelper::ListModelPaths(currentSolutionPath + "/Models/Belts/", beltPaths);
+	FileHelper::ListModelPaths(currentSolutionPath + "/Models/Belts/", beltModelPaths);
 
-	ResourceCSVParser beltCSVParser(currentSolutionPath + "/Data/BeltData.csv");
+	ResourceCSVParser beltCSVParser(currentSolutionPath + DATA_DIRECTORY + BELT_DATA_FILE_NAME);
 	Scene::AllocateMemory(beltCSVParser.GetCSVLinesCount());
 
 	// Process each CSV line and create a Belt instance out of it
 	for (const std::vector<std::string>& beltParams : beltCSVParser.GetParsedCSV())
 	{
-		const std::string beltName(beltParams[0]);
-		const std::filesystem::path modelPath(beltPaths[beltParams[1]]);
-		const uint32_t instanceCount = std::stoi(beltParams[2]);
-		const float sizeRangeLowerBound = std::stof(beltParams[3]);
-		const uint32_t sizeRangeSpan = std::stoi(beltParams[4]);
-		const float outerBound = Scene::GetEntity<const CelestialBodyEntity>(beltParams[5])->GetBodyData().distanceToParent;
-		const float innerBound = Scene::GetEntity<const CelestialBodyEntity>(beltParams[6])->GetBodyData().distanceToParent;
-
-		float majorRadius = 0.0f;
-		if (beltName == "MainAsteroidBelt")
-		{
-			majorRadius = innerBound * 1.05f + 0.5f * (outerBound * 0.9f - innerBound * 1.05f);
-		}
-		else
+		InstanceParams instanceParams;
+		TorusParams torusParams;
+		BeltRockGroup beltRockGroup;
+		if (ComputeBeltParams(beltParams, instanceParams, torusParams, beltRockGroup))
 		{
-			majorRadius = innerBound + 0.5f * (outerBound - innerBound);
+			CreateBelt(beltParams[0], std::move(instanceParams), std::move(torusParams), std::move(beltRockGroup), startSnapshot.IsOpen() ? &startSnapshot : nullptr);
 		}
-		float minorRadius = 0.0f;
-		if (beltName == "MainAsteroidBelt")
-		{
-			minorRadius = 0.5f * (outerBound * 0.9f - innerBound * 1.05f);
-		}
-		else
-		{
-			minorRadius = 0.5f * (outerBound - innerBound);
-		}
-		const float flatnessFactor = std::stof(beltParams[7]);
-
-		Scene::AddEntity(RenderableType::OPAQUE_ENTITY,
-			std::make_unique<BeltEntity>(
-				beltName,
-				InstanceParams{ modelPath, instanceCount, sizeRangeLowerBound, sizeRangeSpan },
-				TorusParams{ majorRadius, minorRadius, flatnessFactor }
-			)
+	}
+}
+
+bool SolarSystem::ComputeBeltParams(const std::vector<std::string>& beltParams, InstanceParams& outInstanceParams, TorusParams& outTorusParams, BeltRockGroup& outBeltRockGroup)
+{
+	const std::string beltName(beltParams[0]);
+	const CelestialBodyEntity* const outerBoundBodyEntity = Scene::GetEntity<const CelestialBodyEntity>(beltParams[5]);
+	const CelestialBodyEntity* const innerBoundBodyEntity = Scene::GetEntity<const CelestialBodyEntity>(beltParams[6]);
+	if (outerBoundBodyEntity == nullptr || innerBoundBodyEntity == nullptr)
+	{
+		std::cout << "ERROR::SOLAR_SYSTEM - Bodies bounding belt " << beltName << " are not in the Scene" << std::endl;
+		return false;
+	}
+
+	const std::filesystem::path modelPath(beltModelPaths[beltParams[1]]);
+	const uint32_t instanceCount = std::stoi(beltParams[2]);
+	const float sizeRangeLowerBound = std::stof(beltParams[3]);
+	const uint32_t sizeRangeSpan = std::stoi(beltParams[4]);
+	const float outerBound = outerBoundBodyEntity->GetBodyData().distanceToParent;
+	const float innerBound = innerBoundBodyEntity->GetBodyData().distanceToParent;
+
+	float majorRadius = 0.0f;
+	if (beltName == "MainAsteroidBelt")
+	{
+		majorRadius = innerBound * 1.05f + 0.5f * (outerBound * 0.9f - innerBound * 1.05f);
+	}
+	else
+	{
+		majorRadius = innerBound + 0.5f * (outerBound - innerBound);
+	}
+	float minorRadius = 0.0f;
+	if (beltName == "MainAsteroidBelt")
+	{
+		minorRadius = 0.5f * (outerBound * 0.9f - innerBound * 1.05f);
+	}
+	else
+	{
+		minorRadius = 0.5f * (outerBound - innerBound);
+	}
+	const float flatnessFactor = std::stof(beltParams[7]);
+	const uint64_t seed = std::stoull(beltParams[8]);
+
+	outInstanceParams = InstanceParams{ modelPath, instanceCount, sizeRangeLowerBound, sizeRangeSpan, seed };
+	outTorusParams = TorusParams{ majorRadius, minorRadius, flatnessFactor };
+
+	// Physical distances to the Star of bodies bounding the belt [in AU], shrunk the same way as the torus, are mapped to torus bounds
+	const uint32_t outerBoundBodyIndex = outerBoundBodyEntity->GetBodyIndex();
+	const uint32_t innerBoundBodyIndex = innerBoundBodyEntity->GetBodyIndex();
+	const double physicalInnerRadius = physicalDistancesToParent[innerBoundBodyIndex] * (beltName == "MainAsteroidBelt" ? 1.05 : 1.0);
+	const double physicalOuterRadius = physicalDistancesToParent[outerBoundBodyIndex] * (beltName == "MainAsteroidBelt" ? 0.9 : 1.0);
+
+	outBeltRockGroup.physicalInnerRadius = physicalInnerRadius;
+	outBeltRockGroup.sceneInnerRadius = static_cast<double>(majorRadius - minorRadius);
+	outBeltRockGroup.sceneUnitsPerLogRadius = static_cast<double>(2.0f * minorRadius) / std::log(physicalOuterRadius / physicalInnerRadius);
+	outBeltRockGroup.orbitNormal = glm::normalize(glm::cross(glm::dvec3(bodyTable.periapsisAxes[innerBoundBodyIndex]), glm::dvec3(bodyTable.semiMinorAxes[innerBoundBodyIndex])));
+
+	return true;
+}
+
+void SolarSystem::CreateBelt(const std::string& beltName, InstanceParams&& instanceParams, TorusParams&& torusParams, BeltRockGroup&& beltRockGroup,
+	const SimulationSnapshot* snapshot)
+{
+	const uint32_t beltIndex = static_cast<uint32_t>(beltRockGroups.size());
+	const std::size_t firstRockIndex = beltRocks.GetRockCount();
+	const std::size_t rockCount = instanceParams.count;
+
+	// Belts are stored in the snapshot in the order they have been built, each one along with the parameters it has been built with
+	const bool isSnapshotBeltMatching = snapshot != nullptr && SolarSystemSnapshotter::IsBeltMatching(*snapshot, beltIndex, beltName, instanceParams, torusParams);
+
+	std::vector<glm::vec3> instancePlacements;
+	std::vector<glm::vec4> instanceRotationScaleColumns;
+	if (isSnapshotBeltMatching)
+	{
+		instancePlacements.resize(rockCount);
+		instanceRotationScaleColumns.resize(rockCount * 3);
+	}
+
+	EntityHandle addedBeltHandle;
+	if (isSnapshotBeltMatching &&
+		snapshot->ReadSection(SnapshotSectionType::BELT_INSTANCE_PLACEMENTS, beltIndex, instancePlacements.data(), instancePlacements.size()) &&
+		snapshot->ReadSection(SnapshotSectionType::BELT_INSTANCE_ROTATION_SCALE_COLUMNS, beltIndex, instanceRotationScaleColumns.data(), instanceRotationScaleColumns.size()))
+	{
+		addedBeltHandle = Scene::CreateEntity<BeltEntity>(RenderableType::OPAQUE_ENTITY,
+			beltName,
+			std::move(instanceParams),
+			std::move(torusParams),
+			std::move(instancePlacements),
+			std::move(instanceRotationScaleColumns)
+		);
+	}
+	else
+	{
+		addedBeltHandle = Scene::CreateEntity<BeltEntity>(RenderableType::OPAQUE_ENTITY,
+			beltName,
+			std::move(instanceParams),
+			std::move(torusParams)
 		);
 	}
+
+	beltRockGroup.beltEntity = Scene::GetEntity<BeltEntity>(addedBeltHandle);
+	beltRockGroup.firstRockIndex = static_cast<uint32_t>(firstRockIndex);
+	beltRockGroups.push_back(std::move(beltRockGroup));
+
+	beltRocks.Resize(firstRockIndex + rockCount);
+	if (isSnapshotBeltMatching &&
+		snapshot->ReadSection(SnapshotSectionType::BELT_ROCK_ORBIT_FREQS, beltIndex, beltRocks.orbitFreqs.data() + firstRockIndex, rockCount) &&
+		snapshot->ReadSection(SnapshotSectionType::BELT_ROCK_ORBIT_PHASES_AT_EPOCH, beltIndex, beltRocks.orbitPhasesAtEpoch.data() + firstRockIndex, rockCount) &&
+		snapshot->ReadSection(SnapshotSectionType::BELT_ROCK_ECCENTRICITIES, beltIndex, beltRocks.eccentricities.data() + firstRockIndex, rockCount) &&
+		snapshot->ReadSection(SnapshotSectionType::BELT_ROCK_PERIAPSIS_AXES, beltIndex, beltRocks.periapsisAxes.data() + firstRockIndex, rockCount) &&
+		snapshot->ReadSection(SnapshotSectionType::BELT_ROCK_SEMI_MINOR_AXES, beltIndex, beltRocks.semiMinorAxes.data() + firstRockIndex, rockCount))
+	{
+		return;
+	}
+
+	SetBeltRockOrbits(beltRockGroups.back());
+}
+
+void SolarSystem::DestroyBelt(const std::size_t beltRockGroupIndex)
+{
+	const BeltEntity* const beltEntity = beltRockGroups[beltRockGroupIndex].beltEntity;
+	ResizeBeltRocks(beltRockGroupIndex, beltEntity->GetInstanceParams().count, 0);
+	Scene::DestroyEntity(beltEntity->GetHandle());
+
+	beltRockGroups.erase(std::next(beltRockGroups.begin(), static_cast<std::ptrdiff_t>(beltRockGroupIndex)));
+}
+
+void SolarSystem::ResizeBeltRocks(const std::size_t beltRockGroupIndex, const uint32_t rockCount, const uint32_t newRockCount)
+{
+	beltRocks.ResizeRange(beltRockGroups[beltRockGroupIndex].firstRockIndex, rockCount, newRockCount);
+
+	for (std::size_t i = beltRockGroupIndex + 1; i < beltRockGroups.size(); ++i)
+	{
+		beltRockGroups[i].firstRockIndex = beltRockGroups[i].firstRockIndex + newRockCount - rockCount;
+	}
+}
+
+void SolarSystem::SetBeltRockOrbits(const BeltRockGroup& beltRockGroup)
+{
+	const double starGravitationalParam = NBodySystem::GRAVITATIONAL_CONSTANT * bodyMasses[STAR_BODY_INDEX];
+
+	// Each rock orbits the Star through its placement on the torus (being there at epoch), at the mean motion of its physical distance to the Star.
+	// Like placements, eccentricities are drawn out of the belt seed and the instance index, so rocks are set up in parallel batches
+	const uint64_t seed = beltRockGroup.beltEntity->GetInstanceParams().seed;
+	const glm::vec3 orbitNormal(beltRockGroup.orbitNormal);
+	const std::vector<glm::vec3>& placements = beltRockGroup.beltEntity->GetInstancePlacements();
+	ThreadPool::GetInstance().ParallelFor(placements.size(), BeltEntity::MIN_INSTANCES_PER_THREAD, [&](const std::size_t begin, const std::size_t end)
+	{
+		for (std::size_t i = begin; i < end; ++i)
+		{
+			const CounterBasedRandom::Block orbitNumbers = CounterBasedRandom::Generate(seed, i, BeltEntity::ORBIT_RANDOM_BLOCK);
+			const float eccentricity = CounterBasedRandom::ToRange(orbitNumbers[0], 0.0f, MAX_BELT_ROCK_ECCENTRICITY);
+
+			const glm::vec3& placement = placements[i];
+			const glm::vec3 periapsisAxis = placement / (1.0f - eccentricity);
+			const glm::vec3 semiMinorAxis = glm::normalize(glm::cross(orbitNormal, placement)) * (glm::length(periapsisAxis) * std::sqrt(1.0f - eccentricity * eccentricity));
+
+			const double physicalSemiMajorAxis = beltRockGroup.ToPhysicalRadius(static_cast<double>(glm::length(periapsisAxis)));
+			const double orbitFreq = std::sqrt(starGravitationalParam / (physicalSemiMajorAxis * physicalSemiMajorAxis * physicalSemiMajorAxis)) / (2.0 * glm::pi<double>());
+
+			beltRocks.SetRock(beltRockGroup.firstRockIndex + i, periapsisAxis, semiMinorAxis, eccentricity, orbitFreq, 0.0);
+		}
+	});
 }
@@ -3,29 +3,275 @@
 
 #include <glm/vec3.hpp>
 
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
 #include <memory>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include "BeltRockTable.h"
+#include "CelestialBodyTable.h"
+#include "ChebyshevEphemeris.h"
+#include "FixedStepScheduler.h"
+#include "NBodySystem.h"
+#include "SimulationClock.h"
+#include "SimulationSnapshot.h"
 #include "Scene/Scene.h"
+#include "TestParticleSystem.h"
+#include "SolarSystemReloader.h"
+#include "SolarSystemSnapshotter.h"
+#include "SolarSystemTimeline.h"
 
+class BeltEntity;
+struct BodyData;
+struct InstanceParams;
+struct TorusParams;
 
 
+
+// Rocks of a Belt in the Belt Rock Table (and in the Belt Particle System), and how their physical distance to the Star maps to the Scene torus
+struct BeltRockGroup
+{
+	BeltEntity* beltEntity{ nullptr };
+	uint32_t firstRockIndex{ 0 };
+
+	// Distances between bodies bounding the belt being rescaled for convenience, physical distances to the Star [in AU] are mapped
+	// logarithmically to Scene ones: r = sceneInnerRadius + sceneUnitsPerLogRadius * log(d / physicalInnerRadius)
+	double physicalInnerRadius{ 0.0 };
+	double sceneInnerRadius{ 0.0 };
+	double sceneUnitsPerLogRadius{ 0.0 };
+
+	// Normal of the orbital plane of the body bounding the belt from inside, rocks orbiting in the same direction
+	glm::dvec3 orbitNormal{ 0.0, 1.0, 0.0 };
+
+	double ToPhysicalRadius(const double sceneRadius) const { return physicalInnerRadius * std::exp((sceneRadius - sceneInnerRadius) / sceneUnitsPerLogRadius); }
+};
+
 // Render the whole scene as long as the user is in the sphere of center 'Sun position' and radius 'distance Sun -> farthest celestial body'
 class SolarSystem : public Scene
 {
 public:
-	SolarSystem();
+	// Command-line argument followed by the path of a snapshot file to resume from (snapshots being then saved to/restored from this file)
+	static constexpr const char* SNAPSHOT_COMMAND_LINE_ARGUMENT = "--snapshot";
+
+	// Build the Solar System out of the CSV files, and resume from the provided snapshot file if any (the belt instances it contains being reused
+	// instead of being computed again, as long as belt data has not changed since)
+	explicit SolarSystem(const std::filesystem::path& inSnapshotPath = std::filesystem::path());
+
+	void Update(const float deltaTime) override;
+
+	// Jump to the provided Julian date and place every celestial body there at once (no intermediate frame is simulated)
+	void SeekTo(const double julianDate);
+
+	const SimulationClock& GetClock() const { return clock; }
+
+	// Switch between Keplerian motion and N-Body integration of massive bodies under their mutual gravity,
+	// the N-Body state being (re)initialised out of the Keplerian elements at the current date
+	void EnableNBodyMode(const bool inIsNBodyModeEnabled);
+	bool IsNBodyModeEnabled() const { return isNBodyModeEnabled; }
+
+	// Choose how N-Body mode advances massive bodies from one step to the next
+	void SetNBodyIntegrator(const NBodyIntegratorType integratorType) { nBodySystem.SetIntegrator(integratorType); }
+
+	// Energy/momentum drifts accumulated since N-Body mode has been enabled
+	NBodyDiagnostics GetNBodyDiagnostics() const { return nBodySystem.ComputeDiagnostics(); }
+
+	// Insert a celestial body while running, out of a line formatted like the ones of the celestial body CSV file (a moon orbiting a body already in the Scene),
+	// along with its orbit and billboard. Only the new entities are loaded, the body being appended to the simulation as if it was the last CSV line.
+	// Return whether the body has been added
+	bool AddCelestialBody(const std::vector<std::string>& celestialBodyParams);
+
+	// Remove a celestial body while running, along with its orbit, billboard, rings and moons (at any depth). Only their GPU resources are released,
+	// rows of the remaining bodies being compacted in place. The Star cannot be removed. Return whether the body has been removed
+	bool RemoveCelestialBody(const std::string& celestialBodyName);
+
+	// Save the whole simulation state (date, speed, camera, N-Body and belt particle states, belt instances) to a snapshot file, and return whether it succeeded
+	bool SaveSnapshot(const std::filesystem::path& filePath) const { return snapshotter.Save(filePath); }
+
+	// Go back to the state saved in a snapshot file taken out of the same celestial body and belt data, and return whether it succeeded
+	// (N-Body state and belt particles being copied as is, so the simulation goes on exactly from where the snapshot has been taken)
+	bool RestoreSnapshot(const std::filesystem::path& filePath) { return snapshotter.Restore(filePath); }
+
+	// Move to another date of the run: sought to directly in Keplerian mode, and resumed from the last frame of the recorded timeline before it in N-Body mode
+	// (integrated states not being evaluable at any date), the date being brought back within the timeline. Return whether the date has been reached
+	bool ScrubTo(const double julianDate) { return timeline.ScrubTo(julianDate); }
 
 private:
+	// CSV files edited while running are applied by the reloader, straight to the values and entities built out of them
+	friend class SolarSystemReloader;
+
+	// Snapshots are taken out of (and restored straight to) the simulation state by the snapshotter
+	friend class SolarSystemSnapshotter;
+
+	// Recorded frames are scrubbed through by the timeline, which steps the simulation from them up to the requested date
+	friend class SolarSystemTimeline;
+
+	// Folder of the CSV files, relative to the solution, and names of the files the Solar System is built out of
+	static constexpr const char* DATA_DIRECTORY = "/Data/";
+	static constexpr const char* BODY_DATA_FILE_NAME = "CelestialBodyData.csv";
+	static constexpr const char* RING_DATA_FILE_NAME = "RingData.csv";
+	static constexpr const char* BELT_DATA_FILE_NAME = "BeltData.csv";
+
+	// Motion parameters of all celestial bodies, evaluated in batch every frame (Celestial Body Entities only read their row back)
+	CelestialBodyTable bodyTable;
+
+	// Simulated date, moved forward by fixed steps according to the simulation speed
+	SimulationClock clock;
+
+	// Steps of 1/64 day as long as 8 steps per frame are enough, then step sizes up to 4096 days (the Keplerian motion being
+	// evaluated in closed form, step size has no effect on its accuracy), allowing simulation speeds of 10^6 and more
+	static constexpr FixedStepParams KEPLERIAN_STEP_PARAMS{ 1.0 / 64.0, 4096.0, 8 };
+
+	// Integration accuracy depends on step size, which is then kept at 1/128 day (about 120 steps per orbit of the fastest massive moon),
+	// the simulation lagging behind high simulation speeds rather than becoming unstable
+	static constexpr FixedStepParams N_BODY_STEP_PARAMS{ 1.0 / 128.0, 1.0 / 128.0, 256 };
+
+	// 4th order integration at such steps keeps moon phases within 1e-3 relative of an adaptive reference over weeks (leapfrog drifting 100 times more),
+	// for 3 acceleration evaluations per step only (see N-Body integrator benchmark)
+	static constexpr NBodyIntegratorType N_BODY_INTEGRATOR_TYPE = NBodyIntegratorType::YOSHIDA4;
+
+	FixedStepScheduler stepScheduler{ KEPLERIAN_STEP_PARAMS };
+
+	// Simulated date before the last simulation step [in Main Planet days since the epoch], i.e. the state rendering blends from
+	double previousStepElapsedDays{ 0.0 };
+
+	// Fixed-step simulation stage (only the clock moves in Keplerian mode, as every celestial body position is derived from it)
+	void Step(const double stepSize);
+
+	// Massive bodies integrated in physical units when N-Body mode is enabled (bodies without mass keep their Keplerian motion relative to their parent)
+	NBodySystem nBodySystem;
+	bool isNBodyModeEnabled{ false };
+
+	// Physical values per row of the Celestial Body Table, as Scene distances are rescaled for convenience [in kg and AU]
+	std::vector<double> bodyMasses;
+	std::vector<double> physicalDistancesToParent;
+
+	// Bodies without parent are displayed relative to the Star, expected on the first CSV line
+	static constexpr uint32_t STAR_BODY_INDEX = 0;
+
+	// Celestial Body Entity of each row of the Celestial Body Table
+	std::vector<EntityHandle> bodyEntityHandles;
+
+	// Main Planet values CSV radii, distances and dwarf planet orbital periods are scaled by (read once at build, so bodies can be added later on)
+	float mainPlanetRadius{ 1.0f };
+	float mainPlanetDistanceToStar{ 1.0f };
+	float mainPlanetOrbitalPeriod{ 1.0f };
+
+	// Texture of each body, and Model of each ring system/belt rock, keyed by name
+	std::unordered_map<std::string, std::filesystem::path> bodyTexturePaths;
+	std::unordered_map<std::string, std::filesystem::path> ringModelPaths;
+	std::unordered_map<std::string, std::filesystem::path> beltModelPaths;
+
+	// Per row of the Celestial Body Table: index in the N-Body System (or -1 for a body without mass), row it orbits and its position is displayed relative to
+	// (its parent, or the Star for bodies without parent), and factor from physical to Scene distances
+	std::vector<int32_t> nBodyIndices;
+	std::vector<uint32_t> nBodyReferenceIndices;
+	std::vector<double> nBodyDisplayScales;
+
+	// Keplerian orbit of every belt rock around the Star, evaluated in batch every frame (rock positions being the ones of their particle in N-Body mode)
+	BeltRockTable beltRocks;
+	std::vector<BeltRockGroup> beltRockGroups;
+
+	// Rocks are given orbits of random eccentricity up to this bound
+	static constexpr float MAX_BELT_ROCK_ECCENTRICITY = 0.1f;
+
+	// Belt rocks integrated as massless particles under the gravity of the Star, Planets and Dwarf Planets when N-Body mode is enabled
+	TestParticleSystem beltParticles;
+
+	// Rocks move far slower than the massive moons driving the N-Body step size, so they are only stepped once per simulated day
+	static constexpr double BELT_PARTICLE_STEP_SIZE = 1.0;
+
+	// Simulated date belt particle state corresponds to [in Main Planet days since the epoch]
+	double beltParticleElapsedDays{ 0.0 };
+
+	// Index in the N-Body System of each body attracting belt particles (the mass of its moons being added to its own)
+	std::vector<uint32_t> beltAttractorNBodyIndices;
+
+	// Launch belt particles from the Keplerian state of rocks at the current date, at the current N-Body state
+	void LoadBeltParticles();
+
+	// Register every body attracting belt particles, at the current N-Body state
+	void LoadBeltAttractors();
+
+	// Update the position of every belt rock at the provided date, out of its Keplerian orbit (or its particle in N-Body mode), and stream them to the Belts
+	void PlaceBeltRocks(const double elapsedDays);
+	void PlaceBeltParticles(const double elapsedDays);
+
+	// Positions fitted once over 20 years from the epoch, cached on disk across runs
+	ChebyshevEphemeris ephemeris;
+	void LoadEphemeris();
+
+	// Update every celestial body Model matrix at the provided date, out of the ephemeris when it covers the date, out of the Keplerian elements otherwise
+	void PlaceCelestialBodies(const double elapsedDays);
+
 	// @todo - Think about using a Builder Design Pattern to construct such class instances out of CSV files
 	// Instantiate "spherical" celestial bodies/ring systems/belt systems, after loading data from .csv files,
 	// and re-scaling it so we can visualise the whole Solar System without having to travel for too long
 	void BuildMilkyWayBackground();
 	void BuildCelestialBodySystems();
 	void BuildBodyRings();
-	void BuildBelts();
+	void BuildBelts(const SimulationSnapshot& startSnapshot);
+
+	// Whether a celestial body CSV line has all its values: name, type, 11 values, and the parent name for moons
+	static bool IsBodyCSVLineComplete(const std::vector<std::string>& celestialBodyParams);
+
+	// Only moons have their parent listed in the CSV file, other bodies orbiting the Star
+	static std::string GetBodyParentName(const std::vector<std::string>& celestialBodyParams);
+
+	// Order CSV lines so every body comes after its parent at any depth (e.g. moons of moons), keeping the file order between bodies of the same depth
+	// (planet distances being scaled according to the previous planet)
+	static std::vector<const std::vector<std::string>*> OrderBodiesParentsFirst(const std::vector<std::vector<std::string>>& bodyCSVLines);
+
+	// Scale the values of a CSV line to Scene ones, out of the Scene values of the parent (for moons) and of the previous body without parent
+	// (for planets, placed further than it, i.e. than the previous line of the CSV file)
+	BodyData ScaleBodyData(const std::vector<std::string>& celestialBodyParams, const BodyData* parentBodyData, const BodyData* previousRootBodyData);
+
+	// Append a body to the simulation and create its entities, out of its CSV line and its Scene values (its parent being already in the Scene)
+	void CreateCelestialBody(const std::vector<std::string>& celestialBodyParams, const BodyData& bodyData);
+
+	// Overwrite the motion values of a body already in the Scene and shape its orbit again (no texture/mesh being reloaded)
+	void UpdateCelestialBody(const uint32_t bodyIndex, const std::vector<std::string>& celestialBodyParams, const BodyData& bodyData);
+
+	// Destroy a body along with its orbit, billboard, rings and moons (at any depth), and compact the rows of the remaining ones
+	void DestroyCelestialBody(const uint32_t bodyIndex);
+
+	// Return the Scene values of the last body without parent in the Celestial Body Table (nullptr if there is none yet)
+	const BodyData* GetLastRootBodyData() const;
+
+	// Bring simulation states depending on the set of bodies up to date after bodies have been added/removed/edited
+	void OnCelestialBodiesChanged();
+
+	void CreateBodyRings(const std::vector<std::string>& ringParams);
+
+	// Compute the instances of a belt and the mapping of its rocks to physical distances, out of its CSV line and the orbits of the 2 bodies bounding it.
+	// Return false if one of these bodies is not in the Scene
+	bool ComputeBeltParams(const std::vector<std::string>& beltParams, InstanceParams& outInstanceParams, TorusParams& outTorusParams, BeltRockGroup& outBeltRockGroup);
+
+	// Create a belt entity and append its rocks to the Belt Rock Table, reusing the instances and rock orbits of the provided snapshot
+	// if they have been computed there out of the same parameters
+	void CreateBelt(const std::string& beltName, InstanceParams&& instanceParams, TorusParams&& torusParams, BeltRockGroup&& beltRockGroup,
+		const SimulationSnapshot* snapshot = nullptr);
+
+	// Destroy a belt entity and remove its rocks from the Belt Rock Table
+	void DestroyBelt(const std::size_t beltRockGroupIndex);
+
+	// Give rows of a belt the provided amount of rocks in the Belt Rock Table, rocks of the next belts moving accordingly
+	void ResizeBeltRocks(const std::size_t beltRockGroupIndex, const uint32_t rockCount, const uint32_t newRockCount);
+
+	// Set the Keplerian orbit of every rock of a belt out of its placement on the torus
+	void SetBeltRockOrbits(const BeltRockGroup& beltRockGroup);
+
+	// Watch of the CSV files, applying them again whenever they are written
+	SolarSystemReloader reloader{ *this };
+
+	// Snapshot file saved to/restored from on user request
+	SolarSystemSnapshotter snapshotter;
+
+	// Integrated states recorded at each belt particle step in N-Body mode when timeline recording is enabled
+	SolarSystemTimeline timeline{ *this };
 };
 
 
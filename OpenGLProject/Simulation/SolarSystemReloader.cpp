@@ -0,0 +1,467 @@
+#include "SolarSystemReloader.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstddef> // std::size_t
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "Entities/BeltEntity.h"
+#include "Entities/BodyRingsEntity.h"
+#include "Entities/CelestialBodyEntity.h"
+#include "SolarSystem.h"
+#include "Utils/Helpers.h"
+
+namespace
+{
+	using BodyCSVLine = std::vector<std::string>;
+
+	// Name, model and radius
+	constexpr std::size_t RING_CSV_COLUMN_COUNT = 3;
+
+	// Name, model, 3 instance values, 2 bounding bodies, flatness and seed
+	constexpr std::size_t BELT_CSV_COLUMN_COUNT = 9;
+
+	// Convert a whole value of a reloaded CSV file, without throwing if it is not a (finite) number, is out of range, or is followed by other characters
+	// (e.g. when mistyped). Floating-point values may end with the suffix of C++ float literals, as written in the files (e.g. "0.4f")
+	template<typename ValueType>
+	bool TryParseCSVValue(const std::string& value, ValueType& outValue)
+	{
+		const char* const valueEnd = value.data() + value.size();
+		const std::from_chars_result result = std::from_chars(value.data(), valueEnd, outValue);
+		if (result.ec != std::errc())
+		{
+			return false;
+		}
+
+		if constexpr (std::is_floating_point_v<ValueType>)
+		{
+			const bool isSuffixed = result.ptr + 1 == valueEnd && *result.ptr == 'f';
+			return (result.ptr == valueEnd || isSuffixed) && std::isfinite(outValue);
+		}
+		else
+		{
+			return result.ptr == valueEnd;
+		}
+	}
+
+	// Whether the values of a reloaded body line can be applied: numbers only, an elliptical orbit (the only one handled by the Orbital Kernel),
+	// and a texture found in the folder for bodies not in the Scene yet
+	bool IsBodyCSVLineValid(const BodyCSVLine& celestialBodyParams, const bool isNewBody, const std::unordered_map<std::string, std::filesystem::path>& texturePaths)
+	{
+		const std::string& celestialBodyName = celestialBodyParams[0];
+
+		// Radius, distance to parent, obliquity, orbital period, spin period, inclination, eccentricity, node, periapsis, mean anomaly and mass
+		constexpr std::size_t valueCount = 11;
+		float values[valueCount];
+		for (std::size_t i = 0; i < valueCount; ++i)
+		{
+			if (TryParseCSVValue(celestialBodyParams[i + 2], values[i]) == false)
+			{
+				std::cout << "ERROR::SOLAR_SYSTEM - Value " << celestialBodyParams[i + 2] << " of body " << celestialBodyName << " is not a valid number" << std::endl;
+				return false;
+			}
+		}
+
+		const float radius = values[0];
+		const float distanceToParent = values[1];
+		const float orbitalPeriod = values[3];
+		const float eccentricity = values[6];
+		const float mass = values[10];
+		if (radius <= 0.0f || distanceToParent < 0.0f || orbitalPeriod < 0.0f || mass < 0.0f)
+		{
+			std::cout << "ERROR::SOLAR_SYSTEM - Body " << celestialBodyName << " has a negative distance, period or mass, or a radius that is not positive" << std::endl;
+			return false;
+		}
+
+		if (eccentricity < 0.0f || eccentricity >= 1.0f)
+		{
+			std::cout << "ERROR::SOLAR_SYSTEM - Body " << celestialBodyName << " does not have an elliptical orbit (eccentricity " << eccentricity << ")" << std::endl;
+			return false;
+		}
+
+		if (isNewBody == false)
+		{
+			return true;
+		}
+
+		const auto& texturePathIt = texturePaths.find(celestialBodyName);
+		if (texturePathIt == texturePaths.end() || std::filesystem::exists(texturePathIt->second) == false)
+		{
+			std::cout << "ERROR::SOLAR_SYSTEM - No texture found for body " << celestialBodyName << std::endl;
+			return false;
+		}
+
+		return true;
+	}
+
+	// Whether the values of a reloaded ring line are numbers
+	bool IsRingCSVLineValid(const std::vector<std::string>& ringParams)
+	{
+		float radius = 0.0f;
+		if (TryParseCSVValue(ringParams[2], radius) == false || radius <= 0.0f)
+		{
+			std::cout << "ERROR::SOLAR_SYSTEM - Radius " << ringParams[2] << " of the rings of " << ringParams[0] << " is not a valid number" << std::endl;
+			return false;
+		}
+
+		return true;
+	}
+
+	// Whether the values of a reloaded belt line are numbers (instance count, size range and seed being integers)
+	bool IsBeltCSVLineValid(const std::vector<std::string>& beltParams)
+	{
+		uint32_t instanceCount = 0;
+		float sizeRangeLowerBound = 0.0f;
+		uint32_t sizeRangeSpan = 0;
+		float flatnessFactor = 0.0f;
+		uint64_t seed = 0;
+		if (TryParseCSVValue(beltParams[2], instanceCount) == false || TryParseCSVValue(beltParams[3], sizeRangeLowerBound) == false ||
+			TryParseCSVValue(beltParams[4], sizeRangeSpan) == false || TryParseCSVValue(beltParams[7], flatnessFactor) == false || TryParseCSVValue(beltParams[8], seed) == false)
+		{
+			std::cout << "ERROR::SOLAR_SYSTEM - Belt " << beltParams[0] << " has values that are not valid numbers" << std::endl;
+			return false;
+		}
+
+		return true;
+	}
+
+	// Whether values driving the orbit and the spin of a body are the same (others being baked into its meshes and textures)
+	bool HaveSameMotion(const BodyData& bodyData1, const BodyData& bodyData2)
+	{
+		return bodyData1.distanceToParent == bodyData2.distanceToParent && bodyData1.obliquity == bodyData2.obliquity &&
+			bodyData1.orbitalPeriod == bodyData2.orbitalPeriod && bodyData1.spinPeriod == bodyData2.spinPeriod &&
+			bodyData1.orbitalInclination == bodyData2.orbitalInclination && bodyData1.eccentricity == bodyData2.eccentricity &&
+			bodyData1.longitudeOfAscendingNode == bodyData2.longitudeOfAscendingNode && bodyData1.argumentOfPeriapsis == bodyData2.argumentOfPeriapsis &&
+			bodyData1.meanAnomalyAtEpoch == bodyData2.meanAnomalyAtEpoch && bodyData1.mass == bodyData2.mass;
+	}
+
+	bool HaveSameInstances(const InstanceParams& instanceParams1, const InstanceParams& instanceParams2)
+	{
+		return instanceParams1.modelPath == instanceParams2.modelPath && instanceParams1.count == instanceParams2.count &&
+			instanceParams1.sizeRangeLowerBound == instanceParams2.sizeRangeLowerBound && instanceParams1.sizeRangeSpan == instanceParams2.sizeRangeSpan &&
+			instanceParams1.seed == instanceParams2.seed;
+	}
+
+	bool HaveSameTorus(const TorusParams& torusParams1, const TorusParams& torusParams2)
+	{
+		return torusParams1.majorRadius == torusParams2.majorRadius && torusParams1.minorRadius == torusParams2.minorRadius &&
+			torusParams1.flatnessFactor == torusParams2.flatnessFactor;
+	}
+}
+
+
+
+SolarSystemReloader::SolarSystemReloader(SolarSystem& inSolarSystem) :
+	solarSystem(inSolarSystem)
+{
+}
+
+void SolarSystemReloader::Open()
+{
+	dataFileWatcher.Open(FileHelper::GetSolutionAbsolutePath() + SolarSystem::DATA_DIRECTORY,
+		{ SolarSystem::BODY_DATA_FILE_NAME, SolarSystem::RING_DATA_FILE_NAME, SolarSystem::BELT_DATA_FILE_NAME });
+}
+
+void SolarSystemReloader::ReloadChangedDataFiles()
+{
+	const std::vector<std::string> changedFileNames = dataFileWatcher.PollChangedFiles();
+	if (changedFileNames.empty())
+	{
+		return;
+	}
+
+	const auto HasFileChanged = [&changedFileNames](const std::string& fileName)
+	{
+		return std::find(changedFileNames.begin(), changedFileNames.end(), fileName) != changedFileNames.end();
+	};
+
+	const bool haveBodiesChanged = HasFileChanged(SolarSystem::BODY_DATA_FILE_NAME);
+	if (haveBodiesChanged)
+	{
+		ReloadCelestialBodies();
+	}
+
+	if (haveBodiesChanged || HasFileChanged(SolarSystem::RING_DATA_FILE_NAME))
+	{
+		ReloadBodyRings();
+	}
+
+	if (haveBodiesChanged || HasFileChanged(SolarSystem::BELT_DATA_FILE_NAME))
+	{
+		ReloadBelts();
+	}
+}
+
+void SolarSystemReloader::ReloadCelestialBodies()
+{
+	const std::string currentSolutionPath(FileHelper::GetSolutionAbsolutePath());
+
+	// Lines with missing values are expected to come from a file still being written, its next version being reloaded once written
+	ResourceCSVParser bodyCSVParser(currentSolutionPath + SolarSystem::DATA_DIRECTORY + SolarSystem::BODY_DATA_FILE_NAME);
+	const std::vector<BodyCSVLine>& bodyCSVLines = bodyCSVParser.GetParsedCSV();
+	if (std::all_of(bodyCSVLines.begin(), bodyCSVLines.end(), SolarSystem::IsBodyCSVLineComplete) == false)
+	{
+		std::cout << "ERROR::SOLAR_SYSTEM - " << SolarSystem::BODY_DATA_FILE_NAME << " has lines with missing values, it has not been reloaded" << std::endl;
+		return;
+	}
+
+	// Textures of new bodies may have been added to the folder
+	FileHelper::ListModelPaths(currentSolutionPath + "/Textures/CelestialBodies/", solarSystem.bodyTexturePaths);
+
+	// Nothing is applied if any line is invalid, values of a body depending on the ones of other lines
+	const auto& IsLineValid = [this](const BodyCSVLine& celestialBodyParams)
+	{
+		return IsBodyCSVLineValid(celestialBodyParams, solarSystem.GetEntity(celestialBodyParams[0]) == nullptr, solarSystem.bodyTexturePaths);
+	};
+	if (std::all_of(bodyCSVLines.begin(), bodyCSVLines.end(), IsLineValid) == false)
+	{
+		std::cout << "ERROR::SOLAR_SYSTEM - " << SolarSystem::BODY_DATA_FILE_NAME << " has invalid lines, it has not been reloaded" << std::endl;
+		return;
+	}
+
+	const std::vector<std::string>& EarthLine = bodyCSVParser.GetParsedCSVLine("Earth");
+	solarSystem.mainPlanetRadius = std::stof(EarthLine[2]);
+	solarSystem.mainPlanetDistanceToStar = std::stof(EarthLine[3]);
+	solarSystem.mainPlanetOrbitalPeriod = std::stof(EarthLine[5]);
+
+	// Scene values of every line, scaled parents first like at build (values of a moon depending on its parent, and values of a planet on the previous one)
+	const std::vector<const BodyCSVLine*> orderedLines = SolarSystem::OrderBodiesParentsFirst(bodyCSVLines);
+	std::unordered_map<std::string, BodyData> bodyDataByName;
+	std::unordered_map<std::string, const BodyCSVLine*> linesByName;
+	const BodyData* previousRootBodyData = nullptr;
+	for (const BodyCSVLine* const celestialBodyLine : orderedLines)
+	{
+		const std::string celestialBodyParentName(SolarSystem::GetBodyParentName(*celestialBodyLine));
+		const BodyData* const parentBodyData = celestialBodyParentName.length() != 0 ? &bodyDataByName.at(celestialBodyParentName) : nullptr;
+
+		// Elements of an unordered map never move, so the previous body data can be pointed to
+		const BodyData& bodyData = bodyDataByName.emplace((*celestialBodyLine)[0], solarSystem.ScaleBodyData(*celestialBodyLine, parentBodyData, previousRootBodyData)).first->second;
+		linesByName.emplace((*celestialBodyLine)[0], celestialBodyLine);
+		if (parentBodyData == nullptr)
+		{
+			previousRootBodyData = &bodyData;
+		}
+	}
+
+	// Bodies whose line has been removed, or whose parent, type or values baked into their mesh/textures have changed, are destroyed (and created again below)
+	std::vector<std::string> destroyedBodyNames;
+	for (uint32_t i = 0; i < solarSystem.bodyEntityHandles.size(); ++i)
+	{
+		const BodyData& bodyData = solarSystem.GetEntity<const CelestialBodyEntity>(solarSystem.bodyEntityHandles[i])->GetBodyData();
+		const int32_t parentIndex = solarSystem.bodyTable.parentIndices[i];
+		const std::string parentName(parentIndex == CelestialBodyTable::NO_PARENT_INDEX ? "" : solarSystem.GetEntity(solarSystem.bodyEntityHandles[static_cast<std::size_t>(parentIndex)])->GetName());
+
+		const auto& newBodyDataIt = bodyDataByName.find(bodyData.name);
+		if (newBodyDataIt == bodyDataByName.end() || SolarSystem::GetBodyParentName(*linesByName.at(bodyData.name)) != parentName || newBodyDataIt->second.type != bodyData.type ||
+			newBodyDataIt->second.radius != bodyData.radius || newBodyDataIt->second.texturePath != bodyData.texturePath)
+		{
+			if (i == SolarSystem::STAR_BODY_INDEX)
+			{
+				std::cout << "ERROR::SOLAR_SYSTEM - Star cannot be removed or have its type/radius/texture changed while running" << std::endl;
+				continue;
+			}
+
+			destroyedBodyNames.push_back(bodyData.name);
+		}
+	}
+
+	bool haveBodiesChanged = destroyedBodyNames.empty() == false;
+
+	// Moons of a destroyed body having been destroyed with it, bodies are looked up again
+	for (const std::string& destroyedBodyName : destroyedBodyNames)
+	{
+		const CelestialBodyEntity* const celestialBodyEntity = solarSystem.GetEntity<const CelestialBodyEntity>(destroyedBodyName);
+		if (celestialBodyEntity != nullptr)
+		{
+			solarSystem.DestroyCelestialBody(celestialBodyEntity->GetBodyIndex());
+		}
+	}
+
+	// Parents first: bodies still in the Scene have their motion values overwritten if they have changed, others are created
+	for (const BodyCSVLine* const celestialBodyLine : orderedLines)
+	{
+		const BodyData& newBodyData = bodyDataByName.at((*celestialBodyLine)[0]);
+
+		const CelestialBodyEntity* const celestialBodyEntity = solarSystem.GetEntity<const CelestialBodyEntity>(newBodyData.name);
+		if (celestialBodyEntity == nullptr)
+		{
+			solarSystem.CreateCelestialBody(*celestialBodyLine, newBodyData);
+			haveBodiesChanged = true;
+		}
+		else if (HaveSameMotion(celestialBodyEntity->GetBodyData(), newBodyData) == false)
+		{
+			solarSystem.UpdateCelestialBody(celestialBodyEntity->GetBodyIndex(), *celestialBodyLine, newBodyData);
+			haveBodiesChanged = true;
+		}
+	}
+
+	if (haveBodiesChanged)
+	{
+		solarSystem.OnCelestialBodiesChanged();
+	}
+}
+
+void SolarSystemReloader::ReloadBodyRings()
+{
+	const std::string currentSolutionPath(FileHelper::GetSolutionAbsolutePath());
+
+	// Models of new rings may have been added to the folder
+	FileHelper::ListModelPaths(currentSolutionPath + "/Models/Rings/", solarSystem.ringModelPaths);
+
+	ResourceCSVParser ringCSVParser(currentSolutionPath + SolarSystem::DATA_DIRECTORY + SolarSystem::RING_DATA_FILE_NAME);
+	std::unordered_map<std::string, const std::vector<std::string>*> ringLinesByBodyName;
+	for (const std::vector<std::string>& ringParams : ringCSVParser.GetParsedCSV())
+	{
+		if (ringParams.size() < RING_CSV_COLUMN_COUNT)
+		{
+			std::cout << "ERROR::SOLAR_SYSTEM - " << SolarSystem::RING_DATA_FILE_NAME << " has lines with missing values, it has not been reloaded" << std::endl;
+			return;
+		}
+
+		if (IsRingCSVLineValid(ringParams) == false)
+		{
+			std::cout << "ERROR::SOLAR_SYSTEM - " << SolarSystem::RING_DATA_FILE_NAME << " has invalid lines, it has not been reloaded" << std::endl;
+			return;
+		}
+
+		ringLinesByBodyName.emplace(ringParams[0], &ringParams);
+	}
+
+	// Rings whose line has been removed, or whose Model has changed, are destroyed (the radius not being applied to the Model yet, it is not compared)
+	for (const EntityHandle bodyEntityHandle : solarSystem.bodyEntityHandles)
+	{
+		const std::string& bodyName = solarSystem.GetEntity(bodyEntityHandle)->GetName();
+		const BodyRingsEntity* const bodyRingsEntity = solarSystem.GetEntity<const BodyRingsEntity>(bodyName + "Rings");
+		if (bodyRingsEntity == nullptr)
+		{
+			continue;
+		}
+
+		const auto& ringLineIt = ringLinesByBodyName.find(bodyName);
+		if (ringLineIt == ringLinesByBodyName.end() || solarSystem.ringModelPaths[(*ringLineIt->second)[1]] != bodyRingsEntity->GetRingsData().modelPath)
+		{
+			solarSystem.DestroyEntity(bodyRingsEntity->GetHandle());
+		}
+	}
+
+	// Bodies without rings get the ones of their line, if any (new lines, changed Models, or bodies just created again)
+	for (const auto& [bodyName, ringParams] : ringLinesByBodyName)
+	{
+		if (solarSystem.GetEntity(bodyName) != nullptr && solarSystem.GetEntity(bodyName + "Rings") == nullptr)
+		{
+			solarSystem.CreateBodyRings(*ringParams);
+		}
+	}
+}
+
+void SolarSystemReloader::ReloadBelts()
+{
+	const std::string currentSolutionPath(FileHelper::GetSolutionAbsolutePath());
+
+	// Models of new belt rocks may have been added to the folder
+	FileHelper::ListModelPaths(currentSolutionPath + "/Models/Belts/", solarSystem.beltModelPaths);
+
+	ResourceCSVParser beltCSVParser(currentSolutionPath + SolarSystem::DATA_DIRECTORY + SolarSystem::BELT_DATA_FILE_NAME);
+	const std::vector<std::vector<std::string>>& beltCSVLines = beltCSVParser.GetParsedCSV();
+	if (std::any_of(beltCSVLines.begin(), beltCSVLines.end(), [](const std::vector<std::string>& beltParams) { return beltParams.size() < BELT_CSV_COLUMN_COUNT; }))
+	{
+		std::cout << "ERROR::SOLAR_SYSTEM - " << SolarSystem::BELT_DATA_FILE_NAME << " has lines with missing values, it has not been reloaded" << std::endl;
+		return;
+	}
+
+	// Values are converted by solarSystem.ComputeBeltParams() once belts are compared, so they are all checked beforehand
+	if (std::all_of(beltCSVLines.begin(), beltCSVLines.end(), IsBeltCSVLineValid) == false)
+	{
+		std::cout << "ERROR::SOLAR_SYSTEM - " << SolarSystem::BELT_DATA_FILE_NAME << " has invalid lines, it has not been reloaded" << std::endl;
+		return;
+	}
+
+	const auto FindBeltRockGroup = [this](const std::string& beltName)
+	{
+		return std::find_if(solarSystem.beltRockGroups.begin(), solarSystem.beltRockGroups.end(), [&beltName](const BeltRockGroup& group) { return group.beltEntity->GetName() == beltName; });
+	};
+
+	// Belts whose line has been removed are destroyed (last ones first, so indices of the ones left to check do not change)
+	for (std::size_t i = solarSystem.beltRockGroups.size(); i-- > 0;)
+	{
+		const std::string& beltName = solarSystem.beltRockGroups[i].beltEntity->GetName();
+		if (std::none_of(beltCSVLines.begin(), beltCSVLines.end(), [&beltName](const std::vector<std::string>& beltParams) { return beltParams[0] == beltName; }))
+		{
+			solarSystem.DestroyBelt(i);
+		}
+	}
+
+	for (const std::vector<std::string>& beltParams : beltCSVLines)
+	{
+		InstanceParams instanceParams;
+		TorusParams torusParams;
+		BeltRockGroup beltRockGroup;
+		const bool areBeltParamsComputed = solarSystem.ComputeBeltParams(beltParams, instanceParams, torusParams, beltRockGroup);
+
+		const auto& groupIt = FindBeltRockGroup(beltParams[0]);
+		if (groupIt == solarSystem.beltRockGroups.end())
+		{
+			if (areBeltParamsComputed)
+			{
+				solarSystem.CreateBelt(beltParams[0], std::move(instanceParams), std::move(torusParams), std::move(beltRockGroup));
+			}
+
+			continue;
+		}
+
+		const std::size_t groupIndex = static_cast<std::size_t>(std::distance(solarSystem.beltRockGroups.begin(), groupIt));
+
+		// Bodies bounding the belt have been removed
+		if (areBeltParamsComputed == false)
+		{
+			solarSystem.DestroyBelt(groupIndex);
+			continue;
+		}
+
+		const BeltEntity& beltEntity = *groupIt->beltEntity;
+		if (HaveSameInstances(beltEntity.GetInstanceParams(), instanceParams) && HaveSameTorus(beltEntity.GetTorusParams(), torusParams) &&
+			groupIt->physicalInnerRadius == beltRockGroup.physicalInnerRadius && groupIt->sceneUnitsPerLogRadius == beltRockGroup.sceneUnitsPerLogRadius &&
+			groupIt->orbitNormal == beltRockGroup.orbitNormal)
+		{
+			continue;
+		}
+
+		// Instances are placed again with the rock Model already loaded, which is only loaded again if it has changed
+		const uint32_t rockCount = beltEntity.GetInstanceParams().count;
+		const uint32_t newRockCount = instanceParams.count;
+		if (instanceParams.modelPath == beltEntity.GetInstanceParams().modelPath)
+		{
+			solarSystem.GetEntity<BeltEntity>(beltEntity.GetHandle())->Regenerate(std::move(instanceParams), std::move(torusParams));
+		}
+		else
+		{
+			solarSystem.DestroyEntity(beltEntity.GetHandle());
+			groupIt->beltEntity = solarSystem.GetEntity<BeltEntity>(solarSystem.CreateEntity<BeltEntity>(RenderableType::OPAQUE_ENTITY,
+				beltParams[0],
+				std::move(instanceParams),
+				std::move(torusParams)
+			));
+		}
+
+		beltRockGroup.beltEntity = groupIt->beltEntity;
+		beltRockGroup.firstRockIndex = groupIt->firstRockIndex;
+		*groupIt = beltRockGroup;
+
+		solarSystem.ResizeBeltRocks(groupIndex, rockCount, newRockCount);
+		solarSystem.SetBeltRockOrbits(solarSystem.beltRockGroups[groupIndex]);
+	}
+
+	// Particles are launched again out of the new rock orbits
+	if (solarSystem.isNBodyModeEnabled)
+	{
+		solarSystem.LoadBeltParticles();
+	}
+}
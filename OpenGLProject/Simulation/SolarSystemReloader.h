@@ -0,0 +1,45 @@
+#ifndef SOLAR_SYSTEM_RELOADER_H
+#define SOLAR_SYSTEM_RELOADER_H
+
+#include "Utils/FileWatcher.h"
+
+class SolarSystem;
+
+
+
+// Apply the CSV files of the Data folder edited while running to a Solar System, without restarting: only what differs from the Scene is applied.
+// Motion values of bodies are overwritten in place, belts have their instances placed again, and only entities whose textures/Models depend on edited
+// values (or whose line has been added/removed) are created/destroyed. Rings and belts, depending on bodies, are checked again whenever bodies have changed
+class SolarSystemReloader
+{
+public:
+	explicit SolarSystemReloader(SolarSystem& inSolarSystem);
+
+	// Copy constructor (not needed - SINGLE RELOADER PER SOLAR SYSTEM)
+	SolarSystemReloader(const SolarSystemReloader& inSolarSystemReloader) = delete;
+	SolarSystemReloader& operator = (const SolarSystemReloader& inSolarSystemReloader) = delete;
+
+	// Move constructor (not needed)
+	SolarSystemReloader(SolarSystemReloader&& inSolarSystemReloader) = delete;
+	SolarSystemReloader& operator = (SolarSystemReloader&& inSolarSystemReloader) = delete;
+
+	// Start watching the CSV files the Solar System has been built out of
+	void Open();
+
+	// Parse again the CSV files written since the last call, and apply them to the Solar System
+	void ReloadChangedDataFiles();
+
+private:
+	SolarSystem& solarSystem;
+
+	// CSV files of the Data folder, watched so values edited while running are applied at the next update
+	FileWatcher dataFileWatcher;
+
+	void ReloadCelestialBodies();
+	void ReloadBodyRings();
+	void ReloadBelts();
+};
+
+
+
+#endif // SOLAR_SYSTEM_RELOADER_H
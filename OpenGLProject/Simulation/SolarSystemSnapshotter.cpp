@@ -0,0 +1,270 @@
+#include "SolarSystemSnapshotter.h"
+
+#include <glm/vec3.hpp>
+
+#include <cstddef> // std::size_t
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Application/Application.h"
+#include "Cameras/PerspectiveCamera.h"
+#include "Entities/BeltEntity.h"
+#include "SolarSystem.h"
+#include "Utils/Helpers.h"
+
+namespace
+{
+	// Snapshots only depend on the orbital elements of bodies, already hashed to detect outdated ephemeris files
+	uint64_t ComputeSnapshotFingerprint(const CelestialBodyTable& bodyTable)
+	{
+		return ChebyshevEphemeris::ComputeFingerprint(bodyTable, EphemerisParams());
+	}
+
+	SnapshotBelt MakeSnapshotBelt(const std::string& beltName, const InstanceParams& instanceParams, const TorusParams& torusParams)
+	{
+		return SnapshotBelt{ SimulationSnapshot::ComputeNameHash(beltName), instanceParams.seed, instanceParams.count, instanceParams.sizeRangeSpan,
+			instanceParams.sizeRangeLowerBound, torusParams.majorRadius, torusParams.minorRadius, torusParams.flatnessFactor };
+	}
+
+}
+
+
+
+SolarSystemSnapshotter::SolarSystemSnapshotter(SolarSystem& inSolarSystem, const std::filesystem::path& inSnapshotPath) :
+	solarSystem(inSolarSystem),
+	snapshotPath(inSnapshotPath.empty() ? std::filesystem::path(FileHelper::GetSolutionAbsolutePath() + "/Data/Cache/SimulationSnapshot.bin") : inSnapshotPath)
+{
+}
+
+void SolarSystemSnapshotter::Update()
+{
+	switch (Application::GetInstance().TakeSnapshotRequest())
+	{
+	case SnapshotRequest::SAVE:
+	{
+		Save(snapshotPath);
+		break;
+	}
+	case SnapshotRequest::RESTORE:
+	{
+		Restore(snapshotPath);
+		break;
+	}
+	default:
+	{
+		break;
+	}
+	}
+}
+
+bool SolarSystemSnapshotter::Open(const std::filesystem::path& filePath, SimulationSnapshot& outSnapshot) const
+{
+	return outSnapshot.Open(filePath, ComputeSnapshotFingerprint(solarSystem.bodyTable), solarSystem.bodyTable.GetBodyCount());
+}
+
+bool SolarSystemSnapshotter::Save(const std::filesystem::path& filePath) const
+{
+	const PerspectiveCamera& camera = solarSystem.sceneViewer.GetCamera();
+
+	SnapshotState state;
+	state.julianDate = solarSystem.clock.GetJulianDate();
+	state.beltParticleElapsedDays = solarSystem.beltParticleElapsedDays;
+	state.speedFactor = Application::GetInstance().GetSpeedFactor();
+	state.pausedSpeedFactor = Application::GetInstance().GetPausedSpeedFactor();
+	state.cameraPosition = camera.GetPosition();
+	state.cameraRotation = camera.GetOrientation().GetRotation();
+	state.isNBodyModeEnabled = solarSystem.isNBodyModeEnabled ? 1 : 0;
+
+	// Sections point to the arrays of the simulation, written as is
+	std::vector<SnapshotSection> sections;
+	sections.push_back(SnapshotSection::Make(SnapshotSectionType::STATE, 0, &state, 1));
+
+	// N-Body state and belt particles only exist in N-Body mode (being built out of the Keplerian state otherwise)
+	if (solarSystem.isNBodyModeEnabled)
+	{
+		sections.push_back(SnapshotSection::Make(SnapshotSectionType::N_BODY_MASSES, 0, solarSystem.nBodySystem.GetMasses()));
+		sections.push_back(SnapshotSection::Make(SnapshotSectionType::N_BODY_POSITIONS_X, 0, solarSystem.nBodySystem.GetPositionsX()));
+		sections.push_back(SnapshotSection::Make(SnapshotSectionType::N_BODY_POSITIONS_Y, 0, solarSystem.nBodySystem.GetPositionsY()));
+		sections.push_back(SnapshotSection::Make(SnapshotSectionType::N_BODY_POSITIONS_Z, 0, solarSystem.nBodySystem.GetPositionsZ()));
+		sections.push_back(SnapshotSection::Make(SnapshotSectionType::N_BODY_VELOCITIES_X, 0, solarSystem.nBodySystem.GetVelocitiesX()));
+		sections.push_back(SnapshotSection::Make(SnapshotSectionType::N_BODY_VELOCITIES_Y, 0, solarSystem.nBodySystem.GetVelocitiesY()));
+		sections.push_back(SnapshotSection::Make(SnapshotSectionType::N_BODY_VELOCITIES_Z, 0, solarSystem.nBodySystem.GetVelocitiesZ()));
+		sections.push_back(SnapshotSection::Make(SnapshotSectionType::N_BODY_INDICES, 0, solarSystem.nBodyIndices));
+
+		sections.push_back(SnapshotSection::Make(SnapshotSectionType::BELT_PARTICLE_POSITIONS_X, 0, solarSystem.beltParticles.positionsX));
+		sections.push_back(SnapshotSection::Make(SnapshotSectionType::BELT_PARTICLE_POSITIONS_Y, 0, solarSystem.beltParticles.positionsY));
+		sections.push_back(SnapshotSection::Make(SnapshotSectionType::BELT_PARTICLE_POSITIONS_Z, 0, solarSystem.beltParticles.positionsZ));
+		sections.push_back(SnapshotSection::Make(SnapshotSectionType::BELT_PARTICLE_VELOCITIES_X, 0, solarSystem.beltParticles.velocitiesX));
+		sections.push_back(SnapshotSection::Make(SnapshotSectionType::BELT_PARTICLE_VELOCITIES_Y, 0, solarSystem.beltParticles.velocitiesY));
+		sections.push_back(SnapshotSection::Make(SnapshotSectionType::BELT_PARTICLE_VELOCITIES_Z, 0, solarSystem.beltParticles.velocitiesZ));
+		sections.push_back(SnapshotSection::Make(SnapshotSectionType::BELT_PARTICLE_ACCELERATIONS_X, 0, solarSystem.beltParticles.accelerationsX));
+		sections.push_back(SnapshotSection::Make(SnapshotSectionType::BELT_PARTICLE_ACCELERATIONS_Y, 0, solarSystem.beltParticles.accelerationsY));
+		sections.push_back(SnapshotSection::Make(SnapshotSectionType::BELT_PARTICLE_ACCELERATIONS_Z, 0, solarSystem.beltParticles.accelerationsZ));
+	}
+
+	std::vector<SnapshotBelt> snapshotBelts;
+	snapshotBelts.reserve(solarSystem.beltRockGroups.size());
+	for (uint32_t i = 0; i < solarSystem.beltRockGroups.size(); ++i)
+	{
+		const BeltEntity& beltEntity = *solarSystem.beltRockGroups[i].beltEntity;
+		const std::size_t firstRockIndex = solarSystem.beltRockGroups[i].firstRockIndex;
+		const std::size_t rockCount = beltEntity.GetInstanceParams().count;
+
+		snapshotBelts.push_back(MakeSnapshotBelt(beltEntity.GetName(), beltEntity.GetInstanceParams(), beltEntity.GetTorusParams()));
+		sections.push_back(SnapshotSection::Make(SnapshotSectionType::BELT, i, &snapshotBelts.back(), 1));
+		sections.push_back(SnapshotSection::Make(SnapshotSectionType::BELT_INSTANCE_PLACEMENTS, i, beltEntity.GetInstancePlacements()));
+		sections.push_back(SnapshotSection::Make(SnapshotSectionType::BELT_INSTANCE_ROTATION_SCALE_COLUMNS, i, beltEntity.GetInstanceRotationScaleColumns()));
+		sections.push_back(SnapshotSection::Make(SnapshotSectionType::BELT_ROCK_ORBIT_FREQS, i, solarSystem.beltRocks.orbitFreqs.data() + firstRockIndex, rockCount));
+		sections.push_back(SnapshotSection::Make(SnapshotSectionType::BELT_ROCK_ORBIT_PHASES_AT_EPOCH, i, solarSystem.beltRocks.orbitPhasesAtEpoch.data() + firstRockIndex, rockCount));
+		sections.push_back(SnapshotSection::Make(SnapshotSectionType::BELT_ROCK_ECCENTRICITIES, i, solarSystem.beltRocks.eccentricities.data() + firstRockIndex, rockCount));
+		sections.push_back(SnapshotSection::Make(SnapshotSectionType::BELT_ROCK_PERIAPSIS_AXES, i, solarSystem.beltRocks.periapsisAxes.data() + firstRockIndex, rockCount));
+		sections.push_back(SnapshotSection::Make(SnapshotSectionType::BELT_ROCK_SEMI_MINOR_AXES, i, solarSystem.beltRocks.semiMinorAxes.data() + firstRockIndex, rockCount));
+	}
+
+	if (SimulationSnapshot::Write(filePath, ComputeSnapshotFingerprint(solarSystem.bodyTable), static_cast<uint32_t>(solarSystem.bodyTable.GetBodyCount()), sections) == false)
+	{
+		std::cout << "ERROR::SOLAR_SYSTEM - Snapshot " << filePath.filename().string() << " could not be saved" << std::endl;
+		return false;
+	}
+
+	std::cout << "Simulation snapshot saved to " << filePath.string() << std::endl;
+	return true;
+}
+
+bool SolarSystemSnapshotter::Restore(const std::filesystem::path& filePath)
+{
+	SimulationSnapshot snapshot;
+	if (Open(filePath, snapshot) == false)
+	{
+		std::cout << "ERROR::SOLAR_SYSTEM - Snapshot " << filePath.filename().string() << " could not be opened" << std::endl;
+		return false;
+	}
+
+	return RestoreState(snapshot);
+}
+
+bool SolarSystemSnapshotter::RestoreState(const SimulationSnapshot& snapshot)
+{
+	std::size_t stateCount = 0;
+	const SnapshotState* const state = snapshot.GetSection<SnapshotState>(SnapshotSectionType::STATE, 0, stateCount);
+	if (state == nullptr || stateCount != 1)
+	{
+		std::cout << "ERROR::SOLAR_SYSTEM - Snapshot has no simulation state" << std::endl;
+		return false;
+	}
+
+	// Belt particles are only meaningful for the belts they have been launched from
+	std::size_t extraBeltCount = 0;
+	bool areBeltsMatching = snapshot.GetSection<SnapshotBelt>(SnapshotSectionType::BELT, static_cast<uint32_t>(solarSystem.beltRockGroups.size()), extraBeltCount) == nullptr;
+	for (uint32_t i = 0; i < solarSystem.beltRockGroups.size() && areBeltsMatching; ++i)
+	{
+		const BeltEntity& beltEntity = *solarSystem.beltRockGroups[i].beltEntity;
+		areBeltsMatching = IsBeltMatching(snapshot, i, beltEntity.GetName(), beltEntity.GetInstanceParams(), beltEntity.GetTorusParams());
+	}
+
+	if (areBeltsMatching == false)
+	{
+		std::cout << "ERROR::SOLAR_SYSTEM - Snapshot has been taken with other belt data" << std::endl;
+		return false;
+	}
+
+	// N-Body state is read entirely before anything is overwritten, so a snapshot missing part of it leaves the simulation untouched
+	const bool isSnapshotNBodyModeEnabled = state->isNBodyModeEnabled != 0;
+	std::size_t nBodyCount = 0;
+	snapshot.GetSection<double>(SnapshotSectionType::N_BODY_MASSES, 0, nBodyCount);
+
+	std::vector<double> masses(nBodyCount);
+	std::vector<double> positionsX(nBodyCount);
+	std::vector<double> positionsY(nBodyCount);
+	std::vector<double> positionsZ(nBodyCount);
+	std::vector<double> velocitiesX(nBodyCount);
+	std::vector<double> velocitiesY(nBodyCount);
+	std::vector<double> velocitiesZ(nBodyCount);
+	std::vector<int32_t> restoredNBodyIndices(solarSystem.bodyTable.GetBodyCount());
+
+	// One particle per rock in every particle array
+	const std::size_t particleCount = solarSystem.beltRocks.GetRockCount();
+	bool areParticlesComplete = true;
+	for (const SnapshotSectionType particleSectionType : { SnapshotSectionType::BELT_PARTICLE_POSITIONS_X, SnapshotSectionType::BELT_PARTICLE_POSITIONS_Y,
+		SnapshotSectionType::BELT_PARTICLE_POSITIONS_Z, SnapshotSectionType::BELT_PARTICLE_VELOCITIES_X, SnapshotSectionType::BELT_PARTICLE_VELOCITIES_Y,
+		SnapshotSectionType::BELT_PARTICLE_VELOCITIES_Z, SnapshotSectionType::BELT_PARTICLE_ACCELERATIONS_X, SnapshotSectionType::BELT_PARTICLE_ACCELERATIONS_Y,
+		SnapshotSectionType::BELT_PARTICLE_ACCELERATIONS_Z })
+	{
+		std::size_t sectionParticleCount = 0;
+		areParticlesComplete = areParticlesComplete && snapshot.GetSection<float>(particleSectionType, 0, sectionParticleCount) != nullptr && sectionParticleCount == particleCount;
+	}
+
+	if (isSnapshotNBodyModeEnabled && (areParticlesComplete == false ||
+		snapshot.ReadSection(SnapshotSectionType::N_BODY_MASSES, 0, masses.data(), nBodyCount) == false ||
+		snapshot.ReadSection(SnapshotSectionType::N_BODY_POSITIONS_X, 0, positionsX.data(), nBodyCount) == false ||
+		snapshot.ReadSection(SnapshotSectionType::N_BODY_POSITIONS_Y, 0, positionsY.data(), nBodyCount) == false ||
+		snapshot.ReadSection(SnapshotSectionType::N_BODY_POSITIONS_Z, 0, positionsZ.data(), nBodyCount) == false ||
+		snapshot.ReadSection(SnapshotSectionType::N_BODY_VELOCITIES_X, 0, velocitiesX.data(), nBodyCount) == false ||
+		snapshot.ReadSection(SnapshotSectionType::N_BODY_VELOCITIES_Y, 0, velocitiesY.data(), nBodyCount) == false ||
+		snapshot.ReadSection(SnapshotSectionType::N_BODY_VELOCITIES_Z, 0, velocitiesZ.data(), nBodyCount) == false ||
+		snapshot.ReadSection(SnapshotSectionType::N_BODY_INDICES, 0, restoredNBodyIndices.data(), restoredNBodyIndices.size()) == false))
+	{
+		std::cout << "ERROR::SOLAR_SYSTEM - Snapshot N-Body state is incomplete" << std::endl;
+		return false;
+	}
+
+	Application::GetInstance().SetSpeedFactors(state->speedFactor, state->pausedSpeedFactor);
+	Application::GetInstance().EnableNBodyMode(isSnapshotNBodyModeEnabled);
+	solarSystem.sceneViewer.GetCamera().SetTransform(state->cameraPosition, state->cameraRotation);
+
+	solarSystem.isNBodyModeEnabled = isSnapshotNBodyModeEnabled;
+	solarSystem.stepScheduler = FixedStepScheduler(solarSystem.isNBodyModeEnabled ? SolarSystem::N_BODY_STEP_PARAMS : SolarSystem::KEPLERIAN_STEP_PARAMS);
+	solarSystem.timeline.Clear();
+
+	// No previous state to blend from after a jump in time
+	solarSystem.clock.SeekTo(state->julianDate);
+	solarSystem.stepScheduler.Reset();
+	solarSystem.previousStepElapsedDays = solarSystem.clock.GetElapsedDaysSinceEpoch();
+
+	solarSystem.beltParticles.Clear();
+	if (solarSystem.isNBodyModeEnabled)
+	{
+		solarSystem.nBodySystem.Clear();
+		solarSystem.nBodySystem.Reserve(nBodyCount);
+		for (std::size_t i = 0; i < nBodyCount; ++i)
+		{
+			solarSystem.nBodySystem.AddBody(masses[i], glm::dvec3(positionsX[i], positionsY[i], positionsZ[i]), glm::dvec3(velocitiesX[i], velocitiesY[i], velocitiesZ[i]));
+		}
+		solarSystem.nBodySystem.ResetDriftReference();
+		solarSystem.nBodyIndices = std::move(restoredNBodyIndices);
+
+		// Particles (and their accelerations, the first kick of their next step reusing them) are copied in bulk out of the mapped file
+		solarSystem.LoadBeltAttractors();
+		solarSystem.beltParticles.Resize(particleCount);
+		snapshot.ReadSection(SnapshotSectionType::BELT_PARTICLE_POSITIONS_X, 0, solarSystem.beltParticles.positionsX.data(), particleCount);
+		snapshot.ReadSection(SnapshotSectionType::BELT_PARTICLE_POSITIONS_Y, 0, solarSystem.beltParticles.positionsY.data(), particleCount);
+		snapshot.ReadSection(SnapshotSectionType::BELT_PARTICLE_POSITIONS_Z, 0, solarSystem.beltParticles.positionsZ.data(), particleCount);
+		snapshot.ReadSection(SnapshotSectionType::BELT_PARTICLE_VELOCITIES_X, 0, solarSystem.beltParticles.velocitiesX.data(), particleCount);
+		snapshot.ReadSection(SnapshotSectionType::BELT_PARTICLE_VELOCITIES_Y, 0, solarSystem.beltParticles.velocitiesY.data(), particleCount);
+		snapshot.ReadSection(SnapshotSectionType::BELT_PARTICLE_VELOCITIES_Z, 0, solarSystem.beltParticles.velocitiesZ.data(), particleCount);
+		snapshot.ReadSection(SnapshotSectionType::BELT_PARTICLE_ACCELERATIONS_X, 0, solarSystem.beltParticles.accelerationsX.data(), particleCount);
+		snapshot.ReadSection(SnapshotSectionType::BELT_PARTICLE_ACCELERATIONS_Y, 0, solarSystem.beltParticles.accelerationsY.data(), particleCount);
+		snapshot.ReadSection(SnapshotSectionType::BELT_PARTICLE_ACCELERATIONS_Z, 0, solarSystem.beltParticles.accelerationsZ.data(), particleCount);
+		solarSystem.beltParticleElapsedDays = state->beltParticleElapsedDays;
+	}
+
+	solarSystem.PlaceCelestialBodies(solarSystem.previousStepElapsedDays);
+
+	return true;
+}
+
+bool SolarSystemSnapshotter::IsBeltMatching(const SimulationSnapshot& snapshot, const uint32_t beltIndex, const std::string& beltName,
+	const InstanceParams& instanceParams, const TorusParams& torusParams)
+{
+	const SnapshotBelt belt(MakeSnapshotBelt(beltName, instanceParams, torusParams));
+
+	std::size_t beltCount = 0;
+	const SnapshotBelt* const snapshotBelt = snapshot.GetSection<SnapshotBelt>(SnapshotSectionType::BELT, beltIndex, beltCount);
+	return snapshotBelt != nullptr && beltCount == 1 && snapshotBelt->nameHash == belt.nameHash && snapshotBelt->seed == belt.seed &&
+		snapshotBelt->instanceCount == belt.instanceCount && snapshotBelt->sizeRangeSpan == belt.sizeRangeSpan &&
+		snapshotBelt->sizeRangeLowerBound == belt.sizeRangeLowerBound && snapshotBelt->majorRadius == belt.majorRadius &&
+		snapshotBelt->minorRadius == belt.minorRadius && snapshotBelt->flatnessFactor == belt.flatnessFactor;
+}
@@ -0,0 +1,58 @@
+#ifndef SOLAR_SYSTEM_SNAPSHOTTER_H
+#define SOLAR_SYSTEM_SNAPSHOTTER_H
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+class SimulationSnapshot;
+class SolarSystem;
+struct InstanceParams;
+struct TorusParams;
+
+
+
+// Save the whole state of a Solar System (date, speed, camera, N-Body and belt particle states, belt instances) to snapshot files, and go back to it,
+// N-Body state and belt particles being copied as is so the simulation goes on exactly from where the snapshot has been taken
+class SolarSystemSnapshotter
+{
+public:
+	// Snapshots are saved to/restored from the provided file on user request (in the cache folder if none is provided)
+	SolarSystemSnapshotter(SolarSystem& inSolarSystem, const std::filesystem::path& inSnapshotPath);
+
+	// Copy constructor (not needed - SINGLE SNAPSHOTTER PER SOLAR SYSTEM)
+	SolarSystemSnapshotter(const SolarSystemSnapshotter& inSolarSystemSnapshotter) = delete;
+	SolarSystemSnapshotter& operator = (const SolarSystemSnapshotter& inSolarSystemSnapshotter) = delete;
+
+	// Move constructor (not needed)
+	SolarSystemSnapshotter(SolarSystemSnapshotter&& inSolarSystemSnapshotter) = delete;
+	SolarSystemSnapshotter& operator = (SolarSystemSnapshotter&& inSolarSystemSnapshotter) = delete;
+
+	// Save or restore the snapshot file if the user has requested it since the last call
+	void Update();
+
+	// Open a snapshot file, and return whether it has been taken out of the current celestial body data
+	bool Open(const std::filesystem::path& filePath, SimulationSnapshot& outSnapshot) const;
+
+	// Save the simulation state to a snapshot file, and return whether it succeeded
+	bool Save(const std::filesystem::path& filePath) const;
+
+	// Go back to the state saved in a snapshot file taken out of the same celestial body and belt data, and return whether it succeeded
+	bool Restore(const std::filesystem::path& filePath);
+
+	// Apply the state of an opened snapshot, after checking it has been taken with the current belts. Return whether it succeeded
+	bool RestoreState(const SimulationSnapshot& snapshot);
+
+	// Whether the belt stored at the provided index of a snapshot has been built out of the same parameters (so its instances can be reused)
+	static bool IsBeltMatching(const SimulationSnapshot& snapshot, const uint32_t beltIndex, const std::string& beltName,
+		const InstanceParams& instanceParams, const TorusParams& torusParams);
+
+private:
+	SolarSystem& solarSystem;
+
+	std::filesystem::path snapshotPath;
+};
+
+
+
+#endif // SOLAR_SYSTEM_SNAPSHOTTER_H
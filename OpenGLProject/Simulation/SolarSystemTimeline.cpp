@@ -0,0 +1,119 @@
+#include "SolarSystemTimeline.h"
+
+#include <glm/vec3.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef> // std::size_t
+#include <iostream>
+#include <vector>
+
+#include "Application/Application.h"
+#include "SimulationClock.h"
+#include "SolarSystem.h"
+#include "Utils/Helpers.h"
+
+
+
+SolarSystemTimeline::SolarSystemTimeline(SolarSystem& inSolarSystem) :
+	solarSystem(inSolarSystem)
+{
+}
+
+void SolarSystemTimeline::Update()
+{
+	if (Application::GetInstance().IsTimelineRecordingEnabled() != timelineRecorder.IsOpen())
+	{
+		if (Application::GetInstance().IsTimelineRecordingEnabled())
+		{
+			timelineRecorder.Open(FileHelper::GetSolutionAbsolutePath() + "/Data/Cache/Timeline/", TIMELINE_PARAMS);
+		}
+		else
+		{
+			timelineRecorder.Close();
+		}
+	}
+
+	const double scrubDays = Application::GetInstance().TakeScrubRequest();
+	if (scrubDays != 0.0)
+	{
+		ScrubTo(solarSystem.clock.GetJulianDate() + scrubDays);
+	}
+}
+
+void SolarSystemTimeline::RecordFrame()
+{
+	timelineRecorder.RecordFrame(solarSystem.beltParticleElapsedDays, solarSystem.nBodySystem, solarSystem.beltParticles);
+}
+
+bool SolarSystemTimeline::ScrubTo(const double julianDate)
+{
+	// Keplerian states are evaluated in closed form at any date
+	if (solarSystem.isNBodyModeEnabled == false)
+	{
+		solarSystem.SeekTo(julianDate);
+		return true;
+	}
+
+	if (timelineRecorder.HasFrames() == false)
+	{
+		std::cout << "ERROR::SOLAR_SYSTEM - No timeline has been recorded in N-Body mode to scrub through" << std::endl;
+		return false;
+	}
+
+	const double elapsedDays = std::clamp(julianDate - SimulationClock::J2000_JULIAN_DATE,
+		timelineRecorder.GetFirstFrameElapsedDays(), timelineRecorder.GetLastFrameElapsedDays());
+
+	TimelineFrame frame;
+	if (timelineRecorder.ScrubTo(elapsedDays, frame) == false)
+	{
+		return false;
+	}
+
+	// Bodies/belts changing clears the timeline, so frames always match the current N-Body System and particles
+	const std::size_t nBodyCount = frame.nBodyStates[0].size();
+	const std::size_t particleCount = frame.particleStates[0].size();
+	if (nBodyCount != solarSystem.nBodySystem.GetBodyCount() || particleCount != solarSystem.beltRocks.GetRockCount())
+	{
+		std::cout << "ERROR::SOLAR_SYSTEM - Timeline frame does not match the current bodies/belts" << std::endl;
+		assert(false);
+		return false;
+	}
+
+	const std::vector<double> masses(solarSystem.nBodySystem.GetMasses());
+	solarSystem.nBodySystem.Clear();
+	solarSystem.nBodySystem.Reserve(nBodyCount);
+	for (std::size_t i = 0; i < nBodyCount; ++i)
+	{
+		solarSystem.nBodySystem.AddBody(masses[i], glm::dvec3(frame.nBodyStates[0][i], frame.nBodyStates[1][i], frame.nBodyStates[2][i]),
+			glm::dvec3(frame.nBodyStates[3][i], frame.nBodyStates[4][i], frame.nBodyStates[5][i]));
+	}
+	solarSystem.nBodySystem.ResetDriftReference();
+
+	// Accelerations are not recorded, but computed again out of positions and attractors at the frame date
+	solarSystem.beltParticles.Resize(particleCount);
+	solarSystem.beltParticles.positionsX = std::move(frame.particleStates[0]);
+	solarSystem.beltParticles.positionsY = std::move(frame.particleStates[1]);
+	solarSystem.beltParticles.positionsZ = std::move(frame.particleStates[2]);
+	solarSystem.beltParticles.velocitiesX = std::move(frame.particleStates[3]);
+	solarSystem.beltParticles.velocitiesY = std::move(frame.particleStates[4]);
+	solarSystem.beltParticles.velocitiesZ = std::move(frame.particleStates[5]);
+	solarSystem.LoadBeltAttractors();
+	solarSystem.beltParticles.ComputeAccelerations();
+
+	solarSystem.clock.SeekTo(SimulationClock::J2000_JULIAN_DATE + frame.elapsedDays);
+	solarSystem.stepScheduler.Reset();
+	solarSystem.beltParticleElapsedDays = frame.elapsedDays;
+
+	// Frames being recorded once per belt particle step, the run goes on from the frame up to the exact date
+	while (elapsedDays - solarSystem.clock.GetElapsedDaysSinceEpoch() >= solarSystem.stepScheduler.GetStepSize())
+	{
+		solarSystem.Step(solarSystem.stepScheduler.GetStepSize());
+	}
+
+	// No previous state to blend from after a jump in time
+	solarSystem.previousStepElapsedDays = solarSystem.clock.GetElapsedDaysSinceEpoch();
+	solarSystem.PlaceCelestialBodies(solarSystem.previousStepElapsedDays);
+
+	return true;
+}
@@ -0,0 +1,49 @@
+#ifndef SOLAR_SYSTEM_TIMELINE_H
+#define SOLAR_SYSTEM_TIMELINE_H
+
+#include "TimelineRecorder.h"
+
+class SolarSystem;
+
+
+
+// Record the integrated states of a Solar System in N-Body mode while the user has enabled it, and move the simulation to another date of the run
+// (sought to directly in Keplerian mode, and resumed from the last recorded frame before it in N-Body mode)
+class SolarSystemTimeline
+{
+public:
+	explicit SolarSystemTimeline(SolarSystem& inSolarSystem);
+
+	// Copy constructor (not needed - SINGLE TIMELINE PER SOLAR SYSTEM)
+	SolarSystemTimeline(const SolarSystemTimeline& inSolarSystemTimeline) = delete;
+	SolarSystemTimeline& operator = (const SolarSystemTimeline& inSolarSystemTimeline) = delete;
+
+	// Move constructor (not needed)
+	SolarSystemTimeline(SolarSystemTimeline&& inSolarSystemTimeline) = delete;
+	SolarSystemTimeline& operator = (SolarSystemTimeline&& inSolarSystemTimeline) = delete;
+
+	// Start/stop recording as the user toggles it, and scrub to the date the user has requested since the last call
+	void Update();
+
+	// Record the current N-Body and belt particle states, once both correspond to the same date
+	void RecordFrame();
+
+	// Forget the frames recorded so far, as they belong to another run
+	void Clear() { timelineRecorder.Clear(); }
+
+	// Move to another date of the run, the date being brought back within the timeline in N-Body mode. Return whether the date has been reached
+	bool ScrubTo(const double julianDate);
+
+private:
+	SolarSystem& solarSystem;
+
+	// Frames written to the cache folder
+	TimelineRecorder timelineRecorder;
+
+	// Keyframe every 32 simulated days, and 16 chunks on disk, i.e. the last 512 days at least can be scrubbed through
+	static constexpr TimelineParams TIMELINE_PARAMS{ 32, 16 };
+};
+
+
+
+#endif // SOLAR_SYSTEM_TIMELINE_H
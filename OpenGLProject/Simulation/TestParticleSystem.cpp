@@ -0,0 +1,264 @@
+#include "TestParticleSystem.h"
+
+#include <cmath>
+
+#include "Utils/SIMDHelpers.h"
+#include "Utils/ThreadPool.h"
+
+
+
+uint32_t TestParticleSystem::AddParticle(const glm::dvec3& position, const glm::dvec3& velocity)
+{
+	const uint32_t particleIndex = static_cast<uint32_t>(GetParticleCount());
+
+	positionsX.push_back(static_cast<float>(position.x));
+	positionsY.push_back(static_cast<float>(position.y));
+	positionsZ.push_back(static_cast<float>(position.z));
+
+	velocitiesX.push_back(static_cast<float>(velocity.x));
+	velocitiesY.push_back(static_cast<float>(velocity.y));
+	velocitiesZ.push_back(static_cast<float>(velocity.z));
+
+	accelerationsX.push_back(0.0f);
+	accelerationsY.push_back(0.0f);
+	accelerationsZ.push_back(0.0f);
+
+	areAccelerationsUpToDate = false;
+
+	return particleIndex;
+}
+
+void TestParticleSystem::Reserve(const std::size_t particleCount)
+{
+	for (std::vector<float>* const array : { &positionsX, &positionsY, &positionsZ, &velocitiesX, &velocitiesY, &velocitiesZ, &accelerationsX, &accelerationsY, &accelerationsZ })
+	{
+		array->reserve(particleCount);
+	}
+}
+
+void TestParticleSystem::Clear()
+{
+	for (std::vector<float>* const array : { &positionsX, &positionsY, &positionsZ, &velocitiesX, &velocitiesY, &velocitiesZ, &accelerationsX, &accelerationsY, &accelerationsZ })
+	{
+		array->clear();
+	}
+
+	areAccelerationsUpToDate = false;
+}
+
+void TestParticleSystem::Resize(const std::size_t particleCount)
+{
+	for (std::vector<float>* const array : { &positionsX, &positionsY, &positionsZ, &velocitiesX, &velocitiesY, &velocitiesZ, &accelerationsX, &accelerationsY, &accelerationsZ })
+	{
+		array->resize(particleCount);
+	}
+
+	areAccelerationsUpToDate = true;
+}
+
+uint32_t TestParticleSystem::AddAttractor(const double gravitationalParam, const glm::dvec3& position)
+{
+	const uint32_t attractorIndex = static_cast<uint32_t>(GetAttractorCount());
+
+	attractorGravitationalParams.push_back(static_cast<float>(gravitationalParam));
+	attractorPositionsX.push_back(static_cast<float>(position.x));
+	attractorPositionsY.push_back(static_cast<float>(position.y));
+	attractorPositionsZ.push_back(static_cast<float>(position.z));
+
+	areAccelerationsUpToDate = false;
+
+	return attractorIndex;
+}
+
+void TestParticleSystem::SetAttractorPosition(const uint32_t attractorIndex, const glm::dvec3& position)
+{
+	attractorPositionsX[attractorIndex] = static_cast<float>(position.x);
+	attractorPositionsY[attractorIndex] = static_cast<float>(position.y);
+	attractorPositionsZ[attractorIndex] = static_cast<float>(position.z);
+}
+
+void TestParticleSystem::ClearAttractors()
+{
+	attractorGravitationalParams.clear();
+	attractorPositionsX.clear();
+	attractorPositionsY.clear();
+	attractorPositionsZ.clear();
+
+	areAccelerationsUpToDate = false;
+}
+
+void TestParticleSystem::Step(const double stepSize)
+{
+	if (areAccelerationsUpToDate == false)
+	{
+		ComputeAccelerations();
+	}
+
+	const float stepSizeF = static_cast<float>(stepSize);
+	RunBatches([this, stepSizeF](const std::size_t begin, const std::size_t end)
+	{
+		if (isSIMDEnabled)
+		{
+			StepSIMD(begin, end, stepSizeF);
+		}
+		else
+		{
+			StepScalar(begin, end, stepSizeF);
+		}
+	});
+}
+
+void TestParticleSystem::ComputeAccelerations()
+{
+	// A null step leaves positions/velocities untouched, and only refreshes accelerations
+	RunBatches([this](const std::size_t begin, const std::size_t end)
+	{
+		if (isSIMDEnabled)
+		{
+			StepSIMD(begin, end, 0.0f);
+		}
+		else
+		{
+			StepScalar(begin, end, 0.0f);
+		}
+	});
+
+	areAccelerationsUpToDate = true;
+}
+
+void TestParticleSystem::SetComputeOptions(const bool inIsSIMDEnabled, const bool inIsMultithreadingEnabled)
+{
+	isSIMDEnabled = inIsSIMDEnabled;
+	isMultithreadingEnabled = inIsMultithreadingEnabled;
+}
+
+template<typename BatchTaskType>
+void TestParticleSystem::RunBatches(const BatchTaskType& task) const
+{
+	// Each batch only reads attractors and writes the state of its own particles, so batches can run concurrently without synchronisation
+	if (isMultithreadingEnabled)
+	{
+		ThreadPool::GetInstance().ParallelFor(GetParticleCount(), MIN_PARTICLES_PER_THREAD, task);
+	}
+	else
+	{
+		task(0, GetParticleCount());
+	}
+}
+
+void TestParticleSystem::StepScalar(const std::size_t begin, const std::size_t end, const float stepSize)
+{
+	const float halfStepSize = 0.5f * stepSize;
+	const float squaredSoftening = SOFTENING_LENGTH * SOFTENING_LENGTH;
+	const std::size_t attractorCount = GetAttractorCount();
+
+	for (std::size_t i = begin; i < end; ++i)
+	{
+		// Kick with accelerations of the end of the previous step, then drift
+		float velocityX = velocitiesX[i] + accelerationsX[i] * halfStepSize;
+		float velocityY = velocitiesY[i] + accelerationsY[i] * halfStepSize;
+		float velocityZ = velocitiesZ[i] + accelerationsZ[i] * halfStepSize;
+
+		const float positionX = positionsX[i] + velocityX * stepSize;
+		const float positionY = positionsY[i] + velocityY * stepSize;
+		const float positionZ = positionsZ[i] + velocityZ * stepSize;
+
+		float accelerationX = 0.0f;
+		float accelerationY = 0.0f;
+		float accelerationZ = 0.0f;
+
+		for (std::size_t j = 0; j < attractorCount; ++j)
+		{
+			const float deltaX = attractorPositionsX[j] - positionX;
+			const float deltaY = attractorPositionsY[j] - positionY;
+			const float deltaZ = attractorPositionsZ[j] - positionZ;
+
+			// a = GM * d / (|d|^2 + eps^2)^(3/2)
+			const float squaredDistance = deltaX * deltaX + deltaY * deltaY + deltaZ * deltaZ + squaredSoftening;
+			const float factor = attractorGravitationalParams[j] / (squaredDistance * std::sqrt(squaredDistance));
+
+			accelerationX += factor * deltaX;
+			accelerationY += factor * deltaY;
+			accelerationZ += factor * deltaZ;
+		}
+
+		// Kick with accelerations at the new positions
+		velocityX += accelerationX * halfStepSize;
+		velocityY += accelerationY * halfStepSize;
+		velocityZ += accelerationZ * halfStepSize;
+
+		positionsX[i] = positionX;
+		positionsY[i] = positionY;
+		positionsZ[i] = positionZ;
+		velocitiesX[i] = velocityX;
+		velocitiesY[i] = velocityY;
+		velocitiesZ[i] = velocityZ;
+		accelerationsX[i] = accelerationX;
+		accelerationsY[i] = accelerationY;
+		accelerationsZ[i] = accelerationZ;
+	}
+}
+
+void TestParticleSystem::StepSIMD(const std::size_t begin, const std::size_t end, const float stepSize)
+{
+#if SIMD_SSE2_ENABLED
+	const __m128 stepSizeLane = _mm_set1_ps(stepSize);
+	const __m128 halfStepSizeLane = _mm_set1_ps(0.5f * stepSize);
+	const __m128 squaredSofteningLane = _mm_set1_ps(SOFTENING_LENGTH * SOFTENING_LENGTH);
+	const __m128 oneLane = _mm_set1_ps(1.0f);
+	const std::size_t attractorCount = GetAttractorCount();
+
+	// Particles are processed 4 at a time (there are only a few attractors, so vectorising over them would leave lanes empty)
+	std::size_t i = begin;
+	for (; i + SIMDHelpers::FLOAT_LANE_COUNT <= end; i += SIMDHelpers::FLOAT_LANE_COUNT)
+	{
+		__m128 velocityX = _mm_add_ps(_mm_loadu_ps(velocitiesX.data() + i), _mm_mul_ps(_mm_loadu_ps(accelerationsX.data() + i), halfStepSizeLane));
+		__m128 velocityY = _mm_add_ps(_mm_loadu_ps(velocitiesY.data() + i), _mm_mul_ps(_mm_loadu_ps(accelerationsY.data() + i), halfStepSizeLane));
+		__m128 velocityZ = _mm_add_ps(_mm_loadu_ps(velocitiesZ.data() + i), _mm_mul_ps(_mm_loadu_ps(accelerationsZ.data() + i), halfStepSizeLane));
+
+		const __m128 positionX = _mm_add_ps(_mm_loadu_ps(positionsX.data() + i), _mm_mul_ps(velocityX, stepSizeLane));
+		const __m128 positionY = _mm_add_ps(_mm_loadu_ps(positionsY.data() + i), _mm_mul_ps(velocityY, stepSizeLane));
+		const __m128 positionZ = _mm_add_ps(_mm_loadu_ps(positionsZ.data() + i), _mm_mul_ps(velocityZ, stepSizeLane));
+
+		__m128 accelerationX = _mm_setzero_ps();
+		__m128 accelerationY = _mm_setzero_ps();
+		__m128 accelerationZ = _mm_setzero_ps();
+
+		for (std::size_t j = 0; j < attractorCount; ++j)
+		{
+			const __m128 deltaX = _mm_sub_ps(_mm_set1_ps(attractorPositionsX[j]), positionX);
+			const __m128 deltaY = _mm_sub_ps(_mm_set1_ps(attractorPositionsY[j]), positionY);
+			const __m128 deltaZ = _mm_sub_ps(_mm_set1_ps(attractorPositionsZ[j]), positionZ);
+
+			const __m128 squaredDistance = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(deltaX, deltaX), _mm_mul_ps(deltaY, deltaY)), _mm_mul_ps(deltaZ, deltaZ)), squaredSofteningLane);
+
+			// Full precision division rather than the 12-bit reciprocal approximation, whose error would show up as energy drift
+			const __m128 inverseCubedDistance = _mm_div_ps(oneLane, _mm_mul_ps(squaredDistance, _mm_sqrt_ps(squaredDistance)));
+			const __m128 factor = _mm_mul_ps(_mm_set1_ps(attractorGravitationalParams[j]), inverseCubedDistance);
+
+			accelerationX = _mm_add_ps(accelerationX, _mm_mul_ps(factor, deltaX));
+			accelerationY = _mm_add_ps(accelerationY, _mm_mul_ps(factor, deltaY));
+			accelerationZ = _mm_add_ps(accelerationZ, _mm_mul_ps(factor, deltaZ));
+		}
+
+		velocityX = _mm_add_ps(velocityX, _mm_mul_ps(accelerationX, halfStepSizeLane));
+		velocityY = _mm_add_ps(velocityY, _mm_mul_ps(accelerationY, halfStepSizeLane));
+		velocityZ = _mm_add_ps(velocityZ, _mm_mul_ps(accelerationZ, halfStepSizeLane));
+
+		_mm_storeu_ps(positionsX.data() + i, positionX);
+		_mm_storeu_ps(positionsY.data() + i, positionY);
+		_mm_storeu_ps(positionsZ.data() + i, positionZ);
+		_mm_storeu_ps(velocitiesX.data() + i, velocityX);
+		_mm_storeu_ps(velocitiesY.data() + i, velocityY);
+		_mm_storeu_ps(velocitiesZ.data() + i, velocityZ);
+		_mm_storeu_ps(accelerationsX.data() + i, accelerationX);
+		_mm_storeu_ps(accelerationsY.data() + i, accelerationY);
+		_mm_storeu_ps(accelerationsZ.data() + i, accelerationZ);
+	}
+
+	// Remaining particles not filling a whole SIMD register
+	StepScalar(i, end, stepSize);
+#else
+	StepScalar(begin, end, stepSize);
+#endif
+}
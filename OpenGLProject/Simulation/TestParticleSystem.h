@@ -0,0 +1,89 @@
+#ifndef TEST_PARTICLE_SYSTEM_H
+#define TEST_PARTICLE_SYSTEM_H
+
+#include <glm/vec3.hpp>
+
+#include <cstddef> // std::size_t
+#include <cstdint>
+#include <vector>
+
+
+
+// Massless particles moving under the gravity of a few massive attractors, without acting on them nor on each other (restricted N-Body problem),
+// in the same physical units as the N-Body System (positions in AU, time in days). As there can be millions of them, state is stored
+// in single precision as a Structure of Arrays, so a step runs 4 particles at a time with SSE2, split across the threads of the Thread Pool.
+// Attractors are not integrated here: their positions are expected to be set by their owner before each step
+class TestParticleSystem
+{
+public:
+	// Minimum amount of particles per batch when splitting a step across threads (below, synchronisation costs more than it saves)
+	static constexpr std::size_t MIN_PARTICLES_PER_THREAD = 4096;
+
+	// Length added in quadrature to distances to attractors [in AU], so a particle passing through a body (steps being far too large
+	// to resolve such encounters anyway) is not ejected by a near-infinite kick
+	static constexpr float SOFTENING_LENGTH = 1.0e-3f;
+
+	// Register a particle and return its index in every array of the system
+	uint32_t AddParticle(const glm::dvec3& position, const glm::dvec3& velocity);
+
+	void Reserve(const std::size_t particleCount);
+	void Clear();
+
+	// Resize state arrays so they can be filled in bulk by the caller (e.g. out of a snapshot), accelerations included, which are then considered up to date
+	void Resize(const std::size_t particleCount);
+
+	std::size_t GetParticleCount() const { return positionsX.size(); }
+
+	// Register a body particles are attracted by, with its gravitational parameter [in AU^3/days^2], and return its index
+	uint32_t AddAttractor(const double gravitationalParam, const glm::dvec3& position);
+	void SetAttractorPosition(const uint32_t attractorIndex, const glm::dvec3& position);
+	void ClearAttractors();
+
+	std::size_t GetAttractorCount() const { return attractorGravitationalParams.size(); }
+
+	// Advance every particle by one kick-drift-kick leapfrog step [in days], attractors being expected at their position at the end of the step:
+	// the first kick reuses accelerations computed at the end of the previous step, so kicks, drift and the new accelerations are done in a single pass over particles
+	void Step(const double stepSize);
+
+	// Compute the acceleration of every particle at current attractor positions (done automatically by the first step after particles/attractors are added)
+	void ComputeAccelerations();
+
+	// Choose how steps are run (mainly for benchmarking purposes)
+	void SetComputeOptions(const bool inIsSIMDEnabled, const bool inIsMultithreadingEnabled);
+
+	// State arrays
+	std::vector<float> positionsX;
+	std::vector<float> positionsY;
+	std::vector<float> positionsZ;
+
+	std::vector<float> velocitiesX;
+	std::vector<float> velocitiesY;
+	std::vector<float> velocitiesZ;
+
+	std::vector<float> accelerationsX;
+	std::vector<float> accelerationsY;
+	std::vector<float> accelerationsZ;
+
+private:
+	std::vector<float> attractorGravitationalParams;
+	std::vector<float> attractorPositionsX;
+	std::vector<float> attractorPositionsY;
+	std::vector<float> attractorPositionsZ;
+
+	bool areAccelerationsUpToDate{ false };
+
+	bool isSIMDEnabled{ true };
+	bool isMultithreadingEnabled{ true };
+
+	// Run a task over batches of particles, on the Thread Pool if enabled
+	template<typename BatchTaskType>
+	void RunBatches(const BatchTaskType& task) const;
+
+	// Step (or only compute accelerations, with a null step size) particles [begin, end[
+	void StepScalar(const std::size_t begin, const std::size_t end, const float stepSize);
+	void StepSIMD(const std::size_t begin, const std::size_t end, const float stepSize);
+};
+
+
+
+#endif // TEST_PARTICLE_SYSTEM_H
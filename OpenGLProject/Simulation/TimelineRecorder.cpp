@@ -0,0 +1,515 @@
+#include "TimelineRecorder.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <utility>
+
+#include "NBodySystem.h"
+#include "TestParticleSystem.h"
+#include "Utils/ThreadPool.h"
+
+namespace
+{
+	constexpr uint32_t timelineVersion = 1;
+
+	// Frames span multiples of this size in chunk files, so frame headers and state arrays stay aligned when mapped
+	constexpr std::size_t frameAlignment = 8;
+
+	// Minimum amount of quantization blocks per batch when encoding particle deltas across threads
+	constexpr std::size_t minBlocksPerThread = 4;
+
+	constexpr float maxQuantizedDelta = 32767.0f;
+
+	std::size_t AlignFrameSize(const std::size_t byteCount)
+	{
+		return (byteCount + frameAlignment - 1) / frameAlignment * frameAlignment;
+	}
+
+	std::size_t ComputeBlockCount(const std::size_t particleCount)
+	{
+		return (particleCount + TimelineRecorder::PARTICLES_PER_QUANTIZATION_BLOCK - 1) / TimelineRecorder::PARTICLES_PER_QUANTIZATION_BLOCK;
+	}
+
+	std::array<const double*, TimelineFrame::STATE_ARRAY_COUNT> GetNBodyStates(const NBodySystem& nBodySystem)
+	{
+		return { nBodySystem.GetPositionsX().data(), nBodySystem.GetPositionsY().data(), nBodySystem.GetPositionsZ().data(),
+			nBodySystem.GetVelocitiesX().data(), nBodySystem.GetVelocitiesY().data(), nBodySystem.GetVelocitiesZ().data() };
+	}
+
+	std::array<const float*, TimelineFrame::STATE_ARRAY_COUNT> GetParticleStates(const TestParticleSystem& particleSystem)
+	{
+		return { particleSystem.positionsX.data(), particleSystem.positionsY.data(), particleSystem.positionsZ.data(),
+			particleSystem.velocitiesX.data(), particleSystem.velocitiesY.data(), particleSystem.velocitiesZ.data() };
+	}
+
+	// Deltas are added back the same way when encoding and decoding, so both sides reconstruct bit-identical states
+	void AddNBodyDelta(double& state, const float delta)
+	{
+		state += static_cast<double>(delta);
+	}
+
+	void AddParticleDelta(float& state, const int16_t quantizedDelta, const float scale)
+	{
+		state += static_cast<float>(quantizedDelta) * scale;
+	}
+}
+
+
+
+TimelineRecorder::~TimelineRecorder()
+{
+	Close();
+}
+
+void TimelineRecorder::Open(const std::filesystem::path& inDirectory, const TimelineParams& inParams)
+{
+	Close();
+
+	if (inParams.framesPerChunk == 0 || inParams.chunkCount == 0)
+	{
+		std::cout << "ERROR::TIMELINE_RECORDER - At least one frame per chunk and one chunk are expected" << std::endl;
+		assert(false);
+		return;
+	}
+
+	directory = inDirectory;
+	params = inParams;
+	std::filesystem::create_directories(directory);
+
+	Clear();
+	nextSlot = 0;
+
+	isWriterStopping = false;
+	writerThread = std::thread(&TimelineRecorder::RunWriter, this);
+}
+
+void TimelineRecorder::Close()
+{
+	if (IsOpen() == false)
+	{
+		return;
+	}
+
+	{
+		const std::lock_guard<std::mutex> lock(writerMutex);
+		isWriterStopping = true;
+	}
+	writeAvailable.notify_one();
+	writerThread.join();
+
+	// Recorded chunks are kept, so the timeline can still be scrubbed through (they are only forgotten when a new recording starts)
+	freeBuffers.clear();
+}
+
+void TimelineRecorder::Clear()
+{
+	// Chunk files are left as they are, and overwritten when their slot is reused
+	chunks.clear();
+	isLastChunkOpen = false;
+	scrubPoint.reset();
+}
+
+void TimelineRecorder::RecordFrame(const double elapsedDays, const NBodySystem& nBodySystem, const TestParticleSystem& particleSystem)
+{
+	if (IsOpen() == false)
+	{
+		return;
+	}
+
+	// The run has gone on from the frame last scrubbed to, so frames recorded after it are not part of the timeline anymore
+	if (scrubPoint.has_value())
+	{
+		// The chunk scrubbed to may not be recorded anymore (e.g. its slot has been reused), in which case there is nothing to truncate
+		const auto chunkIt = std::find_if(chunks.begin(), chunks.end(), [this](const Chunk& chunk) { return chunk.slot == scrubPoint->slot; });
+		if (chunkIt != chunks.end())
+		{
+			chunkIt->frameCount = scrubPoint->frameCount;
+			chunkIt->lastElapsedDays = scrubPoint->elapsedDays;
+			chunks.erase(chunkIt + 1, chunks.end());
+		}
+		scrubPoint.reset();
+	}
+
+	const std::size_t nBodyCount = nBodySystem.GetBodyCount();
+	const std::size_t particleCount = particleSystem.positionsX.size();
+
+	// A chunk only holds frames of the same amounts of bodies/particles
+	if (isLastChunkOpen && (chunks.back().frameCount >= params.framesPerChunk || chunks.back().nBodyCount != nBodyCount || chunks.back().particleCount != particleCount))
+	{
+		isLastChunkOpen = false;
+	}
+
+	const bool isChunkStart = isLastChunkOpen == false;
+
+	std::vector<char> bytes;
+	{
+		const std::lock_guard<std::mutex> lock(writerMutex);
+
+		// The disk is lagging behind: the frame is dropped rather than waiting for it, the next frame starting a new chunk
+		// as deltas would not be relative to the previous frame anymore
+		if (pendingWrites.size() >= MAX_PENDING_WRITES)
+		{
+			isLastChunkOpen = false;
+			return;
+		}
+
+		if (freeBuffers.empty() == false)
+		{
+			bytes = std::move(freeBuffers.back());
+			freeBuffers.pop_back();
+		}
+	}
+
+	bytes.resize(isChunkStart ? sizeof(ChunkHeader) + ComputeKeyframeSize(nBodyCount, particleCount) : ComputeDeltaFrameSize(nBodyCount, particleCount));
+	char* frameBytes = bytes.data();
+
+	if (isChunkStart)
+	{
+		// Slot of the oldest chunk is reused once all of them are taken
+		const uint32_t slot = nextSlot;
+		nextSlot = (nextSlot + 1) % params.chunkCount;
+		chunks.erase(std::remove_if(chunks.begin(), chunks.end(), [slot](const Chunk& chunk) { return chunk.slot == slot; }), chunks.end());
+		if (scrubPoint.has_value() && scrubPoint->slot == slot)
+		{
+			scrubPoint.reset();
+		}
+
+		Chunk chunk;
+		chunk.slot = slot;
+		chunk.nBodyCount = static_cast<uint32_t>(nBodyCount);
+		chunk.particleCount = static_cast<uint32_t>(particleCount);
+		chunk.firstElapsedDays = elapsedDays;
+		chunks.push_back(chunk);
+
+		ChunkHeader chunkHeader;
+		chunkHeader.version = timelineVersion;
+		chunkHeader.nBodyCount = chunk.nBodyCount;
+		chunkHeader.particleCount = chunk.particleCount;
+		chunkHeader.framesPerChunk = params.framesPerChunk;
+		std::memcpy(frameBytes, &chunkHeader, sizeof(ChunkHeader));
+		frameBytes += sizeof(ChunkHeader);
+	}
+
+	FrameHeader frameHeader;
+	frameHeader.elapsedDays = elapsedDays;
+	frameHeader.isKeyframe = isChunkStart ? 1 : 0;
+	std::memcpy(frameBytes, &frameHeader, sizeof(FrameHeader));
+
+	if (isChunkStart)
+	{
+		EncodeKeyframe(nBodySystem, particleSystem, frameBytes + sizeof(FrameHeader));
+	}
+	else
+	{
+		EncodeDeltaFrame(nBodySystem, particleSystem, frameBytes + sizeof(FrameHeader));
+	}
+
+	Chunk& lastChunk = chunks.back();
+	++lastChunk.frameCount;
+	lastChunk.lastElapsedDays = elapsedDays;
+	isLastChunkOpen = true;
+
+	{
+		const std::lock_guard<std::mutex> lock(writerMutex);
+		pendingWrites.push_back(PendingWrite{ lastChunk.slot, isChunkStart, std::move(bytes) });
+	}
+	writeAvailable.notify_one();
+}
+
+bool TimelineRecorder::ScrubTo(const double elapsedDays, TimelineFrame& outFrame)
+{
+	if (HasFrames() == false || elapsedDays < GetFirstFrameElapsedDays())
+	{
+		return false;
+	}
+
+	// Last chunk starting at or before the date
+	std::size_t chunkIndex = chunks.size() - 1;
+	while (chunks[chunkIndex].firstElapsedDays > elapsedDays)
+	{
+		--chunkIndex;
+	}
+
+	const Chunk& chunk = chunks[chunkIndex];
+	const std::filesystem::path chunkPath = GetChunkPath(chunk.slot);
+
+	Flush();
+
+	const std::size_t keyframeSize = ComputeKeyframeSize(chunk.nBodyCount, chunk.particleCount);
+	const std::size_t deltaFrameSize = ComputeDeltaFrameSize(chunk.nBodyCount, chunk.particleCount);
+	if (mappedChunk.Open(chunkPath) == false || mappedChunk.GetSize() < sizeof(ChunkHeader) + keyframeSize + (chunk.frameCount - 1) * deltaFrameSize)
+	{
+		std::cout << "ERROR::TIMELINE_RECORDER - File " << chunkPath.filename().string() << " could not be mapped, or is truncated" << std::endl;
+		mappedChunk.Close();
+		return false;
+	}
+
+	const char* frameBytes = static_cast<const char*>(mappedChunk.GetData());
+	const ChunkHeader* const chunkHeader = reinterpret_cast<const ChunkHeader*>(frameBytes);
+
+	const ChunkHeader defaultChunkHeader;
+	if (std::memcmp(chunkHeader->magic, defaultChunkHeader.magic, sizeof(defaultChunkHeader.magic)) != 0 || chunkHeader->version != timelineVersion
+		|| chunkHeader->nBodyCount != chunk.nBodyCount || chunkHeader->particleCount != chunk.particleCount)
+	{
+		std::cout << "ERROR::TIMELINE_RECORDER - File " << chunkPath.filename().string() << " does not hold the recorded chunk" << std::endl;
+		mappedChunk.Close();
+		return false;
+	}
+
+	frameBytes += sizeof(ChunkHeader);
+	double frameElapsedDays = reinterpret_cast<const FrameHeader*>(frameBytes)->elapsedDays;
+	DecodeKeyframe(frameBytes + sizeof(FrameHeader), chunk.nBodyCount, chunk.particleCount);
+	frameBytes += keyframeSize;
+
+	// Replay deltas up to the last frame at or before the date
+	uint32_t frameIndex = 0;
+	for (; frameIndex + 1 < chunk.frameCount; ++frameIndex)
+	{
+		const FrameHeader* const frameHeader = reinterpret_cast<const FrameHeader*>(frameBytes);
+		if (frameHeader->elapsedDays > elapsedDays)
+		{
+			break;
+		}
+
+		frameElapsedDays = frameHeader->elapsedDays;
+		DecodeDeltaFrame(frameBytes + sizeof(FrameHeader), chunk.nBodyCount, chunk.particleCount);
+		frameBytes += deltaFrameSize;
+	}
+
+	// Unmapped before the slot gets written again
+	mappedChunk.Close();
+
+	outFrame.elapsedDays = frameElapsedDays;
+	outFrame.nBodyStates = decodedNBodyStates;
+	outFrame.particleStates = decodedParticleStates;
+
+	// Decoded state has overwritten the one deltas were taken relative to, so the next frame starts a new chunk
+	scrubPoint = ScrubPoint{ chunk.slot, frameIndex + 1, frameElapsedDays };
+	isLastChunkOpen = false;
+
+	return true;
+}
+
+std::filesystem::path TimelineRecorder::GetChunkPath(const uint32_t slot) const
+{
+	return directory / ("TimelineChunk" + std::to_string(slot) + ".bin");
+}
+
+std::size_t TimelineRecorder::ComputeKeyframeSize(const std::size_t nBodyCount, const std::size_t particleCount)
+{
+	return AlignFrameSize(sizeof(FrameHeader) + TimelineFrame::STATE_ARRAY_COUNT * (nBodyCount * sizeof(double) + particleCount * sizeof(float)));
+}
+
+std::size_t TimelineRecorder::ComputeDeltaFrameSize(const std::size_t nBodyCount, const std::size_t particleCount)
+{
+	// Float body deltas, then float scales of particle blocks, then 16-bit particle deltas (each array aligned on its element size)
+	return AlignFrameSize(sizeof(FrameHeader) + TimelineFrame::STATE_ARRAY_COUNT
+		* (nBodyCount * sizeof(float) + ComputeBlockCount(particleCount) * sizeof(float) + particleCount * sizeof(int16_t)));
+}
+
+void TimelineRecorder::EncodeKeyframe(const NBodySystem& nBodySystem, const TestParticleSystem& particleSystem, char* bytes)
+{
+	const std::size_t nBodyCount = nBodySystem.GetBodyCount();
+	const std::size_t particleCount = particleSystem.positionsX.size();
+
+	const std::array<const double*, TimelineFrame::STATE_ARRAY_COUNT> nBodyStates = GetNBodyStates(nBodySystem);
+	for (std::size_t a = 0; a < TimelineFrame::STATE_ARRAY_COUNT; ++a)
+	{
+		std::memcpy(bytes, nBodyStates[a], nBodyCount * sizeof(double));
+		decodedNBodyStates[a].assign(nBodyStates[a], nBodyStates[a] + nBodyCount);
+		bytes += nBodyCount * sizeof(double);
+	}
+
+	const std::array<const float*, TimelineFrame::STATE_ARRAY_COUNT> particleStates = GetParticleStates(particleSystem);
+	for (std::size_t a = 0; a < TimelineFrame::STATE_ARRAY_COUNT; ++a)
+	{
+		std::memcpy(bytes, particleStates[a], particleCount * sizeof(float));
+		decodedParticleStates[a].assign(particleStates[a], particleStates[a] + particleCount);
+		bytes += particleCount * sizeof(float);
+	}
+}
+
+void TimelineRecorder::EncodeDeltaFrame(const NBodySystem& nBodySystem, const TestParticleSystem& particleSystem, char* bytes)
+{
+	const std::size_t nBodyCount = nBodySystem.GetBodyCount();
+	const std::size_t particleCount = particleSystem.positionsX.size();
+	const std::size_t blockCount = ComputeBlockCount(particleCount);
+
+	const std::array<const double*, TimelineFrame::STATE_ARRAY_COUNT> nBodyStates = GetNBodyStates(nBodySystem);
+	float* const nBodyDeltas = reinterpret_cast<float*>(bytes);
+	for (std::size_t a = 0; a < TimelineFrame::STATE_ARRAY_COUNT; ++a)
+	{
+		double* const decodedStates = decodedNBodyStates[a].data();
+		for (std::size_t i = 0; i < nBodyCount; ++i)
+		{
+			const float delta = static_cast<float>(nBodyStates[a][i] - decodedStates[i]);
+			nBodyDeltas[a * nBodyCount + i] = delta;
+			AddNBodyDelta(decodedStates[i], delta);
+		}
+	}
+	bytes += TimelineFrame::STATE_ARRAY_COUNT * nBodyCount * sizeof(float);
+
+	const std::array<const float*, TimelineFrame::STATE_ARRAY_COUNT> particleStates = GetParticleStates(particleSystem);
+	float* const blockScales = reinterpret_cast<float*>(bytes);
+	int16_t* const particleDeltas = reinterpret_cast<int16_t*>(bytes + TimelineFrame::STATE_ARRAY_COUNT * blockCount * sizeof(float));
+
+	// Blocks are independent from each other (each one writing its own scales and deltas)
+	ThreadPool::GetInstance().ParallelFor(blockCount, minBlocksPerThread, [&](const std::size_t beginBlock, const std::size_t endBlock)
+	{
+		for (std::size_t block = beginBlock; block < endBlock; ++block)
+		{
+			const std::size_t begin = block * PARTICLES_PER_QUANTIZATION_BLOCK;
+			const std::size_t end = std::min(begin + PARTICLES_PER_QUANTIZATION_BLOCK, particleCount);
+
+			for (std::size_t a = 0; a < TimelineFrame::STATE_ARRAY_COUNT; ++a)
+			{
+				float* const decodedStates = decodedParticleStates[a].data();
+
+				float maxDelta = 0.0f;
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					maxDelta = std::max(maxDelta, std::abs(particleStates[a][i] - decodedStates[i]));
+				}
+
+				const float scale = maxDelta / maxQuantizedDelta;
+				const float inverseScale = scale > 0.0f ? 1.0f / scale : 0.0f;
+				blockScales[a * blockCount + block] = scale;
+
+				int16_t* const quantizedDeltas = particleDeltas + a * particleCount;
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					const float quantizedDelta = std::round((particleStates[a][i] - decodedStates[i]) * inverseScale);
+					quantizedDeltas[i] = static_cast<int16_t>(std::clamp(quantizedDelta, -maxQuantizedDelta, maxQuantizedDelta));
+					AddParticleDelta(decodedStates[i], quantizedDeltas[i], scale);
+				}
+			}
+		}
+	});
+}
+
+void TimelineRecorder::DecodeKeyframe(const char* bytes, const std::size_t nBodyCount, const std::size_t particleCount)
+{
+	for (std::size_t a = 0; a < TimelineFrame::STATE_ARRAY_COUNT; ++a)
+	{
+		const double* const states = reinterpret_cast<const double*>(bytes);
+		decodedNBodyStates[a].assign(states, states + nBodyCount);
+		bytes += nBodyCount * sizeof(double);
+	}
+
+	for (std::size_t a = 0; a < TimelineFrame::STATE_ARRAY_COUNT; ++a)
+	{
+		const float* const states = reinterpret_cast<const float*>(bytes);
+		decodedParticleStates[a].assign(states, states + particleCount);
+		bytes += particleCount * sizeof(float);
+	}
+}
+
+void TimelineRecorder::DecodeDeltaFrame(const char* bytes, const std::size_t nBodyCount, const std::size_t particleCount)
+{
+	const std::size_t blockCount = ComputeBlockCount(particleCount);
+
+	const float* const nBodyDeltas = reinterpret_cast<const float*>(bytes);
+	for (std::size_t a = 0; a < TimelineFrame::STATE_ARRAY_COUNT; ++a)
+	{
+		for (std::size_t i = 0; i < nBodyCount; ++i)
+		{
+			AddNBodyDelta(decodedNBodyStates[a][i], nBodyDeltas[a * nBodyCount + i]);
+		}
+	}
+	bytes += TimelineFrame::STATE_ARRAY_COUNT * nBodyCount * sizeof(float);
+
+	const float* const blockScales = reinterpret_cast<const float*>(bytes);
+	const int16_t* const particleDeltas = reinterpret_cast<const int16_t*>(bytes + TimelineFrame::STATE_ARRAY_COUNT * blockCount * sizeof(float));
+
+	ThreadPool::GetInstance().ParallelFor(blockCount, minBlocksPerThread, [&](const std::size_t beginBlock, const std::size_t endBlock)
+	{
+		for (std::size_t block = beginBlock; block < endBlock; ++block)
+		{
+			const std::size_t begin = block * PARTICLES_PER_QUANTIZATION_BLOCK;
+			const std::size_t end = std::min(begin + PARTICLES_PER_QUANTIZATION_BLOCK, particleCount);
+
+			for (std::size_t a = 0; a < TimelineFrame::STATE_ARRAY_COUNT; ++a)
+			{
+				float* const decodedStates = decodedParticleStates[a].data();
+				const float scale = blockScales[a * blockCount + block];
+				const int16_t* const quantizedDeltas = particleDeltas + a * particleCount;
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					AddParticleDelta(decodedStates[i], quantizedDeltas[i], scale);
+				}
+			}
+		}
+	});
+}
+
+void TimelineRecorder::Flush()
+{
+	// Nothing is pending once the writer has been joined (and no writer would acknowledge the request)
+	if (IsOpen() == false)
+	{
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(writerMutex);
+	isCloseRequested = true;
+	writeAvailable.notify_one();
+	writesDone.wait(lock, [this]() { return pendingWrites.empty() && isWriting == false && isCloseRequested == false; });
+}
+
+void TimelineRecorder::RunWriter()
+{
+	std::ofstream fileStream;
+	uint32_t fileSlot = 0;
+
+	std::unique_lock<std::mutex> lock(writerMutex);
+	while (true)
+	{
+		writeAvailable.wait(lock, [this]() { return pendingWrites.empty() == false || isCloseRequested || isWriterStopping; });
+
+		if (pendingWrites.empty())
+		{
+			// Every frame is written, so the chunk file is closed for it to be mapped (it is only opened again in append mode by the next frame)
+			fileStream.close();
+			isCloseRequested = false;
+			writesDone.notify_all();
+
+			if (isWriterStopping)
+			{
+				return;
+			}
+
+			continue;
+		}
+
+		PendingWrite pendingWrite = std::move(pendingWrites.front());
+		pendingWrites.pop_front();
+		isWriting = true;
+		lock.unlock();
+
+		if (pendingWrite.isChunkStart || fileStream.is_open() == false || fileSlot != pendingWrite.slot)
+		{
+			fileStream.close();
+			fileStream.clear();
+			fileStream.open(GetChunkPath(pendingWrite.slot), std::ios::out | std::ios::binary | (pendingWrite.isChunkStart ? std::ios::trunc : std::ios::app));
+			fileSlot = pendingWrite.slot;
+		}
+
+		fileStream.write(pendingWrite.bytes.data(), static_cast<std::streamsize>(pendingWrite.bytes.size()));
+		if (fileStream.fail())
+		{
+			std::cout << "ERROR::TIMELINE_RECORDER - File " << GetChunkPath(pendingWrite.slot).filename().string() << " could not be written!" << std::endl;
+		}
+
+		lock.lock();
+		if (freeBuffers.size() < MAX_PENDING_WRITES)
+		{
+			freeBuffers.push_back(std::move(pendingWrite.bytes));
+		}
+		isWriting = false;
+	}
+}
@@ -0,0 +1,190 @@
+#ifndef TIMELINE_RECORDER_H
+#define TIMELINE_RECORDER_H
+
+#include <array>
+#include <condition_variable>
+#include <cstddef> // std::size_t
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "Utils/MemoryMappedFile.h"
+
+class NBodySystem;
+class TestParticleSystem;
+
+
+
+struct TimelineParams
+{
+	// Frames recorded per chunk: a keyframe, then deltas relative to the previous frame
+	uint32_t framesPerChunk{ 32 };
+
+	// Chunk files on disk, the oldest chunk being overwritten once all of them are used
+	uint32_t chunkCount{ 16 };
+};
+
+// Integrated state at a recorded date: positions X, Y, Z then velocities X, Y, Z of N-Body System bodies and of belt particles
+// (accelerations being computed again out of positions)
+struct TimelineFrame
+{
+	static constexpr std::size_t STATE_ARRAY_COUNT = 6;
+
+	double elapsedDays{ 0.0 };
+	std::array<std::vector<double>, STATE_ARRAY_COUNT> nBodyStates;
+	std::array<std::vector<float>, STATE_ARRAY_COUNT> particleStates;
+};
+
+// Record of integrated runs (N-Body mode), so they can be scrubbed backwards, which cannot be done out of closed-form orbits like Keplerian runs.
+// Frames are grouped into chunks: a full keyframe, then compact deltas relative to the previous frame (body deltas as floats, particle deltas
+// as 16-bit integers scaled per block of particles). Deltas are taken relative to the state decoding gives back, so quantization error never accumulates.
+// Chunks are streamed to a ring of files by a writer thread, the frame loop only encoding frames (in parallel batches), and memory-mapped when scrubbing.
+// File layout of a chunk: header, then frames, each one starting with its date (keyframes and deltas having a fixed size each)
+class TimelineRecorder
+{
+public:
+	// Amount of particles sharing the same delta scale
+	static constexpr std::size_t PARTICLES_PER_QUANTIZATION_BLOCK = 4096;
+
+	// Frames waiting to be written beyond which new frames are dropped (and the next one starts a new chunk), rather than stalling the frame loop
+	static constexpr std::size_t MAX_PENDING_WRITES = 8;
+
+	TimelineRecorder() = default;
+
+	// Copy constructor (not needed - WRITER THREAD SHOULD BE OWNED AND JOINED BY A SINGLE INSTANCE)
+	TimelineRecorder(const TimelineRecorder& inTimelineRecorder) = delete;
+	TimelineRecorder& operator = (const TimelineRecorder& inTimelineRecorder) = delete;
+
+	// Move constructor (not needed)
+	TimelineRecorder(TimelineRecorder&& inTimelineRecorder) = delete;
+	TimelineRecorder& operator = (TimelineRecorder&& inTimelineRecorder) = delete;
+
+	~TimelineRecorder();
+
+	// Start recording into chunk files of the provided directory (stopping any recording started beforehand, and forgetting its frames)
+	void Open(const std::filesystem::path& inDirectory, const TimelineParams& inParams);
+
+	// Stop recording, once pending frames have been written. Recorded frames can still be scrubbed to
+	void Close();
+
+	bool IsOpen() const { return writerThread.joinable(); }
+
+	// Forget every recorded frame (e.g. when the integrated state has been built again), the next frame starting a new chunk
+	void Clear();
+
+	// Encode the current state as the next frame (a keyframe when it starts a chunk), and queue it for writing
+	void RecordFrame(const double elapsedDays, const NBodySystem& nBodySystem, const TestParticleSystem& particleSystem);
+
+	// Recorded time span [in Main Planet days since the epoch], empty if there is no recorded frame
+	bool HasFrames() const { return chunks.empty() == false; }
+	double GetFirstFrameElapsedDays() const { return chunks.front().firstElapsedDays; }
+	double GetLastFrameElapsedDays() const { return chunks.back().lastElapsedDays; }
+
+	// Decode the last frame recorded at or before the provided date, out of the keyframe of its chunk and the deltas following it,
+	// and return whether there is such a frame. Frames recorded after it are only forgotten once the next frame is recorded (the run going on
+	// from the decoded frame), so the timeline can be scrubbed back and forth in the meantime
+	bool ScrubTo(const double elapsedDays, TimelineFrame& outFrame);
+
+private:
+	struct ChunkHeader
+	{
+		char magic[4]{ 'T', 'I', 'M', 'E' };
+		uint32_t version{ 1 };
+		uint32_t nBodyCount{ 0 };
+		uint32_t particleCount{ 0 };
+		uint32_t framesPerChunk{ 0 };
+		uint32_t padding{ 0 };
+	};
+
+	struct FrameHeader
+	{
+		double elapsedDays{ 0.0 };
+		uint32_t isKeyframe{ 0 };
+		uint32_t padding{ 0 };
+	};
+
+	// Recorded chunk, in a slot of the ring of files
+	struct Chunk
+	{
+		uint32_t slot{ 0 };
+		uint32_t frameCount{ 0 };
+		uint32_t nBodyCount{ 0 };
+		uint32_t particleCount{ 0 };
+		double firstElapsedDays{ 0.0 };
+		double lastElapsedDays{ 0.0 };
+	};
+
+	// Frame encoded by the frame loop, written by the writer thread
+	struct PendingWrite
+	{
+		uint32_t slot{ 0 };
+		bool isChunkStart{ false };
+		std::vector<char> bytes;
+	};
+
+	std::filesystem::path directory;
+	TimelineParams params;
+
+	// Recorded chunks, oldest first
+	std::deque<Chunk> chunks;
+	uint32_t nextSlot{ 0 };
+
+	// Whether the next frame is appended to the last chunk (instead of starting a new one with a keyframe)
+	bool isLastChunkOpen{ false };
+
+	// Last frame scrubbed to, frames recorded after it being forgotten when the next frame is recorded
+	struct ScrubPoint
+	{
+		uint32_t slot{ 0 };
+		uint32_t frameCount{ 0 };
+		double elapsedDays{ 0.0 };
+	};
+
+	std::optional<ScrubPoint> scrubPoint;
+
+	// State decoding gives back for the last encoded frame, deltas of the next frame being taken relative to it
+	std::array<std::vector<double>, TimelineFrame::STATE_ARRAY_COUNT> decodedNBodyStates;
+	std::array<std::vector<float>, TimelineFrame::STATE_ARRAY_COUNT> decodedParticleStates;
+
+	// Chunk being decoded when scrubbing
+	MemoryMappedFile mappedChunk;
+
+	std::thread writerThread;
+	std::mutex writerMutex;
+	std::condition_variable writeAvailable;
+	std::condition_variable writesDone;
+	std::deque<PendingWrite> pendingWrites;
+
+	// Buffers of written frames, reused by the next ones
+	std::vector<std::vector<char>> freeBuffers;
+
+	bool isWriting{ false };
+	bool isCloseRequested{ false };
+	bool isWriterStopping{ false };
+
+	std::filesystem::path GetChunkPath(const uint32_t slot) const;
+
+	// Size of a keyframe/delta frame for the provided amounts of bodies/particles
+	static std::size_t ComputeKeyframeSize(const std::size_t nBodyCount, const std::size_t particleCount);
+	static std::size_t ComputeDeltaFrameSize(const std::size_t nBodyCount, const std::size_t particleCount);
+
+	void EncodeKeyframe(const NBodySystem& nBodySystem, const TestParticleSystem& particleSystem, char* bytes);
+	void EncodeDeltaFrame(const NBodySystem& nBodySystem, const TestParticleSystem& particleSystem, char* bytes);
+
+	// Overwrite the decoded state with a keyframe, or add the deltas of a frame to it
+	void DecodeKeyframe(const char* bytes, const std::size_t nBodyCount, const std::size_t particleCount);
+	void DecodeDeltaFrame(const char* bytes, const std::size_t nBodyCount, const std::size_t particleCount);
+
+	// Wait for every pending frame to be written, and for the chunk file to be closed (so it can be mapped)
+	void Flush();
+
+	void RunWriter();
+};
+
+
+
+#endif // TIMELINE_RECORDER_H
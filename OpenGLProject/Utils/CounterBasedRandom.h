@@ -0,0 +1,71 @@
+#ifndef COUNTER_BASED_RANDOM_H
+#define COUNTER_BASED_RANDOM_H
+
+#include <array>
+#include <cstdint>
+
+
+
+// Counter-based random number generation (Philox4x32-10, from Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3"): random numbers are a pure function
+// of a key (e.g. the seed of a belt) and a counter (e.g. the index of an instance), so they can be drawn in any order, from any thread, without any shared state,
+// and the same key/counter pair always gives the same numbers, whatever the platform or the amount of threads
+namespace CounterBasedRandom
+{
+	// 4 random 32-bit words, all drawn at once by a single evaluation
+	using Block = std::array<uint32_t, 4>;
+
+	// Round multipliers and key increments ("Weyl sequence") of the reference implementation
+	constexpr uint32_t PHILOX_MULTIPLIER_0 = 0xD2511F53;
+	constexpr uint32_t PHILOX_MULTIPLIER_1 = 0xCD9E8D57;
+	constexpr uint32_t PHILOX_KEY_INCREMENT_0 = 0x9E3779B9;
+	constexpr uint32_t PHILOX_KEY_INCREMENT_1 = 0xBB67AE85;
+
+	// 10 rounds is the smallest amount passing BigCrush with a safety margin
+	constexpr uint32_t PHILOX_ROUND_COUNT = 10;
+
+	// Scramble a 128-bit counter with a 64-bit key
+	inline Block Philox4x32(Block counter, uint32_t key0, uint32_t key1)
+	{
+		for (uint32_t round = 0; round < PHILOX_ROUND_COUNT; ++round)
+		{
+			const uint64_t product0 = static_cast<uint64_t>(PHILOX_MULTIPLIER_0) * counter[0];
+			const uint64_t product1 = static_cast<uint64_t>(PHILOX_MULTIPLIER_1) * counter[2];
+
+			counter = {
+				static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key0,
+				static_cast<uint32_t>(product1),
+				static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key1,
+				static_cast<uint32_t>(product0)
+			};
+
+			key0 += PHILOX_KEY_INCREMENT_0;
+			key1 += PHILOX_KEY_INCREMENT_1;
+		}
+
+		return counter;
+	}
+
+	// Draw the block of index blockIndex of a stream (e.g. an instance), out of a seed: several blocks per stream give more than 4 numbers to a single instance,
+	// and different users of the same stream (e.g. placement and orbit of an instance) keep their own block indices, so their numbers never overlap
+	inline Block Generate(const uint64_t seed, const uint64_t streamIndex, const uint32_t blockIndex)
+	{
+		const Block counter{ static_cast<uint32_t>(streamIndex), static_cast<uint32_t>(streamIndex >> 32), blockIndex, 0 };
+		return Philox4x32(counter, static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32));
+	}
+
+	// Map a random word to [0, 1[ (only the 24 upper bits are kept, i.e. the amount of bits a float mantissa can hold, so every value is exactly representable)
+	inline float ToUnitFloat(const uint32_t word)
+	{
+		return static_cast<float>(word >> 8) * (1.0f / 16777216.0f);
+	}
+
+	// Map a random word to [lowerBound, upperBound[
+	inline float ToRange(const uint32_t word, const float lowerBound, const float upperBound)
+	{
+		return lowerBound + ToUnitFloat(word) * (upperBound - lowerBound);
+	}
+}
+
+
+
+#endif // COUNTER_BASED_RANDOM_H
@@ -0,0 +1,136 @@
+#include "FileWatcher.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cerrno>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include <cstddef> // std::size_t
+#include <iostream>
+#include <system_error>
+
+
+
+FileWatcher::~FileWatcher()
+{
+	Close();
+}
+
+bool FileWatcher::Open(const std::filesystem::path& inDirectory, const std::vector<std::string>& inFileNames)
+{
+	Close();
+
+	// The directory is watched rather than the files, as editors often save a file by replacing it (which would end the watch of the file itself)
+#ifdef _WIN32
+	const HANDLE changeHandle = FindFirstChangeNotificationW(inDirectory.wstring().c_str(), FALSE, FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME);
+	if (changeHandle == INVALID_HANDLE_VALUE)
+	{
+		std::cout << "ERROR::UTILS - Directory " << inDirectory.string() << " could not be watched (error " << GetLastError() << ")" << std::endl;
+		return false;
+	}
+
+	notificationHandle = reinterpret_cast<std::intptr_t>(changeHandle);
+#else
+	const int inotifyDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (inotifyDescriptor == -1)
+	{
+		std::cout << "ERROR::UTILS - Directory " << inDirectory.string() << " could not be watched (error " << errno << ")" << std::endl;
+		return false;
+	}
+
+	// Only completed writes are notified, so files are never read while being written
+	if (inotify_add_watch(inotifyDescriptor, inDirectory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) == -1)
+	{
+		std::cout << "ERROR::UTILS - Directory " << inDirectory.string() << " could not be watched (error " << errno << ")" << std::endl;
+		close(inotifyDescriptor);
+		return false;
+	}
+
+	notificationHandle = inotifyDescriptor;
+#endif
+
+	directory = inDirectory;
+	fileNames = inFileNames;
+
+	lastWriteTimes.clear();
+	for (const std::string& fileName : fileNames)
+	{
+		std::error_code errorCode;
+		lastWriteTimes.push_back(std::filesystem::last_write_time(directory / fileName, errorCode));
+	}
+
+	return true;
+}
+
+void FileWatcher::Close()
+{
+	if (IsOpen() == false)
+	{
+		return;
+	}
+
+#ifdef _WIN32
+	FindCloseChangeNotification(reinterpret_cast<HANDLE>(notificationHandle));
+#else
+	close(static_cast<int>(notificationHandle));
+#endif
+
+	notificationHandle = INVALID_NOTIFICATION_HANDLE;
+}
+
+std::vector<std::string> FileWatcher::PollChangedFiles()
+{
+	std::vector<std::string> changedFileNames;
+	if (IsOpen() == false || HasDirectoryChanged() == false)
+	{
+		return changedFileNames;
+	}
+
+	for (std::size_t i = 0; i < fileNames.size(); ++i)
+	{
+		// A file being replaced may briefly not exist, its new version being then reported by the next notification
+		std::error_code errorCode;
+		const std::filesystem::file_time_type lastWriteTime = std::filesystem::last_write_time(directory / fileNames[i], errorCode);
+		if (errorCode || lastWriteTime == lastWriteTimes[i])
+		{
+			continue;
+		}
+
+		lastWriteTimes[i] = lastWriteTime;
+		changedFileNames.push_back(fileNames[i]);
+	}
+
+	return changedFileNames;
+}
+
+bool FileWatcher::HasDirectoryChanged()
+{
+#ifdef _WIN32
+	const HANDLE changeHandle = reinterpret_cast<HANDLE>(notificationHandle);
+	if (WaitForSingleObject(changeHandle, 0) != WAIT_OBJECT_0)
+	{
+		return false;
+	}
+
+	// Notifications raised in the meantime are merged into the next one
+	FindNextChangeNotification(changeHandle);
+
+	return true;
+#else
+	// Events are only drained, watched files being then told apart by their write time
+	alignas(inotify_event) char eventBuffer[4096];
+
+	bool hasChanged = false;
+	while (read(static_cast<int>(notificationHandle), eventBuffer, sizeof(eventBuffer)) > 0)
+	{
+		hasChanged = true;
+	}
+
+	return hasChanged;
+#endif
+}
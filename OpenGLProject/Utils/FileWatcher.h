@@ -0,0 +1,55 @@
+#ifndef FILE_WATCHER_H
+#define FILE_WATCHER_H
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+
+
+// Non-blocking watch of some files of a single directory (e.g. data files edited while running). The OS notifies changes of the directory
+// (inotify on Linux, change notifications on Windows), so polling every frame costs a single system call as long as nothing has changed.
+// Watched files are then told apart by their last write time, so unrelated files of the directory (e.g. editor backups) are ignored
+class FileWatcher
+{
+public:
+	FileWatcher() = default;
+
+	// Copy constructor (not needed - NOTIFICATION HANDLE SHOULD BE OWNED AND CLOSED BY A SINGLE INSTANCE)
+	FileWatcher(const FileWatcher& inFileWatcher) = delete;
+	FileWatcher& operator = (const FileWatcher& inFileWatcher) = delete;
+
+	// Move constructor (not needed)
+	FileWatcher(FileWatcher&& inFileWatcher) = delete;
+	FileWatcher& operator = (FileWatcher&& inFileWatcher) = delete;
+
+	~FileWatcher();
+
+	// Start watching the provided files of a directory (stopping any watch started beforehand), and return whether it succeeded
+	bool Open(const std::filesystem::path& inDirectory, const std::vector<std::string>& inFileNames);
+	void Close();
+
+	bool IsOpen() const { return notificationHandle != INVALID_NOTIFICATION_HANDLE; }
+
+	// Return the names of the watched files written since the last call (each name once, none if nothing has changed)
+	std::vector<std::string> PollChangedFiles();
+
+private:
+	// inotify descriptor on Linux, change notification handle on Windows (both being -1 when invalid)
+	static constexpr std::intptr_t INVALID_NOTIFICATION_HANDLE = -1;
+	std::intptr_t notificationHandle{ INVALID_NOTIFICATION_HANDLE };
+
+	std::filesystem::path directory;
+	std::vector<std::string> fileNames;
+
+	// Last write time of each watched file, as of the last time it has been reported
+	std::vector<std::filesystem::file_time_type> lastWriteTimes;
+
+	// Return whether the OS has notified any change in the directory since the last call (draining all pending notifications)
+	bool HasDirectoryChanged();
+};
+
+
+
+#endif // FILE_WATCHER_H
@@ -156,9 +156,14 @@ std::string FileHelper::GetErrorStateFlagMessage(const std::ifstream& fileStream
 }
 
 std::string FileHelper::GetSolutionAbsolutePath()
+{
+	return GetSolutionAbsolutePath(Application::GetInstance().GetExecutablePath());
+}
+
+std::string FileHelper::GetSolutionAbsolutePath(const std::filesystem::path& executablePath)
 {
 	// Solution absolute path needs to be determined from the executable absolute path, so it both works when running from VS editor and from executable
-	const std::string currentExecutablePath(Application::GetInstance().GetExecutablePath().string());
+	const std::string currentExecutablePath(executablePath.string());
 
 	// Cut off the name of the executable from the path
 	const size_t lastDoubleBackslashSymbol = currentExecutablePath.find_last_of("\\");
@@ -41,6 +41,8 @@ namespace FileHelper
 	std::string GetTexturePathFromMtlLine(const std::string& mtlLine);
 
 	std::string GetSolutionAbsolutePath();
+	// Same as above, out of the provided executable path (e.g. when no Application has been set up)
+	std::string GetSolutionAbsolutePath(const std::filesystem::path& executablePath);
 	std::string GetProjectAbsolutePath();
 
 	std::string GetErrorStateFlagMessage(const std::ifstream& fileStream);
@@ -0,0 +1,93 @@
+#include "MemoryMappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <iostream>
+
+
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+	Close();
+}
+
+bool MemoryMappedFile::Open(const std::filesystem::path& path)
+{
+	Close();
+
+	std::error_code errorCode;
+	const std::uintmax_t fileSize = std::filesystem::file_size(path, errorCode);
+	if (errorCode || fileSize == 0)
+	{
+		return false;
+	}
+
+	// File and mapping handles can be released as soon as the view is mapped, the view keeping the mapping alive on its own
+#ifdef _WIN32
+	const HANDLE fileHandle = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		std::cout << "ERROR::UTILS - File " << path.filename().string() << " could not be opened for mapping (error " << GetLastError() << ")" << std::endl;
+		return false;
+	}
+
+	const HANDLE mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(fileHandle);
+	if (mappingHandle == nullptr)
+	{
+		std::cout << "ERROR::UTILS - File " << path.filename().string() << " could not be mapped (error " << GetLastError() << ")" << std::endl;
+		return false;
+	}
+
+	data = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mappingHandle);
+#else
+	const int fileDescriptor = open(path.c_str(), O_RDONLY);
+	if (fileDescriptor == -1)
+	{
+		std::cout << "ERROR::UTILS - File " << path.filename().string() << " could not be opened for mapping" << std::endl;
+		return false;
+	}
+
+	void* const view = mmap(nullptr, static_cast<std::size_t>(fileSize), PROT_READ, MAP_SHARED, fileDescriptor, 0);
+	close(fileDescriptor);
+
+	data = view == MAP_FAILED ? nullptr : view;
+#endif
+
+	if (data == nullptr)
+	{
+		std::cout << "ERROR::UTILS - View of file " << path.filename().string() << " could not be mapped" << std::endl;
+		return false;
+	}
+
+	size = static_cast<std::size_t>(fileSize);
+
+	return true;
+}
+
+void MemoryMappedFile::Close()
+{
+	if (data == nullptr)
+	{
+		return;
+	}
+
+#ifdef _WIN32
+	UnmapViewOfFile(data);
+#else
+	munmap(const_cast<void*>(data), size);
+#endif
+
+	data = nullptr;
+	size = 0;
+}
@@ -0,0 +1,42 @@
+#ifndef MEMORY_MAPPED_FILE_H
+#define MEMORY_MAPPED_FILE_H
+
+#include <cstddef> // std::size_t
+#include <filesystem>
+
+
+
+// Read-only view of a whole file mapped into the process address space: pages are only loaded by the OS when first accessed,
+// and stay shared with the file system cache, so large binary data can be used in-place without any read/copy at startup
+class MemoryMappedFile
+{
+public:
+	MemoryMappedFile() = default;
+
+	// Copy constructor (not needed - MAPPED VIEW SHOULD BE OWNED AND UNMAPPED BY A SINGLE INSTANCE)
+	MemoryMappedFile(const MemoryMappedFile& inMemoryMappedFile) = delete;
+	MemoryMappedFile& operator = (const MemoryMappedFile& inMemoryMappedFile) = delete;
+
+	// Move constructor (not needed)
+	MemoryMappedFile(MemoryMappedFile&& inMemoryMappedFile) = delete;
+	MemoryMappedFile& operator = (MemoryMappedFile&& inMemoryMappedFile) = delete;
+
+	~MemoryMappedFile();
+
+	// Map the file (unmapping any file mapped beforehand), and return whether it succeeded (e.g. false if the file does not exist or is empty)
+	bool Open(const std::filesystem::path& path);
+	void Close();
+
+	bool IsOpen() const { return data != nullptr; }
+
+	const void* GetData() const { return data; }
+	std::size_t GetSize() const { return size; }
+
+private:
+	const void* data{ nullptr };
+	std::size_t size{ 0 };
+};
+
+
+
+#endif // MEMORY_MAPPED_FILE_H
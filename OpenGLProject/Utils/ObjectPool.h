@@ -0,0 +1,115 @@
+#ifndef OBJECT_POOL_H
+#define OBJECT_POOL_H
+
+#include <cstddef> // std::size_t
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+
+
+// Storage of objects of a single type in fixed-size chunks, so objects sit next to each other in memory and never move once created
+// (non-owning ptrs stay valid). Slots of destroyed objects are reused by the next ones, so creating/destroying an object is O(1)
+// and does not fragment the heap. Objects still alive when the pool is destroyed are destroyed with it
+template<typename ObjectType, std::size_t OBJECTS_PER_CHUNK = 64>
+class ObjectPool
+{
+public:
+	ObjectPool() = default;
+
+	// Copy constructor (not needed, as objects are referred to by ptr)
+	ObjectPool(const ObjectPool& inObjectPool) = delete;
+	ObjectPool& operator = (const ObjectPool& inObjectPool) = delete;
+
+	// Move constructor (not needed, as objects are referred to by ptr)
+	ObjectPool(ObjectPool&& inObjectPool) = delete;
+	ObjectPool& operator = (ObjectPool&& inObjectPool) = delete;
+
+	~ObjectPool()
+	{
+		for (const std::unique_ptr<Slot[]>& chunk : chunks)
+		{
+			for (std::size_t i = 0; i < OBJECTS_PER_CHUNK; ++i)
+			{
+				if (chunk[i].isAlive)
+				{
+					chunk[i].GetObject()->~ObjectType();
+				}
+			}
+		}
+	}
+
+	// Construct an object in the first free slot (a new chunk being allocated when all slots are taken)
+	template<typename... Args>
+	ObjectType* Create(Args&&... args)
+	{
+		if (firstFreeSlot == nullptr)
+		{
+			AllocateChunk();
+		}
+
+		Slot* const slot = firstFreeSlot;
+		ObjectType* const object = new (slot->storage) ObjectType(std::forward<Args>(args)...);
+
+		// Only taken once construction has succeeded
+		firstFreeSlot = slot->nextFreeSlot;
+		slot->isAlive = true;
+		++objectCount;
+
+		return object;
+	}
+
+	// Destroy an object created by this pool, its slot being reused by the next object created
+	void Destroy(ObjectType* const object)
+	{
+		object->~ObjectType();
+
+		// Storage is the first member of the slot, so both share the same address
+		Slot* const slot = reinterpret_cast<Slot*>(object);
+		slot->isAlive = false;
+		slot->nextFreeSlot = firstFreeSlot;
+		firstFreeSlot = slot;
+		--objectCount;
+	}
+
+	std::size_t GetObjectCount() const { return objectCount; }
+	std::size_t GetCapacity() const { return chunks.size() * OBJECTS_PER_CHUNK; }
+
+private:
+	struct Slot
+	{
+		alignas(ObjectType) unsigned char storage[sizeof(ObjectType)];
+
+		Slot* nextFreeSlot{ nullptr };
+		bool isAlive{ false };
+
+		ObjectType* GetObject() { return std::launder(reinterpret_cast<ObjectType*>(storage)); }
+	};
+
+	std::vector<std::unique_ptr<Slot[]>> chunks;
+
+	// Head of the list of free slots, linked through the slots themselves
+	Slot* firstFreeSlot{ nullptr };
+
+	std::size_t objectCount{ 0 };
+
+	void AllocateChunk()
+	{
+		chunks.push_back(std::make_unique<Slot[]>(OBJECTS_PER_CHUNK));
+
+		// Link new slots in order, so objects created one after the other are stored one after the other
+		Slot* const chunk = chunks.back().get();
+		for (std::size_t i = 0; i + 1 < OBJECTS_PER_CHUNK; ++i)
+		{
+			chunk[i].nextFreeSlot = &chunk[i + 1];
+		}
+		chunk[OBJECTS_PER_CHUNK - 1].nextFreeSlot = firstFreeSlot;
+
+		firstFreeSlot = chunk;
+	}
+};
+
+
+
+#endif // OBJECT_POOL_H
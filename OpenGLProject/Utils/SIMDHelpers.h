@@ -0,0 +1,85 @@
+#ifndef SIMD_HELPERS_H
+#define SIMD_HELPERS_H
+
+#include <cstdint>
+
+// SSE2 is part of the x64 baseline, and the default instruction set of 32-bit x86 builds (/arch:SSE2), so it is the only SIMD level we rely on
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SIMD_SSE2_ENABLED 1
+#include <emmintrin.h>
+#else
+#define SIMD_SSE2_ENABLED 0
+#endif
+
+
+
+// Batch math helpers processing several floats per instruction, used by simulation kernels iterating over Structure-of-Arrays data
+namespace SIMDHelpers
+{
+	// Amount of floats processed by a single SIMD register (i.e. a 128-bit lane)
+	constexpr uint32_t FLOAT_LANE_COUNT = 4;
+
+	// Amount of doubles processed by a single SIMD register
+	constexpr uint32_t DOUBLE_LANE_COUNT = 2;
+
+#if SIMD_SSE2_ENABLED
+	// Round 2 doubles down to the nearest integer, for values up to 2^51 in magnitude (SSE2 has no floor instruction, and its
+	// conversions to integer are limited to 32 bits): adding then subtracting 1.5 * 2^52 rounds to nearest, then 1 is removed where it rounded up
+	inline __m128d Floor(const __m128d x)
+	{
+		const __m128d roundingMagic = _mm_set1_pd(6755399441055744.0);
+
+		const __m128d rounded = _mm_sub_pd(_mm_add_pd(x, roundingMagic), roundingMagic);
+		return _mm_sub_pd(rounded, _mm_and_pd(_mm_cmpgt_pd(rounded, x), _mm_set1_pd(1.0)));
+	}
+
+	// Compute sine and cosine of 4 angles [in radians] at once (Cephes-style minimax polynomials on [-Pi/4, Pi/4], ~1e-7 absolute error).
+	// Warning: angles should be wrapped to a few turns beforehand, as range reduction is done in single precision
+	inline void SinCos(const __m128 x, __m128& outSin, __m128& outCos)
+	{
+		const __m128 twoOverPi = _mm_set1_ps(0.63661977236758134f);
+
+		// Extended precision modular arithmetic (Cody-Waite): Pi/2 = DP1 + DP2 + DP3
+		const __m128 DP1 = _mm_set1_ps(1.5703125f);
+		const __m128 DP2 = _mm_set1_ps(4.837512969970703125e-4f);
+		const __m128 DP3 = _mm_set1_ps(7.54978995489188216e-8f);
+
+		// Quadrant index of each angle (rounded to nearest with the default MXCSR rounding mode)
+		const __m128i quadrant = _mm_cvtps_epi32(_mm_mul_ps(x, twoOverPi));
+		const __m128 quadrantF = _mm_cvtepi32_ps(quadrant);
+
+		__m128 r = _mm_sub_ps(x, _mm_mul_ps(quadrantF, DP1));
+		r = _mm_sub_ps(r, _mm_mul_ps(quadrantF, DP2));
+		r = _mm_sub_ps(r, _mm_mul_ps(quadrantF, DP3));
+		const __m128 r2 = _mm_mul_ps(r, r);
+
+		// sin(r) = r + r^3 * (S1 + r^2 * (S2 + r^2 * S3))
+		__m128 sinPoly = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(-1.9515295891e-4f), r2), _mm_set1_ps(8.3321608736e-3f));
+		sinPoly = _mm_add_ps(_mm_mul_ps(sinPoly, r2), _mm_set1_ps(-1.6666654611e-1f));
+		sinPoly = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(sinPoly, r2), r), r);
+
+		// cos(r) = 1 - r^2 / 2 + r^4 * (C1 + r^2 * (C2 + r^2 * C3))
+		__m128 cosPoly = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(2.443315711809948e-5f), r2), _mm_set1_ps(-1.388731625493765e-3f));
+		cosPoly = _mm_add_ps(_mm_mul_ps(cosPoly, r2), _mm_set1_ps(4.166664568298827e-2f));
+		cosPoly = _mm_mul_ps(_mm_mul_ps(cosPoly, r2), r2);
+		cosPoly = _mm_add_ps(_mm_sub_ps(cosPoly, _mm_mul_ps(r2, _mm_set1_ps(0.5f))), _mm_set1_ps(1.0f));
+
+		// Odd quadrants swap sine and cosine polynomials
+		const __m128i one = _mm_set1_epi32(1);
+		const __m128 swapMask = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, one), one));
+		const __m128 sinResult = _mm_or_ps(_mm_and_ps(swapMask, cosPoly), _mm_andnot_ps(swapMask, sinPoly));
+		const __m128 cosResult = _mm_or_ps(_mm_and_ps(swapMask, sinPoly), _mm_andnot_ps(swapMask, cosPoly));
+
+		// Sine is negative in quadrants 2 and 3, cosine in quadrants 1 and 2 (bit 1 moved to the float sign bit)
+		const __m128 sinSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(2)), 30));
+		const __m128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(quadrant, one), _mm_set1_epi32(2)), 30));
+
+		outSin = _mm_xor_ps(sinResult, sinSign);
+		outCos = _mm_xor_ps(cosResult, cosSign);
+	}
+#endif
+};
+
+
+
+#endif // SIMD_HELPERS_H
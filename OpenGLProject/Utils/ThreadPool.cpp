@@ -0,0 +1,109 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+
+
+ThreadPool& ThreadPool::GetInstance()
+{
+	// Created on first use, and destroyed at exit so workers are stopped and joined
+	static ThreadPool instance(ComputeWorkerCount());
+	return instance;
+}
+
+uint32_t ThreadPool::ComputeWorkerCount()
+{
+	const uint32_t hardwareThreadCount = std::thread::hardware_concurrency();
+	return hardwareThreadCount > 1 ? hardwareThreadCount - 1 : 0;
+}
+
+ThreadPool::ThreadPool(const uint32_t workerCount)
+{
+	workers.reserve(workerCount);
+	for (uint32_t i = 0; i < workerCount; ++i)
+	{
+		workers.emplace_back(&ThreadPool::RunWorker, this);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		isStopping = true;
+	}
+	workAvailable.notify_all();
+
+	for (std::thread& worker : workers)
+	{
+		worker.join();
+	}
+}
+
+void ThreadPool::ParallelFor(const std::size_t count, const std::size_t minBatchSize, const BatchTask& inTask)
+{
+	if (workers.empty() || count <= minBatchSize)
+	{
+		inTask(0, count);
+		return;
+	}
+
+	// A few batches per thread, so threads finishing early can help the others
+	const std::size_t threadCount = workers.size() + 1;
+	const std::size_t maxBatchCount = std::max<std::size_t>(1, count / std::max<std::size_t>(1, minBatchSize));
+	const std::size_t targetBatchCount = std::min(maxBatchCount, threadCount * 4);
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		task = &inTask;
+		taskCount = count;
+		batchSize = (count + targetBatchCount - 1) / targetBatchCount;
+		batchCount = (count + batchSize - 1) / batchSize;
+		nextBatch = 0;
+		busyWorkerCount = static_cast<uint32_t>(workers.size());
+		++generation;
+	}
+	workAvailable.notify_all();
+
+	RunBatches();
+
+	std::unique_lock<std::mutex> lock(mutex);
+	workDone.wait(lock, [this]() { return busyWorkerCount == 0; });
+	task = nullptr;
+}
+
+void ThreadPool::RunWorker()
+{
+	uint64_t lastGeneration = 0;
+
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			workAvailable.wait(lock, [this, lastGeneration]() { return isStopping || generation != lastGeneration; });
+			if (isStopping)
+			{
+				return;
+			}
+
+			lastGeneration = generation;
+		}
+
+		RunBatches();
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			--busyWorkerCount;
+		}
+		workDone.notify_one();
+	}
+}
+
+void ThreadPool::RunBatches()
+{
+	for (std::size_t batch = nextBatch++; batch < batchCount; batch = nextBatch++)
+	{
+		const std::size_t begin = batch * batchSize;
+		(*task)(begin, std::min(taskCount, begin + batchSize));
+	}
+}
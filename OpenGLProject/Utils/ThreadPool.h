@@ -0,0 +1,75 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef> // std::size_t
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+
+// Singleton class owning worker threads created once for the whole Application run, so data-parallel loops
+// (e.g. run every simulation step) do not pay for thread creation each time
+class ThreadPool
+{
+public:
+	// Signature of the work done on a batch of indices [begin, end[
+	using BatchTask = std::function<void(const std::size_t begin, const std::size_t end)>;
+
+	// Unique Singleton instance defined in source file (one worker per hardware thread, minus the calling one)
+	static ThreadPool& GetInstance();
+
+	// Copy constructor (not needed)
+	ThreadPool(const ThreadPool& inThreadPool) = delete;
+	ThreadPool& operator = (const ThreadPool& inThreadPool) = delete;
+
+	// Move constructor (not needed)
+	ThreadPool(ThreadPool&& inThreadPool) = delete;
+	ThreadPool& operator = (ThreadPool&& inThreadPool) = delete;
+
+	~ThreadPool();
+
+	uint32_t GetWorkerCount() const { return static_cast<uint32_t>(workers.size()); }
+
+	// Split [0, count[ into batches of at least minBatchSize indices, run them on the workers and the calling thread,
+	// and only return once all of them are done. Small ranges are run on the calling thread only, not to pay for synchronisation.
+	// Warning: batches must not write to shared data, and tasks must not call ParallelFor themselves
+	void ParallelFor(const std::size_t count, const std::size_t minBatchSize, const BatchTask& task);
+
+private:
+	ThreadPool(const uint32_t workerCount);
+
+	// One worker per hardware thread, minus the calling one
+	static uint32_t ComputeWorkerCount();
+
+	std::vector<std::thread> workers;
+
+	std::mutex mutex;
+	std::condition_variable workAvailable;
+	std::condition_variable workDone;
+
+	// Current ParallelFor call, shared with the workers
+	const BatchTask* task{ nullptr };
+	std::size_t taskCount{ 0 };
+	std::size_t batchSize{ 0 };
+	std::size_t batchCount{ 0 };
+	std::atomic<std::size_t> nextBatch{ 0 };
+
+	// Incremented at each ParallelFor call, so workers know new work is available
+	uint64_t generation{ 0 };
+	uint32_t busyWorkerCount{ 0 };
+	bool isStopping{ false };
+
+	void RunWorker();
+
+	// Grab and run batches until none is left (called by workers and the calling thread alike)
+	void RunBatches();
+};
+
+
+
+#endif // THREAD_POOL_H
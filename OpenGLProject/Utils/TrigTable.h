@@ -0,0 +1,100 @@
+#ifndef TRIG_TABLE_H
+#define TRIG_TABLE_H
+
+#include <array>
+#include <cstddef> // std::size_t
+#include <cstdint>
+
+
+
+// Sines of a full turn split into equal angle steps, computed at compile time (glm/std trigonometric functions not being constexpr),
+// so meshes sampling angles on those steps (e.g. unit spheres and circles) are built without any trigonometric call
+namespace TrigTable
+{
+	// Angle steps of the full turn: a multiple of the subdivisions of every mesh sampling the table
+	constexpr uint32_t TURN_STEP_COUNT = 2400;
+
+	// Return whether a turn split into the provided amount of equal parts only falls on table steps
+	constexpr bool IsSampled(const uint32_t turnPartCount) { return turnPartCount != 0 && TURN_STEP_COUNT % turnPartCount == 0; }
+
+	namespace Detail
+	{
+		constexpr double pi = 3.14159265358979323846;
+
+		// Taylor series up to degree 21, accurate to double precision over [0, Pi/2]
+		constexpr double Sin(const double x)
+		{
+			double term = x;
+			double sum = x;
+			for (int32_t n = 1; n <= 10; ++n)
+			{
+				term *= -x * x / ((2.0 * n) * (2.0 * n + 1.0));
+				sum += term;
+			}
+
+			return sum;
+		}
+
+		constexpr double Cos(const double x)
+		{
+			double term = 1.0;
+			double sum = 1.0;
+			for (int32_t n = 1; n <= 10; ++n)
+			{
+				term *= -x * x / ((2.0 * n - 1.0) * (2.0 * n));
+				sum += term;
+			}
+
+			return sum;
+		}
+
+		// Steps are reduced to the first quarter of the turn, where the series converge quickly
+		constexpr std::array<float, TURN_STEP_COUNT> ComputeSines()
+		{
+			constexpr uint32_t quarterStepCount = TURN_STEP_COUNT / 4;
+			constexpr double stepAngle = 2.0 * pi / TURN_STEP_COUNT;
+
+			std::array<float, TURN_STEP_COUNT> sines{};
+			for (uint32_t step = 0; step < TURN_STEP_COUNT; ++step)
+			{
+				const double angle = (step % quarterStepCount) * stepAngle;
+				switch (step / quarterStepCount)
+				{
+				case 0:
+				{
+					sines[step] = static_cast<float>(Sin(angle));
+					break;
+				}
+				case 1:
+				{
+					sines[step] = static_cast<float>(Cos(angle));
+					break;
+				}
+				case 2:
+				{
+					sines[step] = static_cast<float>(-Sin(angle));
+					break;
+				}
+				default:
+				{
+					sines[step] = static_cast<float>(-Cos(angle));
+				}
+				}
+			}
+
+			return sines;
+		}
+	}
+
+	inline constexpr std::array<float, TURN_STEP_COUNT> SINES = Detail::ComputeSines();
+
+	static_assert(TURN_STEP_COUNT % 4 == 0, "Quarter turns should fall on table steps");
+
+	// Sine/cosine of the angle step * 2 Pi / TURN_STEP_COUNT, for any (possibly negative) step
+	constexpr float Sin(const int64_t step) { return SINES[static_cast<std::size_t>((step % TURN_STEP_COUNT + TURN_STEP_COUNT) % TURN_STEP_COUNT)]; }
+	constexpr float Cos(const int64_t step) { return Sin(step + TURN_STEP_COUNT / 4); }
+}
+
+
+
+#endif // TRIG_TABLE_H